@@ -76,7 +76,7 @@ using namespace ns3::ccnx;
 #define DEBUG_TRACE 0
 
 void
-RunSimulation (void)
+RunSimulation (unsigned batchSize)
 {
   Time::SetResolution (Time::NS);
 
@@ -125,12 +125,14 @@ RunSimulation (void)
   forwarderHelper.SetLayerDelayConstant (MicroSeconds (10));
   forwarderHelper.SetLayerDelaySlope (NanoSeconds (1));
   forwarderHelper.SetLayerDelayServers (2);
+  forwarderHelper.SetLayerDelayBatchSize (batchSize);
 
   // Set the PIT processing times (linear function of name bytes)
   CCNxStandardPitFactory pitFactory;
   pitFactory.SetLayerDelayConstant (MicroSeconds (10));
   pitFactory.SetLayerDelaySlope (NanoSeconds (3));
   pitFactory.SetLayerDelayServers (4);
+  pitFactory.SetLayerDelayBatchSize (batchSize);
   forwarderHelper.SetPitFactory (pitFactory);
 
   // Set the FIB processing times (linear function of name components until match found)
@@ -138,6 +140,7 @@ RunSimulation (void)
   fibFactory.SetLayerDelayConstant (MicroSeconds (8));
   fibFactory.SetLayerDelaySlope (NanoSeconds (7));
   fibFactory.SetLayerDelayServers (2);
+  fibFactory.SetLayerDelayBatchSize (batchSize);
   forwarderHelper.SetFibFactory (fibFactory);
 
   ccnxStack.SetForwardingHelper (forwarderHelper);
@@ -192,7 +195,13 @@ RunSimulation (void)
 int
 main (int argc, char *argv[])
 {
+  // The most queued packets each layer delay server takes per scheduler event
+  unsigned batchSize = 1;
 
-  RunSimulation ();
+  CommandLine cmd;
+  cmd.AddValue ("batchSize", "Layer delay batch size of the forwarder, PIT, and FIB", batchSize);
+  cmd.Parse (argc, argv);
+
+  RunSimulation (batchSize);
   return 0;
 }
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+/*
+ * Link-flap benchmark on the 12-node NFP topology of ccnx-nfp-routing-12node.cc.
+ *
+ * Every flapPeriod one point-to-point link (round robin) is taken down at both ends for
+ * downTime and then brought back up.  While a link is down its neighbors stop hearing Hellos,
+ * time out, and NFP removes every route learned over that connection.  The run reports the
+ * wall-clock time of the simulation, each node's NFP computation cost, and the NFP bytes sent
+ * by all nodes, so the cost of neighbor-down handling can be compared between builds.  Use
+ * --compactPayloads=false to compare the bytes sent against the uncompressed payload encoding.
+ *
+ * Example:
+ *    ./waf --run "ccnx-nfp-link-flap-benchmark --prefixes=200 --simTime=120"
+ *    ./waf --run "ccnx-nfp-link-flap-benchmark --prefixes=10000 --compactPayloads=false"
+ *
+ * Uses a point-to-point topology.  n0 anchors the benchmark prefixes.
+ *
+ *                             -----------n11
+ *                             |           |
+ *                n4 --  n5 -- n6 --- n7 \ |
+ *                |      |     |   x  |   n9 -- n10
+ * n0 ----------- n1     n2    n3 --- n8 /
+ *     5Mbps      |      |     |
+ *     2ms      |------ LAN -----|
+ *                    100 Mbps / 1 usec
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/csma-module.h"
+
+#include "ns3/ccns3Sim-module.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxNfpLinkFlapBenchmark");
+
+static uint32_t g_flapCount = 0;
+
+static void
+SetLinkState (Ptr<NetDevice> a, Ptr<NetDevice> b, bool up)
+{
+  Ptr<NetDevice> ends[2] = { a, b };
+  for (int i = 0; i < 2; ++i)
+    {
+      Ptr<CCNxL3Protocol> ccnx = ends[i]->GetNode ()->GetObject<CCNxL3Protocol> ();
+      Ptr<CCNxL3Interface> interface = ccnx->GetInterface (ends[i]->GetIfIndex ());
+      if (up)
+        {
+          interface->SetUp ();
+        }
+      else
+        {
+          interface->SetDown ();
+        }
+    }
+}
+
+static void
+FlapLink (NetDeviceContainer pppDevices, uint32_t link, Time flapPeriod, Time downTime)
+{
+  uint32_t linkCount = pppDevices.GetN () / 2;
+  Ptr<NetDevice> a = pppDevices.Get (2 * link);
+  Ptr<NetDevice> b = pppDevices.Get (2 * link + 1);
+
+  g_flapCount++;
+  NS_LOG_INFO ("Flap link " << link << " n" << a->GetNode ()->GetId () << " -- n" << b->GetNode ()->GetId ()
+                            << " at " << Simulator::Now ().GetSeconds ());
+
+  SetLinkState (a, b, false);
+  Simulator::Schedule (downTime, &SetLinkState, a, b, true);
+  Simulator::Schedule (flapPeriod, &FlapLink, pppDevices, (link + 1) % linkCount, flapPeriod, downTime);
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t prefixes = 100;
+  double simTime = 60.0;
+  double flapStart = 10.0;
+  double flapPeriod = 5.0;
+  double downTime = 4.0;
+  bool compactPayloads = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("prefixes", "Number of prefixes anchored at n0", prefixes);
+  cmd.AddValue ("simTime", "Simulation time (seconds)", simTime);
+  cmd.AddValue ("flapStart", "Time of the first link flap (seconds)", flapStart);
+  cmd.AddValue ("flapPeriod", "Time between link flaps (seconds)", flapPeriod);
+  cmd.AddValue ("downTime", "How long a flapped link stays down (seconds)", downTime);
+  cmd.AddValue ("compactPayloads", "Use the compact NFP payload encoding", compactPayloads);
+  cmd.Parse (argc, argv);
+
+  Time::SetResolution (Time::NS);
+
+  NodeContainer nodes;
+  nodes.Create (12);
+
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+
+  NetDeviceContainer pppDevices;
+
+  pppDevices.Add (pointToPoint.Install (nodes.Get (0), nodes.Get (1)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (1), nodes.Get (4)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (2), nodes.Get (5)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (3), nodes.Get (6)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (3), nodes.Get (8)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (3), nodes.Get (7)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (4), nodes.Get (5)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (5), nodes.Get (6)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (6), nodes.Get (7)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (6), nodes.Get (8)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (6), nodes.Get (11)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (7), nodes.Get (8)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (7), nodes.Get (9)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (8), nodes.Get (9)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (9), nodes.Get (10)));
+  pppDevices.Add (pointToPoint.Install (nodes.Get (9), nodes.Get (11)));
+
+  NodeContainer csmaNodes;
+  csmaNodes.Add (nodes.Get (1));
+  csmaNodes.Add (nodes.Get (2));
+  csmaNodes.Add (nodes.Get (3));
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (1000000000));    // 1 Gbps
+  csma.SetChannelAttribute ("Delay", TimeValue (MicroSeconds (1)));
+  NetDeviceContainer csmaDevices = csma.Install (csmaNodes);
+
+  NfpRoutingHelper nfpHelper;
+  nfpHelper.Set ("HelloInterval", TimeValue (Seconds (1)));
+  nfpHelper.Set ("CompactPayloads", BooleanValue (compactPayloads));
+
+  CCNxStackHelper ccnxStack;
+  ccnxStack.SetRoutingHelper (nfpHelper);
+  ccnxStack.Install (nodes);
+  ccnxStack.AddInterfaces (pppDevices);
+  ccnxStack.AddInterfaces (csmaDevices);
+
+  // n0 anchors many prefixes so each neighbor-down has a large RIB to clean up
+  TypeId tid = TypeId::LookupByName ("ns3::ccnx::CCNxMessagePortalFactory");
+  Ptr<CCNxPortal> sink = CCNxPortal::CreatePortal (nodes.Get (0), tid);
+  for (uint32_t i = 0; i < prefixes; ++i)
+    {
+      std::ostringstream uri;
+      uri << "ccnx:/name=foo/name=prefix" << i;
+      sink->RegisterAnchor (Create<CCNxName> (uri.str ()));
+    }
+
+  Simulator::Schedule (Seconds (flapStart), &FlapLink, pppDevices, 0, Seconds (flapPeriod), Seconds (downTime));
+
+  Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper> (&std::cout);
+  NfpRoutingHelper::PrintComputationCostAllNodesWithDelay (Seconds (simTime), stream);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  Simulator::Stop (Seconds (simTime) + MilliSeconds (1));
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  NfpStats stats;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      stats += nodes.Get (i)->GetObject<NfpRoutingProtocol> ()->GetStats ();
+    }
+
+  Simulator::Destroy ();
+
+  std::cout << "Prefixes " << prefixes << " flaps " << g_flapCount
+            << " simTime " << simTime << "s wallClock " << elapsed << " ms" << std::endl;
+  std::cout << "Compact payloads " << compactPayloads << " payloads sent " << stats.GetPayloadsSent ()
+            << " bytes sent " << stats.GetBytesSent () << std::endl;
+  return 0;
+}
@@ -69,6 +69,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <sys/resource.h>
 
 #include "ns3/core-module.h"
 #include "ns3/network-module.h"
@@ -129,7 +130,7 @@ PrintTraffic (Ptr<CCNxPortal> sink)
 }
 
 static void
-RunSimulation (void)
+RunSimulation (Time linkCostDelayUnit)
 {
 //    LogComponentEnable ("CCNxStandardLayer3", (LogLevel) (LOG_LEVEL_INFO | LOG_PREFIX_ALL));
 //    LogComponentEnable ("NfpRoutingProtocol", (LogLevel) (LOG_LEVEL_INFO | LOG_PREFIX_ALL));
@@ -198,6 +199,9 @@ RunSimulation (void)
 
   NfpRoutingHelper nfpHelper;
   nfpHelper.Set ("HelloInterval", TimeValue (Seconds (1)));
+
+  // With a positive unit, the 2 msec links cost more than the 1 usec LAN
+  nfpHelper.Set ("LinkCostDelayUnit", TimeValue (linkCostDelayUnit));
   nfpHelper.PrintNeighborTableAllNodesWithInterval (Time (Seconds (5)), trace);
   nfpHelper.PrintRoutingTableAllNodesWithInterval (Time (Seconds (5)), trace);
 
@@ -226,15 +230,50 @@ RunSimulation (void)
   Ptr<CCNxPortal> source = CCNxPortal::CreatePortal (nodes.Get (10), tid);
   Simulator::Schedule (Seconds (0.5), &GenerateTraffic, source, 500, sinkName);
 
+  NfpRoutingHelper::PrintComputationCostAllNodesWithDelay (Seconds (10), trace);
+
   // Run the simulator and execute all the events
   Simulator::Stop (Seconds (10));
   Simulator::Run ();
   Simulator::Destroy ();
 }
 
+/*
+ * Peak resident set size so runs with and without the forwarder pool can be compared.
+ * ru_maxrss is in KB on Linux.
+ */
+static void
+PrintMemoryUsage (void)
+{
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+
+  CCNxPoolAllocator::Stats stats = CCNxPoolAllocator::GetStats ();
+  std::cout << "Pool enabled=" << CCNxPoolAllocator::IsEnabled ()
+            << " allocations=" << stats.allocations
+            << " heapAllocations=" << stats.heapAllocations
+            << " slabBytes=" << CCNxPoolAllocator::GetSlabBytes () << std::endl;
+  std::cout << "Peak RSS " << usage.ru_maxrss << " KB" << std::endl;
+}
+
 int
 main (int argc, char *argv[])
 {
-  RunSimulation ();
+  bool pool = true;
+  std::string strategy = "Multicast";
+  double linkCostDelayUnit = 0;
+
+  CommandLine cmd;
+  cmd.AddValue ("pool", "Allocate per-packet forwarder objects from CCNxPoolAllocator", pool);
+  cmd.AddValue ("strategy", "FIB forwarding strategy (Multicast, BestRoute, Ecmp, WeightedSplit, Adaptive)", strategy);
+  cmd.AddValue ("linkCostDelayUnit", "If positive, NFP link cost is the channel delay in these microseconds", linkCostDelayUnit);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::ccnx::CCNxStandardFib::ForwardingStrategy", StringValue (strategy));
+
+  CCNxPoolAllocator::SetEnabled (pool);
+
+  RunSimulation (MicroSeconds (linkCostDelayUnit));
+  PrintMemoryUsage ();
   return 0;
 }
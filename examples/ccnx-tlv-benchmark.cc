@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+/*
+ * Microbenchmark of the two ways to walk a TLV container.
+ *
+ * The iterator path reads each type, length and value through a Buffer::Iterator, which
+ * bounds checks every byte.  The cursor path copies the container out of the Buffer once and
+ * walks it with a CCNxTlvCursor, which checks each TLV once against the end of the container.
+ * The next two rows time a whole name through CCNxCodecName, which uses the cursor path.
+ *
+ * The last rows decode an Interest (with KeyId and ContentObjectHash restrictions) and a
+ * Content Object (with payload type and expiry time) of the same name and a `payloadSize`
+ * payload, through CCNxCodecInterest and CCNxCodecContentObject.  These walk the message
+ * with the Buffer::Iterator and hand the T_NAME to CCNxCodecName.  The "deferred" rows use
+ * SetDeferPayload() so the payload is not copied.
+ *
+ * Usage:
+ *    ./waf --run "ccnx-tlv-benchmark --segments=8 --segmentLength=12 --payloadSize=1000 --iterations=1000000"
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ccns3Sim-module.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+static Ptr<const CCNxName>
+CreateName (uint32_t segments, uint32_t segmentLength)
+{
+  std::ostringstream uri;
+  uri << "ccnx:";
+  for (uint32_t i = 0; i < segments; i++)
+    {
+      uri << "/name=" << std::string (segmentLength, 'a' + (i % 26));
+    }
+  return Create<CCNxName> (uri.str ());
+}
+
+static void
+Report (const std::string &label, int64_t ms, uint32_t iterations, uint64_t checksum)
+{
+  double nsPerOp = iterations ? (ms * 1e6) / iterations : 0.0;
+  std::cout << std::left << std::setw (22) << label
+            << std::right << std::setw (10) << ms << " ms"
+            << std::setw (12) << std::fixed << std::setprecision (1) << nsPerOp << " ns/op"
+            << "   (checksum " << checksum << ")" << std::endl;
+}
+
+/*
+ * Walk the segments of the T_NAME container at `start` with the Buffer::Iterator.
+ */
+static uint64_t
+WalkIterator (Buffer::Iterator start, uint8_t *scratch)
+{
+  uint64_t sum = 0;
+  CCNxTlv::ReadType (start);
+  uint16_t outerLength = CCNxTlv::ReadLength (start);
+  uint32_t bytesRead = 0;
+  while (bytesRead < outerLength)
+    {
+      uint16_t type = CCNxTlv::ReadType (start);
+      uint16_t length = CCNxTlv::ReadLength (start);
+      start.Read (scratch, length);
+      sum += type + length + scratch[0];
+      bytesRead += CCNxTlv::GetTLSize () + length;
+    }
+  return sum;
+}
+
+/*
+ * Walk the same container with one bulk read and a CCNxTlvCursor.
+ */
+static uint64_t
+WalkCursor (Buffer::Iterator start, uint8_t *scratch)
+{
+  uint64_t sum = 0;
+  CCNxTlv::ReadType (start);
+  uint16_t outerLength = CCNxTlv::ReadLength (start);
+  start.Read (scratch, outerLength);
+
+  CCNxTlvCursor cursor (scratch, outerLength);
+  uint16_t type;
+  uint16_t length;
+  const uint8_t *value;
+  while (cursor.Next (type, length, value))
+    {
+      sum += type + length + value[0];
+    }
+  NS_ASSERT_MSG (cursor.IsEnd (), "Malformed name");
+  return sum;
+}
+
+/*
+ * Decode the message at `buffer` `iterations` times with a new Codec each time and report it.
+ */
+template <class Codec>
+static void
+TimeDeserialize (const std::string &label, const Buffer &buffer, bool deferPayload, uint32_t iterations)
+{
+  SystemWallClockMs clock;
+  uint64_t checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      Codec decoder;
+      decoder.SetDeferPayload (deferPayload);
+      checksum += decoder.Deserialize (buffer.Begin ());
+      checksum += decoder.GetHeader ()->GetName ()->GetSegmentCount ();
+    }
+  Report (label, clock.End (), iterations, checksum);
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t segments = 8;
+  uint32_t segmentLength = 12;
+  uint32_t payloadSize = 1000;
+  uint32_t iterations = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("segments", "Number of name segments", segments);
+  cmd.AddValue ("segmentLength", "Bytes per name segment", segmentLength);
+  cmd.AddValue ("payloadSize", "Payload bytes of the Interest and Content Object", payloadSize);
+  cmd.AddValue ("iterations", "Number of times to run each benchmark", iterations);
+  cmd.Parse (argc, argv);
+
+  Ptr<const CCNxName> name = CreateName (segments, segmentLength);
+  CCNxCodecName codec;
+  codec.SetHeader (name);
+
+  Buffer buffer (0);
+  buffer.AddAtStart (codec.GetSerializedSize ());
+  codec.Serialize (buffer.Begin ());
+
+  std::vector<uint8_t> scratch (buffer.GetSize ());
+
+  std::cout << "name " << segments << " x " << segmentLength << " bytes, "
+            << buffer.GetSize () << " bytes on the wire, " << iterations << " iterations" << std::endl;
+
+  SystemWallClockMs clock;
+  uint64_t checksum;
+
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      checksum += WalkIterator (buffer.Begin (), scratch.data ());
+    }
+  Report ("walk iterator", clock.End (), iterations, checksum);
+
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      checksum += WalkCursor (buffer.Begin (), scratch.data ());
+    }
+  Report ("walk cursor", clock.End (), iterations, checksum);
+
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      CCNxCodecName decoder;
+      decoder.Deserialize (buffer.Begin ());
+      checksum += decoder.GetHeader ()->GetSegmentCount ();
+    }
+  Report ("codec deserialize", clock.End (), iterations, checksum);
+
+  Buffer out (0);
+  out.AddAtStart (codec.GetSerializedSize ());
+  checksum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      codec.Serialize (out.Begin ());
+      Buffer::Iterator it = out.Begin ();
+      checksum += it.ReadU8 ();
+    }
+  Report ("codec serialize", clock.End (), iterations, checksum);
+
+  Ptr<CCNxInterest> interest = Create<CCNxInterest> (name, Create<CCNxBuffer> (payloadSize, true),
+                                                     Create<CCNxHashValue> (1), Create<CCNxHashValue> (2));
+  CCNxCodecInterest interestCodec;
+  interestCodec.SetHeader (interest);
+  Buffer interestBuffer (0);
+  interestBuffer.AddAtStart (interestCodec.GetSerializedSize ());
+  interestCodec.Serialize (interestBuffer.Begin ());
+
+  Ptr<CCNxContentObject> object = Create<CCNxContentObject> (name, Create<CCNxBuffer> (payloadSize, true),
+                                                             CCNxContentObjectPayloadType_Data, Create<CCNxTime> (1000000));
+  CCNxCodecContentObject objectCodec;
+  objectCodec.SetHeader (object);
+  Buffer objectBuffer (0);
+  objectBuffer.AddAtStart (objectCodec.GetSerializedSize ());
+  objectCodec.Serialize (objectBuffer.Begin ());
+
+  std::cout << "interest " << interestBuffer.GetSize () << " bytes, content object "
+            << objectBuffer.GetSize () << " bytes on the wire" << std::endl;
+
+  TimeDeserialize<CCNxCodecInterest> ("interest", interestBuffer, false, iterations);
+  TimeDeserialize<CCNxCodecInterest> ("interest deferred", interestBuffer, true, iterations);
+  TimeDeserialize<CCNxCodecContentObject> ("object", objectBuffer, false, iterations);
+  TimeDeserialize<CCNxCodecContentObject> ("object deferred", objectBuffer, true, iterations);
+
+  return 0;
+}
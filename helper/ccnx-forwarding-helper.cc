@@ -56,6 +56,7 @@
 #include "ccnx-forwarding-helper.h"
 
 #include "ns3/node-list.h"
+#include "ns3/node-container.h"
 #include "ns3/simulator.h"
 #include "ns3/ccnx-forwarder.h"
 
@@ -72,6 +73,19 @@ CCNxForwardingHelper::~CCNxForwardingHelper ()
   // empty
 }
 
+int64_t
+CCNxForwardingHelper::AssignStreams (NodeContainer &c, int64_t stream)
+{
+  int64_t currentStream = stream;
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<CCNxForwarder> forwarder = (*i)->GetObject<CCNxForwarder> ();
+      NS_ASSERT_MSG (forwarder, "CCNxForwarder not installed on node");
+      currentStream += forwarder->AssignStreams (currentStream);
+    }
+  return (currentStream - stream);
+}
+
 void
 CCNxForwardingHelper::PrintForwardingStatisticsAllNodesWithDelay (Time printDelay, Ptr<OutputStreamWrapper> stream)
 {
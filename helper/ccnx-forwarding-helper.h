@@ -59,6 +59,7 @@
 #include "ns3/ptr.h"
 #include "ns3/object.h"
 #include "ns3/node.h"
+#include "ns3/node-container.h"
 #include "ns3/nstime.h"
 #include "ns3/output-stream-wrapper.h"
 
@@ -96,6 +97,16 @@ public:
    */
   virtual TypeId GetForwardingTypeId () const = 0;
 
+  /**
+   * Assign fixed random variable stream numbers to the forwarders on the nodes, starting
+   * at `stream`.  Must be called after the forwarders are installed.
+   *
+   * @param [in] c The nodes whose forwarders get streams
+   * @param [in] stream The first stream number to use
+   * @return The number of streams assigned
+   */
+  static int64_t AssignStreams (NodeContainer &c, int64_t stream);
+
   // ===== Methods to display statistics
 
   /**
@@ -80,8 +80,9 @@ CCNxStackHelper::TraceFilter::Match (Ptr<const CCNxName> name) const
 {
   NS_LOG_FUNCTION (this << name);
 
+  // A packet with no name (not decoded, or a nameless Content Object) only matches an unfiltered trace
   bool match = true;
-  if (m_namePrefix && !m_namePrefix->IsPrefixOf (*name))
+  if (m_namePrefix && (!name || !m_namePrefix->IsPrefixOf (*name)))
     {
       match = false;
     }
@@ -282,10 +283,17 @@ void
 CCNxStackHelper::AsciiDropTraceCallback (std::string context, const CCNxL3Protocol *ccnx, Ptr<const Packet> ns3Packet,
                                          Ptr<const CCNxPacket> ccnxPacket, uint32_t interface, CCNxL3Protocol::DropReason reason)
 {
+  // Packets dropped on receive before they are decoded (e.g. DROP_BAD_HEADER) have no CCNxPacket
+  Ptr<const CCNxName> name;
+  if (ccnxPacket)
+    {
+      name = ccnxPacket->GetMessage ()->GetName ();
+    }
+
   TraceFilterListType *list = m_traceFilters[ccnx->GetNode ()->GetId ()];
   for (std::list<TraceFilter>::const_iterator i = list->cbegin (); i != list->cend (); ++i)
     {
-      if (i->Match (ccnxPacket->GetMessage ()->GetName ()))
+      if (i->Match (name))
         {
           Ptr<OutputStreamWrapper> stream = i->GetStream ();
           AsciiTrace ("d ", context, stream, ccnx, ns3Packet, ccnxPacket, interface);
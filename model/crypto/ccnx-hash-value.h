@@ -59,6 +59,7 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include "ns3/ccnx-byte-array.h"
+#include "ns3/ccnx-pool-allocator.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -70,8 +71,10 @@ namespace ccnx {
  *
  * We use a uint64_t for all hash values, even if they are things like SHA256.
  * In general, we fake all crypto routines.
+ *
+ * The forwarder makes several of these per Content Object, so they come from CCNxPoolAllocator.
  */
-class CCNxHashValue : public SimpleRefCount<CCNxHashValue>
+class CCNxHashValue : public SimpleRefCount<CCNxHashValue>, public CCNxPoolAllocated
 {
 public:
   /**
@@ -69,7 +69,8 @@ CCNxHasherFnv1a::GetTypeId ()
 {
   static TypeId tid = TypeId ("ns3::ccnx::CCNxHasherFnv1a")
     .SetParent<CCNxHasher> ()
-    .SetGroupName ("CCNx");
+    .SetGroupName ("CCNx")
+    .AddConstructor<CCNxHasherFnv1a> ();
   return tid;
 }
 
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <string.h>
+#include <vector>
+#include "ccnx-hasher-sha256.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_OBJECT_ENSURE_REGISTERED (CCNxHasherSha256);
+
+const uint32_t CCNxHasherSha256::m_roundConstants[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t
+RotateRight (uint32_t x, unsigned n)
+{
+  return (x >> n) | (x << (32 - n));
+}
+
+TypeId
+CCNxHasherSha256::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ccnx::CCNxHasherSha256")
+    .SetParent<CCNxHasher> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<CCNxHasherSha256> ();
+  return tid;
+}
+
+CCNxHasherSha256::CCNxHasherSha256 ()
+{
+  Init ();
+}
+
+CCNxHasherSha256::~CCNxHasherSha256 ()
+{
+  // empty
+}
+
+bool
+CCNxHasherSha256::Init ()
+{
+  static const uint32_t initialState[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+  memcpy (m_state, initialState, sizeof (m_state));
+  m_blockLength = 0;
+  m_totalLength = 0;
+  return true;
+}
+
+void
+CCNxHasherSha256::Compress (const uint8_t *block)
+{
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++)
+    {
+      w[i] = ((uint32_t) block[4 * i] << 24) | ((uint32_t) block[4 * i + 1] << 16)
+        | ((uint32_t) block[4 * i + 2] << 8) | (uint32_t) block[4 * i + 3];
+    }
+  for (int i = 16; i < 64; i++)
+    {
+      uint32_t s0 = RotateRight (w[i - 15], 7) ^ RotateRight (w[i - 15], 18) ^ (w[i - 15] >> 3);
+      uint32_t s1 = RotateRight (w[i - 2], 17) ^ RotateRight (w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+  uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+  uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+  for (int i = 0; i < 64; i++)
+    {
+      uint32_t S1 = RotateRight (e, 6) ^ RotateRight (e, 11) ^ RotateRight (e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t t1 = h + S1 + ch + m_roundConstants[i] + w[i];
+      uint32_t S0 = RotateRight (a, 2) ^ RotateRight (a, 13) ^ RotateRight (a, 22);
+      uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t t2 = S0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+
+  m_state[0] += a;
+  m_state[1] += b;
+  m_state[2] += c;
+  m_state[3] += d;
+  m_state[4] += e;
+  m_state[5] += f;
+  m_state[6] += g;
+  m_state[7] += h;
+}
+
+size_t
+CCNxHasherSha256::Update (const uint8_t *buffer, size_t length)
+{
+  m_totalLength += length;
+  size_t offset = 0;
+
+  if (m_blockLength > 0)
+    {
+      size_t fill = sizeof (m_block) - m_blockLength;
+      if (fill > length)
+        {
+          fill = length;
+        }
+      memcpy (m_block + m_blockLength, buffer, fill);
+      m_blockLength += fill;
+      offset += fill;
+      if (m_blockLength == sizeof (m_block))
+        {
+          Compress (m_block);
+          m_blockLength = 0;
+        }
+    }
+
+  // whole blocks straight from the caller's buffer
+  while (length - offset >= sizeof (m_block))
+    {
+      Compress (buffer + offset);
+      offset += sizeof (m_block);
+    }
+
+  if (offset < length)
+    {
+      memcpy (m_block + m_blockLength, buffer + offset, length - offset);
+      m_blockLength += length - offset;
+    }
+  return length;
+}
+
+size_t
+CCNxHasherSha256::Update (Buffer::Iterator start)
+{
+  size_t length = 0;
+  uint8_t chunk[256];
+  while (!start.IsEnd ())
+    {
+      size_t n = 0;
+      while (n < sizeof (chunk) && !start.IsEnd ())
+        {
+          chunk[n++] = start.ReadU8 ();
+        }
+      length += Update (chunk, n);
+    }
+  return length;
+}
+
+Ptr<CCNxHashValue>
+CCNxHasherSha256::Finalize ()
+{
+  uint64_t bitLength = m_totalLength * 8;
+
+  // 0x80, zeros to 56 mod 64, then the 64-bit big-endian bit length
+  uint8_t padding[72];
+  size_t padLength = (m_blockLength < 56) ? (56 - m_blockLength) : (120 - m_blockLength);
+  memset (padding, 0, sizeof (padding));
+  padding[0] = 0x80;
+  for (int i = 0; i < 8; i++)
+    {
+      padding[padLength + i] = (uint8_t) (bitLength >> (56 - 8 * i));
+    }
+  Update (padding, padLength + 8);
+
+  std::vector<uint8_t> digest (32);
+  for (int i = 0; i < 8; i++)
+    {
+      digest[4 * i] = (uint8_t) (m_state[i] >> 24);
+      digest[4 * i + 1] = (uint8_t) (m_state[i] >> 16);
+      digest[4 * i + 2] = (uint8_t) (m_state[i] >> 8);
+      digest[4 * i + 3] = (uint8_t) m_state[i];
+    }
+  return Create<CCNxHashValue> (Create<const CCNxByteArray> (digest));
+}
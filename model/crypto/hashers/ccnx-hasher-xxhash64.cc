@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <string.h>
+#include "ccnx-hasher-xxhash64.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_OBJECT_ENSURE_REGISTERED (CCNxHasherXxHash64);
+
+static const uint64_t _prime1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t _prime2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t _prime3 = 0x165667B19E3779F9ULL;
+static const uint64_t _prime4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t _prime5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t
+RotateLeft (uint64_t x, unsigned n)
+{
+  return (x << n) | (x >> (64 - n));
+}
+
+/*
+ * Read little-endian regardless of host byte order
+ */
+static inline uint64_t
+ReadLe64 (const uint8_t *p)
+{
+  uint64_t x = 0;
+  for (int i = 7; i >= 0; --i)
+    {
+      x = (x << 8) | p[i];
+    }
+  return x;
+}
+
+static inline uint32_t
+ReadLe32 (const uint8_t *p)
+{
+  return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static inline uint64_t
+Round (uint64_t lane, uint64_t input)
+{
+  lane += input * _prime2;
+  lane = RotateLeft (lane, 31);
+  return lane * _prime1;
+}
+
+static inline uint64_t
+MergeRound (uint64_t hash, uint64_t lane)
+{
+  hash ^= Round (0, lane);
+  return hash * _prime1 + _prime4;
+}
+
+TypeId
+CCNxHasherXxHash64::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ccnx::CCNxHasherXxHash64")
+    .SetParent<CCNxHasher> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<CCNxHasherXxHash64> ();
+  return tid;
+}
+
+CCNxHasherXxHash64::CCNxHasherXxHash64 ()
+{
+  Init ();
+}
+
+CCNxHasherXxHash64::~CCNxHasherXxHash64 ()
+{
+  // empty
+}
+
+bool
+CCNxHasherXxHash64::Init ()
+{
+  m_lanes[0] = _prime1 + _prime2;
+  m_lanes[1] = _prime2;
+  m_lanes[2] = 0;
+  m_lanes[3] = 0 - _prime1;
+  m_stripeLength = 0;
+  m_totalLength = 0;
+  return true;
+}
+
+void
+CCNxHasherXxHash64::Consume (const uint8_t *stripe)
+{
+  m_lanes[0] = Round (m_lanes[0], ReadLe64 (stripe));
+  m_lanes[1] = Round (m_lanes[1], ReadLe64 (stripe + 8));
+  m_lanes[2] = Round (m_lanes[2], ReadLe64 (stripe + 16));
+  m_lanes[3] = Round (m_lanes[3], ReadLe64 (stripe + 24));
+}
+
+size_t
+CCNxHasherXxHash64::Update (const uint8_t *buffer, size_t length)
+{
+  m_totalLength += length;
+  size_t offset = 0;
+
+  if (m_stripeLength > 0)
+    {
+      size_t fill = sizeof (m_stripe) - m_stripeLength;
+      if (fill > length)
+        {
+          fill = length;
+        }
+      memcpy (m_stripe + m_stripeLength, buffer, fill);
+      m_stripeLength += fill;
+      offset += fill;
+      if (m_stripeLength == sizeof (m_stripe))
+        {
+          Consume (m_stripe);
+          m_stripeLength = 0;
+        }
+    }
+
+  // whole stripes straight from the caller's buffer
+  while (length - offset >= sizeof (m_stripe))
+    {
+      Consume (buffer + offset);
+      offset += sizeof (m_stripe);
+    }
+
+  if (offset < length)
+    {
+      memcpy (m_stripe + m_stripeLength, buffer + offset, length - offset);
+      m_stripeLength += length - offset;
+    }
+  return length;
+}
+
+size_t
+CCNxHasherXxHash64::Update (Buffer::Iterator start)
+{
+  size_t length = 0;
+  uint8_t chunk[256];
+  while (!start.IsEnd ())
+    {
+      size_t n = 0;
+      while (n < sizeof (chunk) && !start.IsEnd ())
+        {
+          chunk[n++] = start.ReadU8 ();
+        }
+      length += Update (chunk, n);
+    }
+  return length;
+}
+
+Ptr<CCNxHashValue>
+CCNxHasherXxHash64::Finalize ()
+{
+  uint64_t hash;
+  if (m_totalLength >= sizeof (m_stripe))
+    {
+      hash = RotateLeft (m_lanes[0], 1) + RotateLeft (m_lanes[1], 7)
+        + RotateLeft (m_lanes[2], 12) + RotateLeft (m_lanes[3], 18);
+      for (int i = 0; i < 4; i++)
+        {
+          hash = MergeRound (hash, m_lanes[i]);
+        }
+    }
+  else
+    {
+      hash = m_lanes[2] + _prime5;
+    }
+
+  hash += m_totalLength;
+
+  // the tail is whatever did not fill a stripe
+  const uint8_t *p = m_stripe;
+  size_t remaining = m_stripeLength;
+  while (remaining >= 8)
+    {
+      hash ^= Round (0, ReadLe64 (p));
+      hash = RotateLeft (hash, 27) * _prime1 + _prime4;
+      p += 8;
+      remaining -= 8;
+    }
+  if (remaining >= 4)
+    {
+      hash ^= (uint64_t) ReadLe32 (p) * _prime1;
+      hash = RotateLeft (hash, 23) * _prime2 + _prime3;
+      p += 4;
+      remaining -= 4;
+    }
+  while (remaining > 0)
+    {
+      hash ^= (*p) * _prime5;
+      hash = RotateLeft (hash, 11) * _prime1;
+      p++;
+      remaining--;
+    }
+
+  hash ^= hash >> 33;
+  hash *= _prime2;
+  hash ^= hash >> 29;
+  hash *= _prime3;
+  hash ^= hash >> 32;
+
+  return Create<CCNxHashValue> (hash, sizeof(uint64_t));
+}
@@ -84,3 +84,15 @@ CCNxFib::~CCNxFib ()
 {
 
 }
+
+void
+CCNxFib::ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress)
+{
+  // empty
+}
+
+void
+CCNxFib::SetInterestLifetime (Time lifetime)
+{
+  // empty
+}
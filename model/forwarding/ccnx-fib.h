@@ -61,6 +61,7 @@
 #include <map>
 #include "ns3/ccnx-name.h"
 #include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
 #include "ns3/ccnx-connection.h"
 #include "ns3/ccnx-forwarder.h"
 #include "ns3/ccnx-forwarder-message.h"
@@ -146,8 +147,11 @@ public:
 
   /**
    * AddRoute - add a prefix to the Fib. A new FibEntry is created if necessary.
+   * If the route already exists, its cost is updated.
    *
    * @param [in]  Ptr<CCNxName> ccnxName - a Ptr to the ccnxName object of the prefix
+   * @param [in]  connection - the next hop
+   * @param [in]  cost - the route cost through `connection`, as given by the routing protocol (lower is better)
    * @return true on success (currently only returns true).
    *
    * Example:
@@ -163,7 +167,7 @@ public:
    *
    * @see ccnxForwarding_Release
    */
-  virtual bool AddRoute (Ptr<const CCNxName> ccnxName, Ptr<CCNxConnection>  connection) = 0;
+  virtual bool AddRoute (Ptr<const CCNxName> ccnxName, Ptr<CCNxConnection>  connection, uint32_t cost = 0) = 0;
 
   /**
    * DeleteRoute - delete a route from the Fib. The FibEntry is deleted if empty.
@@ -215,6 +219,22 @@ public:
    */
   virtual int CountEntries () = 0;
 
+  /**
+   * A Content Object for `name` arrived on `ingress` and satisfied an Interest this FIB routed.
+   * This is feedback for a forwarding strategy that measures its next hops.  The default does nothing.
+   *
+   * @param name [in] The Content Object name
+   * @param ingress [in] The connection the Content Object arrived on
+   */
+  virtual void ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress);
+
+  /**
+   * The PIT lifetime of an Interest without a lifetime header.  A forwarding strategy that
+   * measures its next hops counts an Interest not answered within this time as unsatisfied.
+   * The default does nothing.
+   */
+  virtual void SetInterestLifetime (Time lifetime);
+
 
 };          //class
 }    //namespace
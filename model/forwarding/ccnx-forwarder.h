@@ -227,6 +227,14 @@ public:
    */
   virtual void PrintForwardingStatistics (Ptr<OutputStreamWrapper> streamWrapper) const = 0;
 
+  /**
+   * Assign a fixed random variable stream number to the random variables used by the forwarder.
+   *
+   * @param stream [in] The first stream number to use
+   * @return The number of streams assigned
+   */
+  virtual int64_t AssignStreams (int64_t stream) = 0;
+
 
 
   /**
@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_CCNX_HASH_TABLE_H_
+#define CCNS3SIM_MODEL_FORWARDING_CCNX_HASH_TABLE_H_
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+#include "ns3/assert.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-forwarder-base
+ *
+ * An open-addressing (linear probing) hash table keyed by a caller-supplied 64-bit digest.
+ *
+ * The caller computes the digest of a key once (e.g. `CCNxName::GetHash()`) and passes it
+ * to every operation.  The table compares the stored digest first and only calls `KeyEqual`
+ * on a digest hit, so a lookup normally costs one or two cache lines and a single full key
+ * comparison.
+ *
+ * The slot array is a power of two in size and is grown when occupied plus deleted slots
+ * exceed 3/4 of the capacity.  Deleted slots are tombstones until the next resize.
+ *
+ * N.B.: Because this is a class template, all implementation must be in the header
+ * file so the compiler can generate the template specializations from user code.
+ *
+ * Example:
+ * @code
+ * {
+ *   CCNxHashTable< Ptr<const CCNxName>, Ptr<CCNxStandardPitEntry>, EqualsPtrCCNxName > table;
+ *   table.Insert (name->GetHash (), name, entry);
+ *   Ptr<CCNxStandardPitEntry> *found = table.Find (name->GetHash (), name);
+ * }
+ * @endcode
+ */
+template <class K, class V, class KeyEqual>
+class CCNxHashTable
+{
+public:
+  /**
+   * @param initialCapacity [in] The initial number of slots, rounded up to a power of 2
+   */
+  CCNxHashTable (size_t initialCapacity = 16)
+    : m_count (0), m_deleted (0)
+  {
+    size_t capacity = 8;
+    while (capacity < initialCapacity)
+      {
+        capacity <<= 1;
+      }
+    m_slots.resize (capacity);
+  }
+
+  /**
+   * Look up a key.
+   *
+   * @param digest [in] The digest of `key`
+   * @param key [in] The key to find
+   * @return A pointer to the stored value, or NULL if not found.  The pointer is
+   *         invalidated by the next Insert().
+   */
+  V * Find (uint64_t digest, const K &key)
+  {
+    size_t index = Probe (digest, key);
+    return (index == NotFound) ? 0 : &m_slots[index].value;
+  }
+
+  /**
+   * Look up a key using a query of another type, so the caller does not need to build a key.
+   *
+   * @param digest [in] The digest of the key being looked for
+   * @param query [in] Passed to `equal`
+   * @param equal [in] `equal (key, query)` returns true if `key` is the one being looked for
+   * @return A pointer to the stored value, or NULL if not found.  The pointer is
+   *         invalidated by the next Insert().
+   */
+  template <class Q, class QueryEqual>
+  V * Find (uint64_t digest, const Q &query, QueryEqual equal)
+  {
+    size_t index = Probe (digest, query, equal);
+    return (index == NotFound) ? 0 : &m_slots[index].value;
+  }
+
+  /**
+   * Insert or replace the value for a key.
+   *
+   * @param digest [in] The digest of `key`
+   * @param key [in] The key to insert
+   * @param value [in] The value to store
+   * @return A reference to the stored value
+   */
+  V & Insert (uint64_t digest, const K &key, const V &value)
+  {
+    size_t index = Probe (digest, key);
+    if (index != NotFound)
+      {
+        m_slots[index].value = value;
+        return m_slots[index].value;
+      }
+
+    if ((m_count + m_deleted + 1) * 4 > m_slots.size () * 3)
+      {
+        Resize (m_count * 2 + 1 > m_slots.size () / 2 ? m_slots.size () * 2 : m_slots.size ());
+      }
+
+    size_t mask = m_slots.size () - 1;
+    index = digest & mask;
+    while (m_slots[index].state == Occupied)
+      {
+        index = (index + 1) & mask;
+      }
+
+    if (m_slots[index].state == Deleted)
+      {
+        m_deleted--;
+      }
+
+    Slot &slot = m_slots[index];
+    slot.state = Occupied;
+    slot.digest = digest;
+    slot.key = key;
+    slot.value = value;
+    m_count++;
+    return slot.value;
+  }
+
+  /**
+   * Remove a key.
+   *
+   * @param digest [in] The digest of `key`
+   * @param key [in] The key to remove
+   * @return true if the key was found and removed
+   */
+  bool Erase (uint64_t digest, const K &key)
+  {
+    size_t index = Probe (digest, key);
+    if (index == NotFound)
+      {
+        return false;
+      }
+
+    EraseSlot (index);
+    return true;
+  }
+
+  /**
+   * The number of keys in the table
+   */
+  size_t size () const
+  {
+    return m_count;
+  }
+
+  /**
+   * The number of slots in the table.  Use with `IsOccupied()`, `GetKey()`, `GetValue()`, and
+   * `EraseSlot()` to walk the table.
+   */
+  size_t capacity () const
+  {
+    return m_slots.size ();
+  }
+
+  bool IsOccupied (size_t index) const
+  {
+    return m_slots[index].state == Occupied;
+  }
+
+  const K & GetKey (size_t index) const
+  {
+    NS_ASSERT_MSG (IsOccupied (index), "Slot is not occupied");
+    return m_slots[index].key;
+  }
+
+  V & GetValue (size_t index)
+  {
+    NS_ASSERT_MSG (IsOccupied (index), "Slot is not occupied");
+    return m_slots[index].value;
+  }
+
+  const V & GetValue (size_t index) const
+  {
+    NS_ASSERT_MSG (IsOccupied (index), "Slot is not occupied");
+    return m_slots[index].value;
+  }
+
+  /**
+   * Remove the key in slot `index`.  Does not move other keys, so it is safe to call while
+   * walking the table by slot index.
+   */
+  void EraseSlot (size_t index)
+  {
+    NS_ASSERT_MSG (IsOccupied (index), "Slot is not occupied");
+    Slot &slot = m_slots[index];
+    slot.state = Deleted;
+    slot.key = K ();
+    slot.value = V ();
+    m_count--;
+    m_deleted++;
+  }
+
+  /**
+   * Remove all keys.  The capacity is not reduced.
+   */
+  void clear ()
+  {
+    size_t capacity = m_slots.size ();
+    m_slots.clear ();
+    m_slots.resize (capacity);
+    m_count = 0;
+    m_deleted = 0;
+  }
+
+private:
+  static const size_t NotFound = (size_t) -1;
+
+  enum SlotState
+  {
+    Empty = 0, Occupied, Deleted
+  };
+
+  struct Slot
+  {
+    Slot () : state (Empty), digest (0), key (), value () {}
+    uint8_t state;
+    uint64_t digest;
+    K key;
+    V value;
+  };
+
+  /**
+   * @return The slot index of `key` or NotFound
+   */
+  size_t Probe (uint64_t digest, const K &key) const
+  {
+    return Probe (digest, key, KeyEqual ());
+  }
+
+  /**
+   * @return The slot index of the key for which `equal (key, query)` is true, or NotFound
+   */
+  template <class Q, class QueryEqual>
+  size_t Probe (uint64_t digest, const Q &query, QueryEqual equal) const
+  {
+    size_t mask = m_slots.size () - 1;
+    size_t index = digest & mask;
+
+    // There is always at least one Empty slot because of the load factor
+    while (m_slots[index].state != Empty)
+      {
+        const Slot &slot = m_slots[index];
+        if (slot.state == Occupied && slot.digest == digest && equal (slot.key, query))
+          {
+            return index;
+          }
+        index = (index + 1) & mask;
+      }
+    return NotFound;
+  }
+
+  /**
+   * Rehash in to a new slot array of `capacity` slots, dropping tombstones.
+   */
+  void Resize (size_t capacity)
+  {
+    std::vector<Slot> old;
+    old.swap (m_slots);
+    m_slots.resize (capacity);
+    m_count = 0;
+    m_deleted = 0;
+
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < old.size (); ++i)
+      {
+        if (old[i].state == Occupied)
+          {
+            size_t index = old[i].digest & mask;
+            while (m_slots[index].state == Occupied)
+              {
+                index = (index + 1) & mask;
+              }
+            m_slots[index] = old[i];
+            m_count++;
+          }
+      }
+  }
+
+  typedef std::vector<Slot> SlotArrayType;
+
+  /**
+   * The slot array, always a power of 2 in size
+   */
+  SlotArrayType m_slots;
+
+  /**
+   * The number of occupied slots
+   */
+  size_t m_count;
+
+  /**
+   * The number of tombstone slots
+   */
+  size_t m_deleted;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_CCNX_HASH_TABLE_H_ */
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_CCNX_POOL_ALLOCATOR_H_
+#define CCNS3SIM_MODEL_FORWARDING_CCNX_POOL_ALLOCATOR_H_
+
+#include <algorithm>
+#include <new>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+#include "ns3/assert.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-forwarder-base
+ *
+ * A size-class pool for the small objects the forwarder creates and frees for every packet
+ * (work items, connection lists, hash values, small vector storage).
+ *
+ * Requests are rounded up to a multiple of `Granularity` bytes.  Each size class up to
+ * `MaxPooledSize` keeps a free list threaded through the freed blocks and refills it by
+ * carving a slab of `SlabBytes` from the heap.  Freed blocks go back on their free list and
+ * slabs are never returned, so after warm up a steady packet load does no malloc/free at all.
+ * Larger requests go straight to the heap.
+ *
+ * The pool is not thread safe, which is fine for a single simulator thread.
+ *
+ * The pool can be turned off with `SetEnabled()` (e.g. to compare peak RSS), in which case every
+ * new request goes to the heap.  `Deallocate()` decides how to free a block by whether it lies
+ * in one of the slabs, not by the current mode, so the mode may be changed at any time, even
+ * with pooled objects (such as file-scope statics created before `main`) still alive.
+ *
+ * N.B.: This is header only so it can be used from class templates (see CCNxSmallVector).
+ *
+ * Example:
+ * @code
+ * {
+ *   void *p = CCNxPoolAllocator::Allocate (sizeof(Foo));
+ *   ...
+ *   CCNxPoolAllocator::Deallocate (p, sizeof(Foo));
+ * }
+ * @endcode
+ */
+class CCNxPoolAllocator
+{
+public:
+  static const size_t Granularity = 16;
+  static const size_t MaxPooledSize = 256;
+  static const size_t SlabBytes = 16384;
+
+  /**
+   * Counters for reporting
+   */
+  struct Stats
+  {
+    uint64_t allocations;     //<! Calls to Allocate()
+    uint64_t heapAllocations; //<! Calls to Allocate() that went to the heap (too large or disabled)
+    uint64_t slabs;           //<! Slabs carved from the heap
+    uint64_t outstanding;     //<! Pooled blocks currently allocated
+  };
+
+  /**
+   * Returns a block of at least `size` bytes, suitably aligned for any object.
+   */
+  static void * Allocate (size_t size)
+  {
+    State &state = GetState ();
+    state.stats.allocations++;
+
+    if (!state.enabled || size > MaxPooledSize)
+      {
+        state.stats.heapAllocations++;
+        return ::operator new (size);
+      }
+
+    size_t sizeClass = SizeClass (size);
+    FreeBlock *block = state.freeLists[sizeClass];
+    if (block == 0)
+      {
+        block = Refill (state, sizeClass);
+      }
+    state.freeLists[sizeClass] = block->next;
+    state.stats.outstanding++;
+    return block;
+  }
+
+  /**
+   * Returns a block from `Allocate()`.  `size` must be the size that was asked for.
+   *
+   * A block inside a slab goes back on its free list, anything else was allocated from
+   * the heap and is returned there.
+   */
+  static void Deallocate (void *p, size_t size)
+  {
+    if (p == 0)
+      {
+        return;
+      }
+
+    State &state = GetState ();
+    if (size > MaxPooledSize || !InSlab (state, p))
+      {
+        ::operator delete (p);
+        return;
+      }
+
+    NS_ASSERT_MSG (state.stats.outstanding > 0, "Deallocate without Allocate");
+    size_t sizeClass = SizeClass (size);
+    FreeBlock *block = static_cast<FreeBlock *> (p);
+    block->next = state.freeLists[sizeClass];
+    state.freeLists[sizeClass] = block;
+    state.stats.outstanding--;
+  }
+
+  /**
+   * Turns the pool on or off for later allocations.  Blocks already allocated are
+   * still freed the way they were allocated.
+   */
+  static void SetEnabled (bool enabled)
+  {
+    GetState ().enabled = enabled;
+  }
+
+  static bool IsEnabled (void)
+  {
+    return GetState ().enabled;
+  }
+
+  static Stats GetStats (void)
+  {
+    return GetState ().stats;
+  }
+
+  /**
+   * The bytes held in slabs (in use or free)
+   */
+  static size_t GetSlabBytes (void)
+  {
+    return GetState ().stats.slabs * SlabBytes;
+  }
+
+private:
+  static const size_t SizeClasses = MaxPooledSize / Granularity;
+
+  struct FreeBlock
+  {
+    FreeBlock *next;
+  };
+
+  struct State
+  {
+    bool enabled;
+    FreeBlock *freeLists[SizeClasses];
+    Stats stats;
+    std::vector<uint8_t *> slabs;   //<! Slab start addresses, sorted
+  };
+
+  /**
+   * The state is never destroyed, so pooled objects with static storage duration
+   * may still be freed during exit.
+   */
+  static State & GetState (void)
+  {
+    static State *state = NewState ();
+    return *state;
+  }
+
+  static State * NewState (void)
+  {
+    State *state = new State ();
+    state->enabled = true;
+    return state;
+  }
+
+  /**
+   * True if `p` points in to one of the slabs
+   */
+  static bool InSlab (const State &state, const void *p)
+  {
+    const uint8_t *byte = static_cast<const uint8_t *> (p);
+    std::vector<uint8_t *>::const_iterator i = std::upper_bound (state.slabs.begin (), state.slabs.end (), byte);
+    if (i == state.slabs.begin ())
+      {
+        return false;
+      }
+    --i;
+    return byte < *i + SlabBytes;
+  }
+
+  static size_t SizeClass (size_t size)
+  {
+    return (size == 0) ? 0 : (size - 1) / Granularity;
+  }
+
+  /**
+   * Carve a new slab in to blocks of `sizeClass` and return the first one, with the
+   * rest on the free list.
+   */
+  static FreeBlock * Refill (State &state, size_t sizeClass)
+  {
+    size_t blockSize = (sizeClass + 1) * Granularity;
+    size_t count = SlabBytes / blockSize;
+    uint8_t *slab = static_cast<uint8_t *> (::operator new (SlabBytes));
+    state.slabs.insert (std::upper_bound (state.slabs.begin (), state.slabs.end (), slab), slab);
+    state.stats.slabs++;
+
+    FreeBlock *head = 0;
+    for (size_t i = count; i > 0; --i)
+      {
+        FreeBlock *block = reinterpret_cast<FreeBlock *> (slab + (i - 1) * blockSize);
+        block->next = head;
+        head = block;
+      }
+    return head;
+  }
+};
+
+/**
+ * @ingroup ccnx-forwarder-base
+ *
+ * Derive from this to allocate a class from CCNxPoolAllocator with `new` and `delete`
+ * (and so with `Create<>()` and the reference counting in `SimpleRefCount`).  The class should
+ * have a virtual destructor if it is deleted through a base pointer, so the sized delete below
+ * sees the size of the most derived class.
+ */
+class CCNxPoolAllocated
+{
+public:
+  static void * operator new (size_t size)
+  {
+    return CCNxPoolAllocator::Allocate (size);
+  }
+
+  static void operator delete (void *p, size_t size)
+  {
+    CCNxPoolAllocator::Deallocate (p, size);
+  }
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_CCNX_POOL_ALLOCATOR_H_ */
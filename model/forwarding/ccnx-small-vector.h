@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_CCNX_SMALL_VECTOR_H_
+#define CCNS3SIM_MODEL_FORWARDING_CCNX_SMALL_VECTOR_H_
+
+#include <new>
+#include <stddef.h>
+#include "ns3/assert.h"
+#include "ns3/ccnx-pool-allocator.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-forwarder-base
+ *
+ * A vector that keeps up to `N` elements inside the object and only goes to
+ * `CCNxPoolAllocator` when it grows beyond that.  The forwarder's per-packet lists of
+ * connections are almost always one or two entries, so they never allocate.
+ *
+ * Only the subset of the std::vector API the forwarder uses is provided.  Iterators are
+ * plain pointers and are invalidated by any insertion or erase.
+ *
+ * N.B.: Because this is a class template, all implementation must be in the header
+ * file so the compiler can generate the template specializations from user code.
+ *
+ * Example:
+ * @code
+ * {
+ *   CCNxSmallVector< Ptr<CCNxConnection>, 4 > connections;
+ *   connections.push_back (connection);
+ *   for (CCNxSmallVector< Ptr<CCNxConnection>, 4 >::iterator i = connections.begin (); i != connections.end (); ++i)
+ *     {
+ *       ...
+ *     }
+ * }
+ * @endcode
+ */
+template <class T, size_t N>
+class CCNxSmallVector
+{
+public:
+  typedef T value_type;
+  typedef T * iterator;
+  typedef const T * const_iterator;
+
+  CCNxSmallVector ()
+    : m_data (InlineData ()), m_size (0), m_capacity (N)
+  {
+  }
+
+  CCNxSmallVector (const CCNxSmallVector &other)
+    : m_data (InlineData ()), m_size (0), m_capacity (N)
+  {
+    Append (other);
+  }
+
+  CCNxSmallVector & operator= (const CCNxSmallVector &other)
+  {
+    if (this != &other)
+      {
+        clear ();
+        Append (other);
+      }
+    return *this;
+  }
+
+  ~CCNxSmallVector ()
+  {
+    clear ();
+    if (!IsInline ())
+      {
+        CCNxPoolAllocator::Deallocate (m_data, m_capacity * sizeof(T));
+      }
+  }
+
+  size_t size () const
+  {
+    return m_size;
+  }
+
+  bool empty () const
+  {
+    return m_size == 0;
+  }
+
+  iterator begin ()
+  {
+    return m_data;
+  }
+
+  iterator end ()
+  {
+    return m_data + m_size;
+  }
+
+  const_iterator begin () const
+  {
+    return m_data;
+  }
+
+  const_iterator end () const
+  {
+    return m_data + m_size;
+  }
+
+  T & operator[] (size_t index)
+  {
+    NS_ASSERT_MSG (index < m_size, "Index out of range");
+    return m_data[index];
+  }
+
+  const T & operator[] (size_t index) const
+  {
+    NS_ASSERT_MSG (index < m_size, "Index out of range");
+    return m_data[index];
+  }
+
+  T & front ()
+  {
+    return (*this)[0];
+  }
+
+  const T & front () const
+  {
+    return (*this)[0];
+  }
+
+  T & back ()
+  {
+    return (*this)[m_size - 1];
+  }
+
+  const T & back () const
+  {
+    return (*this)[m_size - 1];
+  }
+
+  void push_back (const T &value)
+  {
+    if (m_size == m_capacity)
+      {
+        // value may be one of our own elements, so copy it before moving the storage
+        T copy (value);
+        reserve (m_capacity * 2);
+        new (m_data + m_size) T (copy);
+      }
+    else
+      {
+        new (m_data + m_size) T (value);
+      }
+    m_size++;
+  }
+
+  void pop_back ()
+  {
+    NS_ASSERT_MSG (m_size > 0, "pop_back on empty vector");
+    m_size--;
+    m_data[m_size].~T ();
+  }
+
+  /**
+   * Removes the element at `position`, keeping the order of the others.
+   *
+   * @return The iterator to the element after the removed one
+   */
+  iterator erase (iterator position)
+  {
+    NS_ASSERT_MSG (position >= begin () && position < end (), "erase out of range");
+    for (iterator i = position; i + 1 != end (); ++i)
+      {
+        *i = *(i + 1);
+      }
+    pop_back ();
+    return position;
+  }
+
+  /**
+   * Linear search for `value`
+   *
+   * @return The iterator of the first equal element, or `end()`
+   */
+  iterator find (const T &value)
+  {
+    iterator i = begin ();
+    while (i != end () && !(*i == value))
+      {
+        ++i;
+      }
+    return i;
+  }
+
+  const_iterator find (const T &value) const
+  {
+    return const_cast<CCNxSmallVector *> (this)->find (value);
+  }
+
+  void clear ()
+  {
+    while (m_size > 0)
+      {
+        pop_back ();
+      }
+  }
+
+  void reserve (size_t capacity)
+  {
+    if (capacity <= m_capacity)
+      {
+        return;
+      }
+
+    T *data = static_cast<T *> (CCNxPoolAllocator::Allocate (capacity * sizeof(T)));
+    for (size_t i = 0; i < m_size; ++i)
+      {
+        new (data + i) T (m_data[i]);
+        m_data[i].~T ();
+      }
+
+    if (!IsInline ())
+      {
+        CCNxPoolAllocator::Deallocate (m_data, m_capacity * sizeof(T));
+      }
+    m_data = data;
+    m_capacity = capacity;
+  }
+
+  size_t capacity () const
+  {
+    return m_capacity;
+  }
+
+private:
+  T * InlineData ()
+  {
+    return reinterpret_cast<T *> (m_inline);
+  }
+
+  bool IsInline () const
+  {
+    return m_data == reinterpret_cast<const T *> (m_inline);
+  }
+
+  void Append (const CCNxSmallVector &other)
+  {
+    reserve (m_size + other.m_size);
+    for (const_iterator i = other.begin (); i != other.end (); ++i)
+      {
+        push_back (*i);
+      }
+  }
+
+  /**
+   * Raw storage for the first N elements, aligned for T
+   */
+  union
+  {
+    char m_inline[N * sizeof(T)];
+    double m_alignDouble;
+    void *m_alignPointer;
+    long long m_alignLong;
+  };
+
+  T *m_data;
+  size_t m_size;
+  size_t m_capacity;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_CCNX_SMALL_VECTOR_H_ */
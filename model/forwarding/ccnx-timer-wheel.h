@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_CCNX_TIMER_WHEEL_H_
+#define CCNS3SIM_MODEL_FORWARDING_CCNX_TIMER_WHEEL_H_
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+#include "ns3/assert.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/callback.h"
+#include "ns3/simulator.h"
+#include "ns3/event-id.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-forwarder-base
+ *
+ * A hierarchical timing wheel that calls `ExpireCallback(T item)` for each item
+ * at (or shortly after) its deadline.
+ *
+ * Scheduling an item is O(1) and does not create a simulator event.  The wheel
+ * owns a single simulator event that ticks every `granularity` while the wheel is
+ * not empty.  Each tick fires the items in the current slot of the lowest level.
+ * When the lowest level wraps, the next slot of the level above is cascaded down.
+ * Every item is moved at most once per level, so the amortized cost per item is O(1).
+ *
+ * There are `Levels` levels of `SlotsPerLevel` slots each.  Level 0 covers the next
+ * `SlotsPerLevel` ticks, level 1 the next `SlotsPerLevel^2` ticks, and so on.  An item
+ * beyond the top level is parked in the farthest slot and re-scheduled when it is reached.
+ *
+ * Deadlines are rounded up to the next tick, so an item never fires before its
+ * deadline and fires at most one `granularity` after it.  There is no cancel
+ * operation: the user should check in `ExpireCallback` if the item is still
+ * relevant (e.g. the deadline was extended) and re-schedule it if needed.
+ *
+ * N.B.: Because this is a class template, all implementation must be in the header
+ * file so the compiler can generate the template specializations from user code.
+ */
+template <class T>
+class CCNxTimerWheel : public SimpleRefCount< CCNxTimerWheel<T> >
+{
+public:
+  typedef Callback<void, T> ExpireCallback;
+
+  /**
+   * @param granularity [in] The tick length of the wheel (must be positive)
+   * @param expire [in] Called with each item once its deadline has passed
+   */
+  CCNxTimerWheel (Time granularity, ExpireCallback expire)
+    : m_granularity (granularity), m_expire (expire), m_currentTick (0), m_count (0),
+    m_slots (Levels * SlotsPerLevel)
+  {
+    NS_ASSERT_MSG (granularity.GetTimeStep () > 0, "Timer wheel granularity must be positive");
+  }
+
+  virtual ~CCNxTimerWheel ()
+  {
+    Simulator::Cancel (m_tickEvent);
+  }
+
+  /**
+   * Call the ExpireCallback with `item` once `deadline` has passed.
+   *
+   * @param deadline [in] The absolute simulation time of expiry
+   * @param item [in] The item to give back to the ExpireCallback
+   */
+  void Schedule (Time deadline, const T &item)
+  {
+    if (m_count == 0)
+      {
+        // All the slots are empty, so the wheel may be re-aligned to the present time.
+        m_currentTick = Simulator::Now ().GetTimeStep () / m_granularity.GetTimeStep ();
+      }
+
+    int64_t step = m_granularity.GetTimeStep ();
+    int64_t deadlineTick = (deadline.GetTimeStep () + step - 1) / step;
+    if (deadlineTick <= (int64_t) m_currentTick)
+      {
+        deadlineTick = m_currentTick + 1;
+      }
+
+    Place (Record (deadlineTick, item));
+    m_count++;
+
+    if (!m_tickEvent.IsRunning ())
+      {
+        ScheduleTick ();
+      }
+  }
+
+  /**
+   * @return The number of items waiting in the wheel
+   */
+  size_t size () const
+  {
+    return m_count;
+  }
+
+  /**
+   * Discard all items without calling the ExpireCallback and stop ticking.
+   */
+  void clear ()
+  {
+    Simulator::Cancel (m_tickEvent);
+    for (size_t i = 0; i < m_slots.size (); ++i)
+      {
+        m_slots[i].clear ();
+      }
+    m_count = 0;
+  }
+
+  /**
+   * @return The tick length of the wheel
+   */
+  Time GetGranularity () const
+  {
+    return m_granularity;
+  }
+
+private:
+  static const unsigned LevelBits = 6;
+  static const unsigned SlotsPerLevel = 1 << LevelBits;
+  static const unsigned Levels = 4;
+
+  struct Record
+  {
+    Record (uint64_t deadlineTick, const T &item) : m_deadlineTick (deadlineTick), m_item (item)
+    {
+    }
+
+    uint64_t m_deadlineTick;
+    T m_item;
+  };
+
+  typedef std::vector<Record> SlotType;
+
+  /**
+   * Put a record in the lowest level that covers its deadline.  A deadline equal to
+   * the current tick goes in the current level 0 slot, which is about to be fired.
+   */
+  void Place (const Record &record)
+  {
+    uint64_t delta = record.m_deadlineTick - m_currentTick;
+    uint64_t deadlineTick = record.m_deadlineTick;
+
+    unsigned level = 0;
+    while (level < Levels - 1 && delta >= ((uint64_t) 1 << (LevelBits * (level + 1))))
+      {
+        level++;
+      }
+
+    if (delta >= ((uint64_t) 1 << (LevelBits * Levels)))
+      {
+        // Beyond the horizon, park it in the farthest slot.
+        deadlineTick = m_currentTick + ((uint64_t) 1 << (LevelBits * Levels)) - 1;
+      }
+
+    unsigned slot = (deadlineTick >> (LevelBits * level)) & (SlotsPerLevel - 1);
+    m_slots[level * SlotsPerLevel + slot].push_back (record);
+  }
+
+  void ScheduleTick ()
+  {
+    Time next = TimeStep ((m_currentTick + 1) * m_granularity.GetTimeStep ());
+    m_tickEvent = Simulator::Schedule (next - Simulator::Now (), &CCNxTimerWheel::Tick, this);
+  }
+
+  /**
+   * Move every record in the given slot down to a lower level.
+   */
+  void Cascade (unsigned level, unsigned slot)
+  {
+    SlotType records;
+    records.swap (m_slots[level * SlotsPerLevel + slot]);
+    for (size_t i = 0; i < records.size (); ++i)
+      {
+        Place (records[i]);
+      }
+  }
+
+  void Tick ()
+  {
+    m_currentTick++;
+
+    for (unsigned level = 1; level < Levels; ++level)
+      {
+        uint64_t lowerBits = m_currentTick & (((uint64_t) 1 << (LevelBits * level)) - 1);
+        if (lowerBits != 0)
+          {
+            break;
+          }
+        Cascade (level, (m_currentTick >> (LevelBits * level)) & (SlotsPerLevel - 1));
+      }
+
+    SlotType records;
+    records.swap (m_slots[m_currentTick & (SlotsPerLevel - 1)]);
+    for (size_t i = 0; i < records.size (); ++i)
+      {
+        if (records[i].m_deadlineTick > m_currentTick)
+          {
+            // a parked record from beyond the horizon
+            Place (records[i]);
+            continue;
+          }
+
+        m_count--;
+        m_expire (records[i].m_item);
+      }
+
+    if (m_count > 0 && !m_tickEvent.IsRunning ())
+      {
+        ScheduleTick ();
+      }
+  }
+
+  Time m_granularity;
+  ExpireCallback m_expire;
+  uint64_t m_currentTick;
+  size_t m_count;
+  std::vector<SlotType> m_slots;
+  EventId m_tickEvent;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_CCNX_TIMER_WHEEL_H_ */
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <algorithm>
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ccnx-standard-adaptive-strategy.h"
+#include "ccnx-standard-pit.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxStandardAdaptiveStrategy");
+
+/*
+ * A next hop whose smoothed satisfaction falls below this is not used unless nothing else is
+ */
+static const double _liveSatisfaction = 0.5;
+
+static const double _defaultSmoothing = 0.125;
+static const unsigned _defaultProbeInterval = 16;
+
+/*
+ * The initial value of the PIT "DefaultLifetime" attribute, so a Config::SetDefault of
+ * it also applies here.
+ */
+static Time
+GetDefaultTimeout ()
+{
+  TypeId::AttributeInformation info;
+  bool found = CCNxStandardPit::GetTypeId ().LookupAttributeByName ("DefaultLifetime", &info);
+  NS_ASSERT_MSG (found, "CCNxStandardPit has no DefaultLifetime attribute");
+  Ptr<const TimeValue> lifetime = DynamicCast<const TimeValue> (info.initialValue);
+  NS_ASSERT_MSG (lifetime, "CCNxStandardPit DefaultLifetime is not a TimeValue");
+  return lifetime->Get ();
+}
+
+CCNxStandardAdaptiveStrategy::CCNxStandardAdaptiveStrategy ()
+  : m_smoothing (_defaultSmoothing), m_probeInterval (_defaultProbeInterval), m_timeout (GetDefaultTimeout ()),
+  m_probeCount (0)
+{
+}
+
+CCNxStandardAdaptiveStrategy::CCNxStandardAdaptiveStrategy (double smoothing, unsigned probeInterval, Time timeout)
+  : m_smoothing (smoothing), m_probeInterval (probeInterval), m_timeout (timeout), m_probeCount (0)
+{
+  NS_ASSERT_MSG (smoothing > 0.0 && smoothing <= 1.0, "Smoothing must be in (0, 1], got " << smoothing);
+}
+
+CCNxStandardAdaptiveStrategy::~CCNxStandardAdaptiveStrategy ()
+{
+}
+
+CCNxStandardAdaptiveStrategy::FaceStats &
+CCNxStandardAdaptiveStrategy::GetOrCreateFaceStats (PrefixState &state, CCNxConnection::ConnIdType connectionId)
+{
+  for (FaceStatsVecType::iterator it = state.faces.begin (); it != state.faces.end (); ++it)
+    {
+      if (it->connectionId == connectionId)
+        {
+          return *it;
+        }
+    }
+
+  // a new next hop is live until it fails to answer
+  FaceStats stats;
+  stats.connectionId = connectionId;
+  stats.measured = false;
+  stats.srtt = Time (0);
+  stats.satisfaction = 1.0;
+  stats.satisfied = 0;
+  stats.unsatisfied = 0;
+  state.faces.push_back (stats);
+  return state.faces.back ();
+}
+
+void
+CCNxStandardAdaptiveStrategy::SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                                            const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                                            Ptr<CCNxConnectionList> egress)
+{
+  Time now = Simulator::Now ();
+  ExpireOutstanding (now);
+
+  std::vector< Ptr<CCNxConnection> > candidates;
+  candidates.reserve (nextHops.size ());
+  for (CCNxStandardFibEntry::NextHopsVecType::const_iterator it = nextHops.begin (); it != nextHops.end (); ++it)
+    {
+      if (!IsIngress (*it, ingress))
+        {
+          candidates.push_back (it->connection);
+        }
+    }
+  if (candidates.empty ())
+    {
+      return;
+    }
+
+  uint64_t prefixHash = name->GetPrefixHash (prefixLength);
+  PrefixState &state = m_prefixes[prefixHash];
+  state.interestCount++;
+
+  std::vector< Ptr<CCNxConnection> > chosen;
+  if (candidates.size () > 1)
+    {
+      Choose (state, candidates, chosen);
+    }
+  else
+    {
+      chosen.push_back (candidates.front ());
+    }
+
+  uint64_t nameHash = name->GetHash ();
+  Outstanding &outstanding = m_outstanding[nameHash];
+  outstanding.sent = now;
+  outstanding.prefixHash = prefixHash;
+  outstanding.connections.clear ();
+  for (size_t i = 0; i < chosen.size (); ++i)
+    {
+      egress->push_back (chosen[i]);
+      outstanding.connections.push_back (chosen[i]->GetConnectionId ());
+    }
+  m_expiryQueue.push_back (std::make_pair (now, nameHash));
+}
+
+void
+CCNxStandardAdaptiveStrategy::Choose (PrefixState &state, const std::vector< Ptr<CCNxConnection> > &candidates,
+                                      std::vector< Ptr<CCNxConnection> > &chosen)
+{
+  for (size_t i = 0; i < candidates.size (); ++i)
+    {
+      GetOrCreateFaceStats (state, candidates[i]->GetConnectionId ());
+    }
+
+  // only take pointers once every next hop has its stats, as creating one may move the others
+  std::vector<FaceStats *> stats (candidates.size ());
+  for (size_t i = 0; i < candidates.size (); ++i)
+    {
+      stats[i] = &GetOrCreateFaceStats (state, candidates[i]->GetConnectionId ());
+    }
+
+  // the fastest live measured next hop, else the first live one, else the most satisfied
+  int best = -1;
+  for (size_t i = 0; i < candidates.size (); ++i)
+    {
+      if (stats[i]->measured && stats[i]->satisfaction >= _liveSatisfaction
+          && (best < 0 || stats[i]->srtt < stats[best]->srtt))
+        {
+          best = i;
+        }
+    }
+  for (size_t i = 0; best < 0 && i < candidates.size (); ++i)
+    {
+      if (stats[i]->satisfaction >= _liveSatisfaction)
+        {
+          best = i;
+        }
+    }
+  if (best < 0)
+    {
+      best = 0;
+      for (size_t i = 1; i < candidates.size (); ++i)
+        {
+          if (stats[i]->satisfaction > stats[best]->satisfaction)
+            {
+              best = i;
+            }
+        }
+    }
+
+  chosen.push_back (candidates[best]);
+
+  if (m_probeInterval > 0 && state.interestCount % m_probeInterval == 0)
+    {
+      size_t probe = state.probeCursor++ % (candidates.size () - 1);
+      if (probe >= (size_t) best)
+        {
+          probe++;
+        }
+      chosen.push_back (candidates[probe]);
+      m_probeCount++;
+    }
+
+  NS_LOG_DEBUG ("Adaptive egress " << candidates[best]->GetConnectionId () << " of " << candidates.size ()
+                                   << (chosen.size () > 1 ? " with probe" : ""));
+}
+
+void
+CCNxStandardAdaptiveStrategy::ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress)
+{
+  Time now = Simulator::Now ();
+  ExpireOutstanding (now);
+
+  OutstandingMapType::iterator it = m_outstanding.find (name->GetHash ());
+  if (it == m_outstanding.end ())
+    {
+      return;
+    }
+
+  CCNxConnection::ConnIdType connectionId = ingress->GetConnectionId ();
+  const std::vector<CCNxConnection::ConnIdType> &connections = it->second.connections;
+  for (size_t i = 0; i < connections.size (); ++i)
+    {
+      if (connections[i] == connectionId)
+        {
+          FaceStats &stats = GetOrCreateFaceStats (m_prefixes[it->second.prefixHash], connectionId);
+          Time sample = now - it->second.sent;
+          if (stats.measured)
+            {
+              stats.srtt = Seconds ((1.0 - m_smoothing) * stats.srtt.GetSeconds () + m_smoothing * sample.GetSeconds ());
+            }
+          else
+            {
+              stats.srtt = sample;
+              stats.measured = true;
+            }
+          stats.satisfaction = (1.0 - m_smoothing) * stats.satisfaction + m_smoothing;
+          stats.satisfied++;
+
+          NS_LOG_DEBUG ("Adaptive sample connection " << connectionId << " rtt " << sample.As (Time::MS)
+                                                      << " srtt " << stats.srtt.As (Time::MS));
+          break;
+        }
+    }
+
+  // the other next hops of this Interest (a probe) are not penalized, the PIT entry is gone
+  m_outstanding.erase (it);
+}
+
+void
+CCNxStandardAdaptiveStrategy::RemoveConnection (Ptr<CCNxConnection> connection)
+{
+  CCNxConnection::ConnIdType connectionId = connection->GetConnectionId ();
+  for (PrefixMapType::iterator prefix = m_prefixes.begin (); prefix != m_prefixes.end (); ++prefix)
+    {
+      FaceStatsVecType &faces = prefix->second.faces;
+      for (FaceStatsVecType::iterator it = faces.begin (); it != faces.end (); ++it)
+        {
+          if (it->connectionId == connectionId)
+            {
+              faces.erase (it);
+              break;
+            }
+        }
+    }
+
+  for (OutstandingMapType::iterator it = m_outstanding.begin (); it != m_outstanding.end (); ++it)
+    {
+      std::vector<CCNxConnection::ConnIdType> &connections = it->second.connections;
+      connections.erase (std::remove (connections.begin (), connections.end (), connectionId), connections.end ());
+    }
+}
+
+void
+CCNxStandardAdaptiveStrategy::SetInterestLifetime (Time lifetime)
+{
+  NS_LOG_FUNCTION (this << lifetime);
+  m_timeout = lifetime;
+}
+
+void
+CCNxStandardAdaptiveStrategy::ExpireOutstanding (Time now)
+{
+  while (!m_expiryQueue.empty () && now - m_expiryQueue.front ().first >= m_timeout)
+    {
+      OutstandingMapType::iterator it = m_outstanding.find (m_expiryQueue.front ().second);
+      if (it != m_outstanding.end () && it->second.sent == m_expiryQueue.front ().first)
+        {
+          PrefixState &state = m_prefixes[it->second.prefixHash];
+          const std::vector<CCNxConnection::ConnIdType> &connections = it->second.connections;
+          for (size_t i = 0; i < connections.size (); ++i)
+            {
+              FaceStats &stats = GetOrCreateFaceStats (state, connections[i]);
+              stats.satisfaction = (1.0 - m_smoothing) * stats.satisfaction;
+              stats.unsatisfied++;
+            }
+          m_outstanding.erase (it);
+        }
+      m_expiryQueue.pop_front ();
+    }
+}
+
+bool
+CCNxStandardAdaptiveStrategy::GetFaceStats (uint64_t prefixHash, CCNxConnection::ConnIdType connectionId, FaceStats &stats) const
+{
+  PrefixMapType::const_iterator prefix = m_prefixes.find (prefixHash);
+  if (prefix != m_prefixes.end ())
+    {
+      for (FaceStatsVecType::const_iterator it = prefix->second.faces.begin (); it != prefix->second.faces.end (); ++it)
+        {
+          if (it->connectionId == connectionId)
+            {
+              stats = *it;
+              return true;
+            }
+        }
+    }
+  return false;
+}
+
+uint64_t
+CCNxStandardAdaptiveStrategy::GetProbeCount () const
+{
+  return m_probeCount;
+}
+
+size_t
+CCNxStandardAdaptiveStrategy::GetOutstandingCount () const
+{
+  return m_outstanding.size ();
+}
+
+Time
+CCNxStandardAdaptiveStrategy::GetTimeout () const
+{
+  return m_timeout;
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_ADAPTIVE_STRATEGY_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_ADAPTIVE_STRATEGY_H_
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include "ns3/nstime.h"
+#include "ns3/ccnx-standard-forwarding-strategy.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * Adaptive forwarding strategy (`CCNxStandardForwardingStrategy::Adaptive`).  Of the next hops
+ * of the matching FIB entry, `SelectEgress()` picks the one that has been answering fastest
+ * for that FIB prefix.
+ *
+ * For each (FIB prefix, next hop) it keeps an exponentially smoothed RTT and satisfaction ratio.
+ * `SelectEgress()` remembers when each Interest was forwarded and on which connections.  When the
+ * PIT is satisfied by a Content Object, `ContentReceived()` takes an RTT sample for the
+ * connection the Content Object came from and moves its satisfaction towards 1.  An Interest not
+ * answered within the timeout (the PIT lifetime, see `SetInterestLifetime()`) moves the
+ * satisfaction of every connection it went to towards 0.  `RemoveConnection()` drops the
+ * measurements of a connection that went down.
+ *
+ * A next hop is live if it has not been measured or its satisfaction is at least 0.5.  The
+ * Interest goes to the live measured next hop with the lowest smoothed RTT.  If no live next
+ * hop is measured, it goes to the first live one in FIB cost order; if none is live, to the one
+ * with the highest satisfaction.  Every `probeInterval` Interests of a prefix, a copy also goes
+ * to one of the other next hops (round robin), so a slow or recovered next hop is measured again.
+ *
+ * State is keyed by the digest of the matching FIB prefix and of the Interest name.
+ */
+class CCNxStandardAdaptiveStrategy : public CCNxStandardForwardingStrategy
+{
+public:
+  /**
+   * A smoothing of 0.125, a probe every 16 Interests, and the default PIT lifetime
+   * ("ns3::ccnx::CCNxStandardPit::DefaultLifetime") as the timeout.
+   */
+  CCNxStandardAdaptiveStrategy ();
+
+  /**
+   * @param smoothing [in] Weight of a new sample in the smoothed RTT and satisfaction (0, 1]
+   * @param probeInterval [in] Probe another next hop every this many Interests of a prefix (0 never probes)
+   * @param timeout [in] An Interest not answered within this time counts as unsatisfied
+   */
+  CCNxStandardAdaptiveStrategy (double smoothing, unsigned probeInterval, Time timeout);
+
+  virtual ~CCNxStandardAdaptiveStrategy ();
+
+  /**
+   * Appends the chosen next hop (plus a probe, if due) and remembers the Interest.
+   *
+   * @copydetails CCNxStandardForwardingStrategy::SelectEgress
+   */
+  virtual void SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                             const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                             Ptr<CCNxConnectionList> egress);
+
+  /**
+   * A Content Object for `name` satisfied the PIT.
+   *
+   * @param name [in] The Content Object name
+   * @param ingress [in] The connection the Content Object arrived on
+   */
+  virtual void ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress);
+
+  /**
+   * Forgets the measurements of `connection`.  Interests still outstanding on it no longer
+   * count against it when they time out.
+   */
+  virtual void RemoveConnection (Ptr<CCNxConnection> connection);
+
+  /**
+   * Uses `lifetime` as the timeout of Interests
+   */
+  virtual void SetInterestLifetime (Time lifetime);
+
+  /**
+   * The measurements of one next hop for one FIB prefix
+   */
+  struct FaceStats
+  {
+    CCNxConnection::ConnIdType connectionId;
+    bool measured;        //!< true once an RTT sample has been taken
+    Time srtt;            //!< smoothed RTT
+    double satisfaction;  //!< smoothed ratio of satisfied Interests
+    uint64_t satisfied;
+    uint64_t unsatisfied;
+  };
+
+  /**
+   * Copies the measurements of `connectionId` for the prefix `prefixHash` into `stats`.
+   *
+   * @return false if there are none
+   */
+  bool GetFaceStats (uint64_t prefixHash, CCNxConnection::ConnIdType connectionId, FaceStats &stats) const;
+
+  /**
+   * The number of Interests that were also sent to a probe next hop
+   */
+  uint64_t GetProbeCount () const;
+
+  /**
+   * The number of Interests waiting for a Content Object or the timeout
+   */
+  size_t GetOutstandingCount () const;
+
+  /**
+   * The timeout of an Interest
+   */
+  Time GetTimeout () const;
+
+private:
+  typedef std::vector<FaceStats> FaceStatsVecType;
+
+  struct PrefixState
+  {
+    FaceStatsVecType faces;
+    unsigned interestCount;
+    unsigned probeCursor;
+  };
+
+  struct Outstanding
+  {
+    Time sent;
+    uint64_t prefixHash;
+    std::vector<CCNxConnection::ConnIdType> connections;
+  };
+
+  typedef std::unordered_map<uint64_t, PrefixState> PrefixMapType;
+  typedef std::unordered_map<uint64_t, Outstanding> OutstandingMapType;
+
+  /**
+   * (sent time, name digest) in the order Interests were forwarded.  An element is stale if
+   * the Interest was answered or re-forwarded since.
+   */
+  typedef std::deque< std::pair<Time, uint64_t> > ExpiryQueueType;
+
+  FaceStats & GetOrCreateFaceStats (PrefixState &state, CCNxConnection::ConnIdType connectionId);
+
+  /**
+   * Picks the next hop (and probe) from `candidates` for the prefix `state`
+   */
+  void Choose (PrefixState &state, const std::vector< Ptr<CCNxConnection> > &candidates,
+               std::vector< Ptr<CCNxConnection> > &chosen);
+
+  /**
+   * Counts every Interest forwarded before `now - m_timeout` as unsatisfied
+   */
+  void ExpireOutstanding (Time now);
+
+  double m_smoothing;
+  unsigned m_probeInterval;
+  Time m_timeout;
+  uint64_t m_probeCount;
+
+  PrefixMapType m_prefixes;
+  OutstandingMapType m_outstanding;
+  ExpiryQueueType m_expiryQueue;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_ADAPTIVE_STRATEGY_H_ */
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <algorithm>
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ccnx-standard-content-store-arc.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxStandardContentStoreArc");
+
+CCNxStandardContentStoreArc::CCNxStandardContentStoreArc (uint64_t capacity)
+  : m_capacity (capacity), m_target (0), m_b1 (capacity), m_b2 (capacity)
+{
+}
+
+CCNxStandardContentStoreArc::~CCNxStandardContentStoreArc ()
+{
+}
+
+bool
+CCNxStandardContentStoreArc::AddEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  if (m_positions.find (entry) != m_positions.end ())
+    {
+      return RefreshEntry (entry);
+    }
+
+  uint64_t key = entry->GetKey ();
+  Position position;
+
+  if (m_b1.Contains (key))
+    {
+      // Recency ghost hit: T1 was too small
+      uint64_t delta = std::max<uint64_t> (1, m_b2.size () / m_b1.size ());
+      m_target = std::min (m_capacity, m_target + delta);
+      m_b1.Erase (key);
+      position.m_frequent = true;
+    }
+  else if (m_b2.Contains (key))
+    {
+      // Frequency ghost hit: T2 was too small
+      uint64_t delta = std::max<uint64_t> (1, m_b1.size () / m_b2.size ());
+      m_target = m_target > delta ? m_target - delta : 0;
+      m_b2.Erase (key);
+      position.m_frequent = true;
+    }
+  else
+    {
+      position.m_frequent = false;
+    }
+
+  EntryListType &list = position.m_frequent ? m_t2 : m_t1;
+  list.push_front (entry);
+  position.m_entry = list.begin ();
+  m_positions[entry] = position;
+
+  TrimGhosts ();
+  return true;
+}
+
+bool
+CCNxStandardContentStoreArc::RefreshEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  PositionMapType::iterator it = m_positions.find (entry);
+  if (it == m_positions.end ())
+    {
+      NS_LOG_ERROR ("Can't refresh Entry - entry not found in ARC.");
+      return false;
+    }
+
+  m_t2.push_front (entry);
+  Unlink (it->second);
+  it->second.m_frequent = true;
+  it->second.m_entry = m_t2.begin ();
+  return true;
+}
+
+bool
+CCNxStandardContentStoreArc::DeleteEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  PositionMapType::iterator it = m_positions.find (entry);
+  if (it == m_positions.end ())
+    {
+      NS_LOG_ERROR ("Can't delete Entry - entry not found in ARC.");
+      return false;
+    }
+
+  Unlink (it->second);
+  m_positions.erase (it);
+  return true;
+}
+
+bool
+CCNxStandardContentStoreArc::EvictEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  PositionMapType::iterator it = m_positions.find (entry);
+  if (it == m_positions.end ())
+    {
+      NS_LOG_ERROR ("Can't evict Entry - entry not found in ARC.");
+      return false;
+    }
+
+  if (it->second.m_frequent)
+    {
+      m_b2.Insert (entry->GetKey ());
+    }
+  else
+    {
+      m_b1.Insert (entry->GetKey ());
+    }
+
+  Unlink (it->second);
+  m_positions.erase (it);
+  TrimGhosts ();
+  return true;
+}
+
+void
+CCNxStandardContentStoreArc::Unlink (const Position &position)
+{
+  if (position.m_frequent)
+    {
+      m_t2.erase (position.m_entry);
+    }
+  else
+    {
+      m_t1.erase (position.m_entry);
+    }
+}
+
+void
+CCNxStandardContentStoreArc::TrimGhosts ()
+{
+  while (m_t1.size () + m_b1.size () > m_capacity && m_b1.size () > 0)
+    {
+      m_b1.PopOldest ();
+    }
+
+  while (m_positions.size () + m_b1.size () + m_b2.size () > 2 * m_capacity)
+    {
+      if (m_b2.size () > 0)
+        {
+          m_b2.PopOldest ();
+        }
+      else if (m_b1.size () > 0)
+        {
+          m_b1.PopOldest ();
+        }
+      else
+        {
+          break;
+        }
+    }
+}
+
+Ptr<CCNxStandardContentStoreEntry>
+CCNxStandardContentStoreArc::GetVictimEntry ()
+{
+  if (!m_t1.empty () && (m_t1.size () > m_target || m_t2.empty ()))
+    {
+      return m_t1.back ();
+    }
+  if (!m_t2.empty ())
+    {
+      return m_t2.back ();
+    }
+  return Ptr<CCNxStandardContentStoreEntry> (0);
+}
+
+uint64_t
+CCNxStandardContentStoreArc::GetSize () const
+{
+  return m_positions.size ();
+}
+
+void
+CCNxStandardContentStoreArc::SetCapacity (uint64_t capacity)
+{
+  m_capacity = capacity;
+  m_target = std::min (m_target, m_capacity);
+  m_b1.SetCapacity (capacity);
+  m_b2.SetCapacity (capacity);
+  TrimGhosts ();
+}
+
+uint64_t
+CCNxStandardContentStoreArc::GetTarget () const
+{
+  return m_target;
+}
+
+uint64_t
+CCNxStandardContentStoreArc::GetRecentSize () const
+{
+  return m_t1.size ();
+}
+
+uint64_t
+CCNxStandardContentStoreArc::GetFrequentSize () const
+{
+  return m_t2.size ();
+}
+
+uint64_t
+CCNxStandardContentStoreArc::GetGhostSize () const
+{
+  return m_b1.size () + m_b2.size ();
+}
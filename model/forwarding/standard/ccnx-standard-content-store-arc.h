@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_ARC_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_ARC_H_
+
+#include <list>
+#include <unordered_map>
+#include "ns3/ccnx-standard-content-store-policy.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * Adaptive Replacement Cache (Megiddo and Modha, FAST 2003) replacement policy.
+ *
+ * Resident entries are in T1 (seen once recently) or T2 (seen at least twice).  The keys of
+ * entries evicted from T1 and T2 are remembered in the ghost lists B1 and B2.  When a new
+ * object's key is found in B1 the target size `p` of T1 grows, when found in B2 it shrinks,
+ * and the object goes straight to T2.  The victim is the LRU end of T1 if T1 is larger than
+ * `p`, otherwise the LRU end of T2.
+ *
+ * Because the content store asks for a victim before it knows whether the new object is a
+ * ghost hit, the tie case of the original REPLACE (|T1| == p and the new key in B2) takes
+ * the victim from T2.
+ *
+ * All operations are O(1).
+ */
+class CCNxStandardContentStoreArc : public CCNxStandardContentStorePolicy
+{
+public:
+  /**
+   * @param capacity [in] The object capacity of the content store (c in the ARC paper)
+   */
+  CCNxStandardContentStoreArc (uint64_t capacity);
+
+  virtual ~CCNxStandardContentStoreArc ();
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::AddEntry()
+   */
+  virtual bool AddEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::RefreshEntry()
+   */
+  virtual bool RefreshEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::DeleteEntry()
+   */
+  virtual bool DeleteEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::EvictEntry()
+   *
+   * The entry's key moves to B1 or B2.
+   */
+  virtual bool EvictEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::GetVictimEntry()
+   */
+  virtual Ptr<CCNxStandardContentStoreEntry> GetVictimEntry ();
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::GetSize()
+   */
+  virtual uint64_t GetSize () const;
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::SetCapacity()
+   */
+  virtual void SetCapacity (uint64_t capacity);
+
+  /**
+   * The current target size of T1.
+   */
+  uint64_t GetTarget () const;
+
+  /**
+   * The number of resident entries seen once (T1).
+   */
+  uint64_t GetRecentSize () const;
+
+  /**
+   * The number of resident entries seen more than once (T2).
+   */
+  uint64_t GetFrequentSize () const;
+
+  /**
+   * The number of remembered keys (|B1| + |B2|).
+   */
+  uint64_t GetGhostSize () const;
+
+private:
+  typedef std::list<Ptr<CCNxStandardContentStoreEntry> > EntryListType;
+
+  struct Position
+  {
+    bool m_frequent;            // in T2 (else T1)
+    EntryListType::iterator m_entry;
+  };
+
+  typedef std::unordered_map<Ptr<CCNxStandardContentStoreEntry>, Position, CCNxStandardContentStoreEntryPtrHash> PositionMapType;
+
+  /**
+   * Removes the entry from T1 or T2 (but not from m_positions).
+   */
+  void Unlink (const Position &position);
+
+  /**
+   * Forgets ghost keys so |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c.
+   */
+  void TrimGhosts ();
+
+  uint64_t m_capacity;
+  uint64_t m_target;
+
+  EntryListType m_t1;      // MRU at front
+  EntryListType m_t2;      // MRU at front
+  PositionMapType m_positions;
+
+  CCNxStandardContentStoreGhostList m_b1;
+  CCNxStandardContentStoreGhostList m_b2;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_ARC_H_ */
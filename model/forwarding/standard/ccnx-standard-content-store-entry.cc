@@ -58,6 +58,7 @@
 #include "ns3/assert.h"
 #include "ccnx-standard-content-store-entry.h"
 #include "ns3/ccnx-cachetime.h"
+#include "ns3/ccnx-contentobject.h"
 
 using namespace ns3;
 using namespace ns3::ccnx;
@@ -66,7 +67,38 @@ NS_LOG_COMPONENT_DEFINE ("CCNxStandardContentStoreEntry");
 
 CCNxStandardContentStoreEntry::CCNxStandardContentStoreEntry (Ptr<CCNxPacket> contentObject) : m_contentObject (contentObject), m_useCount (0)
 {
-  // empty
+  m_key = MakeKey (contentObject->GetMessage ()->GetName (), contentObject->GetContentObjectHash ()->GetValue ());
+
+  m_footprint = sizeof (CCNxStandardContentStoreEntry) + sizeof (CCNxPacket) + sizeof (CCNxContentObject)
+    + contentObject->GetMessage ()->GetPayloadSize () + contentObject->GetContentObjectHash ()->size ();
+
+  m_deadline = Time::Max ();
+  Ptr<CCNxContentObject> content = DynamicCast<CCNxContentObject, CCNxMessage> (contentObject->GetMessage ());
+  if (content && content->GetExpiryTime ()->getTime () != 0)
+    {
+      m_deadline = Time (content->GetExpiryTime ()->getTime ());
+    }
+
+  Ptr<CCNxPerHopHeader> perHopHeader = contentObject->GetPerhopHeaders ();
+  for (size_t i = 0; i < perHopHeader->size (); i++)
+    {
+      Ptr<CCNxPerHopHeaderEntry> entry = perHopHeader->GetHeader (i);
+      if (entry->GetInstanceTLVType () == CCNxCachetime::GetTLVType ())
+        {
+          Ptr<CCNxCachetime> rct = StaticCast<CCNxCachetime, CCNxPerHopHeaderEntry> (entry);
+          if (rct->GetCachetime ()->getTime () != 0 && Time (rct->GetCachetime ()->getTime ()) < m_deadline)
+            {
+              m_deadline = Time (rct->GetCachetime ()->getTime ());
+            }
+        }
+    }
+
+  Ptr<const CCNxName> name = contentObject->GetMessage ()->GetName ();
+  if (name)
+    {
+      // the name object, its segment buffer and its offset table
+      m_footprint += sizeof (CCNxName) + name->GetEncodedSize () + (name->GetSegmentCount () + 1) * sizeof (uint32_t);
+    }
 }
 
 CCNxStandardContentStoreEntry::~CCNxStandardContentStoreEntry ()
@@ -103,9 +135,9 @@ bool CCNxStandardContentStoreEntry::IsStale () const
   for (size_t i=0;i<perHopHeader->size();i++)
     {
       Ptr<CCNxPerHopHeaderEntry> entry = perHopHeader->GetHeader(i);
-      if (entry->GetInstanceTLVType() == 2) //TODO - why aren't we using an enum for TLV types?
+      if (entry->GetInstanceTLVType() == CCNxCachetime::GetTLVType())
 	{
-	  Ptr<CCNxCachetime> rct = DynamicCast<CCNxCachetime,CCNxPerHopHeaderEntry >(entry);
+	  Ptr<CCNxCachetime> rct = StaticCast<CCNxCachetime,CCNxPerHopHeaderEntry >(entry);
 	  if (rct->GetCachetime()->getTime() != 0) //Ignore null  time
 	    {
 	    Time expiryTime(rct->GetCachetime()->getTime());
@@ -131,3 +163,42 @@ uint64_t CCNxStandardContentStoreEntry::GetUseCount ()
 {
   return m_useCount;
 }
+
+uint64_t
+CCNxStandardContentStoreEntry::GetKey () const
+{
+  return m_key;
+}
+
+Time
+CCNxStandardContentStoreEntry::GetDeadline () const
+{
+  return m_deadline;
+}
+
+uint64_t
+CCNxStandardContentStoreEntry::GetFootprint () const
+{
+  return m_footprint;
+}
+
+uint64_t
+CCNxStandardContentStoreEntry::MakeKey (Ptr<const CCNxName> name, Ptr<const CCNxByteArray> hash)
+{
+  if (name && name->GetSegmentCount ())
+    {
+      return name->GetHash ();
+    }
+
+  // FNV-1a over the hash bytes
+  uint64_t key = 0xCBF29CE484222325ULL;
+  if (hash)
+    {
+      for (size_t i = 0; i < hash->size (); ++i)
+        {
+          key ^= (*hash)[i];
+          key *= 0x00000100000001B3ULL;
+        }
+    }
+  return key;
+}
@@ -58,6 +58,7 @@
 #define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_ENTRY_H_
 
 #include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
 #include "ns3/ccnx-packet.h"
 
 namespace ns3 {
@@ -111,6 +112,14 @@ public:
    */
   bool IsStale () const;
 
+  /**
+   * The earliest of the content object's ExpiryTime and RecommendedCacheTime (ignoring null
+   * times).  After it, `IsExpired()` or `IsStale()` is true.
+   *
+   * @return The deadline, or `Time::Max()` if the object has neither time
+   */
+  Time GetDeadline () const;
+
   /**
    * Increment the usage count of this record.  Used to track how many times a record
    * is used to satisfy an Interest.
@@ -125,12 +134,41 @@ public:
    */
   uint64_t GetUseCount ();
 
+  /**
+   * A 64-bit digest that identifies the stored object.  It is the name digest
+   * (`CCNxName::GetHash()`) if the object has a name, otherwise a digest of its
+   * ContentObjectHash.  Replacement policies use it to remember evicted objects.
+   *
+   * @return The object key (computed once)
+   */
+  uint64_t GetKey () const;
 
+  /**
+   * Compute the key `GetKey()` would return for an object with this name and hash.
+   * It may be used with an Interest's name to look up the same key.
+   *
+   * @param name [in] The object name (may be null or empty)
+   * @param hash [in] The ContentObjectHash (used only if there is no name, may be null)
+   * @return The object key
+   */
+  static uint64_t MakeKey (Ptr<const CCNxName> name, Ptr<const CCNxByteArray> hash);
 
+  /**
+   * The number of bytes a forwarder needs to hold this object in memory: the payload
+   * (`CCNxMessage::GetPayloadSize()`, real or virtual), the name segments, the content
+   * object hash, and the entry, packet, message and name objects.  It does not include
+   * the content store's index or replacement policy nodes.
+   *
+   * @return The object footprint in bytes (computed once)
+   */
+  uint64_t GetFootprint () const;
 
 private:
   Ptr<CCNxPacket> m_contentObject;
   uint64_t m_useCount;
+  uint64_t m_key;
+  uint64_t m_footprint;
+  Time m_deadline;
 
 
 };
@@ -56,6 +56,8 @@
 #include "ns3/ccnx-standard-content-store-factory.h"
 #include "ns3/ccnx-standard-content-store.h"
 #include "ns3/integer.h"
+#include "ns3/enum.h"
+#include "ns3/boolean.h"
 #include "ns3/object.h"
 
 
@@ -101,3 +103,39 @@ CCNxStandardContentStoreFactory::SetLayerDelayServers (unsigned serverCount)
 {
   Set ("LayerDelayServers", IntegerValue (serverCount));
 }
+
+void
+CCNxStandardContentStoreFactory::SetLayerDelayBatchSize (unsigned batchSize)
+{
+  Set ("LayerDelayBatchSize", IntegerValue (batchSize));
+}
+
+void
+CCNxStandardContentStoreFactory::SetReplacementPolicy (CCNxStandardContentStore::ReplacementPolicy policy)
+{
+  Set ("ReplacementPolicy", EnumValue (policy));
+}
+
+void
+CCNxStandardContentStoreFactory::SetTinyLfuAdmission (bool enable)
+{
+  Set ("TinyLfuAdmission", BooleanValue (enable));
+}
+
+void
+CCNxStandardContentStoreFactory::SetByteCapacity (uint64_t bytes)
+{
+  Set ("ByteCapacity", IntegerValue (bytes));
+}
+
+void
+CCNxStandardContentStoreFactory::SetReapInterval (Time interval)
+{
+  Set ("ReapInterval", TimeValue (interval));
+}
+
+void
+CCNxStandardContentStoreFactory::SetReapBatchSize (unsigned batchSize)
+{
+  Set ("ReapBatchSize", IntegerValue (batchSize));
+}
@@ -58,6 +58,7 @@
 
 #include "ns3/object-factory.h"
 #include "ns3/nstime.h"
+#include "ns3/ccnx-standard-content-store.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -114,6 +115,49 @@ public:
    * This value is set via the attribute "LayerDelayServers".  The default is 1.
    */
   void SetLayerDelayServers (unsigned serverCount);
+
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.  Larger
+   * batches use fewer events but deliver the earlier items of a batch when the last one is done.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1 (unbatched).
+   */
+  void SetLayerDelayBatchSize (unsigned batchSize);
+
+  /**
+   * Selects the eviction algorithm of the content store.
+   *
+   * This value is set via the attribute "ReplacementPolicy".  The default is Lru.
+   */
+  void SetReplacementPolicy (CCNxStandardContentStore::ReplacementPolicy policy);
+
+  /**
+   * Enables the TinyLFU admission filter in front of the replacement policy.
+   *
+   * This value is set via the attribute "TinyLfuAdmission".  The default is false.
+   */
+  void SetTinyLfuAdmission (bool enable);
+
+  /**
+   * Bounds the memory footprint of the content store, in bytes.  0 means no limit.
+   *
+   * This value is set via the attribute "ByteCapacity".  The default is 0.
+   */
+  void SetByteCapacity (uint64_t bytes);
+
+  /**
+   * Sets the minimum time between runs of the expired content reaper.
+   *
+   * This value is set via the attribute "ReapInterval".  The default is 10 msec.
+   */
+  void SetReapInterval (Time interval);
+
+  /**
+   * Sets the maximum number of expired objects the reaper removes per run.  0 disables the reaper.
+   *
+   * This value is set via the attribute "ReapBatchSize".  The default is 64.
+   */
+  void SetReapBatchSize (unsigned batchSize);
 };
 
 }   /* namespace ccnx */
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ccnx-standard-content-store-gdsf.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxStandardContentStoreGdsf");
+
+CCNxStandardContentStoreGdsf::CCNxStandardContentStoreGdsf () : m_inflation (0)
+{
+}
+
+CCNxStandardContentStoreGdsf::~CCNxStandardContentStoreGdsf ()
+{
+}
+
+void
+CCNxStandardContentStoreGdsf::Prioritize (Ptr<CCNxStandardContentStoreEntry> entry, Position &position)
+{
+  double priority = m_inflation + (double) position.m_frequency / position.m_size;
+  position.m_priority = m_priorities.insert (std::make_pair (priority, entry));
+}
+
+bool
+CCNxStandardContentStoreGdsf::AddEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  if (m_positions.find (entry) != m_positions.end ())
+    {
+      return RefreshEntry (entry);
+    }
+
+  Position position;
+  position.m_frequency = 1;
+  position.m_size = entry->GetPacket ()->GetMessage ()->GetPayloadSize ();
+  if (position.m_size == 0)
+    {
+      position.m_size = 1;
+    }
+
+  Prioritize (entry, position);
+  m_positions[entry] = position;
+  return true;
+}
+
+bool
+CCNxStandardContentStoreGdsf::RefreshEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  PositionMapType::iterator it = m_positions.find (entry);
+  if (it == m_positions.end ())
+    {
+      NS_LOG_ERROR ("Can't refresh Entry - entry not found in GDSF.");
+      return false;
+    }
+
+  m_priorities.erase (it->second.m_priority);
+  it->second.m_frequency++;
+  Prioritize (entry, it->second);
+  return true;
+}
+
+bool
+CCNxStandardContentStoreGdsf::DeleteEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  PositionMapType::iterator it = m_positions.find (entry);
+  if (it == m_positions.end ())
+    {
+      NS_LOG_ERROR ("Can't delete Entry - entry not found in GDSF.");
+      return false;
+    }
+
+  m_priorities.erase (it->second.m_priority);
+  m_positions.erase (it);
+  return true;
+}
+
+bool
+CCNxStandardContentStoreGdsf::EvictEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  PositionMapType::iterator it = m_positions.find (entry);
+  if (it == m_positions.end ())
+    {
+      NS_LOG_ERROR ("Can't evict Entry - entry not found in GDSF.");
+      return false;
+    }
+
+  m_inflation = it->second.m_priority->first;
+  m_priorities.erase (it->second.m_priority);
+  m_positions.erase (it);
+  return true;
+}
+
+Ptr<CCNxStandardContentStoreEntry>
+CCNxStandardContentStoreGdsf::GetVictimEntry ()
+{
+  if (m_priorities.empty ())
+    {
+      return Ptr<CCNxStandardContentStoreEntry> (0);
+    }
+  return m_priorities.begin ()->second;
+}
+
+uint64_t
+CCNxStandardContentStoreGdsf::GetSize () const
+{
+  return m_positions.size ();
+}
+
+double
+CCNxStandardContentStoreGdsf::GetInflation () const
+{
+  return m_inflation;
+}
+
+double
+CCNxStandardContentStoreGdsf::GetPriority (Ptr<CCNxStandardContentStoreEntry> entry) const
+{
+  PositionMapType::const_iterator it = m_positions.find (entry);
+  return it == m_positions.end () ? 0 : it->second.m_priority->first;
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_GDSF_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_GDSF_H_
+
+#include <map>
+#include <unordered_map>
+#include "ns3/ccnx-standard-content-store-policy.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * Greedy-Dual-Size-Frequency (Cherkasova, HP Labs 1998) replacement policy.  It favours small,
+ * frequently requested objects, which is what matters when the content store is bounded in bytes.
+ *
+ * Each entry has the priority
+ *
+ * \f$H = L + frequency / size\f$
+ *
+ * where size is the payload size (`CCNxMessage::GetPayloadSize()`, at least 1) and L is the
+ * inflation value, the priority of the last evicted entry.  L lets old popular entries age out.
+ * The victim is the entry with the lowest priority, the least recently updated on a tie.
+ *
+ * The entries are kept in a priority-ordered map, so add, refresh and evict are O(log n).
+ */
+class CCNxStandardContentStoreGdsf : public CCNxStandardContentStorePolicy
+{
+public:
+  CCNxStandardContentStoreGdsf ();
+
+  virtual ~CCNxStandardContentStoreGdsf ();
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::AddEntry()
+   */
+  virtual bool AddEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::RefreshEntry()
+   */
+  virtual bool RefreshEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::DeleteEntry()
+   */
+  virtual bool DeleteEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::EvictEntry()
+   *
+   * The inflation value becomes the entry's priority.
+   */
+  virtual bool EvictEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::GetVictimEntry()
+   */
+  virtual Ptr<CCNxStandardContentStoreEntry> GetVictimEntry ();
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::GetSize()
+   */
+  virtual uint64_t GetSize () const;
+
+  /**
+   * The current inflation value L.
+   */
+  double GetInflation () const;
+
+  /**
+   * The priority H of the entry, or 0 if the entry is not in the policy.
+   */
+  double GetPriority (Ptr<CCNxStandardContentStoreEntry> entry) const;
+
+private:
+  typedef std::multimap<double, Ptr<CCNxStandardContentStoreEntry> > PriorityMapType;
+
+  struct Position
+  {
+    uint64_t m_frequency;
+    uint64_t m_size;
+    PriorityMapType::iterator m_priority;
+  };
+
+  typedef std::unordered_map<Ptr<CCNxStandardContentStoreEntry>, Position, CCNxStandardContentStoreEntryPtrHash> PositionMapType;
+
+  /**
+   * (Re)insert the entry in the priority map with its current frequency.
+   */
+  void Prioritize (Ptr<CCNxStandardContentStoreEntry> entry, Position &position);
+
+  double m_inflation;
+  PriorityMapType m_priorities;
+  PositionMapType m_positions;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_GDSF_H_ */
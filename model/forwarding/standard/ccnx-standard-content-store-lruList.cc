@@ -103,6 +103,12 @@ CCNxStandardContentStoreLruList::AddEntry(Ptr<CCNxStandardContentStoreEntry> ent
 
 }
 
+bool
+CCNxStandardContentStoreLruList::RefreshEntry(Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  return AddEntry(entry);
+}
+
 bool
 CCNxStandardContentStoreLruList::DeleteEntry(Ptr<CCNxStandardContentStoreEntry> entry)
 {
@@ -135,17 +141,23 @@ CCNxStandardContentStoreLruList::GetSize() const
 
 }
 
+Ptr<CCNxStandardContentStoreEntry>
+CCNxStandardContentStoreLruList::GetVictimEntry()
+{
+  return GetBackEntry();
+}
+
 Ptr<CCNxStandardContentStoreEntry>
 CCNxStandardContentStoreLruList::GetBackEntry()
 {
-  return m_lruList.back();
+  return m_lruList.empty() ? Ptr<CCNxStandardContentStoreEntry>(0) : m_lruList.back();
 }
 
 
 Ptr<CCNxStandardContentStoreEntry>
 CCNxStandardContentStoreLruList::GetFrontEntry()
 {
-  return m_lruList.front();
+  return m_lruList.empty() ? Ptr<CCNxStandardContentStoreEntry>(0) : m_lruList.front();
 }
 
 
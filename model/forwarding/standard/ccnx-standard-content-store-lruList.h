@@ -56,9 +56,11 @@
 #ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_LRU_LIST_H_
 #define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_LRU_LIST_H_
 
+#include <list>
 #include <unordered_map>
 #include "ns3/simple-ref-count.h"
 #include "ns3/ccnx-standard-content-store-entry.h"
+#include "ns3/ccnx-standard-content-store-policy.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -80,10 +82,12 @@ namespace ccnx {
    *
    * This approach uses an unordered map < Ptr<entry>, listIterator> and a list < entry >. The map delivers quick
    * scalable find(1) while the list provides quick add(2),refresh(4),delete(3).
+   *
+   * This is the default `CCNxStandardContentStorePolicy`.
     *
    */
 
-class CCNxStandardContentStoreLruList : public ns3::SimpleRefCount<CCNxStandardContentStoreLruList>
+class CCNxStandardContentStoreLruList : public CCNxStandardContentStorePolicy
 {
 public:
 
@@ -98,13 +102,24 @@ public:
    * returns - true
    *
    */
-   bool AddEntry(Ptr<CCNxStandardContentStoreEntry> entry);
+   virtual bool AddEntry(Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /*
+   * RefreshEntry - Move an Entry to the front of the LRU (same as AddEntry).
+   * returns - true
+   */
+   virtual bool RefreshEntry(Ptr<CCNxStandardContentStoreEntry> entry);
 
   /*
    * DeleteEntry - Delete an Entry from the LRU.
    * returns - true if found in list, false if not found.
    */
-   bool DeleteEntry(Ptr<CCNxStandardContentStoreEntry> entry);
+   virtual bool DeleteEntry(Ptr<CCNxStandardContentStoreEntry> entry);
+
+   /*
+    * GetVictimEntry - Same as GetBackEntry.
+    */
+   virtual Ptr<CCNxStandardContentStoreEntry> GetVictimEntry();
 
    /*
     * GetBackEntry - Return tail of list (so it can be deleted from Lru and  other structures), or null if no list.
@@ -122,7 +137,7 @@ public:
     * GetSize - Get current size of LRU.
     */
 
-   uint64_t GetSize() const;
+   virtual uint64_t GetSize() const;
 
 
 protected:
@@ -133,7 +148,7 @@ private:
   typedef std::list<Ptr<CCNxStandardContentStoreEntry> > LruListType;
   LruListType m_lruList;
 
-  typedef std::map <Ptr<CCNxStandardContentStoreEntry>,  LruListType::iterator > LruMapType;
+  typedef std::unordered_map <Ptr<CCNxStandardContentStoreEntry>,  LruListType::iterator, CCNxStandardContentStoreEntryPtrHash > LruMapType;
   LruMapType m_lruMap;
 };
 
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_POLICY_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_POLICY_H_
+
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include "ns3/simple-ref-count.h"
+#include "ns3/ccnx-standard-content-store-entry.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * The replacement policy of a `CCNxStandardContentStore`.  The content store owns the lookup
+ * maps; the policy only keeps the eviction order.  The content store calls:
+ *
+ * 1. `AddEntry()` after it stores a new object.
+ * 2. `RefreshEntry()` after an Interest matches a stored object.
+ * 3. `GetVictimEntry()` when it is full and needs room, then `EvictEntry()` on the victim.
+ * 4. `DeleteEntry()` when an object is removed for any other reason (expired, stale, explicit delete).
+ *
+ * Every operation must be O(1) (amortized) in the number of stored objects.
+ *
+ * A policy may remember the keys (`CCNxStandardContentStoreEntry::GetKey()`) of evicted
+ * objects, so an `EvictEntry()` is not the same as a `DeleteEntry()`.
+ */
+class CCNxStandardContentStorePolicy : public ns3::SimpleRefCount<CCNxStandardContentStorePolicy>
+{
+public:
+  virtual ~CCNxStandardContentStorePolicy ()
+  {
+  }
+
+  /**
+   * Add a new entry to the policy.
+   *
+   * @param entry [in] The entry just stored in the content store
+   * @return true if added
+   */
+  virtual bool AddEntry (Ptr<CCNxStandardContentStoreEntry> entry) = 0;
+
+  /**
+   * An Interest matched the entry.
+   *
+   * @param entry [in] An entry previously added
+   * @return true if the entry is in the policy
+   */
+  virtual bool RefreshEntry (Ptr<CCNxStandardContentStoreEntry> entry) = 0;
+
+  /**
+   * Remove an entry without remembering it.
+   *
+   * @param entry [in] An entry previously added
+   * @return true if found and removed, false if not found
+   */
+  virtual bool DeleteEntry (Ptr<CCNxStandardContentStoreEntry> entry) = 0;
+
+  /**
+   * Remove an entry because the content store needs its space.  Policies with history
+   * (e.g. ARC, S3-FIFO) remember its key.  The default is `DeleteEntry()`.
+   *
+   * @param entry [in] Usually the entry returned by `GetVictimEntry()`
+   * @return true if found and removed, false if not found
+   */
+  virtual bool EvictEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+  {
+    return DeleteEntry (entry);
+  }
+
+  /**
+   * Returns the entry the policy would evict next.  The entry is not removed, but the policy
+   * may re-order its internal queues to find it.
+   *
+   * @return The next victim, or null if the policy is empty
+   */
+  virtual Ptr<CCNxStandardContentStoreEntry> GetVictimEntry () = 0;
+
+  /**
+   * The number of entries in the policy (not counting remembered keys).
+   */
+  virtual uint64_t GetSize () const = 0;
+
+  /**
+   * Tells the policy the object capacity of the content store.  Policies that size internal
+   * queues from the capacity override this.  The default does nothing.
+   *
+   * @param capacity [in] The maximum number of objects in the content store
+   */
+  virtual void SetCapacity (uint64_t capacity)
+  {
+  }
+};
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * Hash function for `Ptr<CCNxStandardContentStoreEntry>`, so policies may use an
+ * `std::unordered_map` from entry to list position.  It hashes the pointer, not the object.
+ */
+struct CCNxStandardContentStoreEntryPtrHash
+{
+  size_t operator() (const Ptr<CCNxStandardContentStoreEntry> &entry) const
+  {
+    return std::hash<const CCNxStandardContentStoreEntry *> () (PeekPointer (entry));
+  }
+};
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * A bounded FIFO of evicted object keys (`CCNxStandardContentStoreEntry::GetKey()`).  Used by
+ * policies that keep ghost entries.  Insert, erase and lookup are O(1).  When full, the oldest
+ * key is forgotten.
+ *
+ * N.B.: header only, as it is a small helper for the policy classes.
+ */
+class CCNxStandardContentStoreGhostList
+{
+public:
+  /**
+   * @param capacity [in] The maximum number of remembered keys
+   */
+  CCNxStandardContentStoreGhostList (uint64_t capacity = 0) : m_capacity (capacity)
+  {
+  }
+
+  /**
+   * Remember a key as the newest.  If already present it is moved to the newest position.
+   */
+  void Insert (uint64_t key)
+  {
+    Erase (key);
+    if (m_capacity == 0)
+      {
+        return;
+      }
+    while (m_keys.size () >= m_capacity)
+      {
+        PopOldest ();
+      }
+    m_keys.push_front (key);
+    m_map[key] = m_keys.begin ();
+  }
+
+  /**
+   * Forget a key.
+   *
+   * @return true if the key was present
+   */
+  bool Erase (uint64_t key)
+  {
+    MapType::iterator it = m_map.find (key);
+    if (it == m_map.end ())
+      {
+        return false;
+      }
+    m_keys.erase (it->second);
+    m_map.erase (it);
+    return true;
+  }
+
+  bool Contains (uint64_t key) const
+  {
+    return m_map.find (key) != m_map.end ();
+  }
+
+  /**
+   * Forget the oldest key (no-op if empty).
+   */
+  void PopOldest ()
+  {
+    if (!m_keys.empty ())
+      {
+        m_map.erase (m_keys.back ());
+        m_keys.pop_back ();
+      }
+  }
+
+  uint64_t size () const
+  {
+    return m_keys.size ();
+  }
+
+  /**
+   * Changes the capacity, forgetting the oldest keys if needed.
+   */
+  void SetCapacity (uint64_t capacity)
+  {
+    m_capacity = capacity;
+    while (m_keys.size () > m_capacity)
+      {
+        PopOldest ();
+      }
+  }
+
+private:
+  typedef std::list<uint64_t> KeyListType;
+  typedef std::unordered_map<uint64_t, KeyListType::iterator> MapType;
+
+  uint64_t m_capacity;
+  KeyListType m_keys;
+  MapType m_map;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_POLICY_H_ */
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ccnx-standard-content-store-s3fifo.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxStandardContentStoreS3Fifo");
+
+static const uint8_t _maxFrequency = 3;
+
+/**
+ * S is 10% of the capacity, but at least 1 entry
+ */
+static uint64_t
+SmallTarget (uint64_t capacity)
+{
+  uint64_t target = capacity / 10;
+  return target > 0 ? target : 1;
+}
+
+CCNxStandardContentStoreS3Fifo::CCNxStandardContentStoreS3Fifo (uint64_t capacity)
+  : m_capacity (capacity), m_smallTarget (SmallTarget (capacity)), m_ghost (capacity)
+{
+}
+
+CCNxStandardContentStoreS3Fifo::~CCNxStandardContentStoreS3Fifo ()
+{
+}
+
+bool
+CCNxStandardContentStoreS3Fifo::AddEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  if (m_positions.find (entry) != m_positions.end ())
+    {
+      return RefreshEntry (entry);
+    }
+
+  Position position;
+  position.m_main = m_ghost.Erase (entry->GetKey ());
+  position.m_frequency = 0;
+
+  EntryListType &list = position.m_main ? m_main : m_small;
+  list.push_front (entry);
+  position.m_entry = list.begin ();
+  m_positions[entry] = position;
+  return true;
+}
+
+bool
+CCNxStandardContentStoreS3Fifo::RefreshEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  PositionMapType::iterator it = m_positions.find (entry);
+  if (it == m_positions.end ())
+    {
+      NS_LOG_ERROR ("Can't refresh Entry - entry not found in S3-FIFO.");
+      return false;
+    }
+
+  if (it->second.m_frequency < _maxFrequency)
+    {
+      it->second.m_frequency++;
+    }
+  return true;
+}
+
+bool
+CCNxStandardContentStoreS3Fifo::DeleteEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  PositionMapType::iterator it = m_positions.find (entry);
+  if (it == m_positions.end ())
+    {
+      NS_LOG_ERROR ("Can't delete Entry - entry not found in S3-FIFO.");
+      return false;
+    }
+
+  Unlink (it->second);
+  m_positions.erase (it);
+  return true;
+}
+
+bool
+CCNxStandardContentStoreS3Fifo::EvictEntry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  PositionMapType::iterator it = m_positions.find (entry);
+  if (it == m_positions.end ())
+    {
+      NS_LOG_ERROR ("Can't evict Entry - entry not found in S3-FIFO.");
+      return false;
+    }
+
+  if (!it->second.m_main)
+    {
+      m_ghost.Insert (entry->GetKey ());
+    }
+
+  Unlink (it->second);
+  m_positions.erase (it);
+  return true;
+}
+
+void
+CCNxStandardContentStoreS3Fifo::Unlink (const Position &position)
+{
+  if (position.m_main)
+    {
+      m_main.erase (position.m_entry);
+    }
+  else
+    {
+      m_small.erase (position.m_entry);
+    }
+}
+
+Ptr<CCNxStandardContentStoreEntry>
+CCNxStandardContentStoreS3Fifo::GetVictimEntry ()
+{
+  while (!m_positions.empty ())
+    {
+      if (!m_small.empty () && (m_small.size () >= m_smallTarget || m_main.empty ()))
+        {
+          Ptr<CCNxStandardContentStoreEntry> oldest = m_small.back ();
+          Position &position = m_positions[oldest];
+          if (position.m_frequency == 0)
+            {
+              return oldest;
+            }
+
+          // hit while in S, promote to M
+          m_small.pop_back ();
+          m_main.push_front (oldest);
+          position.m_main = true;
+          position.m_frequency = 0;
+          position.m_entry = m_main.begin ();
+        }
+      else
+        {
+          Ptr<CCNxStandardContentStoreEntry> oldest = m_main.back ();
+          Position &position = m_positions[oldest];
+          if (position.m_frequency == 0)
+            {
+              return oldest;
+            }
+
+          // re-insert
+          position.m_frequency--;
+          m_main.splice (m_main.begin (), m_main, position.m_entry);
+        }
+    }
+
+  return Ptr<CCNxStandardContentStoreEntry> (0);
+}
+
+uint64_t
+CCNxStandardContentStoreS3Fifo::GetSize () const
+{
+  return m_positions.size ();
+}
+
+void
+CCNxStandardContentStoreS3Fifo::SetCapacity (uint64_t capacity)
+{
+  m_capacity = capacity;
+  m_smallTarget = SmallTarget (capacity);
+  m_ghost.SetCapacity (capacity);
+}
+
+uint64_t
+CCNxStandardContentStoreS3Fifo::GetSmallSize () const
+{
+  return m_small.size ();
+}
+
+uint64_t
+CCNxStandardContentStoreS3Fifo::GetMainSize () const
+{
+  return m_main.size ();
+}
+
+uint64_t
+CCNxStandardContentStoreS3Fifo::GetGhostSize () const
+{
+  return m_ghost.size ();
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_S3FIFO_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_S3FIFO_H_
+
+#include <list>
+#include <unordered_map>
+#include "ns3/ccnx-standard-content-store-policy.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * S3-FIFO (Yang et al., SOSP 2023) replacement policy.
+ *
+ * New objects enter a small FIFO S (10% of the capacity).  Objects in the main FIFO M,
+ * and objects whose key is in the ghost FIFO G, stay in the cache longer:
+ *
+ * - A hit only increments a 2-bit frequency counter; it never moves the entry.
+ * - When S is at its target size, its oldest entry moves to M if it was hit while in S,
+ *   otherwise it is the victim and its key goes to G.
+ * - Otherwise the oldest entry of M is re-inserted with its frequency decremented if it
+ *   was hit, or is the victim.
+ * - A new object whose key is in G goes straight to M.
+ *
+ * Each access does at most 3 re-insertions, so all operations are amortized O(1).
+ */
+class CCNxStandardContentStoreS3Fifo : public CCNxStandardContentStorePolicy
+{
+public:
+  /**
+   * @param capacity [in] The object capacity of the content store
+   */
+  CCNxStandardContentStoreS3Fifo (uint64_t capacity);
+
+  virtual ~CCNxStandardContentStoreS3Fifo ();
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::AddEntry()
+   */
+  virtual bool AddEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::RefreshEntry()
+   */
+  virtual bool RefreshEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::DeleteEntry()
+   */
+  virtual bool DeleteEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::EvictEntry()
+   *
+   * If the entry is in S, its key goes to G.
+   */
+  virtual bool EvictEntry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::GetVictimEntry()
+   *
+   * Moves entries from S to M and re-inserts entries in M until it finds the victim.
+   */
+  virtual Ptr<CCNxStandardContentStoreEntry> GetVictimEntry ();
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::GetSize()
+   */
+  virtual uint64_t GetSize () const;
+
+  /**
+   * @copydoc CCNxStandardContentStorePolicy::SetCapacity()
+   */
+  virtual void SetCapacity (uint64_t capacity);
+
+  /**
+   * The number of entries in the small FIFO S.
+   */
+  uint64_t GetSmallSize () const;
+
+  /**
+   * The number of entries in the main FIFO M.
+   */
+  uint64_t GetMainSize () const;
+
+  /**
+   * The number of keys in the ghost FIFO G.
+   */
+  uint64_t GetGhostSize () const;
+
+private:
+  typedef std::list<Ptr<CCNxStandardContentStoreEntry> > EntryListType;
+
+  struct Position
+  {
+    bool m_main;                // in M (else S)
+    uint8_t m_frequency;        // 0 to 3
+    EntryListType::iterator m_entry;
+  };
+
+  typedef std::unordered_map<Ptr<CCNxStandardContentStoreEntry>, Position, CCNxStandardContentStoreEntryPtrHash> PositionMapType;
+
+  /**
+   * Removes the entry from S or M (but not from m_positions).
+   */
+  void Unlink (const Position &position);
+
+  uint64_t m_capacity;
+  uint64_t m_smallTarget;
+
+  EntryListType m_small;      // newest at front
+  EntryListType m_main;       // newest at front
+  PositionMapType m_positions;
+
+  CCNxStandardContentStoreGhostList m_ghost;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_S3FIFO_H_ */
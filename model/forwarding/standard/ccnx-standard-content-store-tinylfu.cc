@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ccnx-standard-content-store-tinylfu.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxStandardContentStoreTinyLfu");
+
+static const uint8_t _maxCount = 15;
+
+/**
+ * Per-row seeds for Index().  Odd 64-bit constants.
+ */
+static const uint64_t _seeds[] = {
+  0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0xFF51AFD7ED558CCDULL
+};
+
+CCNxStandardContentStoreTinyLfu::CCNxStandardContentStoreTinyLfu (uint64_t capacity)
+{
+  SetCapacity (capacity);
+}
+
+CCNxStandardContentStoreTinyLfu::~CCNxStandardContentStoreTinyLfu ()
+{
+}
+
+void
+CCNxStandardContentStoreTinyLfu::SetCapacity (uint64_t capacity)
+{
+  m_width = 16;
+  m_widthBits = 4;
+  while (m_width < capacity)
+    {
+      m_width <<= 1;
+      m_widthBits++;
+    }
+
+  m_samples = 0;
+  m_sampleLimit = 10 * m_width;
+  m_counters.assign (_rows * m_width, 0);
+}
+
+uint64_t
+CCNxStandardContentStoreTinyLfu::GetWidth () const
+{
+  return m_width;
+}
+
+uint64_t
+CCNxStandardContentStoreTinyLfu::Index (uint64_t key, unsigned row) const
+{
+  // multiplicative hashing, the high bits are the best mixed
+  uint64_t h = (key ^ (key >> 32)) * _seeds[row];
+  return row * m_width + (h >> (64 - m_widthBits));
+}
+
+void
+CCNxStandardContentStoreTinyLfu::RecordAccess (uint64_t key)
+{
+  for (unsigned row = 0; row < _rows; ++row)
+    {
+      uint8_t &counter = m_counters[Index (key, row)];
+      if (counter < _maxCount)
+        {
+          counter++;
+        }
+    }
+
+  if (++m_samples >= m_sampleLimit)
+    {
+      Reset ();
+    }
+}
+
+uint8_t
+CCNxStandardContentStoreTinyLfu::Estimate (uint64_t key) const
+{
+  uint8_t estimate = _maxCount;
+  for (unsigned row = 0; row < _rows; ++row)
+    {
+      uint8_t counter = m_counters[Index (key, row)];
+      if (counter < estimate)
+        {
+          estimate = counter;
+        }
+    }
+  return estimate;
+}
+
+bool
+CCNxStandardContentStoreTinyLfu::Admit (uint64_t candidateKey, uint64_t victimKey) const
+{
+  return Estimate (candidateKey) > Estimate (victimKey);
+}
+
+void
+CCNxStandardContentStoreTinyLfu::Reset ()
+{
+  NS_LOG_DEBUG ("Halving TinyLFU sketch after " << m_samples << " samples");
+  for (size_t i = 0; i < m_counters.size (); ++i)
+    {
+      m_counters[i] >>= 1;
+    }
+  m_samples /= 2;
+}
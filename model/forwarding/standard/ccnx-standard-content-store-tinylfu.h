@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_TINYLFU_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_TINYLFU_H_
+
+#include <vector>
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * TinyLFU admission filter (Einziger, Friedman and Manes, ACM ToS 2017).
+ *
+ * It keeps an approximate request frequency of object keys
+ * (`CCNxStandardContentStoreEntry::GetKey()`) in a count-min sketch of 4 rows of saturating
+ * counters (max 15).  After 10 times the sketch width samples, every counter is halved so old
+ * popularity fades.  When the content store is full, a new object is admitted only if its
+ * estimated frequency is higher than the replacement policy's victim.
+ *
+ * The sketch width is the object capacity rounded up to a power of 2.  Record and estimate are
+ * O(1); the periodic halving is O(width) every 10 * width samples, so O(1) amortized.
+ */
+class CCNxStandardContentStoreTinyLfu : public ns3::SimpleRefCount<CCNxStandardContentStoreTinyLfu>
+{
+public:
+  /**
+   * @param capacity [in] The object capacity of the content store
+   */
+  CCNxStandardContentStoreTinyLfu (uint64_t capacity);
+
+  virtual ~CCNxStandardContentStoreTinyLfu ();
+
+  /**
+   * Count one request for the key.
+   */
+  void RecordAccess (uint64_t key);
+
+  /**
+   * The estimated number of (recent) requests for the key, from 0 to 15.
+   */
+  uint8_t Estimate (uint64_t key) const;
+
+  /**
+   * Should the content store replace the victim with the candidate?
+   *
+   * @param candidateKey [in] The key of the object to add
+   * @param victimKey [in] The key of the object the replacement policy would evict
+   * @return true if the candidate is estimated to be more popular than the victim
+   */
+  bool Admit (uint64_t candidateKey, uint64_t victimKey) const;
+
+  /**
+   * Resizes (and clears) the sketch for a new object capacity.
+   */
+  void SetCapacity (uint64_t capacity);
+
+  /**
+   * The number of counters in each row of the sketch.
+   */
+  uint64_t GetWidth () const;
+
+private:
+  static const unsigned _rows = 4;
+
+  /**
+   * The counter index of the key in the given row.
+   */
+  uint64_t Index (uint64_t key, unsigned row) const;
+
+  /**
+   * Halves all counters.
+   */
+  void Reset ();
+
+  uint64_t m_width;
+  unsigned m_widthBits;
+  uint64_t m_samples;
+  uint64_t m_sampleLimit;
+  std::vector<uint8_t> m_counters;      // _rows * m_width
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_TINYLFU_H_ */
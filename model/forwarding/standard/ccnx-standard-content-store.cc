@@ -55,10 +55,18 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/simulator.h"
 #include "ns3/integer.h"
+#include "ns3/enum.h"
+#include "ns3/boolean.h"
 #include "ns3/ccnx-delay-queue.h"
 #include "ns3/object.h"
 #include "ccnx-standard-content-store.h"
+#include "ns3/ccnx-standard-content-store-lruList.h"
+#include "ns3/ccnx-standard-content-store-lfu.h"
+#include "ns3/ccnx-standard-content-store-arc.h"
+#include "ns3/ccnx-standard-content-store-s3fifo.h"
+#include "ns3/ccnx-standard-content-store-gdsf.h"
 
 using namespace ns3;
 using namespace ns3::ccnx;
@@ -71,10 +79,26 @@ NS_OBJECT_ENSURE_REGISTERED (CCNxStandardContentStore);
 
 
 static const long long _defaultObjectCapacity = 10000;  //size_t and uint64_t dont work with AddAttribute
+static const long long _defaultByteCapacity = 0;        //0 means the byte footprint is not bounded
+
+/**
+ * Approximate bytes of one index node: a red-black tree node (3 pointers and a colour)
+ * holding a packet pointer and an entry pointer.
+ */
+static const uint64_t _mapNodeBytes = 4 * sizeof (void *) + 2 * sizeof (Ptr<CCNxStandardContentStoreEntry>);
+
+/**
+ * Approximate bytes of an entry in the replacement policy: a list node (2 pointers plus
+ * the entry pointer) and a hash map node (next pointer, key, position).
+ */
+static const uint64_t _policyNodeBytes = 8 * sizeof (void *);
 
 static const Time _defaultLayerDelayConstant = MicroSeconds (1);
 static const Time _defaultLayerDelaySlope = NanoSeconds (10);
 static unsigned _defaultLayerDelayServers = 1;
+static unsigned _defaultLayerDelayBatchSize = 1;
+static const Time _defaultReapInterval = MilliSeconds (10);
+static unsigned _defaultReapBatchSize = 64;
 Ptr<CCNxHashValue> CCNxStandardContentStore::nullHashValue = Create<CCNxHashValue> (0);
 
 /**
@@ -106,8 +130,33 @@ CCNxStandardContentStore::GetTypeId ()
     .AddAttribute ("ObjectCapacity",
                   "The maximum number of content objects to store (default = 10000)",
 		   IntegerValue (_defaultObjectCapacity),
-		   MakeIntegerAccessor (&CCNxStandardContentStore::m_objectCapacity),
+		   MakeIntegerAccessor (&CCNxStandardContentStore::SetObjectCapacity, &CCNxStandardContentStore::GetObjectCapacity),
 		   MakeIntegerChecker<long long> ())
+    .AddAttribute ("ReplacementPolicy", "The eviction algorithm used when the store is full (must be set while empty)",
+		   EnumValue (CCNxStandardContentStore::Lru),
+		   MakeEnumAccessor (&CCNxStandardContentStore::SetReplacementPolicy, &CCNxStandardContentStore::GetReplacementPolicy),
+		   MakeEnumChecker (CCNxStandardContentStore::Lru, "Lru",
+		                    CCNxStandardContentStore::Lfu, "Lfu",
+		                    CCNxStandardContentStore::Arc, "Arc",
+		                    CCNxStandardContentStore::S3Fifo, "S3Fifo",
+		                    CCNxStandardContentStore::Gdsf, "Gdsf"))
+    .AddAttribute ("ByteCapacity",
+                  "The maximum memory footprint in bytes of the stored objects, 0 for no limit (default = 0)",
+		   IntegerValue (_defaultByteCapacity),
+		   MakeIntegerAccessor (&CCNxStandardContentStore::m_byteCapacity),
+		   MakeIntegerChecker<long long> (0))
+    .AddAttribute ("ReapInterval", "The minimum time between runs of the expired content reaper",
+		  TimeValue (_defaultReapInterval),
+		  MakeTimeAccessor (&CCNxStandardContentStore::m_reapInterval),
+		  MakeTimeChecker ())
+    .AddAttribute ("ReapBatchSize", "The maximum number of expired objects removed per reaper run, 0 disables the reaper",
+		  IntegerValue (_defaultReapBatchSize),
+		  MakeIntegerAccessor (&CCNxStandardContentStore::m_reapBatchSize),
+		  MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("TinyLfuAdmission", "Only replace the policy's victim with a more frequently requested object",
+		   BooleanValue (false),
+		   MakeBooleanAccessor (&CCNxStandardContentStore::SetTinyLfuAdmission, &CCNxStandardContentStore::GetTinyLfuAdmission),
+		   MakeBooleanChecker ())
     .AddAttribute ("LayerDelayConstant", "The amount of constant layer delay",
 		  TimeValue (_defaultLayerDelayConstant),
 		  MakeTimeAccessor (&CCNxStandardContentStore::m_layerDelayConstant),
@@ -119,18 +168,27 @@ CCNxStandardContentStore::GetTypeId ()
     .AddAttribute ("LayerDelayServers", "The number of servers for the layer delay input queue",
 		  IntegerValue (_defaultLayerDelayServers),
 		  MakeIntegerAccessor (&CCNxStandardContentStore::m_layerDelayServers),
+		  MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("LayerDelayBatchSize", "The most items a layer delay server takes per scheduler event (1 is unbatched)",
+		  IntegerValue (_defaultLayerDelayBatchSize),
+		  MakeIntegerAccessor (&CCNxStandardContentStore::m_layerDelayBatchSize),
 		  MakeIntegerChecker<unsigned> ());
     return tid;
 }
 
 
 CCNxStandardContentStore::CCNxStandardContentStore () : m_objectCapacity (_defaultObjectCapacity),
+      m_byteCapacity (_defaultByteCapacity), m_byteCount (0),
+      m_replacementPolicy (Lru), m_admissionRejectCount (0),
+      m_reapInterval (_defaultReapInterval), m_reapBatchSize (_defaultReapBatchSize),
+      m_expiryCount (0), m_evictionCount (0),
       m_matchInterestCallback (MakeCallback (&NullMatchInterestCallback)),
       m_addContentObjectCallback (MakeCallback (&NullAddContentObjectCallback)),
       m_layerDelayConstant (_defaultLayerDelayConstant), m_layerDelaySlope (_defaultLayerDelaySlope),
-      m_layerDelayServers (_defaultLayerDelayServers)
+      m_layerDelayServers (_defaultLayerDelayServers),
+      m_layerDelayBatchSize (_defaultLayerDelayBatchSize)
 {
-    m_lruList = Create<CCNxStandardContentStoreLruList> ();
+    m_policy = Create<CCNxStandardContentStoreLruList> ();
 }
 
 CCNxStandardContentStore::~CCNxStandardContentStore ()
@@ -147,6 +205,16 @@ CCNxStandardContentStore::DoInitialize ()
   m_inputQueue = Create<DelayQueueType> (m_layerDelayServers,
                                          MakeCallback (&CCNxStandardContentStore::GetServiceTime, this),
                                          MakeCallback (&CCNxStandardContentStore::DequeueCallback, this));
+  m_inputQueue->SetBatchSize (m_layerDelayBatchSize);
+}
+
+void
+CCNxStandardContentStore::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  Simulator::Cancel (m_reapEvent);
+  m_expiryIndex.clear ();
+  m_expiryPositions.clear ();
 }
 
 void
@@ -265,6 +333,8 @@ CCNxStandardContentStore::ServiceMatchInterest (Ptr<CCNxStandardForwarderWorkIte
 
   Ptr<CCNxStandardContentStoreEntry> entry = Ptr<CCNxStandardContentStoreEntry> (0) ;
 
+  RecordAdmissionAccess (interest);
+
   //look for matching content in one map only
   if (interest->GetName () and interest->GetName ()->GetSegmentCount ())
     {
@@ -316,7 +386,7 @@ CCNxStandardContentStore::ServiceMatchInterest (Ptr<CCNxStandardForwarderWorkIte
 	//increment it's use count
 	 entry->IncrementUseCount();
 
-	 m_lruList->AddEntry(entry); //This is a Refresh which has same logic as Add
+	 m_policy->RefreshEntry(entry);
 
 	 workItem->SetContentStorePacket(entry->GetPacket());
 	 NS_LOG_INFO ("found content for this interest in CS");
@@ -324,7 +394,8 @@ CCNxStandardContentStore::ServiceMatchInterest (Ptr<CCNxStandardForwarderWorkIte
      else
        { //entry not valid, remove it and dont add a content store packet
 	NS_LOG_INFO ("removing expired or stale content in CS matching this interest - no content returned");
-	DeleteContentObject(entry->GetPacket());
+	RemoveEntry(entry, false);
+	m_expiryCount++;
        }
     }
  else
@@ -353,19 +424,58 @@ CCNxStandardContentStore::ServiceAddContentObject (Ptr<CCNxStandardForwarderWork
     }
   else
     {
-      if (GetObjectCount()>=GetObjectCapacity())
-	{
-	  Ptr<CCNxStandardContentStoreEntry> oldestEntry = m_lruList->GetBackEntry();
-	  DeleteContentObject(oldestEntry->GetPacket());
-	}
       //create new entry
       Ptr<CCNxStandardContentStoreEntry> newEntry = Create<CCNxStandardContentStoreEntry> (cPacket);
 
-      result = m_lruList->AddEntry(newEntry);
+      uint64_t footprint = GetEntryFootprint(newEntry);
+
+      result = true;
+      if (m_byteCapacity > 0 and footprint > (uint64_t) m_byteCapacity)
+	{
+	  NS_LOG_INFO ("content object footprint " << footprint << " is larger than the byte capacity");
+	  result = false;
+	}
+
+      //the admission filter decides once, against the first victim, before anything is evicted
+      if (result and !HasRoomFor(footprint))
+	{
+	  Ptr<CCNxStandardContentStoreEntry> victim = m_policy->GetVictimEntry();
+	  if (!victim)
+	    {
+	      result = false;
+	    }
+	  else if (m_admission and !m_admission->Admit(newEntry->GetKey(), victim->GetKey()))
+	    {
+	      NS_LOG_INFO ("TinyLFU admission filter rejected content object");
+	      m_admissionRejectCount++;
+	      result = false;
+	    }
+	}
+
+      //evict until both the object count and the byte footprint fit
+      while (result and !HasRoomFor(footprint))
+	{
+	  Ptr<CCNxStandardContentStoreEntry> victim = m_policy->GetVictimEntry();
+	  if (!victim)
+	    {
+	      NS_LOG_INFO ("no victim to evict, content store is over capacity");
+	      result = false;
+	      break;
+	    }
+	  RemoveEntry(victim, true);
+	  m_evictionCount++;
+	}
+
+      if (result)
+	{
+	  result = m_policy->AddEntry(newEntry);
+	}
 
       if (result)
 	{
 	  result = AddMapEntry(cPacket,newEntry);
+	  m_byteCount += footprint;
+	  IndexExpiry(newEntry);
 	}
 
   }
@@ -383,6 +493,13 @@ CCNxStandardContentStore::ServiceAddContentObject (Ptr<CCNxStandardForwarderWork
   return result;
 }
 
+bool
+CCNxStandardContentStore::HasRoomFor(uint64_t footprint) const
+{
+  return GetObjectCount() < GetObjectCapacity() and
+         (m_byteCapacity <= 0 or m_byteCount + footprint <= (uint64_t) m_byteCapacity);
+}
+
 bool
 CCNxStandardContentStore::IsEntryValid(Ptr<CCNxStandardContentStoreEntry> entry) const
 {
@@ -446,17 +563,34 @@ CCNxStandardContentStore::FindEntryInNameMap(Ptr<CCNxPacket> cPacket)
 bool
 CCNxStandardContentStore::DeleteContentObject(Ptr<CCNxPacket> cPacket)
 {
-  //remove packet from all maps and Lru
   NS_LOG_FUNCTION (this);
 
   Ptr<CCNxStandardContentStoreEntry> entry =   GetEntryFromPacket(cPacket);
-  bool result = entry!=Ptr<CCNxStandardContentStoreEntry>(0) ? true:false;
-
-  if (result)
+  if (!entry)
     {
-      if (!m_lruList->DeleteEntry(entry))
+      NS_LOG_ERROR("could not find cPacket in Content Store.");
+      return false;
+    }
+  return RemoveEntry(entry, false);
+}
+
+bool
+CCNxStandardContentStore::RemoveEntry(Ptr<CCNxStandardContentStoreEntry> entry, bool evict)
+{
+  //remove packet from all maps, the replacement policy and the expiry index
+  NS_LOG_FUNCTION (this);
+
+  Ptr<CCNxPacket> cPacket = entry->GetPacket();
+  bool result = true;
+
+      if (evict ? m_policy->EvictEntry(entry) : m_policy->DeleteEntry(entry))
+	{
+	  m_byteCount -= GetEntryFootprint(entry);
+	  UnindexExpiry(entry);
+	}
+      else
 	{
-	      NS_LOG_ERROR("could not delete Entry from m_lruList.");
+	      NS_LOG_ERROR("could not delete Entry from m_policy.");
 	}
 
 
@@ -501,11 +635,6 @@ CCNxStandardContentStore::DeleteContentObject(Ptr<CCNxPacket> cPacket)
 		}
 	  }
       }   //name  maps
-    } // found packet
-  else
-	{
-	      NS_LOG_ERROR("could not find cPacket in Content Store.");
-	}
 
   return result;
 }
@@ -561,8 +690,8 @@ size_t
 CCNxStandardContentStore::GetObjectCount () const
 {
   NS_LOG_FUNCTION (this);
-// since we have other methods to check the map sizes, we will do this count using the LRU list
-  return m_lruList->GetSize ();
+// since we have other methods to check the map sizes, we will do this count using the replacement policy
+  return m_policy->GetSize ();
 }
 
 size_t
@@ -572,6 +701,201 @@ CCNxStandardContentStore::GetObjectCapacity () const
   return m_objectCapacity;
 }
 
+void
+CCNxStandardContentStore::SetObjectCapacity (long long capacity)
+{
+  NS_LOG_FUNCTION (this << capacity);
+  m_objectCapacity = capacity;
+  if (m_policy)
+    {
+      m_policy->SetCapacity (capacity);
+    }
+  if (m_admission)
+    {
+      m_admission->SetCapacity (capacity);
+    }
+}
+
+void
+CCNxStandardContentStore::SetReplacementPolicy (ReplacementPolicy policy)
+{
+  NS_LOG_FUNCTION (this << policy);
+  NS_ASSERT_MSG (!m_policy || m_policy->GetSize () == 0, "The replacement policy must be set while the content store is empty");
+
+  m_replacementPolicy = policy;
+  switch (policy)
+    {
+    case Lru:
+      m_policy = Create<CCNxStandardContentStoreLruList> ();
+      break;
+
+    case Lfu:
+      m_policy = Create<CCNxStandardContentStoreLfu> ();
+      break;
+
+    case Arc:
+      m_policy = Create<CCNxStandardContentStoreArc> (m_objectCapacity);
+      break;
+
+    case S3Fifo:
+      m_policy = Create<CCNxStandardContentStoreS3Fifo> (m_objectCapacity);
+      break;
+
+    case Gdsf:
+      m_policy = Create<CCNxStandardContentStoreGdsf> ();
+      break;
+
+    default:
+      NS_ASSERT_MSG (false, "Unsupported replacement policy " << policy);
+      break;
+    }
+}
+
+CCNxStandardContentStore::ReplacementPolicy
+CCNxStandardContentStore::GetReplacementPolicy () const
+{
+  return m_replacementPolicy;
+}
+
+void
+CCNxStandardContentStore::SetTinyLfuAdmission (bool enable)
+{
+  NS_LOG_FUNCTION (this << enable);
+  m_admission = enable ? Create<CCNxStandardContentStoreTinyLfu> (m_objectCapacity) : Ptr<CCNxStandardContentStoreTinyLfu> (0);
+}
+
+bool
+CCNxStandardContentStore::GetTinyLfuAdmission () const
+{
+  return m_admission != Ptr<CCNxStandardContentStoreTinyLfu> (0);
+}
+
+uint64_t
+CCNxStandardContentStore::GetByteCount () const
+{
+  return m_byteCount;
+}
+
+uint64_t
+CCNxStandardContentStore::GetByteCapacity () const
+{
+  return m_byteCapacity;
+}
+
+uint64_t
+CCNxStandardContentStore::GetEntryFootprint (Ptr<CCNxStandardContentStoreEntry> entry) const
+{
+  Ptr<CCNxPacket> cPacket = entry->GetPacket();
+  unsigned maps = 0;
+  if (*cPacket->GetContentObjectHash()->GetValue() != *nullHashValue->GetValue())
+    {
+      maps += 2;	//hash and hash/keyid (KEYIDHACK)
+    }
+  if (cPacket->GetMessage()->GetName()->GetSegmentCount())
+    {
+      maps += 2;	//name and name/keyid (KEYIDHACK)
+    }
+  return entry->GetFootprint() + maps * _mapNodeBytes + _policyNodeBytes;
+}
+
+void
+CCNxStandardContentStore::IndexExpiry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  if (entry->GetDeadline () == Time::Max ())
+    {
+      return;
+    }
+
+  m_expiryPositions[entry] = m_expiryIndex.insert (std::make_pair (entry->GetDeadline (), entry));
+  ScheduleReaper ();
+}
+
+void
+CCNxStandardContentStore::UnindexExpiry (Ptr<CCNxStandardContentStoreEntry> entry)
+{
+  ExpiryPositionType::iterator it = m_expiryPositions.find (entry);
+  if (it != m_expiryPositions.end ())
+    {
+      m_expiryIndex.erase (it->second);
+      m_expiryPositions.erase (it);
+    }
+}
+
+void
+CCNxStandardContentStore::ScheduleReaper ()
+{
+  if (m_reapBatchSize == 0 || m_expiryIndex.empty ())
+    {
+      return;
+    }
+
+  // an entry is dead once its deadline is in the past
+  Time when = m_expiryIndex.begin ()->first + TimeStep (1);
+  if (when < Simulator::Now () + m_reapInterval)
+    {
+      when = Simulator::Now () + m_reapInterval;
+    }
+
+  if (m_reapEvent.IsRunning ())
+    {
+      if (m_reapTime <= when)
+        {
+          return;
+        }
+      Simulator::Cancel (m_reapEvent);
+    }
+
+  m_reapTime = when;
+  m_reapEvent = Simulator::Schedule (when - Simulator::Now (), &CCNxStandardContentStore::Reap, this);
+}
+
+void
+CCNxStandardContentStore::Reap ()
+{
+  NS_LOG_FUNCTION (this);
+
+  unsigned reaped = 0;
+  while (reaped < m_reapBatchSize && !m_expiryIndex.empty () && m_expiryIndex.begin ()->first < Simulator::Now ())
+    {
+      Ptr<CCNxStandardContentStoreEntry> entry = m_expiryIndex.begin ()->second;
+      NS_LOG_INFO ("reaping expired or stale content " << *entry->GetPacket ());
+      RemoveEntry (entry, false);
+      UnindexExpiry (entry);
+      m_expiryCount++;
+      reaped++;
+    }
+
+  ScheduleReaper ();
+}
+
+uint64_t
+CCNxStandardContentStore::GetExpiryCount () const
+{
+  return m_expiryCount;
+}
+
+uint64_t
+CCNxStandardContentStore::GetEvictionCount () const
+{
+  return m_evictionCount;
+}
+
+uint64_t
+CCNxStandardContentStore::GetAdmissionRejectCount () const
+{
+  return m_admissionRejectCount;
+}
+
+void
+CCNxStandardContentStore::RecordAdmissionAccess (Ptr<CCNxInterest> interest)
+{
+  if (m_admission)
+    {
+      Ptr<const CCNxByteArray> hash = interest->HasHashRestriction () ? interest->GetHashRestriction ()->GetValue () : Ptr<const CCNxByteArray> (0);
+      m_admission->RecordAccess (CCNxStandardContentStoreEntry::MakeKey (interest->GetName (), hash));
+    }
+}
+
 
 Ptr<const CCNxByteArray>
 CCNxStandardContentStore::GetKeyidOrRestriction(Ptr<const CCNxPacket> z)
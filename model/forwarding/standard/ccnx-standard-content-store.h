@@ -57,9 +57,12 @@
 #define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_CONTENT_STORE_H_
 
 #include <map>
+#include <unordered_map>
+#include "ns3/event-id.h"
 #include "ns3/ccnx-content-store.h"
 #include "ns3/ccnx-standard-content-store-entry.h"
-#include "ns3/ccnx-standard-content-store-lruList.h"
+#include "ns3/ccnx-standard-content-store-policy.h"
+#include "ns3/ccnx-standard-content-store-tinylfu.h"
 #include "ns3/ccnx-standard-forwarder-work-item.h"
 #include "ns3/ccnx-delay-queue.h"
 #include "ns3/ccnx-name.h"
@@ -76,11 +79,38 @@ namespace ccnx {
  * The Standard ContentStore Class. The standard content store implements a map based content cache
  * with least recently used eviction algorithm.
  *
+ * The eviction algorithm is set by the attribute "ReplacementPolicy" (Lru, Lfu, Arc, S3Fifo or Gdsf).
+ * The attribute "TinyLfuAdmission" puts a TinyLFU admission filter in front of the policy: once the
+ * store is full, a new object only replaces the policy's victim if it has been requested more often.
+ * The filter decides once per object, against the first victim, so an object that needs several
+ * victims under "ByteCapacity" either evicts all of them or none.
+ *
+ * The store is full when it holds "ObjectCapacity" objects or, if "ByteCapacity" is not 0, when
+ * the memory footprint of its objects (payload, name, packet and index overhead) would exceed
+ * "ByteCapacity".  Gdsf is the size-aware policy to use with a byte capacity.
+ *
+ * Objects with an ExpiryTime or RecommendedCacheTime are kept in an expiry-ordered index.  A reaper
+ * wakes up at most every "ReapInterval" while the index is not empty and removes up to "ReapBatchSize"
+ * dead objects, so they do not hold space until an Interest finds them or they reach the victim end
+ * of the replacement policy.
+ *
  */
 
 class CCNxStandardContentStore : public CCNxContentStore
 {
 public:
+  /**
+   * The replacement policies, set via the attribute "ReplacementPolicy".
+   */
+  enum ReplacementPolicy
+  {
+    Lru,                /**< Least recently used (`CCNxStandardContentStoreLruList`) */
+    Lfu,                /**< Least frequently used (`CCNxStandardContentStoreLfu`) */
+    Arc,                /**< Adaptive replacement cache (`CCNxStandardContentStoreArc`) */
+    S3Fifo,             /**< S3-FIFO (`CCNxStandardContentStoreS3Fifo`) */
+    Gdsf                /**< Greedy-Dual-Size-Frequency (`CCNxStandardContentStoreGdsf`) */
+  };
+
   /**
    * Returns the NS3 runtime type of the class ("ns3::ccnx::CCNxStandardContentStore")
    * @return The NS3 runtime type
@@ -165,6 +195,73 @@ public:
    */
   virtual size_t GetObjectCapacity () const;
 
+  /**
+   * Sets the maximum capacity (in content objects) of the content store.  This is
+   * the setter of the attribute "ObjectCapacity".
+   *
+   * @param capacity The object capacity of the content store
+   */
+  void SetObjectCapacity (long long capacity);
+
+  /**
+   * Selects the replacement policy.  This is the setter of the attribute "ReplacementPolicy".
+   * It must be called while the content store is empty.
+   *
+   * @param policy The replacement policy
+   */
+  void SetReplacementPolicy (ReplacementPolicy policy);
+
+  /**
+   * @return The replacement policy
+   */
+  ReplacementPolicy GetReplacementPolicy () const;
+
+  /**
+   * Enables or disables the TinyLFU admission filter.  This is the setter of the
+   * attribute "TinyLfuAdmission".
+   *
+   * @param enable true to filter admissions
+   */
+  void SetTinyLfuAdmission (bool enable);
+
+  /**
+   * @return true if the TinyLFU admission filter is enabled
+   */
+  bool GetTinyLfuAdmission () const;
+
+  /**
+   * Returns the memory footprint in bytes of the stored objects, including the
+   * index and replacement policy overhead.
+   *
+   * @return The bytes used by the content store
+   */
+  uint64_t GetByteCount () const;
+
+  /**
+   * Returns the maximum memory footprint in bytes of the content store, 0 if not bounded.
+   *
+   * The size of the store is usually configured via a SetAttribute ("ByteCapacity").
+   *
+   * @return The byte capacity of the content store
+   */
+  uint64_t GetByteCapacity () const;
+
+  /**
+   * The number of content objects removed because they were expired or stale, by the reaper or
+   * when an Interest matched them.
+   */
+  uint64_t GetExpiryCount () const;
+
+  /**
+   * The number of content objects evicted to make room for a new object.
+   */
+  uint64_t GetEvictionCount () const;
+
+  /**
+   * The number of content objects not stored because the TinyLFU admission filter rejected them.
+   */
+  uint64_t GetAdmissionRejectCount () const;
+
   /**
    * FindEntryInNameMap
    * @param cPacket - content packet
@@ -382,13 +479,17 @@ protected:
         CSByHashKeyidType m_csByHashKeyid;
 
         /**
-          * The Least Recently Used (lru) list is a class which has the least recently used packet at the end of the list,
-          * and the most recently used at the beginning. The list allows the LRU algorithm to be used when
-          * to evict packets when the content store has reached maximum size.
+          * The replacement policy orders the entries for eviction when the content store has reached
+          * maximum size.  The default is a Least Recently Used (lru) list.
 	  * Protected rather than private so it can be accessed by test methods in a derived class used for unit testing.
           */
 
-        Ptr<CCNxStandardContentStoreLruList> m_lruList;
+        Ptr<CCNxStandardContentStorePolicy> m_policy;
+
+        /**
+          * The TinyLFU admission filter, or null if disabled.
+          */
+        Ptr<CCNxStandardContentStoreTinyLfu> m_admission;
 
 private:
 
@@ -397,6 +498,11 @@ private:
    */
   virtual void DoInitialize ();
 
+  /**
+   * DoDispose - called in Object Dispose()
+   */
+  virtual void DoDispose ();
+
   /**
    * Function to return KeyidRestriction from Interest packet or Keyid from ContentObject packet
    * /used to search Content Store packet lookup maps. static allows use in comparison struct.
@@ -413,6 +519,93 @@ private:
   /** Maxium number of content objects to store in content store */
   long long m_objectCapacity;
 
+  /** Maximum memory footprint of the content store in bytes (0 = no limit) */
+  long long m_byteCapacity;
+
+  /** Current memory footprint of the content store in bytes */
+  uint64_t m_byteCount;
+
+  /**
+   * The bytes the entry uses in the content store: `CCNxStandardContentStoreEntry::GetFootprint()`
+   * plus the nodes of the maps it is in and of the replacement policy.
+   */
+  uint64_t GetEntryFootprint (Ptr<CCNxStandardContentStoreEntry> entry) const;
+
+  /**
+   * True if an entry of `footprint` bytes can be added without exceeding "ObjectCapacity" or "ByteCapacity".
+   */
+  bool HasRoomFor (uint64_t footprint) const;
+
+  /** The type of m_policy */
+  ReplacementPolicy m_replacementPolicy;
+
+  /** Number of content objects rejected by m_admission */
+  uint64_t m_admissionRejectCount;
+
+  /**
+   * Removes the entry from all maps, the replacement policy and the expiry index.
+   *
+   * @param entry The entry to remove
+   * @param evict true if removed to make room (the policy may remember it), false otherwise
+   * @return true if removed from all the maps it should be in
+   */
+  bool RemoveEntry (Ptr<CCNxStandardContentStoreEntry> entry, bool evict);
+
+  /**
+   * Expiry-ordered index of entries with a deadline (`CCNxStandardContentStoreEntry::GetDeadline()`).
+   */
+  typedef std::multimap<Time, Ptr<CCNxStandardContentStoreEntry> > ExpiryIndexType;
+  ExpiryIndexType m_expiryIndex;
+
+  /**
+   * Position of each entry in m_expiryIndex, so removal is O(log n).
+   */
+  typedef std::unordered_map<Ptr<CCNxStandardContentStoreEntry>, ExpiryIndexType::iterator, CCNxStandardContentStoreEntryPtrHash> ExpiryPositionType;
+  ExpiryPositionType m_expiryPositions;
+
+  /**
+   * Adds the entry to the expiry index if it has a deadline and makes sure the reaper is scheduled.
+   */
+  void IndexExpiry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * Removes the entry from the expiry index (no-op if not there).
+   */
+  void UnindexExpiry (Ptr<CCNxStandardContentStoreEntry> entry);
+
+  /**
+   * Schedules the reaper for the earliest deadline, but no sooner than m_reapInterval from now.
+   */
+  void ScheduleReaper ();
+
+  /**
+   * Removes up to m_reapBatchSize dead entries, then reschedules itself.
+   */
+  void Reap ();
+
+  /** The pending reaper event */
+  EventId m_reapEvent;
+
+  /** When m_reapEvent fires */
+  Time m_reapTime;
+
+  /** The minimum time between reaper runs (attribute "ReapInterval") */
+  Time m_reapInterval;
+
+  /** The maximum number of entries removed by one reaper run, 0 disables the reaper (attribute "ReapBatchSize") */
+  unsigned m_reapBatchSize;
+
+  /** Number of entries removed because they were expired or stale */
+  uint64_t m_expiryCount;
+
+  /** Number of entries evicted to make room */
+  uint64_t m_evictionCount;
+
+  /**
+   * Record a request for the interest's object in the admission filter (if enabled).
+   */
+  void RecordAdmissionAccess (Ptr<CCNxInterest> interest);
+
 
 
    /**
@@ -487,6 +680,15 @@ private:
    * This value is set via the attribute "LayerDelayServers".  The default is 1.
    */
   unsigned m_layerDelayServers;
+
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1.
+   *
+   * @see CCNxDelayQueue::SetBatchSize
+   */
+  unsigned m_layerDelayBatchSize;
 };
 
 }   /* namespace ccnx */
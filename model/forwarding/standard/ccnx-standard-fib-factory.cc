@@ -56,6 +56,7 @@
 #include "ccnx-standard-fib-factory.h"
 #include "ns3/ccnx-standard-fib.h"
 #include "ns3/integer.h"
+#include "ns3/enum.h"
 
 using namespace ns3;
 using namespace ns3::ccnx;
@@ -85,3 +86,15 @@ CCNxStandardFibFactory::SetLayerDelayServers (unsigned serverCount)
 {
   Set ("LayerDelayServers", IntegerValue (serverCount));
 }
+
+void
+CCNxStandardFibFactory::SetLayerDelayBatchSize (unsigned batchSize)
+{
+  Set ("LayerDelayBatchSize", IntegerValue (batchSize));
+}
+
+void
+CCNxStandardFibFactory::SetForwardingStrategy (CCNxStandardForwardingStrategy::StrategyType strategy)
+{
+  Set ("ForwardingStrategy", EnumValue (strategy));
+}
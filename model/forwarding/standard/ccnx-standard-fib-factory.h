@@ -58,6 +58,7 @@
 
 #include "ns3/object-factory.h"
 #include "ns3/nstime.h"
+#include "ns3/ccnx-standard-forwarding-strategy.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -111,6 +112,21 @@ public:
    * This value is set via the attribute "LayerDelayServers".  The default is 1.
    */
   void SetLayerDelayServers (unsigned serverCount);
+
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.  Larger
+   * batches use fewer events but deliver the earlier items of a batch when the last one is done.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1 (unbatched).
+   */
+  void SetLayerDelayBatchSize (unsigned batchSize);
+
+  /**
+   * Selects how the next hops of the matching FIB entry are chosen for an Interest.
+   *
+   * This value is set via the attribute "ForwardingStrategy".  The default is Multicast.
+   */
+  void SetForwardingStrategy (CCNxStandardForwardingStrategy::StrategyType strategy);
 };
 
 }   /* namespace ccnx */
@@ -56,12 +56,12 @@
 
 
 #include "ccnx-standard-fib.h"
-#include "ns3/ccnx-name-builder.h"
 #include "ns3/simple-ref-count.h"
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/object.h"
 #include "ns3/integer.h"
+#include "ns3/enum.h"
 #include "ns3/ccnx-standard-forwarder-work-item.h"
 
 using namespace ns3;
@@ -74,6 +74,7 @@ NS_OBJECT_ENSURE_REGISTERED (CCNxStandardFib);
 static const Time _defaultLayerDelayConstant = MicroSeconds (1);
 static const Time _defaultLayerDelaySlope = NanoSeconds (10);
 static unsigned _defaultLayerDelayServers = 1;
+static unsigned _defaultLayerDelayBatchSize = 1;
 
 /**
  * Used as a default callback for m_recieveInterestCallback in case the user does not set it.
@@ -103,6 +104,18 @@ CCNxStandardFib::GetTypeId (void)
                    IntegerValue (_defaultLayerDelayServers),
                    MakeIntegerAccessor (&CCNxStandardFib::m_layerDelayServers),
                    MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("LayerDelayBatchSize", "The most items a layer delay server takes per scheduler event (1 is unbatched)",
+                   IntegerValue (_defaultLayerDelayBatchSize),
+                   MakeIntegerAccessor (&CCNxStandardFib::m_layerDelayBatchSize),
+                   MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("ForwardingStrategy", "How the next hops of the matching entry are chosen for an Interest",
+                   EnumValue (CCNxStandardForwardingStrategy::Multicast),
+                   MakeEnumAccessor (&CCNxStandardFib::SetForwardingStrategy, &CCNxStandardFib::GetForwardingStrategy),
+                   MakeEnumChecker (CCNxStandardForwardingStrategy::Multicast, "Multicast",
+                                    CCNxStandardForwardingStrategy::BestRoute, "BestRoute",
+                                    CCNxStandardForwardingStrategy::Ecmp, "Ecmp",
+                                    CCNxStandardForwardingStrategy::WeightedSplit, "WeightedSplit",
+                                    CCNxStandardForwardingStrategy::Adaptive, "Adaptive"))
   ;
 
   return tid;
@@ -112,7 +125,11 @@ CCNxStandardFib::GetTypeId (void)
 CCNxStandardFib::CCNxStandardFib ()
   :   m_LookupCallback (MakeCallback (&NullLookupCallback)),
   m_layerDelayConstant (_defaultLayerDelayConstant), m_layerDelaySlope (_defaultLayerDelaySlope),
-  m_layerDelayServers (_defaultLayerDelayServers)
+  m_layerDelayServers (_defaultLayerDelayServers),
+  m_layerDelayBatchSize (_defaultLayerDelayBatchSize),
+  m_forwardingStrategyType (CCNxStandardForwardingStrategy::Multicast),
+  m_forwardingStrategy (CCNxStandardForwardingStrategy::CreateStrategy (CCNxStandardForwardingStrategy::Multicast)),
+  m_interestLifetime (Time (0))
 {
 
 }
@@ -128,6 +145,7 @@ CCNxStandardFib::DoInitialize ()
   m_inputQueue = Create<DelayQueueType> (m_layerDelayServers,
                                          MakeCallback (&CCNxStandardFib::GetServiceTime, this),
                                          MakeCallback (&CCNxStandardFib::DequeueCallback, this));
+  m_inputQueue->SetBatchSize (m_layerDelayBatchSize);
 }
 
 void
@@ -139,34 +157,75 @@ CCNxStandardFib::SetLookupCallback (LookupCallback lookupCallback)
 bool
 CCNxStandardFib::RemoveConnection (  Ptr<CCNxConnection>  connection)
 {
-  std::pair< FibType::iterator, bool > fibRvPair;
+  m_forwardingStrategy->RemoveConnection (connection);
+
+  ConnectionIndexType::iterator index = m_connectionIndex.find (connection->GetConnectionId ());
+  if (index == m_connectionIndex.end ())
+    {
+      NS_LOG_INFO ( __func__ << " no routes use connection " << connection->GetConnectionId ());
+      return true;
+    }
 
-  FibType::iterator itbegin = fib.begin ();
-  FibType::iterator itend = fib.end ();
+  EntrySetType entries;
+  entries.swap (index->second);
+  m_connectionIndex.erase (index);
 
   std::pair<bool,int> rvPair;
 
-  for (FibType::iterator it = itbegin; it != itend; )
+  for (EntrySetType::iterator it = entries.begin (); it != entries.end (); ++it)
     {
-      rvPair = it->second->RemoveConnection (connection);
-
+      rvPair = it->first->RemoveConnection (connection);
 
       if (rvPair.second == 0)      //erase fib entry
         {
-          FibType::iterator itlast = it;
-          ++it;   //erase invalidates ptr, so must inc it first
-          fib.erase (itlast);
-        }
-      else
-        {
-          ++it;
+          m_fibByHash.Erase (it->second->GetHash (), it->second);
+          fib.erase (it->second);
         }
     }
 
-  NS_LOG_INFO ( __func__ << " successful.");
+  NS_LOG_INFO ( __func__ << " successful, " << entries.size () << " routes.");
   return true;
 }
 
+size_t
+CCNxStandardFib::CountConnectionEntries (Ptr<const CCNxConnection> connection) const
+{
+  ConnectionIndexType::const_iterator index = m_connectionIndex.find (connection->GetConnectionId ());
+  return (index == m_connectionIndex.end ()) ? 0 : index->second.size ();
+}
+
+void
+CCNxStandardFib::SetForwardingStrategy (CCNxStandardForwardingStrategy::StrategyType strategy)
+{
+  NS_LOG_FUNCTION (this << strategy);
+  m_forwardingStrategyType = strategy;
+  m_forwardingStrategy = CCNxStandardForwardingStrategy::CreateStrategy (strategy);
+  if (m_interestLifetime.IsStrictlyPositive ())
+    {
+      m_forwardingStrategy->SetInterestLifetime (m_interestLifetime);
+    }
+}
+
+CCNxStandardForwardingStrategy::StrategyType
+CCNxStandardFib::GetForwardingStrategy () const
+{
+  return m_forwardingStrategyType;
+}
+
+void
+CCNxStandardFib::ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress)
+{
+  m_forwardingStrategy->ContentReceived (name, ingress);
+}
+
+void
+CCNxStandardFib::SetInterestLifetime (Time lifetime)
+{
+  NS_LOG_FUNCTION (this << lifetime);
+  m_interestLifetime = lifetime;
+  m_forwardingStrategy->SetInterestLifetime (lifetime);
+}
+
 
 unsigned
 CCNxStandardFib::PerformLookup (Ptr<CCNxStandardForwarderWorkItem> workItem)
@@ -179,28 +238,29 @@ CCNxStandardFib::PerformLookup (Ptr<CCNxStandardForwarderWorkItem> workItem)
   Ptr<const CCNxName> ccnxName = workItem->GetPacket ()->GetMessage ()->GetName ();
   Ptr<CCNxConnection> ingress = workItem->GetIngressConnection ();
 
-  CCNxNameBuilder builder;
-
-  FibType::iterator bestMatch = fib.end ();
+  Ptr<CCNxStandardFibEntry> bestMatch;
+  size_t bestMatchLength = 0;
   NS_LOG_INFO ( __func__ << " fib size =" << fib.size ());
 
-  //copy first segment of name to name copy and lookup in fib.
+  //probe the hash of the first segment of the name in the fib.
   //if match, add next name segment and look again until no match or name ends
   //if no match, try again until end of name
-  int i = 0;
-  while (i < ccnxName->GetSegmentCount () )
+  NamePrefixQuery query;
+  query.name = PeekPointer (ccnxName);
+  query.length = 0;
+  while (query.length < ccnxName->GetSegmentCount () )
     {
-      builder.Append (ccnxName->GetSegment (i));
-      i++;
-      FibType::iterator it = fib.find (builder.CreateName ());
+      query.length++;
+      Ptr<CCNxStandardFibEntry> *found = m_fibByHash.Find (ccnxName->GetPrefixHash (query.length), query, EqualsNamePrefix ());
 
-      if ( it != fib.end () )
+      if ( found )
         {
-          bestMatch = it;
+          bestMatch = *found;
+          bestMatchLength = query.length;
         }
       else
         {
-          if (bestMatch != fib.end ())
+          if (bestMatch)
             {
               break;       //name was matching but stopped
             }
@@ -208,21 +268,13 @@ CCNxStandardFib::PerformLookup (Ptr<CCNxStandardForwarderWorkItem> workItem)
     }
 
 
-  if (bestMatch == fib.end ())
+  if (!bestMatch)
     {
       NS_LOG_INFO ( __func__ << " No fib match!");
     }
-  else         //get vector and translate  into list, removing ingress connection
+  else         //the forwarding strategy picks the egress connections, never the ingress connection
     {
-      CCNxStandardFibEntry::ConnectionsVecType connectionsVec = bestMatch->second->GetConnections ();
-      for (CCNxStandardFibEntry::ConnectionsVecType::iterator it = connectionsVec.begin (); it != connectionsVec.end (); it++)
-        {
-          Ptr<CCNxConnection> conn = *it;
-          if (conn->GetConnectionId () != ingress->GetConnectionId ())
-            {
-              egress->push_back (conn);
-            }
-        }
+      m_forwardingStrategy->SelectEgress (ccnxName, bestMatchLength, ingress, bestMatch->GetNextHops (), egress);
     }
 
   NS_LOG_DEBUG ("Lookup match count: " << egress->size ());
@@ -272,32 +324,22 @@ CCNxStandardFib::Lookup (Ptr<CCNxForwarderMessage> message)
 } //Lookup
 
 bool
-CCNxStandardFib::AddRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection)
+CCNxStandardFib::AddRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection, uint32_t cost)
 {
   NS_LOG_FUNCTION (this);
 
-  std::pair< FibType::iterator, bool > fibRvPair;
-
-  //find this name in fib. if already present, it's fibEntry ptr is returned.
-  //if not present, a new location is added to the map and a null ptr is returned.
-  Ptr<CCNxStandardFibEntry> fibEntry = fib[ccnxName];
-
-  //if route already in fib, modify entry. if not add new entry first.
-  if (fibEntry != NULL)
-    {
-
-      fibEntry->AddConnection (connection);
-    }
-  else
+  //find this name in fib. if already present, modify its entry. if not add new entry first.
+  FibType::iterator it = fib.find (ccnxName);
+  if (it == fib.end ())
     {
       NS_LOG_DEBUG ( __func__ << " adding new route[" << *ccnxName << "] = [" << connection->GetConnectionId () << "]");
 
-      fib[ccnxName] = Create<CCNxStandardFibEntry> ();
-
-      fib[ccnxName]->AddConnection (connection);
-
+      it = fib.insert (std::make_pair (ccnxName, Create<CCNxStandardFibEntry> ())).first;
+      m_fibByHash.Insert (ccnxName->GetHash (), ccnxName, it->second);
     }
 
+  it->second->AddConnection (connection, cost);
+  m_connectionIndex[connection->GetConnectionId ()][PeekPointer (it->second)] = it->first;
 
   return true;
 
@@ -307,18 +349,20 @@ CCNxStandardFib::AddRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  c
 bool
 CCNxStandardFib::DeleteRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection)
 {
-
-  Ptr<CCNxStandardFibEntry> fibEntry = Create<CCNxStandardFibEntry> ();
-
   FibType::iterator it = fib.find (ccnxName);
   std::pair <bool,int > rvPair;
 
   if (it != fib.end ())
     {
       rvPair = it->second->RemoveConnection (connection);
+      if (rvPair.first)
+        {
+          UnindexConnection (connection->GetConnectionId (), PeekPointer (it->second));
+        }
       if (rvPair.second == 0)          //erase fib entry
         {
-          fib.erase (ccnxName);
+          m_fibByHash.Erase (ccnxName->GetHash (), ccnxName);
+          fib.erase (it);
         }
       NS_LOG_INFO ( __func__ << " successful.");
       return rvPair.first;      //only return true if name and connection were matched.
@@ -332,6 +376,20 @@ CCNxStandardFib::DeleteRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>
 
 } //DeleteRoute
 
+void
+CCNxStandardFib::UnindexConnection (CCNxConnection::ConnIdType connectionId, CCNxStandardFibEntry *entry)
+{
+  ConnectionIndexType::iterator index = m_connectionIndex.find (connectionId);
+  if (index != m_connectionIndex.end ())
+    {
+      index->second.erase (entry);
+      if (index->second.empty ())
+        {
+          m_connectionIndex.erase (index);
+        }
+    }
+}
+
 int CCNxStandardFib::CountEntries ()
 {
   return fib.size ();
@@ -366,4 +424,3 @@ CCNxStandardFib::PrintRoute (std::ostream & os, Ptr<const CCNxName> ccnxName)
   return os;
 
 }
-
@@ -64,7 +64,9 @@
 #include "ns3/ccnx-fib.h"
 #include "ns3/ccnx-forwarder.h"
 #include "ns3/ccnx-standard-fibEntry.h"
+#include "ns3/ccnx-standard-forwarding-strategy.h"
 #include "ns3/ccnx-delay-queue.h"
+#include "ns3/ccnx-hash-table.h"
 #include "ns3/ccnx-standard-forwarder-work-item.h"
 
 namespace ns3 {
@@ -98,6 +100,53 @@ protected:
 
   FibType fib;
 
+  struct EqualsPtrCCNxName
+  {
+    bool operator() (const Ptr<const CCNxName> &a, const Ptr<const CCNxName> &b) const
+    {
+      return a->Equals (*b);
+    }
+  };
+
+  /**
+   * A query for the first `length` segments of `name`, used to probe m_fibByHash without
+   * building the prefix.
+   */
+  struct NamePrefixQuery
+  {
+    const CCNxName *name;
+    size_t length;
+  };
+
+  struct EqualsNamePrefix
+  {
+    bool operator() (const Ptr<const CCNxName> &a, const NamePrefixQuery &b) const
+    {
+      return a->GetSegmentCount () == b.length && a->IsPrefixOf (*b.name);
+    }
+  };
+
+  typedef CCNxHashTable< Ptr<const CCNxName>, Ptr<CCNxStandardFibEntry>, EqualsPtrCCNxName > FibByHashType;
+
+  /**
+   * The same entries as `fib`, keyed by `CCNxName::GetHash()`.  Lookup probes it with
+   * `CCNxName::GetPrefixHash()` for each prefix length of the Interest name.
+   */
+  FibByHashType m_fibByHash;
+
+  /**
+   * The entries that route to one connection, with the name each is stored under in `fib`.
+   */
+  typedef std::map< CCNxStandardFibEntry *, Ptr<const CCNxName> > EntrySetType;
+
+  typedef std::map< CCNxConnection::ConnIdType, EntrySetType > ConnectionIndexType;
+
+  /**
+   * Reverse index from a connection to the entries that use it, kept in step with `AddRoute()`,
+   * `DeleteRoute()`, and `RemoveConnection()`, so removing a connection only touches its own routes.
+   */
+  ConnectionIndexType m_connectionIndex;
+
 public:
   CCNxStandardFib ();
 
@@ -127,7 +176,7 @@ public:
    *
    * @copydoc CCNxFib::AddRoute()
    */
-  virtual bool AddRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection);
+  virtual bool AddRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection, uint32_t cost = 0);
 
   virtual bool DeleteRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection);
 
@@ -141,6 +190,26 @@ public:
    */
   virtual int CountEntries ();
 
+  /**
+   * The number of FIB entries that route to `connection`
+   */
+  size_t CountConnectionEntries (Ptr<const CCNxConnection> connection) const;
+
+  /**
+   * Selects how the next hops of the matching entry are chosen for an Interest.
+   *
+   * This value is set via the attribute "ForwardingStrategy".  The default is Multicast.
+   */
+  void SetForwardingStrategy (CCNxStandardForwardingStrategy::StrategyType strategy);
+
+  CCNxStandardForwardingStrategy::StrategyType GetForwardingStrategy () const;
+
+  //! @copydoc CCNxFib::ContentReceived(Ptr<const CCNxName>, Ptr<CCNxConnection>)
+  virtual void ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress);
+
+  //! @copydoc CCNxFib::SetInterestLifetime(Time)
+  virtual void SetInterestLifetime (Time lifetime);
+
 protected:
   // ns3::Object::DoInitialize()
   void DoInitialize ();
@@ -161,6 +230,11 @@ private:
    */
   unsigned PerformLookup (Ptr<CCNxStandardForwarderWorkItem> workItem);
 
+  /**
+   * Remove `entry` from the reverse index of `connectionId`
+   */
+  void UnindexConnection (CCNxConnection::ConnIdType connectionId, CCNxStandardFibEntry *entry);
+
   /**
    * Set by the forwarder as the callback for Lookup
    */
@@ -217,6 +291,30 @@ private:
    */
   unsigned m_layerDelayServers;
 
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1.
+   *
+   * @see CCNxDelayQueue::SetBatchSize
+   */
+  unsigned m_layerDelayBatchSize;
+
+  /**
+   * The strategy type, set via the attribute "ForwardingStrategy"
+   */
+  CCNxStandardForwardingStrategy::StrategyType m_forwardingStrategyType;
+
+  /**
+   * Picks the egress connections from the matching entry's next hops
+   */
+  Ptr<CCNxStandardForwardingStrategy> m_forwardingStrategy;
+
+  /**
+   * From `SetInterestLifetime()`, given to each new strategy.  Zero until set.
+   */
+  Time m_interestLifetime;
+
 
 };          //class
 }    //namespace
@@ -85,20 +85,22 @@ std::pair<bool,int>
 CCNxStandardFibEntry::RemoveConnection ( Ptr<CCNxConnection> & connection)
 {
 
-  ConnectionsVecType::iterator itbegin = m_connectionsVec.begin ();
-  ConnectionsVecType::iterator itend = m_connectionsVec.end ();
+  NextHopsVecType::iterator itbegin = m_nextHopsVec.begin ();
+  NextHopsVecType::iterator itend = m_nextHopsVec.end ();
   bool erased = false;
-  for (ConnectionsVecType::iterator it = itbegin; it != itend; ++it )
+  for (NextHopsVecType::iterator it = itbegin; it != itend; ++it )
     {
-      if ((*it)->GetConnectionId () == connection->GetConnectionId () )
+      if (it->connection->GetConnectionId () == connection->GetConnectionId () )
         {
+          // AddConnection() keeps the connections unique, and erase invalidates the iterators
           erased = true;
-          m_connectionsVec.erase (it);
+          m_nextHopsVec.erase (it);
+          break;
         }
     }
   std::pair <bool,int> rvPair;
   rvPair.first = erased;
-  rvPair.second = m_connectionsVec.size ();
+  rvPair.second = m_nextHopsVec.size ();
   return rvPair;
 
 
@@ -107,25 +109,34 @@ CCNxStandardFibEntry::RemoveConnection ( Ptr<CCNxConnection> & connection)
 
 
 int
-CCNxStandardFibEntry::AddConnection ( Ptr<CCNxConnection> & connection)
+CCNxStandardFibEntry::AddConnection ( Ptr<CCNxConnection> & connection, uint32_t cost)
 {
-  bool alreadyThere = false;
-
-  ConnectionsVecType::iterator itbegin = m_connectionsVec.begin ();
-  ConnectionsVecType::iterator itend = m_connectionsVec.end ();
-  for (ConnectionsVecType::iterator it = itbegin; it != itend; ++it )
+  // a connection that is already there is re-inserted at the position of its new cost
+  for (NextHopsVecType::iterator it = m_nextHopsVec.begin (); it != m_nextHopsVec.end (); ++it )
     {
-      if ( (*it)->GetConnectionId () == connection->GetConnectionId ())
+      if ( it->connection->GetConnectionId () == connection->GetConnectionId ())
         {
-          alreadyThere = true;
+          if (it->cost == cost)
+            {
+              return m_nextHopsVec.size ();
+            }
+          m_nextHopsVec.erase (it);
+          break;
         }
     }
 
-  if (not alreadyThere)
+  // insert after every next hop of equal or lower cost, so equal costs keep their order
+  NextHopsVecType::iterator position = m_nextHopsVec.begin ();
+  while (position != m_nextHopsVec.end () && position->cost <= cost)
     {
-      m_connectionsVec.push_back (connection);
+      ++position;
     }
-  return m_connectionsVec.size ();
+
+  NextHop nextHop;
+  nextHop.connection = connection;
+  nextHop.cost = cost;
+  m_nextHopsVec.insert (position, nextHop);
+  return m_nextHopsVec.size ();
 
 }
 
@@ -134,20 +145,36 @@ CCNxStandardFibEntry::AddConnection ( Ptr<CCNxConnection> & connection)
 CCNxStandardFibEntry::ConnectionsVecType
 CCNxStandardFibEntry::GetConnections ()
 {
-  return m_connectionsVec;
+  ConnectionsVecType connectionsVec;
+  connectionsVec.reserve (m_nextHopsVec.size ());
+  for (NextHopsVecType::const_iterator it = m_nextHopsVec.begin (); it != m_nextHopsVec.end (); ++it)
+    {
+      connectionsVec.push_back (it->connection);
+    }
+  return connectionsVec;
 
 }
 
+const CCNxStandardFibEntry::NextHopsVecType &
+CCNxStandardFibEntry::GetNextHops () const
+{
+  return m_nextHopsVec;
+}
+
 std::ostream&
 ns3::ccnx::operator<< (std::ostream& os, CCNxStandardFibEntry & ccnxStandardFibEntry)
 
 {
   os << " [ ";
 
-  int last = ccnxStandardFibEntry.m_connectionsVec.size ();
+  int last = ccnxStandardFibEntry.m_nextHopsVec.size ();
   for (int i = 0; i < last; )
     {
-      os << ccnxStandardFibEntry.m_connectionsVec[i]->GetConnectionId ();
+      os << ccnxStandardFibEntry.m_nextHopsVec[i].connection->GetConnectionId ();
+      if (ccnxStandardFibEntry.m_nextHopsVec[i].cost > 0)
+        {
+          os << " (" << ccnxStandardFibEntry.m_nextHopsVec[i].cost << ")";
+        }
       i++;
       if (i < last)
         {
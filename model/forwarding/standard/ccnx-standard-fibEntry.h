@@ -57,6 +57,7 @@
 #ifndef CCNS3SIM_CCNXSTANDARDFIBENTRY_H
 #define CCNS3SIM_CCNXSTANDARDFIBENTRY_H
 
+#include <vector>
 #include <ns3/ccnx-connection.h>
 #include "ns3/simple-ref-count.h"
 
@@ -73,7 +74,9 @@ namespace ccnx {
  * @ingroup ccnx-standard-forwarder
  *
  * The CCNx standard FIB entry class contains a fib entry and methods for the fib class to call.
- * This standard Fib Entry contains  a vector of the next hop connections for matching route prefix.
+ * This standard Fib Entry contains  a vector of the next hop connections for matching route prefix,
+ * each with the route cost it was added with.  The next hops are kept in ascending cost order
+ * (ties in the order they were added), so the best route is first.
  * A lookup on an entry returns the vector of connections.
  * This class is derived from object to support run-time replacement with a more complex class.
  *
@@ -95,6 +98,20 @@ public:
    */
   typedef  std::vector< Ptr<CCNxConnection> > ConnectionsVecType;
 
+  /**
+   * A next hop connection and the cost of the route through it
+   */
+  struct NextHop
+  {
+    Ptr<CCNxConnection> connection;
+    uint32_t cost;
+  };
+
+  /*
+   * vector of next hops in ascending cost order
+   */
+  typedef  std::vector< NextHop > NextHopsVecType;
+
   /**
    * RemoveConnection - remove a connection (if present) from the entry.
    *
@@ -126,9 +143,11 @@ public:
 
 
   /**
-   * AddConnection - Add a connection to the entry.
+   * AddConnection - Add a connection to the entry.  If the connection is already
+   * in the entry, its cost is updated.
    *
    * @param [in] connection
+   * @param [in] cost The route cost through `connection` (lower is better)
    * @return = number of connections in m_fibEntry after adding this one.
    *
    * Example:
@@ -151,7 +170,7 @@ public:
    *
    * @see ccnxFib_Release
    */
-  virtual int AddConnection ( Ptr<CCNxConnection> & connection);
+  virtual int AddConnection ( Ptr<CCNxConnection> & connection, uint32_t cost = 0);
 
 
 
@@ -180,10 +199,16 @@ public:
    */
   virtual ConnectionsVecType GetConnections ();
 
+  /**
+   * GetNextHops - the connections of the entry with their costs, in ascending cost order.
+   * Unlike `GetConnections()` this does not copy.
+   */
+  const NextHopsVecType & GetNextHops () const;
+
   friend std::ostream &operator<< (std::ostream &os, CCNxStandardFibEntry  &ccnxStandardFibEntry);
 
 private:
-  ConnectionsVecType m_connectionsVec;
+  NextHopsVecType m_nextHopsVec;
 
 
 
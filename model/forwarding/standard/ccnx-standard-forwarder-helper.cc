@@ -55,6 +55,8 @@
 
 #include "ns3/log.h"
 #include "ns3/integer.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/ccnx-standard-forwarder-helper.h"
 #include "ns3/ccnx-standard-forwarder.h"
 #include "ns3/ccnx-l3-protocol.h"
@@ -110,6 +112,38 @@ CCNxStandardForwarderHelper::SetLayerDelayServers (unsigned serverCount)
   m_factory.Set ("LayerDelayServers", IntegerValue (serverCount));
 }
 
+void
+CCNxStandardForwarderHelper::SetLayerDelayBatchSize (unsigned batchSize)
+{
+  m_factory.Set ("LayerDelayBatchSize", IntegerValue (batchSize));
+}
+
+void
+CCNxStandardForwarderHelper::SetInputQueueCapacity (unsigned capacity)
+{
+  m_factory.Set ("InputQueueCapacity", IntegerValue (capacity));
+}
+
+void
+CCNxStandardForwarderHelper::SetInputQueueRed (unsigned minThreshold, unsigned maxThreshold, double maxProbability, double queueWeight)
+{
+  m_factory.Set ("InputQueueDropPolicy", EnumValue (CCNxDelayQueueDropPolicy_Red));
+  m_factory.Set ("RedMinThreshold", IntegerValue (minThreshold));
+  m_factory.Set ("RedMaxThreshold", IntegerValue (maxThreshold));
+  m_factory.Set ("RedMaxProbability", DoubleValue (maxProbability));
+  m_factory.Set ("RedQueueWeight", DoubleValue (queueWeight));
+}
+
+void
+CCNxStandardForwarderHelper::SetInputQueueScheduler (CCNxDelayQueueScheduler scheduler, unsigned controlWeight,
+                                                     unsigned contentObjectWeight, unsigned interestWeight)
+{
+  m_factory.Set ("InputQueueScheduler", EnumValue (scheduler));
+  m_factory.Set ("ControlWeight", IntegerValue (controlWeight));
+  m_factory.Set ("ContentObjectWeight", IntegerValue (contentObjectWeight));
+  m_factory.Set ("InterestWeight", IntegerValue (interestWeight));
+}
+
 void
 CCNxStandardForwarderHelper::Install (Ptr<Node> node) const
 {
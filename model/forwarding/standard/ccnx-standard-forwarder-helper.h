@@ -59,6 +59,7 @@
 #include "ns3/object-factory.h"
 #include "ns3/ccnx-forwarding-helper.h"
 #include "ns3/nstime.h"
+#include "ns3/ccnx-delay-queue.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -127,6 +128,40 @@ public:
    */
   void SetLayerDelayServers (unsigned serverCount);
 
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.  Larger
+   * batches use fewer events but deliver the earlier items of a batch when the last one is done.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1 (unbatched).
+   */
+  void SetLayerDelayBatchSize (unsigned batchSize);
+
+  /**
+   * The most packets waiting in the forwarder input queue.  Arrivals beyond that are
+   * dropped and reported on the "InputQueueDrop" trace source.
+   *
+   * This value is set via the attribute "InputQueueCapacity".  The default is 0 (unbounded).
+   */
+  void SetInputQueueCapacity (unsigned capacity);
+
+  /**
+   * Use Random Early Detection on the forwarder input queue (see CCNxDelayQueue::SetRed).
+   *
+   * These values are set via the attributes "InputQueueDropPolicy", "RedMinThreshold",
+   * "RedMaxThreshold", "RedMaxProbability", and "RedQueueWeight".
+   */
+  void SetInputQueueRed (unsigned minThreshold, unsigned maxThreshold, double maxProbability, double queueWeight);
+
+  /**
+   * How the forwarder input queue serves its control, Content Object, and Interest classes.
+   * The weights are only used by weighted round robin.
+   *
+   * These values are set via the attributes "InputQueueScheduler", "ControlWeight",
+   * "ContentObjectWeight", and "InterestWeight".  The default is Fifo.
+   */
+  void SetInputQueueScheduler (CCNxDelayQueueScheduler scheduler, unsigned controlWeight = 4,
+                               unsigned contentObjectWeight = 2, unsigned interestWeight = 1);
+
   /**
    * Sets a custom PIT implementation by its `ObjectFactory`.  If not set,
    * the forwarder will use its default PIT type.
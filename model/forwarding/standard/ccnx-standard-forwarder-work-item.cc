@@ -64,7 +64,8 @@ CCNxStandardForwarderWorkItem::CCNxStandardForwarderWorkItem (Ptr<CCNxPacket> pa
                                                               Ptr<CCNxConnection> egressConnection)
   : CCNxForwarderMessage (packet, ingressConnection),
   m_egressConnection (egressConnection),
-  m_routingErrno (CCNxRoutingError::CCNxRoutingError_NoError)
+  m_routingErrno (CCNxRoutingError::CCNxRoutingError_NoError),
+  m_contentAddedFlag (false)
 {
   // empty
 }
@@ -58,6 +58,7 @@
 
 #include "ns3/ccnx-forwarder-message.h"
 #include "ns3/ccnx-forwarder.h"
+#include "ns3/ccnx-pool-allocator.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -71,9 +72,10 @@ namespace ccnx {
  * from the CCNxL3Protocol via `RouteIn()` or `RouteOut()` to track the message through the PIT, FIB, and CS.
  * It encapsulates things like the CCNxPacket, and the ingressConnection.
  *
- * This is the class that gets stored in all the `CCNxDelayQueue`s.
+ * This is the class that gets stored in all the `CCNxDelayQueue`s.  There is at least one per
+ * packet, so it is allocated from CCNxPoolAllocator.
  */
-class CCNxStandardForwarderWorkItem : public CCNxForwarderMessage
+class CCNxStandardForwarderWorkItem : public CCNxForwarderMessage, public CCNxPoolAllocated
 {
 public:
   CCNxStandardForwarderWorkItem (Ptr<CCNxPacket> packet,
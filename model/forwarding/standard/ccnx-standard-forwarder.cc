@@ -54,6 +54,7 @@
  */
 
 #include <iomanip>
+#include <sstream>
 
 #include "ns3/log.h"
 #include "ns3/assert.h"
@@ -70,6 +71,9 @@
 #include "ns3/ccnx-standard-fib-factory.h"
 
 #include "ns3/integer.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/string.h"
 
 using namespace ns3;
 using namespace ns3::ccnx;
@@ -80,6 +84,32 @@ NS_OBJECT_ENSURE_REGISTERED (CCNxStandardForwarder);
 static const Time _defaultLayerDelayConstant = MicroSeconds (1);
 static const Time _defaultLayerDelaySlope = Seconds (0);
 static unsigned _defaultLayerDelayServers = 1;
+static unsigned _defaultLayerDelayBatchSize = 1;
+static unsigned _defaultInputQueueCapacity = 0;
+static unsigned _defaultRedMinThreshold = 16;
+static unsigned _defaultRedMaxThreshold = 64;
+static const double _defaultRedMaxProbability = 0.1;
+static const double _defaultRedQueueWeight = 0.002;
+static const char *_defaultControlPrefix = "ccnx:/name=nfp";
+static unsigned _defaultControlWeight = 4;
+static unsigned _defaultContentObjectWeight = 2;
+static unsigned _defaultInterestWeight = 1;
+
+/*
+ * For log messages.  A Content Object matched by its hash may have no name.
+ */
+static inline std::string
+NameString (Ptr<CCNxPacket> packet)
+{
+  Ptr<const CCNxName> name = packet->GetMessage ()->GetName ();
+  if (!name)
+    {
+      return "(nameless)";
+    }
+  std::ostringstream os;
+  os << *name;
+  return os.str ();
+}
 
 static ObjectFactory
 GetDefaultPitFactory ()
@@ -135,6 +165,61 @@ CCNxStandardForwarder::GetTypeId ()
                    IntegerValue (_defaultLayerDelayServers),
                    MakeIntegerAccessor (&CCNxStandardForwarder::m_layerDelayServers),
                    MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("LayerDelayBatchSize", "The most items a layer delay server takes per scheduler event (1 is unbatched)",
+                   IntegerValue (_defaultLayerDelayBatchSize),
+                   MakeIntegerAccessor (&CCNxStandardForwarder::m_layerDelayBatchSize),
+                   MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("InputQueueCapacity", "The most packets waiting in the input queue, 0 is unbounded",
+                   IntegerValue (_defaultInputQueueCapacity),
+                   MakeIntegerAccessor (&CCNxStandardForwarder::m_inputQueueCapacity),
+                   MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("InputQueueDropPolicy", "How the input queue drops arrivals",
+                   EnumValue (CCNxDelayQueueDropPolicy_TailDrop),
+                   MakeEnumAccessor (&CCNxStandardForwarder::m_inputQueueDropPolicy),
+                   MakeEnumChecker (CCNxDelayQueueDropPolicy_TailDrop, "TailDrop",
+                                    CCNxDelayQueueDropPolicy_Red, "Red"))
+    .AddAttribute ("RedMinThreshold", "Average input queue backlog where RED starts dropping",
+                   IntegerValue (_defaultRedMinThreshold),
+                   MakeIntegerAccessor (&CCNxStandardForwarder::m_redMinThreshold),
+                   MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("RedMaxThreshold", "Average input queue backlog where RED drops every arrival",
+                   IntegerValue (_defaultRedMaxThreshold),
+                   MakeIntegerAccessor (&CCNxStandardForwarder::m_redMaxThreshold),
+                   MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("RedMaxProbability", "RED drop probability at RedMaxThreshold",
+                   DoubleValue (_defaultRedMaxProbability),
+                   MakeDoubleAccessor (&CCNxStandardForwarder::m_redMaxProbability),
+                   MakeDoubleChecker<double> (0, 1))
+    .AddAttribute ("RedQueueWeight", "Weight of the current backlog in the RED average",
+                   DoubleValue (_defaultRedQueueWeight),
+                   MakeDoubleAccessor (&CCNxStandardForwarder::m_redQueueWeight),
+                   MakeDoubleChecker<double> (0, 1))
+    .AddAttribute ("InputQueueScheduler", "How the input queue serves the control, Content Object, and Interest classes",
+                   EnumValue (CCNxDelayQueueScheduler_Fifo),
+                   MakeEnumAccessor (&CCNxStandardForwarder::m_inputQueueScheduler),
+                   MakeEnumChecker (CCNxDelayQueueScheduler_Fifo, "Fifo",
+                                    CCNxDelayQueueScheduler_StrictPriority, "StrictPriority",
+                                    CCNxDelayQueueScheduler_WeightedRoundRobin, "WeightedRoundRobin"))
+    .AddAttribute ("ControlPrefix", "Interests under this prefix are in the control class (routing protocol)",
+                   StringValue (_defaultControlPrefix),
+                   MakeStringAccessor (&CCNxStandardForwarder::m_controlPrefixString),
+                   MakeStringChecker ())
+    .AddAttribute ("ControlWeight", "Weighted round robin weight of the control class",
+                   IntegerValue (_defaultControlWeight),
+                   MakeIntegerAccessor (&CCNxStandardForwarder::m_controlWeight),
+                   MakeIntegerChecker<unsigned> (1))
+    .AddAttribute ("ContentObjectWeight", "Weighted round robin weight of the Content Object class",
+                   IntegerValue (_defaultContentObjectWeight),
+                   MakeIntegerAccessor (&CCNxStandardForwarder::m_contentObjectWeight),
+                   MakeIntegerChecker<unsigned> (1))
+    .AddAttribute ("InterestWeight", "Weighted round robin weight of the Interest class",
+                   IntegerValue (_defaultInterestWeight),
+                   MakeIntegerAccessor (&CCNxStandardForwarder::m_interestWeight),
+                   MakeIntegerChecker<unsigned> (1))
+    .AddTraceSource ("InputQueueDrop",
+                     "A packet was dropped on arrival at a full (or RED) input queue.",
+                     MakeTraceSourceAccessor (&CCNxStandardForwarder::m_inputQueueDropTrace),
+                     "ns3::ccnx::CCNxStandardForwarder::InputQueueDropTracedCallback")
   ;
   return tid;
 }
@@ -144,7 +229,15 @@ CCNxStandardForwarder::CCNxStandardForwarder ()
   : m_pitFactory (GetDefaultPitFactory ()), m_fibFactory (GetDefaultFibFactory ()),
     m_contentStoreFactory (GetDefaultContentStoreFactory ()),
   m_layerDelayConstant (_defaultLayerDelayConstant), m_layerDelaySlope (_defaultLayerDelaySlope),
-  m_layerDelayServers (_defaultLayerDelayServers)
+  m_layerDelayServers (_defaultLayerDelayServers),
+  m_layerDelayBatchSize (_defaultLayerDelayBatchSize),
+  m_inputQueueCapacity (_defaultInputQueueCapacity),
+  m_inputQueueDropPolicy (CCNxDelayQueueDropPolicy_TailDrop),
+  m_redMinThreshold (_defaultRedMinThreshold), m_redMaxThreshold (_defaultRedMaxThreshold),
+  m_redMaxProbability (_defaultRedMaxProbability), m_redQueueWeight (_defaultRedQueueWeight),
+  m_redStream (-1), m_inputQueueScheduler (CCNxDelayQueueScheduler_Fifo), m_controlPrefixString (_defaultControlPrefix),
+  m_controlWeight (_defaultControlWeight), m_contentObjectWeight (_defaultContentObjectWeight),
+  m_interestWeight (_defaultInterestWeight)
 {
   memset(&m_forwarderStats, 0, sizeof(m_forwarderStats));
 }
@@ -175,6 +268,13 @@ CCNxStandardForwarder::DoInitialize (void)
   m_fib->SetLookupCallback (MakeCallback (&CCNxStandardForwarder::FibLookupCallback, this));
   m_fib->Initialize ();
 
+  // a forwarding strategy that measures its next hops gives up on an Interest when the PIT does
+  TimeValue lifetime;
+  if (m_pit->GetAttributeFailSafe ("DefaultLifetime", lifetime))
+    {
+      m_fib->SetInterestLifetime (lifetime.Get ());
+    }
+
   CCNxNullContentStoreFactory nullContentStoreFactory;
   if (m_contentStoreFactory.GetTypeId().GetUid() != nullContentStoreFactory.GetTypeId ().GetUid())
     {
@@ -188,6 +288,53 @@ CCNxStandardForwarder::DoInitialize (void)
   m_inputQueue = Create<DelayQueueType> (m_layerDelayServers,
                                          MakeCallback (&CCNxStandardForwarder::GetServiceTime, this),
                                          MakeCallback (&CCNxStandardForwarder::ServiceInputQueue, this));
+  m_inputQueue->SetBatchSize (m_layerDelayBatchSize);
+  m_inputQueue->SetCapacity (m_inputQueueCapacity);
+  if (m_inputQueueDropPolicy == CCNxDelayQueueDropPolicy_Red)
+    {
+      m_inputQueue->SetRed (m_redMinThreshold, m_redMaxThreshold, m_redMaxProbability, m_redQueueWeight);
+      if (m_redStream >= 0)
+        {
+          m_inputQueue->AssignStreams (m_redStream);
+        }
+    }
+  m_inputQueue->SetDropCallback (MakeCallback (&CCNxStandardForwarder::InputQueueDrop, this));
+
+  // Always classify, even for Fifo, so the per-class queueing delay is available
+  m_controlPrefix = Create<CCNxName> (m_controlPrefixString);
+  std::vector<unsigned> weights (InputClassCount);
+  weights[InputClass_Control] = m_controlWeight;
+  weights[InputClass_ContentObject] = m_contentObjectWeight;
+  weights[InputClass_Interest] = m_interestWeight;
+  m_inputQueue->SetClasses (MakeCallback (&CCNxStandardForwarder::ClassifyInput, this), m_inputQueueScheduler, weights);
+}
+
+/*
+ * Content Objects are their own class because they drain PIT state.  Interests for the
+ * routing protocol are control.  Everything else is an Interest.
+ */
+unsigned
+CCNxStandardForwarder::ClassifyInput (Ptr<CCNxStandardForwarderWorkItem> item)
+{
+  Ptr<CCNxPacket> packet = item->GetPacket ();
+  switch (packet->GetFixedHeader ()->GetPacketType ())
+    {
+    case CCNxFixedHeaderType_Object:
+      return InputClass_ContentObject;
+
+    case CCNxFixedHeaderType_Interest:
+      {
+        Ptr<const CCNxName> name = packet->GetMessage ()->GetName ();
+        if (name && m_controlPrefix->IsPrefixOf (*name))
+          {
+            return InputClass_Control;
+          }
+        return InputClass_Interest;
+      }
+
+    default:
+      return InputClass_Interest;
+    }
 }
 
 Time
@@ -197,6 +344,17 @@ CCNxStandardForwarder::GetServiceTime (Ptr<CCNxStandardForwarderWorkItem> item)
   return delay;
 }
 
+/*
+ * Called when the input queue refuses a work item from RouteInput() or RouteOutput().
+ */
+void
+CCNxStandardForwarder::InputQueueDrop (Ptr<CCNxStandardForwarderWorkItem> item)
+{
+  NS_LOG_DEBUG ("Input queue drop packet=" << *item->GetPacket ());
+  m_forwarderStats.dropInputQueue++;
+  m_inputQueueDropTrace (item->GetPacket (), item->GetIngressConnection ());
+}
+
 /*
  * Called after the input queue delay from RouteInput() and RouteOutput().
  *
@@ -219,7 +377,7 @@ CCNxStandardForwarder::ServiceInputQueue (Ptr<CCNxStandardForwarderWorkItem> ite
     case CCNxFixedHeaderType_Object:
       {
 	m_forwarderStats.contentObjectsToPit++;
-	NS_LOG_DEBUG("CONTENT: sending to PIT.  name="<< *item->GetPacket()->GetMessage()->GetName());
+	NS_LOG_DEBUG("CONTENT: sending to PIT.  name="<< NameString (item->GetPacket ()));
         m_pit->SatisfyInterest (item);
         break;
       }
@@ -354,11 +512,18 @@ CCNxStandardForwarder::PitSatisfyInterestCallback (Ptr<CCNxForwarderMessage> mes
   if (egressConnections->size() ) //match!
       {
       m_forwarderStats.contentObjectsMatchedInPit++;
+      Ptr<const CCNxName> name = item->GetPacket ()->GetMessage ()->GetName ();
+      if (item->GetIngressConnection () && name)
+        {
+          // feedback to the forwarding strategy for the next hop that answered.  A nameless Content
+          // Object (matched by its hash) cannot be tied to the forwarded Interest, so it gives none.
+          m_fib->ContentReceived (name, item->GetIngressConnection ());
+        }
       if  (m_contentStore and item->GetIngressConnection())
 	{ // there is a CS and this content is not from the CS, so try to add this content
 
 	  m_forwarderStats.contentObjectsToContentStore++;
-	  NS_LOG_DEBUG ("CONTENT:name=" << *message->GetPacket()->GetMessage()->GetName() <<" matched Pit Entry  - starting add to Content Store. 1st egressConn=" << egressConnections->front()->GetConnectionId());
+	  NS_LOG_DEBUG ("CONTENT:name=" << NameString (message->GetPacket ()) <<" matched Pit Entry  - starting add to Content Store. 1st egressConn=" << egressConnections->front()->GetConnectionId());
 	  m_contentStore->AddContentObject(message,egressConnections); //will fwd packet after this, so must retain egressConnections
 	}
       else
@@ -435,7 +600,7 @@ CCNxStandardForwarder::ContentStoreAddContentObjectCallback (Ptr<CCNxForwarderMe
 {
   Ptr<CCNxStandardForwarderWorkItem> workItem = DynamicCast<CCNxStandardForwarderWorkItem, CCNxForwarderMessage> (message);
   NS_ASSERT_MSG ( (workItem), "Got null dynamic cast from CCNxForwarderMessage to CCNxStandardForwarderWorkItem");
-  NS_LOG_DEBUG ("CONTENT:name=" << *message->GetPacket()->GetMessage()->GetName() <<" returned from CS. 1st egressConn=" << workItem->GetConnectionsList()->front()->GetConnectionId());
+  NS_LOG_DEBUG ("CONTENT:name=" << NameString (message->GetPacket ()) <<" returned from CS. 1st egressConn=" << workItem->GetConnectionsList()->front()->GetConnectionId());
 
   if (workItem->GetContentAddedFlag())
     {
@@ -455,22 +620,22 @@ CCNxStandardForwarder::AddRoute (Ptr<CCNxConnection> connection, Ptr<const CCNxN
 {
   NS_LOG_FUNCTION (this);
 
-  return InnerAddRoute (connection,name);
+  return InnerAddRoute (connection, name, 0);
 
 }
 
 bool
-CCNxStandardForwarder::InnerAddRoute (Ptr<CCNxConnection> connection, Ptr<const CCNxName> name)
+CCNxStandardForwarder::InnerAddRoute (Ptr<CCNxConnection> connection, Ptr<const CCNxName> name, uint32_t cost)
 {
-  NS_LOG_FUNCTION (this << connection << name);
+  NS_LOG_FUNCTION (this << connection << name << cost);
   bool added = false;
 
   if (connection->GetConnectionId () != CCNxConnection::ConnIdLocalHost)  //dont add localhost entries to fib
     {
-      added = m_fib->AddRoute (name,  connection);
+      added = m_fib->AddRoute (name,  connection, cost);
     }
 
-  NS_LOG_WARN ( (added ? "Added" : "Didn't Add") << " nexthop connid " << connection->GetConnectionId () << " name " << *name);
+  NS_LOG_WARN ( (added ? "Added" : "Didn't Add") << " nexthop connid " << connection->GetConnectionId () << " name " << *name << " cost " << cost);
   return added;
 }
 
@@ -505,7 +670,19 @@ CCNxStandardForwarder::AddRoute (Ptr<const CCNxRoute> route)
   for (CCNxRoute::const_iterator i = route->begin (); i != route->end (); ++i)
     {
       Ptr<const CCNxRouteEntry> entry = *i;
-      success |= AddRoute (entry->GetConnection (), entry->GetPrefix ()); //TODO CCN add cost to fibEntry - currently cost is lost! ensure cost updated if entry already exists.
+
+      // A route may reach the same next hop more than once (e.g. via several anchors), so use
+      // the lowest cost.  The FIB entry keeps the cost, and updates it if the next hop is already there.
+      uint32_t cost = entry->GetCost ();
+      for (CCNxRoute::const_iterator j = route->begin (); j != route->end (); ++j)
+        {
+          if ((*j)->GetConnection ()->GetConnectionId () == entry->GetConnection ()->GetConnectionId ()
+              && (*j)->GetCost () < cost && (*j)->GetPrefix ()->Equals (*entry->GetPrefix ()))
+            {
+              cost = (*j)->GetCost ();
+            }
+        }
+      success |= InnerAddRoute (entry->GetConnection (), entry->GetPrefix (), cost);
     }
   return success;
 }
@@ -564,6 +741,23 @@ CCNxStandardForwarder::PrintForwardingTable (Ptr<OutputStreamWrapper> streamWrap
   m_fib->PrintRoutes(*stream);
 }
 
+int64_t
+CCNxStandardForwarder::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  if (m_inputQueueDropPolicy != CCNxDelayQueueDropPolicy_Red)
+    {
+      return 0;
+    }
+
+  m_redStream = stream;
+  if (m_inputQueue)
+    {
+      m_inputQueue->AssignStreams (stream);
+    }
+  return 1;
+}
+
 /*
  * Example output:
  * (time)     4 StandardForwarder Packets    In 400 Out 398 UnsupportedType 2
@@ -571,6 +765,7 @@ CCNxStandardForwarder::PrintForwardingTable (Ptr<OutputStreamWrapper> streamWrap
  * (time)     4 StandardForwarder Interests  ToCs  200 Hits 20 Misses 180
  * (time)     4 StandardForwarder Interests  ToFib 180 Forwarded 150 NotForwarded 30
  * (time)     4 StandardForwarder Content    ToPit 192 MatchedInPit 150 NotMatchedInPit 42
+ * (time)     4 StandardForwarder InputQueue Control 12 Drops 0 MeanDelay +1.0us MaxDelay +2.0us ContentObject ...
  */
 void
 CCNxStandardForwarder::PrintForwardingStatistics (Ptr<OutputStreamWrapper> streamWrapper) const
@@ -586,7 +781,23 @@ CCNxStandardForwarder::PrintForwardingStatistics (Ptr<OutputStreamWrapper> strea
   *stream << " In L2 " << m_forwarderStats.RouteInputPacketsIn;
   *stream << " In L4 " << m_forwarderStats.RouteOutputPacketsIn;
   *stream << " Out " << m_forwarderStats.packetsOut;
-  *stream << " UnsupportedType " << m_forwarderStats.dropUnsupportedPacketType << std::endl;
+  *stream << " UnsupportedType " << m_forwarderStats.dropUnsupportedPacketType;
+  *stream << " InputQueueDrops " << m_forwarderStats.dropInputQueue << std::endl;
+
+  static const char *className[InputClassCount] = { "Control", "ContentObject", "Interest" };
+  (*timePrinter)(*stream);
+  *stream << std::setw (5) << m_node->GetId () << std::setw (0) << " StandardForwarder ";
+  *stream << std::setw(10) << "InputQueue" << std::setw(0);
+  for (unsigned i = 0; i < InputClassCount; i++)
+    {
+      const DelayQueueType::ClassStats &stats = m_inputQueue->GetClassStats (i);
+      Time meanDelay = NanoSeconds (stats.served ? stats.totalDelay.GetNanoSeconds () / stats.served : 0);
+      *stream << " " << className[i] << " " << stats.served;
+      *stream << " Drops " << stats.dropped;
+      *stream << " MeanDelay " << meanDelay.As (Time::US);
+      *stream << " MaxDelay " << stats.maxDelay.As (Time::US);
+    }
+  *stream << std::endl;
 
   (*timePrinter)(*stream);
   *stream << std::setw (5) << m_node->GetId () << std::setw (0) << " StandardForwarder ";
@@ -57,7 +57,9 @@
 #define CCNS3SIM_CCNXSTANDARDFORWARDER_H
 
 #include <map>
+#include <string>
 #include "ns3/object-factory.h"
+#include "ns3/traced-callback.h"
 #include "ns3/ccnx-forwarder.h"
 
 #include "ns3/ccnx-delay-queue.h"
@@ -95,6 +97,14 @@ public:
 
   static TypeId GetTypeId ();
 
+  /**
+   * TracedCallback signature for a packet dropped by the input queue.
+   *
+   * @param [in] packet The dropped packet
+   * @param [in] ingress The connection it came from (null if from the Content Store)
+   */
+  typedef void (* InputQueueDropTracedCallback) (Ptr<const CCNxPacket> packet, Ptr<const CCNxConnection> ingress);
+
   /**
    * @copydoc CCNxForwarder::RouteOutput()
    */
@@ -137,6 +147,14 @@ public:
    */
   virtual void PrintForwardingStatistics (Ptr<OutputStreamWrapper> stream) const;
 
+  /**
+   * @copydoc CCNxForwarder::AssignStreams()
+   *
+   * The input queue's RED drop decision uses one stream when "InputQueueDropPolicy" is Red.
+   * The input queue is created in `DoInitialize()`, so the stream is kept until then.
+   */
+  virtual int64_t AssignStreams (int64_t stream);
+
   /**
    * Types of tables to count entries in
    */
@@ -166,6 +184,7 @@ private:
     size_t packetsOut;			/*!< total number of packets returned to CCNxL3Protocol */
 
     size_t dropUnsupportedPacketType;	/*!< packets dropped due to unsupported PacketType */
+    size_t dropInputQueue;		/*!< packets dropped by the input queue capacity or RED */
 
     size_t interestsToPit;		/*!< number of interest sent to PIT */
     size_t interestsVerdictForward;	/*!< Number of interests from PIT to forward */
@@ -195,10 +214,11 @@ private:
    *
    * \param connection Pointer to connection object.
    * \param name Pointer to name object.
+   * \param cost The route cost, kept in the FIB entry for the forwarding strategy.
    * \return true if route added, false otherwise
    *
    */
-  bool InnerAddRoute (Ptr<CCNxConnection> connection, Ptr<const CCNxName> name);
+  bool InnerAddRoute (Ptr<CCNxConnection> connection, Ptr<const CCNxName> name, uint32_t cost);
 
   /**
    *  common function for all RemoveRoute functions.
@@ -335,6 +355,87 @@ private:
    */
   unsigned m_layerDelayServers;
 
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1.
+   *
+   * @see CCNxDelayQueue::SetBatchSize
+   */
+  unsigned m_layerDelayBatchSize;
+
+  /**
+   * The most work items waiting in the input queue, 0 is unbounded.
+   *
+   * This value is set via the attribute "InputQueueCapacity".  The default is 0.
+   */
+  unsigned m_inputQueueCapacity;
+
+  /**
+   * Tail drop or RED on the input queue.  RED uses `m_redMinThreshold`, `m_redMaxThreshold`,
+   * `m_redMaxProbability`, and `m_redQueueWeight` (see CCNxDelayQueue::SetRed).
+   *
+   * This value is set via the attribute "InputQueueDropPolicy".  The default is TailDrop.
+   */
+  CCNxDelayQueueDropPolicy m_inputQueueDropPolicy;
+  unsigned m_redMinThreshold;
+  unsigned m_redMaxThreshold;
+  double m_redMaxProbability;
+  double m_redQueueWeight;
+
+  /**
+   * The stream from `AssignStreams()` for the RED random variable, -1 if not assigned
+   */
+  int64_t m_redStream;
+
+  /**
+   * The input queue service classes.  The order is the strict priority order.
+   */
+  enum InputClass
+  {
+    InputClass_Control = 0,     /**< Routing protocol Interests (under m_controlPrefix) */
+    InputClass_ContentObject,   /**< Content Objects, which drain PIT state */
+    InputClass_Interest,        /**< All other Interests */
+    InputClassCount
+  };
+
+  /**
+   * How the input queue picks among the classes.
+   *
+   * This value is set via the attribute "InputQueueScheduler".  The default is Fifo.
+   */
+  CCNxDelayQueueScheduler m_inputQueueScheduler;
+
+  /**
+   * The prefix of control Interests, set via the attribute "ControlPrefix".
+   * The default is "ccnx:/name=nfp".
+   */
+  std::string m_controlPrefixString;
+  Ptr<const CCNxName> m_controlPrefix;
+
+  /**
+   * Weighted round robin weights, set via the attributes "ControlWeight",
+   * "ContentObjectWeight", and "InterestWeight".  The defaults are 4, 2, and 1.
+   */
+  unsigned m_controlWeight;
+  unsigned m_contentObjectWeight;
+  unsigned m_interestWeight;
+
+  /**
+   * Callback from the input queue to get the InputClass of a work item
+   */
+  unsigned ClassifyInput (Ptr<CCNxStandardForwarderWorkItem> item);
+
+  /**
+   * Fired for each packet dropped by the input queue
+   */
+  TracedCallback<Ptr<const CCNxPacket>, Ptr<const CCNxConnection> > m_inputQueueDropTrace;
+
+  /**
+   * Callback from the input queue for a dropped work item
+   */
+  void InputQueueDrop (Ptr<CCNxStandardForwarderWorkItem> item);
+
 
   /**
    * Asynchronous callback from the Content Store after servicing a MatchInterest call.
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ccnx-standard-forwarding-strategy.h"
+#include "ccnx-standard-adaptive-strategy.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxStandardForwardingStrategy");
+
+/*
+ * A route of cost c gets weight _weightScale / (1 + c), so cost 0 has the most weight
+ * and costs up to about 2^16 still get a non-zero share.
+ */
+static const uint64_t _weightScale = 1 << 16;
+
+Ptr<CCNxStandardForwardingStrategy>
+CCNxStandardForwardingStrategy::CreateStrategy (StrategyType type)
+{
+  Ptr<CCNxStandardForwardingStrategy> strategy;
+  switch (type)
+    {
+    case Multicast:
+      strategy = Create<CCNxStandardMulticastStrategy> ();
+      break;
+
+    case BestRoute:
+      strategy = Create<CCNxStandardBestRouteStrategy> ();
+      break;
+
+    case Ecmp:
+      strategy = Create<CCNxStandardEcmpStrategy> ();
+      break;
+
+    case WeightedSplit:
+      strategy = Create<CCNxStandardWeightedSplitStrategy> ();
+      break;
+
+    case Adaptive:
+      strategy = Create<CCNxStandardAdaptiveStrategy> ();
+      break;
+
+    default:
+      NS_ASSERT_MSG (false, "Unsupported forwarding strategy " << type);
+    }
+  return strategy;
+}
+
+CCNxStandardForwardingStrategy::~CCNxStandardForwardingStrategy ()
+{
+}
+
+void
+CCNxStandardForwardingStrategy::ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress)
+{
+  // empty
+}
+
+void
+CCNxStandardForwardingStrategy::RemoveConnection (Ptr<CCNxConnection> connection)
+{
+  // empty
+}
+
+void
+CCNxStandardForwardingStrategy::SetInterestLifetime (Time lifetime)
+{
+  // empty
+}
+
+bool
+CCNxStandardForwardingStrategy::IsIngress (const CCNxStandardFibEntry::NextHop &nextHop, Ptr<CCNxConnection> ingress)
+{
+  return ingress && nextHop.connection->GetConnectionId () == ingress->GetConnectionId ();
+}
+
+uint64_t
+CCNxStandardForwardingStrategy::HashName (Ptr<const CCNxName> name)
+{
+  // splitmix64 finalizer
+  uint64_t z = name->GetHash ();
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+void
+CCNxStandardMulticastStrategy::SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                                             const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                                             Ptr<CCNxConnectionList> egress)
+{
+  for (CCNxStandardFibEntry::NextHopsVecType::const_iterator it = nextHops.begin (); it != nextHops.end (); ++it)
+    {
+      if (!IsIngress (*it, ingress))
+        {
+          egress->push_back (it->connection);
+        }
+    }
+}
+
+void
+CCNxStandardBestRouteStrategy::SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                                             const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                                             Ptr<CCNxConnectionList> egress)
+{
+  for (CCNxStandardFibEntry::NextHopsVecType::const_iterator it = nextHops.begin (); it != nextHops.end (); ++it)
+    {
+      if (!IsIngress (*it, ingress))
+        {
+          egress->push_back (it->connection);
+          return;
+        }
+    }
+}
+
+void
+CCNxStandardEcmpStrategy::SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                                        const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                                        Ptr<CCNxConnectionList> egress)
+{
+  // the next hops are in cost order, so the equal-cost set is the first run of candidates
+  CCNxStandardFibEntry::NextHopsVecType::const_iterator first = nextHops.begin ();
+  while (first != nextHops.end () && IsIngress (*first, ingress))
+    {
+      ++first;
+    }
+  if (first == nextHops.end ())
+    {
+      return;
+    }
+
+  uint64_t candidates = 0;
+  for (CCNxStandardFibEntry::NextHopsVecType::const_iterator it = first; it != nextHops.end () && it->cost == first->cost; ++it)
+    {
+      if (!IsIngress (*it, ingress))
+        {
+          candidates++;
+        }
+    }
+
+  uint64_t choice = HashName (name) % candidates;
+  for (CCNxStandardFibEntry::NextHopsVecType::const_iterator it = first; it != nextHops.end (); ++it)
+    {
+      if (!IsIngress (*it, ingress) && choice-- == 0)
+        {
+          egress->push_back (it->connection);
+          return;
+        }
+    }
+}
+
+void
+CCNxStandardWeightedSplitStrategy::SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                                                 const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                                                 Ptr<CCNxConnectionList> egress)
+{
+  uint64_t totalWeight = 0;
+  for (CCNxStandardFibEntry::NextHopsVecType::const_iterator it = nextHops.begin (); it != nextHops.end (); ++it)
+    {
+      if (!IsIngress (*it, ingress))
+        {
+          totalWeight += _weightScale / (1 + (uint64_t) it->cost);
+        }
+    }
+  if (totalWeight == 0)
+    {
+      // only the ingress, or every cost is too large to weigh: fall back to the best route
+      for (CCNxStandardFibEntry::NextHopsVecType::const_iterator it = nextHops.begin (); it != nextHops.end (); ++it)
+        {
+          if (!IsIngress (*it, ingress))
+            {
+              egress->push_back (it->connection);
+              return;
+            }
+        }
+      return;
+    }
+
+  uint64_t point = HashName (name) % totalWeight;
+  for (CCNxStandardFibEntry::NextHopsVecType::const_iterator it = nextHops.begin (); it != nextHops.end (); ++it)
+    {
+      if (!IsIngress (*it, ingress))
+        {
+          uint64_t weight = _weightScale / (1 + (uint64_t) it->cost);
+          if (point < weight)
+            {
+              egress->push_back (it->connection);
+              return;
+            }
+          point -= weight;
+        }
+    }
+}
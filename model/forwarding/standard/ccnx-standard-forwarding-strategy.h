@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_FORWARDING_STRATEGY_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_FORWARDING_STRATEGY_H_
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/ccnx-connection.h"
+#include "ns3/ccnx-connection-list.h"
+#include "ns3/ccnx-standard-fibEntry.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * The forwarding strategy of a standard FIB picks which next hops of the longest matching
+ * `CCNxStandardFibEntry` an Interest is sent to.  The FIB calls `SelectEgress()` once per
+ * lookup with the entry's next hops in ascending cost order.  The ingress connection is never
+ * selected.
+ *
+ * A strategy that measures its next hops also gets the FIB's `ContentReceived()`,
+ * `RemoveConnection()`, and `SetInterestLifetime()` calls.  The defaults do nothing.
+ *
+ * The strategy is selected by the FIB attribute "ForwardingStrategy".
+ */
+class CCNxStandardForwardingStrategy : public ns3::SimpleRefCount<CCNxStandardForwardingStrategy>
+{
+public:
+  /**
+   * The strategies available via `CreateStrategy()`
+   */
+  enum StrategyType
+  {
+    /**
+     * Every next hop (except the ingress).  This is the original behavior of the standard FIB.
+     */
+    Multicast,
+    /**
+     * The lowest cost next hop.  Ties go to the next hop added first.
+     */
+    BestRoute,
+    /**
+     * One of the lowest cost next hops, chosen by a hash of the Interest name so all
+     * Interests for a name take the same path.
+     */
+    Ecmp,
+    /**
+     * One next hop chosen by a hash of the Interest name, with weights inversely
+     * proportional to (1 + cost).  Traffic is split over all next hops, not only the best.
+     */
+    WeightedSplit,
+    /**
+     * The next hop with the best measured RTT and Interest satisfaction for the FIB prefix,
+     * with an occasional probe of the others (`CCNxStandardAdaptiveStrategy`).
+     */
+    Adaptive
+  };
+
+  /**
+   * Creates the strategy for `type`
+   */
+  static Ptr<CCNxStandardForwardingStrategy> CreateStrategy (StrategyType type);
+
+  virtual ~CCNxStandardForwardingStrategy ();
+
+  /**
+   * Append the chosen next hops to `egress`.
+   *
+   * @param name [in] The Interest name
+   * @param prefixLength [in] The number of name segments of the matching FIB prefix
+   * @param ingress [in] The connection the Interest arrived on (may be null)
+   * @param nextHops [in] The next hops of the matching FIB entry, in ascending cost order
+   * @param egress [in,out] The list to append the chosen connections to
+   */
+  virtual void SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                             const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                             Ptr<CCNxConnectionList> egress) = 0;
+
+  /**
+   * A Content Object for `name` arrived on `ingress` and satisfied the PIT.
+   */
+  virtual void ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress);
+
+  /**
+   * `connection` was removed from the FIB (e.g. it went down)
+   */
+  virtual void RemoveConnection (Ptr<CCNxConnection> connection);
+
+  /**
+   * The PIT lifetime of an Interest without a lifetime header
+   */
+  virtual void SetInterestLifetime (Time lifetime);
+
+protected:
+  /**
+   * true if `nextHop` is the ingress connection and must not be selected
+   */
+  static bool IsIngress (const CCNxStandardFibEntry::NextHop &nextHop, Ptr<CCNxConnection> ingress);
+
+  /**
+   * A well-mixed 64-bit hash of `name`, so selections do not depend on the low bits of the name digest
+   */
+  static uint64_t HashName (Ptr<const CCNxName> name);
+};
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * @see CCNxStandardForwardingStrategy::Multicast
+ */
+class CCNxStandardMulticastStrategy : public CCNxStandardForwardingStrategy
+{
+public:
+  virtual void SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                             const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                             Ptr<CCNxConnectionList> egress);
+};
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * @see CCNxStandardForwardingStrategy::BestRoute
+ */
+class CCNxStandardBestRouteStrategy : public CCNxStandardForwardingStrategy
+{
+public:
+  virtual void SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                             const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                             Ptr<CCNxConnectionList> egress);
+};
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * @see CCNxStandardForwardingStrategy::Ecmp
+ */
+class CCNxStandardEcmpStrategy : public CCNxStandardForwardingStrategy
+{
+public:
+  virtual void SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                             const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                             Ptr<CCNxConnectionList> egress);
+};
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * @see CCNxStandardForwardingStrategy::WeightedSplit
+ */
+class CCNxStandardWeightedSplitStrategy : public CCNxStandardForwardingStrategy
+{
+public:
+  virtual void SelectEgress (Ptr<const CCNxName> name, size_t prefixLength, Ptr<CCNxConnection> ingress,
+                             const CCNxStandardFibEntry::NextHopsVecType &nextHops,
+                             Ptr<CCNxConnectionList> egress);
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_FORWARDING_STRATEGY_H_ */
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ccnx-standard-hash-pit.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/integer.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxStandardHashPit");
+NS_OBJECT_ENSURE_REGISTERED (CCNxStandardHashPit);
+
+static const unsigned _defaultInitialCapacity = 1024;
+
+TypeId
+CCNxStandardHashPit::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::CCNxStandardHashPit")
+    .SetParent<CCNxStandardPit> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<CCNxStandardHashPit> ()
+    .AddAttribute ("InitialCapacity", "The initial number of slots in each PIT hash table",
+                   IntegerValue (_defaultInitialCapacity),
+                   MakeIntegerAccessor (&CCNxStandardHashPit::m_initialCapacity),
+                   MakeIntegerChecker<unsigned> (1))
+  ;
+
+  return tid;
+}
+
+CCNxStandardHashPit::CCNxStandardHashPit ()
+  : m_initialCapacity (_defaultInitialCapacity)
+{
+}
+
+CCNxStandardHashPit::~CCNxStandardHashPit ()
+{
+}
+
+void
+CCNxStandardHashPit::DoInitialize ()
+{
+  m_hashByName = HashByNameType (m_initialCapacity);
+  m_hashByNameAndKeyId = HashByNameAndKeyIdType (m_initialCapacity);
+  m_hashByHash = HashByHashType (m_initialCapacity);
+
+  CCNxStandardPit::DoInitialize ();
+}
+
+uint64_t
+CCNxStandardHashPit::DigestHashValue (Ptr<const CCNxHashValue> hash)
+{
+  uint64_t digest = 0;
+  if (hash)
+    {
+      // FNV-1a over the hash bytes
+      digest = 0xCBF29CE484222325ULL;
+      Ptr<const CCNxByteArray> value = hash->GetValue ();
+      for (size_t i = 0; i < value->size (); ++i)
+        {
+          digest ^= (*value)[i];
+          digest *= 0x00000100000001B3ULL;
+        }
+    }
+  return digest;
+}
+
+uint64_t
+CCNxStandardHashPit::DigestNameAndKeyId (Ptr<const CCNxName> name, Ptr<const CCNxHashValue> keyId)
+{
+  uint64_t digest = name->GetHash ();
+  digest ^= DigestHashValue (keyId) + 0x9E3779B97F4A7C15ULL + (digest << 6) + (digest >> 2);
+  return digest;
+}
+
+Ptr<CCNxStandardPitEntry>
+CCNxStandardHashPit::LookupPitEntryByHash (Ptr<CCNxHashValue> hashRestriction)
+{
+  Ptr<const CCNxHashValue> key = hashRestriction;
+  Ptr<CCNxStandardPitEntry> *found = m_hashByHash.Find (DigestHashValue (key), key);
+  return found ? *found : Ptr<CCNxStandardPitEntry> (0);
+}
+
+Ptr<CCNxStandardPitEntry>
+CCNxStandardHashPit::LookupPitEntryByNameAndKeyId (Ptr<const CCNxName> name, Ptr<CCNxHashValue> keyId)
+{
+  NameAndKeyIdType key = CreateNameAndKeyIdKey (name, keyId);
+  Ptr<CCNxStandardPitEntry> *found = m_hashByNameAndKeyId.Find (DigestNameAndKeyId (name, keyId), key);
+  return found ? *found : Ptr<CCNxStandardPitEntry> (0);
+}
+
+Ptr<CCNxStandardPitEntry>
+CCNxStandardHashPit::LookupPitEntryByName (Ptr<const CCNxName> name)
+{
+  Ptr<CCNxStandardPitEntry> *found = m_hashByName.Find (name->GetHash (), name);
+  return found ? *found : Ptr<CCNxStandardPitEntry> (0);
+}
+
+Ptr<CCNxStandardPitEntry>
+CCNxStandardHashPit::AddPitEntryByHash (Ptr<CCNxInterest> interest)
+{
+  Ptr<CCNxStandardPitEntry> entry = Create<CCNxStandardPitEntry> ();
+  Ptr<const CCNxHashValue> key = interest->GetHashRestriction ();
+  m_hashByHash.Insert (DigestHashValue (key), key, entry);
+  return entry;
+}
+
+Ptr<CCNxStandardPitEntry>
+CCNxStandardHashPit::AddPitEntryByName (Ptr<CCNxInterest> interest)
+{
+  Ptr<CCNxStandardPitEntry> entry = Create<CCNxStandardPitEntry> ();
+  Ptr<const CCNxName> key = interest->GetName ();
+  m_hashByName.Insert (key->GetHash (), key, entry);
+  return entry;
+}
+
+Ptr<CCNxStandardPitEntry>
+CCNxStandardHashPit::AddPitEntryByNameAndKeyId (Ptr<CCNxInterest> interest)
+{
+  Ptr<CCNxStandardPitEntry> entry = Create<CCNxStandardPitEntry> ();
+  NameAndKeyIdType key = CreateNameAndKeyIdKey (interest->GetName (), interest->GetKeyidRestriction ());
+  m_hashByNameAndKeyId.Insert (DigestNameAndKeyId (key.first, key.second), key, entry);
+  return entry;
+}
+
+void
+CCNxStandardHashPit::RemovePitEntryByHash (Ptr<CCNxHashValue> hashRestriction)
+{
+  Ptr<const CCNxHashValue> key = hashRestriction;
+  m_hashByHash.Erase (DigestHashValue (key), key);
+}
+
+void
+CCNxStandardHashPit::RemovePitEntryByNameAndKeyId (Ptr<const CCNxName> name, Ptr<CCNxHashValue> keyId)
+{
+  NameAndKeyIdType key = CreateNameAndKeyIdKey (name, keyId);
+  m_hashByNameAndKeyId.Erase (DigestNameAndKeyId (name, keyId), key);
+}
+
+void
+CCNxStandardHashPit::RemovePitEntryByName (Ptr<const CCNxName> name)
+{
+  NS_LOG_DEBUG ("RemovePitEntryByName: " << *name);
+  m_hashByName.Erase (name->GetHash (), name);
+}
+
+int
+CCNxStandardHashPit::CountEntries ()
+{
+  return m_hashByName.size () + m_hashByHash.size () + m_hashByNameAndKeyId.size ();
+}
+
+void
+CCNxStandardHashPit::Print (std::ostream &os) const
+{
+  os << "----------------------------------------m_hashByName Table----------------------------------------" << std::endl;
+
+  int i = 0;
+  for (size_t slot = 0; slot < m_hashByName.capacity (); ++slot)
+    {
+      if (m_hashByName.IsOccupied (slot))
+        {
+          os << "TableEntry[" << i++ << "] = " << *m_hashByName.GetKey (slot) << std::endl;
+          os << m_hashByName.GetValue (slot)->PrintPitEntry (os) << std::endl;
+        }
+    }
+
+  os << "------------------------------------m_hashByNameAndKeyId Table----------------------------------------" << std::endl;
+
+  i = 0;
+  for (size_t slot = 0; slot < m_hashByNameAndKeyId.capacity (); ++slot)
+    {
+      if (m_hashByNameAndKeyId.IsOccupied (slot))
+        {
+          const NameAndKeyIdType &key = m_hashByNameAndKeyId.GetKey (slot);
+          os << "TableEntry[" << i++ << "] = " << *key.first;
+          if (key.second)
+            {
+              os << ", " << *key.second->GetValue ();
+            }
+          os << std::endl;
+          os << m_hashByNameAndKeyId.GetValue (slot)->PrintPitEntry (os) << std::endl;
+        }
+    }
+
+  os << "----------------------------------------m_hashByHash Table----------------------------------------" << std::endl;
+
+  i = 0;
+  for (size_t slot = 0; slot < m_hashByHash.capacity (); ++slot)
+    {
+      if (m_hashByHash.IsOccupied (slot))
+        {
+          os << "TableEntry[" << i++ << "] = " << *m_hashByHash.GetKey (slot)->GetValue () << std::endl;
+          os << m_hashByHash.GetValue (slot)->PrintPitEntry (os) << std::endl;
+        }
+    }
+
+  os << std::endl;
+  os << std::endl;
+}
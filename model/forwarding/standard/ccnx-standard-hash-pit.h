@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_HASH_PIT_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_HASH_PIT_H_
+
+#include "ns3/ccnx-standard-pit.h"
+#include "ns3/ccnx-hash-table.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * A `CCNxStandardPit` that stores its three tables (by name, by name and keyid, and by hash)
+ * in open-addressing hash tables instead of ordered std::maps.
+ *
+ * Each table is keyed by a 64-bit digest.  The name digest is `CCNxName::GetHash()`, which is
+ * computed once and cached on the name, so an Interest and its Content Object each pay for
+ * the digest once no matter how many tables they probe.  Full name (or hash value) equality is
+ * only checked when the digests match.
+ *
+ * Interest aggregation and expiry behave exactly as in `CCNxStandardPit`.  Use
+ * `CCNxStandardHashPitFactory` as the forwarder's "PitFactory" to select it.
+ */
+class CCNxStandardHashPit : public CCNxStandardPit
+{
+public:
+  static TypeId GetTypeId (void);
+
+  CCNxStandardHashPit ();
+
+  virtual ~CCNxStandardHashPit ();
+
+  /**
+    * @copydoc CCNxPit::CountEntries()
+    */
+  virtual int CountEntries ();
+
+  /**
+    * @copydoc CCNxPit::Print()
+    */
+  virtual void Print (std::ostream &os) const;
+
+protected:
+  virtual void DoInitialize ();
+
+  virtual Ptr<CCNxStandardPitEntry> LookupPitEntryByHash (Ptr<CCNxHashValue> hashRestriction);
+  virtual Ptr<CCNxStandardPitEntry> LookupPitEntryByNameAndKeyId (Ptr<const CCNxName> name, Ptr<CCNxHashValue> keyId);
+  virtual Ptr<CCNxStandardPitEntry> LookupPitEntryByName (Ptr<const CCNxName> name);
+
+  virtual Ptr<CCNxStandardPitEntry> AddPitEntryByHash (Ptr<CCNxInterest> interest);
+  virtual Ptr<CCNxStandardPitEntry> AddPitEntryByName (Ptr<CCNxInterest> interest);
+  virtual Ptr<CCNxStandardPitEntry> AddPitEntryByNameAndKeyId (Ptr<CCNxInterest> interest);
+
+  virtual void RemovePitEntryByHash (Ptr<CCNxHashValue> hashRestriction);
+  virtual void RemovePitEntryByNameAndKeyId (Ptr<const CCNxName> name, Ptr<CCNxHashValue> keyId);
+  virtual void RemovePitEntryByName (Ptr<const CCNxName> name);
+
+private:
+  /**
+   * Digest of a hash value (used for ContentObjectHash and KeyId restrictions).
+   * A null hash value has digest 0.
+   */
+  static uint64_t DigestHashValue (Ptr<const CCNxHashValue> hash);
+
+  /**
+   * Digest of the (name, keyid) pair.
+   */
+  static uint64_t DigestNameAndKeyId (Ptr<const CCNxName> name, Ptr<const CCNxHashValue> keyId);
+
+  struct EqualsPtrCCNxName
+  {
+    bool operator() (const Ptr<const CCNxName> &a, const Ptr<const CCNxName> &b) const
+    {
+      return a->Equals (*b);
+    }
+  };
+
+  struct EqualsPtrCCNxHashValue
+  {
+    bool operator() (const Ptr<const CCNxHashValue> &a, const Ptr<const CCNxHashValue> &b) const
+    {
+      if (!a || !b)
+        {
+          return !a && !b;
+        }
+      return *a == *b;
+    }
+  };
+
+  struct EqualsNameAndKeyId
+  {
+    bool operator() (const NameAndKeyIdType &a, const NameAndKeyIdType &b) const
+    {
+      EqualsPtrCCNxHashValue hashEquals;
+      return a.first->Equals (*b.first) && hashEquals (a.second, b.second);
+    }
+  };
+
+  typedef CCNxHashTable< Ptr<const CCNxName>, Ptr<CCNxStandardPitEntry>, EqualsPtrCCNxName > HashByNameType;
+  typedef CCNxHashTable< NameAndKeyIdType, Ptr<CCNxStandardPitEntry>, EqualsNameAndKeyId > HashByNameAndKeyIdType;
+  typedef CCNxHashTable< Ptr<const CCNxHashValue>, Ptr<CCNxStandardPitEntry>, EqualsPtrCCNxHashValue > HashByHashType;
+
+  HashByNameType m_hashByName;
+  HashByNameAndKeyIdType m_hashByNameAndKeyId;
+  HashByHashType m_hashByHash;
+
+  /**
+   * The initial number of slots in each table.  Set via the attribute "InitialCapacity".
+   * The tables grow as needed; a larger value avoids rehashing early in a run.
+   */
+  unsigned m_initialCapacity;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_HASH_PIT_H_ */
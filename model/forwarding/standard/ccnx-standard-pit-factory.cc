@@ -104,3 +104,15 @@ CCNxStandardPitFactory::SetLayerDelayServers (unsigned serverCount)
 {
   Set ("LayerDelayServers", IntegerValue (serverCount));
 }
+
+void
+CCNxStandardPitFactory::SetLayerDelayBatchSize (unsigned batchSize)
+{
+  Set ("LayerDelayBatchSize", IntegerValue (batchSize));
+}
+
+void
+CCNxStandardPitFactory::SetHashDelaySlope (Time slope)
+{
+  Set ("HashDelaySlope", TimeValue (slope));
+}
@@ -122,6 +122,22 @@ public:
    * This value is set via the attribute "LayerDelayServers".  The default is 1.
    */
   void SetLayerDelayServers (unsigned serverCount);
+
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.  Larger
+   * batches use fewer events but deliver the earlier items of a batch when the last one is done.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1 (unbatched).
+   */
+  void SetLayerDelayBatchSize (unsigned batchSize);
+
+  /**
+   * The extra layer delay per message byte of hashing a Content Object, charged only when
+   * there are hash restricted Interests in the PIT.
+   *
+   * This value is set via the attribute "HashDelaySlope".  The default is 0.
+   */
+  void SetHashDelaySlope (Time slope);
 };
 
 }   /* namespace ccnx */
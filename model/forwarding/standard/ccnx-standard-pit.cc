@@ -59,6 +59,7 @@
 #include "ns3/ptr.h"
 #include "ns3/object.h"
 #include "ns3/integer.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/ccnx-interestlifetime.h"
 
 using namespace ns3;
@@ -72,6 +73,10 @@ static const Time _defaultLifetime = Seconds (0.2f);  //default interest lifetim
 static const Time _defaultLayerDelayConstant = MicroSeconds (1);
 static const Time _defaultLayerDelaySlope = NanoSeconds (1);
 static unsigned _defaultLayerDelayServers = 1;
+static unsigned _defaultLayerDelayBatchSize = 1;
+static const Time _defaultHashDelaySlope = NanoSeconds (0);
+
+static const Time _defaultExpiryGranularity = MilliSeconds (1);
 
 /**
  * Used as a default callback for m_recieveInterestCallback in case the user does not set it.
@@ -114,6 +119,22 @@ CCNxStandardPit::GetTypeId (void)
                    IntegerValue (_defaultLayerDelayServers),
                    MakeIntegerAccessor (&CCNxStandardPit::m_layerDelayServers),
                    MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("LayerDelayBatchSize", "The most items a layer delay server takes per scheduler event (1 is unbatched)",
+                   IntegerValue (_defaultLayerDelayBatchSize),
+                   MakeIntegerAccessor (&CCNxStandardPit::m_layerDelayBatchSize),
+                   MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("HashDelaySlope", "The layer delay per message byte of hashing a Content Object for a hash restricted lookup",
+                   TimeValue (_defaultHashDelaySlope),
+                   MakeTimeAccessor (&CCNxStandardPit::m_hashDelaySlope),
+                   MakeTimeChecker ())
+    .AddAttribute ("ExpiryGranularity", "The tick of the PIT entry expiry wheel",
+                   TimeValue (_defaultExpiryGranularity),
+                   MakeTimeAccessor (&CCNxStandardPit::m_expiryGranularity),
+                   MakeTimeChecker ())
+    .AddTraceSource ("ExpiredInterest",
+                     "A PIT entry expired without being satisfied.",
+                     MakeTraceSourceAccessor (&CCNxStandardPit::m_expiredInterestTrace),
+                     "ns3::ccnx::CCNxStandardPit::ExpiredInterestTracedCallback")
   ;
 
   return tid;
@@ -125,7 +146,10 @@ CCNxStandardPit::CCNxStandardPit () : m_defaultLifetime (_defaultLifetime),
   m_satisfyInterestCallback (MakeCallback (&NullSatisfyInterestCallback)),
   m_layerDelayConstant (_defaultLayerDelayConstant),
   m_layerDelaySlope (_defaultLayerDelaySlope),
-  m_layerDelayServers (_defaultLayerDelayServers)
+  m_layerDelayServers (_defaultLayerDelayServers),
+  m_layerDelayBatchSize (_defaultLayerDelayBatchSize),
+  m_hashDelaySlope (_defaultHashDelaySlope),
+  m_expiryGranularity (_defaultExpiryGranularity)
 {
   NS_LOG_DEBUG ("at end of ctor, m_defaultLifetime =" << m_defaultLifetime.As(Time::MS));
 }
@@ -140,6 +164,18 @@ CCNxStandardPit::DoInitialize ()
   m_inputQueue = Create<DelayQueueType> (m_layerDelayServers,
                                          MakeCallback (&CCNxStandardPit::GetServiceTime, this),
                                          MakeCallback (&CCNxStandardPit::ServiceInputQueue, this));
+  m_inputQueue->SetBatchSize (m_layerDelayBatchSize);
+
+  m_expiryWheel = Create<ExpiryWheelType> (m_expiryGranularity, MakeCallback (&CCNxStandardPit::ExpireEntry, this));
+}
+
+void
+CCNxStandardPit::DoDispose ()
+{
+  if (m_expiryWheel)
+    {
+      m_expiryWheel->clear ();
+    }
 }
 
 void
@@ -155,7 +191,12 @@ CCNxStandardPit::SetSatisfyInterestCallback (SatisfyInterestCallback satisfyInte
 }
 
 
-#define NOCLEANUP
+bool
+CCNxStandardPit::NeedsContentObjectHash (Ptr<CCNxForwarderMessage> item) const
+{
+  return !m_tableByHash.empty ()
+         && item->GetPacket ()->GetFixedHeader ()->GetPacketType () == CCNxFixedHeaderType_Object;
+}
 
 Time
 CCNxStandardPit::GetServiceTime (Ptr<CCNxForwarderMessage> item)
@@ -168,13 +209,18 @@ CCNxStandardPit::GetServiceTime (Ptr<CCNxForwarderMessage> item)
       size_t nameBytes = 0;
       for (int i = 0; i < name->GetSegmentCount (); ++i)
         {
-          Ptr<const CCNxNameSegment> segment = name->GetSegment (i);
-          nameBytes += segment->GetValue ().size ();
+          nameBytes += name->GetSegmentLength (i);
         }
 
       delay += m_layerDelaySlope * nameBytes;
     }
 
+  // A Content Object is only hashed if some Interest asked for a hash restriction
+  if (NeedsContentObjectHash (item))
+    {
+      delay += m_hashDelaySlope * item->GetPacket ()->GetFixedHeader ()->GetPacketLength ();
+    }
+
   return delay;
 }
 
@@ -214,9 +260,10 @@ CCNxStandardPit::CalculateInterestExpiryTime(Ptr<CCNxPacket> interestPacket)
   for (size_t i=0;i<perHopHeader->size();i++)
     {
       Ptr<CCNxPerHopHeaderEntry> entry = perHopHeader->GetHeader(i);
-      if (entry->GetInstanceTLVType() == 1) //TODO - why aren't we using an enum for TLV types?
+      if (entry->GetInstanceTLVType() == CCNxInterestLifetime::GetTLVType())
 	{
-	  Ptr<CCNxInterestLifetime> lifetime = DynamicCast<CCNxInterestLifetime,CCNxPerHopHeaderEntry >(entry);
+	  // The TLV type identifies the run time type
+	  Ptr<CCNxInterestLifetime> lifetime = StaticCast<CCNxInterestLifetime,CCNxPerHopHeaderEntry >(entry);
 	  Time expiryTime(lifetime->GetInterestLifetime()->getTime());
 	  return(expiryTime+Simulator::Now());
 	}
@@ -240,20 +287,41 @@ CCNxStandardPit::ServiceReceiveInterest (Ptr<CCNxForwarderMessage> item)
 
   Ptr<CCNxStandardPitEntry> pitEntry = LookupPitEntry(interest);
 
+  bool isNewEntry = false;
   if ( !pitEntry ) {
       pitEntry = AddPitEntry(interest);
       NS_ASSERT_MSG ( (pitEntry), "Failed to add a PIT entry");
+      isNewEntry = true;
   }
 
   Time interestExpiryTime = CalculateInterestExpiryTime(item->GetPacket());
   CCNxPit::Verdict verdict = pitEntry->ReceiveInterest(interest, item->GetIngressConnection(), interestExpiryTime);
 
-  NS_LOG_DEBUG ("at end of ReceiveInterest - name,hash pit sizes =[" << m_tableByName.size () << "," << m_tableByHash.size () << "]");
+  if (isNewEntry) {
+      // Extensions of an existing entry are picked up when its wheel record fires
+      ExpiryRecord record;
+      record.interest = interest;
+      record.entry = pitEntry;
+      m_expiryWheel->Schedule (pitEntry->GetExpiryTime (), record);
+  }
+
+  NS_LOG_DEBUG ("at end of ReceiveInterest - pit size =" << CountEntries ());
   NS_LOG_DEBUG ("and the interestExpiryTime=" << interestExpiryTime.As(Time::MS) );
 
   m_receiveInterestCallback (item, verdict);
 }
 
+/*
+ * Add the reverse routes of one PIT entry to the list, skipping any we already have
+ */
+static void
+AppendReverseRoutes (Ptr<CCNxConnectionList> list, const CCNxStandardPitEntry::ReverseRouteType &routes)
+{
+  for (CCNxStandardPitEntry::ReverseRouteType::const_iterator i = routes.begin(); i != routes.end(); ++i) {
+      list->push_back_unique (*i);
+  }
+}
+
 void
 CCNxStandardPit::ServiceSatisfyInterest (Ptr<CCNxForwarderMessage> item)
 {
@@ -268,19 +336,19 @@ CCNxStandardPit::ServiceSatisfyInterest (Ptr<CCNxForwarderMessage> item)
    * Lookup the content object in all three tables and use the union of the returned values.
    */
 
-  CCNxStandardPitEntry::ReverseRouteType reverseRouteSet;
+  // The union of the reverse routes, built straight in to the list we hand back
+  Ptr<CCNxConnectionList> satisfiedConnections = Create<CCNxConnectionList>();
 
   if (contentObject->GetName()) {
       Ptr<CCNxStandardPitEntry> entry = LookupPitEntryByName (contentObject->GetName());
       if (entry) {
-          CCNxStandardPitEntry::ReverseRouteType aSet = entry->SatisfyInterest(item->GetIngressConnection());
-          reverseRouteSet.insert (aSet.begin(), aSet.end());
+          AppendReverseRoutes (satisfiedConnections, entry->SatisfyInterest(item->GetIngressConnection()));
 
           if (entry->size() == 0) {
               RemovePitEntryByName (contentObject->GetName ());
           }
 
-	  NS_LOG_DEBUG("Content matched LookupPitEntryByName reverseRouteSet size = " << reverseRouteSet.size());
+	  NS_LOG_DEBUG("Content matched LookupPitEntryByName reverseRouteSet size = " << satisfiedConnections->size());
 
       } else {
 	  NS_LOG_DEBUG("Content object has name, but did not match LookupPitEntryByName");
@@ -290,30 +358,24 @@ CCNxStandardPit::ServiceSatisfyInterest (Ptr<CCNxForwarderMessage> item)
       // then add those to the reverseRouteSet.
   }
 
+  // Hashing reads the whole message, so skip it when no Interest is waiting on a hash
+  if (NeedsContentObjectHash (item))
   {
-    Ptr<CCNxHashValue> hash = Create<CCNxHashValue>(item->GetPacket()->GetContentObjectHash()->GetValue());
+    Ptr<CCNxHashValue> hash = item->GetPacket()->GetContentObjectHash();
     Ptr<CCNxStandardPitEntry> entry = LookupPitEntryByHash (hash);
     if (entry) {
-        CCNxStandardPitEntry::ReverseRouteType aSet = entry->SatisfyInterest(item->GetIngressConnection());
-        // because it's a set, this insert will make a union
-        reverseRouteSet.insert (aSet.begin(), aSet.end());
+        AppendReverseRoutes (satisfiedConnections, entry->SatisfyInterest(item->GetIngressConnection()));
 
         if (entry->size() == 0) {
             RemovePitEntryByHash (hash);
         }
 
-	 NS_LOG_DEBUG("Content matched LookupPitEntryByName reverseRouteSet size = " << reverseRouteSet.size());
+	 NS_LOG_DEBUG("Content matched LookupPitEntryByName reverseRouteSet size = " << satisfiedConnections->size());
     } else {
 	 NS_LOG_DEBUG("Content object did not match LookupPitEntryByHash");
     }
   }
 
-  // Now convert the Set into a ConnectionList
-  Ptr<CCNxConnectionList> satisfiedConnections = Create<CCNxConnectionList>();
-  for (CCNxStandardPitEntry::ReverseRouteType::iterator i = reverseRouteSet.begin(); i != reverseRouteSet.end(); ++i) {
-      satisfiedConnections->push_back(*i);
-  }
-
   NS_LOG_DEBUG ( __func__ << " returning conn list of size = " << satisfiedConnections->size () );
   if (satisfiedConnections->size ())
     {
@@ -489,8 +551,46 @@ CCNxStandardPit::RemovePitEntryByName(Ptr<const CCNxName> name)
 void
 CCNxStandardPit::RemoveEntry (Ptr<CCNxInterest> interest)
 {
-//TODO CCN write RemoveEntry function
+  // Mirror the table selection in AddPitEntry()
+  if (interest->HasHashRestriction ()) {
+      RemovePitEntryByHash (interest->GetHashRestriction ());
+  } else if (interest->GetName ()) {
+      RemovePitEntryByName (interest->GetName ());
+  }
+}
+
+Ptr<CCNxStandardPitEntry>
+CCNxStandardPit::LookupPitEntryAsAdded (Ptr<CCNxInterest> interest)
+{
+  Ptr<CCNxStandardPitEntry> entry = Ptr<CCNxStandardPitEntry>(0);
+
+  if (interest->HasHashRestriction ()) {
+      entry = LookupPitEntryByHash (interest->GetHashRestriction ());
+  } else if (interest->GetName ()) {
+      entry = LookupPitEntryByName (interest->GetName ());
+  }
+
+  return entry;
+}
+
+void
+CCNxStandardPit::ExpireEntry (ExpiryRecord record)
+{
+  if (LookupPitEntryAsAdded (record.interest) != record.entry) {
+      // The entry was satisfied and removed (and maybe replaced by a newer entry)
+      return;
+  }
+
+  if (!record.entry->isExpired ()) {
+      // A later Interest extended the entry
+      m_expiryWheel->Schedule (record.entry->GetExpiryTime (), record);
+      return;
+  }
+
+  NS_LOG_DEBUG ("Reclaiming expired PIT entry for " << *record.interest);
 
+  RemoveEntry (record.interest);
+  m_expiredInterestTrace (record.interest);
 }
 
 int
@@ -59,8 +59,10 @@
 #include "ns3/ccnx-pit.h"
 
 #include "ns3/nstime.h"
+#include "ns3/traced-callback.h"
 #include "ccnx-standard-pitEntry.h"
 #include "ns3/ccnx-delay-queue.h"
+#include "ns3/ccnx-timer-wheel.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -91,8 +93,11 @@ namespace ccnx {
  * - Whan an Interest arrives or is aggregated, the Lifetime for that reverse hop is extended.  As a simplification,
  *   we only keep a single lifetime not per reverse hop.
  *
- * Expiration: When an interest is added, it's expiryTime is set = Now()+InterestTimeout. This interest is discarded
- * when a related interest or contentObject is being processed  if Now > expiryTime.
+ * Expiration: When an interest is added, it's expiryTime is set = Now()+InterestTimeout.  Each new PIT entry
+ * is put in a timing wheel (CCNxTimerWheel) with a tick of "ExpiryGranularity".  When the wheel reaches the
+ * entry's expiry time, the entry is removed from its table if it is still there and has not been extended
+ * by a later Interest (in which case it is put back in the wheel at its new expiry time).  An entry removed
+ * this way was never satisfied and its Interest is passed to the "ExpiredInterest" trace source.
  *
  * There are three primary methods (see  @see Parent::Method for detailed description):
  *      ReceiveInterest, which processes a new interest and returns a verdict on whether it should be forwarded.
@@ -202,6 +207,13 @@ public:
    */
   friend std::ostream &operator<< (std::ostream& os, Ptr<CCNxStandardPit> ccnxStandardPit);
 
+  /**
+   * TracedCallback signature for a PIT entry that expired without being satisfied.
+   *
+   * @param [in] interest The Interest that created the PIT entry
+   */
+  typedef void (* ExpiredInterestTracedCallback) (Ptr<const CCNxInterest> interest);
+
 protected:
 
   /**
@@ -209,8 +221,16 @@ protected:
    */
   virtual void DoInitialize ();
 
+  /**
+   * DoDispose - called in Object Dispose()
+   */
+  virtual void DoDispose ();
 
-private:
+  /*
+   * The table access methods below are virtual so a derived PIT may replace the
+   * std::map storage (e.g. CCNxStandardHashPit) while reusing the Interest and
+   * Content Object processing of this class.
+   */
 
   /**
    * Create the key type to use in the ByNameAndKeyIdType std::map.
@@ -251,7 +271,7 @@ private:
    * @return Ptr<CCNxStandardPitEntry>(0) if not found (NULL)
    * @return Non-null if matched
    */
-  Ptr<CCNxStandardPitEntry> LookupPitEntryByHash(Ptr<CCNxHashValue> hashRestriction);
+  virtual Ptr<CCNxStandardPitEntry> LookupPitEntryByHash(Ptr<CCNxHashValue> hashRestriction);
 
   /**
    * Find the PIT entry in the name & keyid table.
@@ -260,7 +280,7 @@ private:
    * @return Ptr<CCNxStandardPitEntry>(0) if not found (NULL)
    * @return Non-null if matched
    */
-  Ptr<CCNxStandardPitEntry> LookupPitEntryByNameAndKeyId(Ptr<const CCNxName> name, Ptr<CCNxHashValue> keyId);
+  virtual Ptr<CCNxStandardPitEntry> LookupPitEntryByNameAndKeyId(Ptr<const CCNxName> name, Ptr<CCNxHashValue> keyId);
 
   /**
    * Find the PIT entry in the name table.
@@ -269,7 +289,7 @@ private:
    * @return Ptr<CCNxStandardPitEntry>(0) if not found (NULL)
    * @return Non-null if matched
    */
-  Ptr<CCNxStandardPitEntry> LookupPitEntryByName(Ptr<const CCNxName> name);
+  virtual Ptr<CCNxStandardPitEntry> LookupPitEntryByName(Ptr<const CCNxName> name);
 
   /**
    * Create a new PitEntry and save it in the appropriate tables
@@ -285,7 +305,7 @@ private:
    * @param interest [in] The interest being processed
    * @return non-null The new pitEntry saved in the Hash table
    */
-  Ptr<CCNxStandardPitEntry> AddPitEntryByHash(Ptr<CCNxInterest> interest);
+  virtual Ptr<CCNxStandardPitEntry> AddPitEntryByHash(Ptr<CCNxInterest> interest);
 
   /**
    * Create a pitEntry in the ByName table
@@ -293,7 +313,7 @@ private:
    * @param interest [in] The interest being processed
    * @return non-null The new pitEntry, which has been saved in the Name table
    */
-  Ptr<CCNxStandardPitEntry> AddPitEntryByName(Ptr<CCNxInterest> interest);
+  virtual Ptr<CCNxStandardPitEntry> AddPitEntryByName(Ptr<CCNxInterest> interest);
 
   /**
    * Create a pitEntry in the ByNameAndKeyId table
@@ -301,7 +321,7 @@ private:
    * @param interest [in] The interest being processed
    * @return non-null The new pitEntry, which has been saved in the Name table
    */
-  Ptr<CCNxStandardPitEntry> AddPitEntryByNameAndKeyId(Ptr<CCNxInterest> interest);
+  virtual Ptr<CCNxStandardPitEntry> AddPitEntryByNameAndKeyId(Ptr<CCNxInterest> interest);
 
   // === REMOVE
 
@@ -310,7 +330,7 @@ private:
    *
    * @param hashRestriction [in] The Interest to remove
    */
-  void RemovePitEntryByHash(Ptr<CCNxHashValue> hashRestriction);
+  virtual void RemovePitEntryByHash(Ptr<CCNxHashValue> hashRestriction);
 
   /**
    * Remove the PIT entry in the name and keyid table.
@@ -318,14 +338,16 @@ private:
    * @param name [in] The Interest name to remove
    * @param keyId [in] The Interest keyId to remove
    */
-  void RemovePitEntryByNameAndKeyId(Ptr<const CCNxName> name, Ptr<CCNxHashValue> keyId);
+  virtual void RemovePitEntryByNameAndKeyId(Ptr<const CCNxName> name, Ptr<CCNxHashValue> keyId);
 
   /**
    * Remove the PIT entry in the name table
    *
    * @param name [in] The Interest name to remove
    */
-  void RemovePitEntryByName(Ptr<const CCNxName> name);
+  virtual void RemovePitEntryByName(Ptr<const CCNxName> name);
+
+private:
 
   // ===
 
@@ -345,6 +367,33 @@ private:
    */
   void ServiceSatisfyInterest (Ptr<CCNxForwarderMessage> item);
 
+  /**
+   * The item we keep in the expiry wheel.  The Interest tells us which table the
+   * entry is in, the entry tells us if the table still holds the same PIT entry.
+   */
+  struct ExpiryRecord
+  {
+    Ptr<CCNxInterest> interest;
+    Ptr<CCNxStandardPitEntry> entry;
+  };
+
+  /**
+   * Callback from the expiry wheel.  If the record's entry is still in the table and
+   * is expired, remove it and fire the ExpiredInterest trace.  If it was extended,
+   * re-schedule it.
+   *
+   * @param record [in] The entry whose (original) expiry time has passed
+   */
+  void ExpireEntry (ExpiryRecord record);
+
+  /**
+   * The PIT entry for `interest` in the same table AddPitEntry() would use
+   *
+   * @param interest [in] The Interest to lookup
+   * @return Ptr<CCNxStandardPitEntry>(0) if not found (NULL)
+   */
+  Ptr<CCNxStandardPitEntry> LookupPitEntryAsAdded (Ptr<CCNxInterest> interest);
+
 
    //Map Names to PitEntrys
   PitByNameType m_tableByName;
@@ -389,6 +438,11 @@ private:
    */
   Time GetServiceTime (Ptr<CCNxForwarderMessage> item);
 
+  /**
+   * True if `item` is a Content Object and there are hash restricted entries to look it up in
+   */
+  bool NeedsContentObjectHash (Ptr<CCNxForwarderMessage> item) const;
+
   /**
    * Callback from delay queue after a work item has waited its service time
    *
@@ -421,6 +475,42 @@ private:
    * This value is set via the attribute "LayerDelayServers".  The default is 1.
    */
   unsigned m_layerDelayServers;
+
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1.
+   *
+   * @see CCNxDelayQueue::SetBatchSize
+   */
+  unsigned m_layerDelayBatchSize;
+
+  /**
+   * The extra layer delay per message byte of computing a ContentObjectHash, charged to a
+   * Content Object when there are hash restricted PIT entries to look it up in.
+   *
+   * This value is set via the attribute "HashDelaySlope".  The default is 0.
+   */
+  Time m_hashDelaySlope;
+
+  /**
+   * The tick of the expiry wheel.  An expired entry is removed at most this long after its expiry time.
+   *
+   * This value is set via the attribute "ExpiryGranularity".  The default is 1 msec.
+   */
+  Time m_expiryGranularity;
+
+  typedef CCNxTimerWheel<ExpiryRecord> ExpiryWheelType;
+
+  /**
+   * Every PIT entry is in the expiry wheel at most once
+   */
+  Ptr<ExpiryWheelType> m_expiryWheel;
+
+  /**
+   * Fired when a PIT entry is removed because it expired without being satisfied
+   */
+  TracedCallback<Ptr<const CCNxInterest> > m_expiredInterestTrace;
 };
 
 }
@@ -92,6 +92,12 @@ CCNxStandardPitEntry::isExpired() const
   return isExpired;
 }
 
+Time
+CCNxStandardPitEntry::GetExpiryTime() const
+{
+  return m_expiryTime;
+}
+
 CCNxPit::Verdict
 CCNxStandardPitEntry::ReceiveInterest (Ptr<CCNxInterest> interest, Ptr<CCNxConnection> ingress, Time expiryTime)
 {
@@ -121,7 +127,7 @@ CCNxStandardPitEntry::ReceiveInterest (Ptr<CCNxInterest> interest, Ptr<CCNxConne
    * If the reverse route set is empty, forward the interest.
    */
   if (m_reverseRoutes.size() == 0) {
-      m_reverseRoutes.insert(ingress);
+      m_reverseRoutes.push_back(ingress);
       NS_LOG_DEBUG("Forward first from reverse route ConnId " << ingress->GetConnectionId());
   } else {
       /*
@@ -133,7 +139,7 @@ CCNxStandardPitEntry::ReceiveInterest (Ptr<CCNxInterest> interest, Ptr<CCNxConne
 	   * The reverse route is not in the set.  Add it and mark it as Aggregated.
 	   */
 
-	  m_reverseRoutes.insert(ingress);
+	  m_reverseRoutes.push_back(ingress);
 	  verdict = CCNxPit::Aggregate;
 
 	  NS_LOG_DEBUG("Aggregate from reverse route ConnId " << ingress->GetConnectionId());
@@ -157,14 +163,13 @@ CCNxStandardPitEntry::SatisfyInterest (Ptr<CCNxConnection> ingress)
   if (!isExpired()) {
 
       /*
-       * Copy all the entries from m_reverseRoutes to the return variable
-       */
-      reverseRoutes.insert(m_reverseRoutes.begin(), m_reverseRoutes.end());
-
-      /*
-       * Remove the ingress
+       * Copy all the entries from m_reverseRoutes to the return variable, except the ingress
        */
-      reverseRoutes.erase(ingress);
+      for (ReverseRouteType::const_iterator i = m_reverseRoutes.begin(); i != m_reverseRoutes.end(); ++i) {
+	  if (*i != ingress) {
+	      reverseRoutes.push_back(*i);
+	  }
+      }
 
       /*
        * Clear m_reverseRoutes
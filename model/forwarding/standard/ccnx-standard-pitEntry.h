@@ -64,7 +64,7 @@
 #include "ns3/ccnx-forwarder.h"
 #include "ns3/ccnx-pit.h"
 
-#include <set>
+#include "ns3/ccnx-small-vector.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -92,9 +92,10 @@ class CCNxStandardPitEntry : public ns3::SimpleRefCount<CCNxStandardPitEntry>
 {
 public:
   /**
-   * This is a set defined on the Ptr<>.  It will be sorted by the memory address of the Ptr.
+   * The reverse routes, each connection at most once, in the order the Interests arrived.
+   * There are almost always only a few, so they are kept inline and searched linearly.
    */
-  typedef std::set< Ptr<CCNxConnection> > ReverseRouteType;
+  typedef CCNxSmallVector< Ptr<CCNxConnection>, 4 > ReverseRouteType;
 
   /**
    * When a PitEntry is created, it is expired and has no reverse routes.  You need
@@ -144,6 +145,13 @@ public:
    */
   bool isExpired() const;
 
+  /**
+   * The time at which this PitEntry expires.  It only moves forward as Interests arrive.
+   *
+   * @return The expiry time (negative if the entry has never been primed)
+   */
+  Time GetExpiryTime() const;
+
   /*
    *  Two methods to display this pit entry
    */
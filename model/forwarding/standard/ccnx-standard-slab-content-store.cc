@@ -0,0 +1,649 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/integer.h"
+#include "ns3/object.h"
+#include "ccnx-standard-slab-content-store.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxStandardSlabContentStore");
+NS_OBJECT_ENSURE_REGISTERED (CCNxStandardSlabContentStore);
+
+static const long long _defaultObjectCapacity = 10000;
+
+static const Time _defaultLayerDelayConstant = MicroSeconds (1);
+static const Time _defaultLayerDelaySlope = NanoSeconds (10);
+static unsigned _defaultLayerDelayServers = 1;
+static unsigned _defaultLayerDelayBatchSize = 1;
+
+static const size_t _minimumIndexCapacity = 16;
+
+/*
+ * The zero hash a packet carries when it has no ContentObjectHash, and the KeyId every
+ * content object is treated as having (same KEYIDHACK as CCNxStandardContentStore).
+ */
+static Ptr<const CCNxByteArray> _nullHash = Create<CCNxHashValue> (0)->GetValue ();
+static Ptr<const CCNxByteArray> _contentKeyid = Create<CCNxHashValue> (55)->GetValue ();
+
+static void
+NullMatchInterestCallback (Ptr<CCNxForwarderMessage> message)
+{
+  NS_ASSERT_MSG (false, "You must set the MatchInterest Callback via SetMatchInterestCallback()");
+}
+
+static void
+NullAddContentObjectCallback (Ptr<CCNxForwarderMessage> message )
+{
+  NS_ASSERT_MSG (false, "You must set the AddContentObject Callback via SetAddContentObjectCallback()");
+}
+
+TypeId
+CCNxStandardSlabContentStore::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ccnx::CCNxStandardSlabContentStore")
+    .SetParent<CCNxContentStore> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<CCNxStandardSlabContentStore> ()
+    .AddAttribute ("ObjectCapacity",
+                   "The maximum number of content objects to store (default = 10000)",
+                   IntegerValue (_defaultObjectCapacity),
+                   MakeIntegerAccessor (&CCNxStandardSlabContentStore::m_objectCapacity),
+                   MakeIntegerChecker<long long> ())
+    .AddAttribute ("LayerDelayConstant", "The amount of constant layer delay",
+                   TimeValue (_defaultLayerDelayConstant),
+                   MakeTimeAccessor (&CCNxStandardSlabContentStore::m_layerDelayConstant),
+                   MakeTimeChecker ())
+    .AddAttribute ("LayerDelaySlope", "The slope of the layer delay (in terms of payload bytes)",
+                   TimeValue (_defaultLayerDelaySlope),
+                   MakeTimeAccessor (&CCNxStandardSlabContentStore::m_layerDelaySlope),
+                   MakeTimeChecker ())
+    .AddAttribute ("LayerDelayServers", "The number of servers for the layer delay input queue",
+                   IntegerValue (_defaultLayerDelayServers),
+                   MakeIntegerAccessor (&CCNxStandardSlabContentStore::m_layerDelayServers),
+                   MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("LayerDelayBatchSize", "The most items a layer delay server takes per scheduler event (1 is unbatched)",
+                   IntegerValue (_defaultLayerDelayBatchSize),
+                   MakeIntegerAccessor (&CCNxStandardSlabContentStore::m_layerDelayBatchSize),
+                   MakeIntegerChecker<unsigned> ());
+  return tid;
+}
+
+CCNxStandardSlabContentStore::CCNxStandardSlabContentStore ()
+  : m_freeHead (NoSlot), m_lruHead (NoSlot), m_lruTail (NoSlot), m_objectCount (0),
+  m_objectCapacity (_defaultObjectCapacity),
+  m_matchInterestCallback (MakeCallback (&NullMatchInterestCallback)),
+  m_addContentObjectCallback (MakeCallback (&NullAddContentObjectCallback)),
+  m_layerDelayConstant (_defaultLayerDelayConstant), m_layerDelaySlope (_defaultLayerDelaySlope),
+  m_layerDelayServers (_defaultLayerDelayServers),
+  m_layerDelayBatchSize (_defaultLayerDelayBatchSize)
+{
+}
+
+CCNxStandardSlabContentStore::~CCNxStandardSlabContentStore ()
+{
+}
+
+void
+CCNxStandardSlabContentStore::DoInitialize ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_inputQueue = Create<DelayQueueType> (m_layerDelayServers,
+                                         MakeCallback (&CCNxStandardSlabContentStore::GetServiceTime, this),
+                                         MakeCallback (&CCNxStandardSlabContentStore::DequeueCallback, this));
+  m_inputQueue->SetBatchSize (m_layerDelayBatchSize);
+}
+
+void
+CCNxStandardSlabContentStore::DoDispose ()
+{
+  m_slab.clear ();
+  m_nameIndex.clear ();
+  m_hashIndex.clear ();
+  m_freeHead = m_lruHead = m_lruTail = NoSlot;
+  m_objectCount = 0;
+}
+
+void
+CCNxStandardSlabContentStore::SetMatchInterestCallback (MatchInterestCallback matchInterestCallback)
+{
+  m_matchInterestCallback = matchInterestCallback;
+}
+
+void
+CCNxStandardSlabContentStore::SetAddContentObjectCallback (AddContentObjectCallback addContentObjectCallback)
+{
+  m_addContentObjectCallback = addContentObjectCallback;
+}
+
+void
+CCNxStandardSlabContentStore::MatchInterest (Ptr<CCNxForwarderMessage> message)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<CCNxStandardForwarderWorkItem> workItem = DynamicCast<CCNxStandardForwarderWorkItem, CCNxForwarderMessage> (message);
+  NS_ASSERT_MSG (message->GetPacket ()->GetFixedHeader ()->GetPacketType () == CCNxFixedHeaderType_Interest,
+                 "Lookup given a non-Interest packet: " << *message->GetPacket ());
+
+  m_inputQueue->push_back (workItem);
+}
+
+void
+CCNxStandardSlabContentStore::AddContentObject (Ptr<CCNxForwarderMessage> message, Ptr<CCNxConnectionList> egressConnections)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<CCNxStandardForwarderWorkItem> workItem = DynamicCast<CCNxStandardForwarderWorkItem, CCNxForwarderMessage> (message);
+  NS_ASSERT_MSG (message->GetPacket ()->GetFixedHeader ()->GetPacketType () == CCNxFixedHeaderType_Object,
+                 "AddContentObject given a non-content packet: " << *message->GetPacket ());
+  workItem->SetConnectionsList (egressConnections); //will fwd packet after this, so must retain egressConnections
+  m_inputQueue->push_back (workItem);
+}
+
+Time
+CCNxStandardSlabContentStore::GetServiceTime (Ptr<CCNxStandardForwarderWorkItem> workItem)
+{
+  NS_ASSERT_MSG (workItem != 0, "Got null casting CCNxForwarderMessage to CCNxStandardForwarderWorkItem");
+  Time delay = m_layerDelayConstant;
+
+  switch (workItem->GetPacket ()->GetFixedHeader ()->GetPacketType () )
+    {
+    case CCNxFixedHeaderType_Interest:
+      if (ServiceMatchInterest (workItem))
+        {
+          delay += m_layerDelaySlope * workItem->GetContentStorePacket ()->GetMessage ()->GetPayloadSize ();
+        }
+      break;
+
+    case CCNxFixedHeaderType_Object:
+      if (ServiceAddContentObject (workItem))
+        {
+          delay += m_layerDelaySlope * workItem->GetPacket ()->GetMessage ()->GetPayloadSize ();
+        }
+      break;
+
+    default:
+      NS_ASSERT_MSG (false, "GetServiceTime got unsupported packet type: " << *workItem->GetPacket ());
+      break;
+    }
+
+  return delay;
+}
+
+void
+CCNxStandardSlabContentStore::DequeueCallback (Ptr<CCNxStandardForwarderWorkItem> workItem)
+{
+  switch (workItem->GetPacket ()->GetFixedHeader ()->GetPacketType () )
+    {
+    case CCNxFixedHeaderType_Interest:
+      m_matchInterestCallback (workItem);
+      break;
+
+    case CCNxFixedHeaderType_Object:
+      m_addContentObjectCallback (workItem);
+      break;
+
+    default:
+      NS_ASSERT_MSG (false, "DequeueCallback got unsupported packet type: " << *workItem->GetPacket ());
+      break;
+    }
+}
+
+bool
+CCNxStandardSlabContentStore::ServiceMatchInterest (Ptr<CCNxStandardForwarderWorkItem> workItem)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<CCNxInterest> interest = DynamicCast<CCNxInterest, CCNxMessage> (workItem->GetPacket ()->GetMessage ());
+
+  uint32_t slot = NoSlot;
+  Ptr<const CCNxName> name = interest->GetName ();
+  if (name && name->GetSegmentCount ())
+    {
+      slot = FindSlotByName (name);
+      if (slot != NoSlot && interest->HasHashRestriction ()
+          && *m_slab[slot].m_entry->GetPacket ()->GetContentObjectHash ()->GetValue () != *interest->GetHashRestriction ()->GetValue ())
+        {
+          slot = NoSlot;
+        }
+    }
+  else if (interest->HasHashRestriction ())
+    {
+      slot = FindSlotByHash (interest->GetHashRestriction ()->GetValue ());
+    }
+
+  if (slot != NoSlot && interest->HasKeyidRestriction ()
+      && *interest->GetKeyidRestriction ()->GetValue () != *_contentKeyid)
+    {
+      slot = NoSlot;
+    }
+
+  if (slot == NoSlot)
+    {
+      NS_LOG_INFO ("unable to find content matching interest=" << *workItem->GetPacket () << " in CS");
+      return false;
+    }
+
+  Ptr<CCNxStandardContentStoreEntry> entry = m_slab[slot].m_entry;
+  if (entry->IsExpired () || entry->IsStale ())
+    {
+      NS_LOG_INFO ("removing expired or stale content in CS matching this interest - no content returned");
+      ReleaseSlot (slot);
+      return false;
+    }
+
+  entry->IncrementUseCount ();
+  LruUnlink (slot);
+  LruPushFront (slot);
+
+  workItem->SetContentStorePacket (entry->GetPacket ());
+  NS_LOG_INFO ("found content for this interest in CS");
+  return true;
+}
+
+bool
+CCNxStandardSlabContentStore::ServiceAddContentObject (Ptr<CCNxStandardForwarderWorkItem> workItem)
+{
+  NS_LOG_FUNCTION (this);
+  bool result = false;
+  Ptr<CCNxPacket> cPacket = workItem->GetPacket ();
+
+  Ptr<const CCNxByteArray> hash = cPacket->GetContentObjectHash ()->GetValue ();
+  Ptr<const CCNxName> name = cPacket->GetMessage ()->GetName ();
+  bool hasHash = IsNonNullHash (hash);
+  bool hasName = name && name->GetSegmentCount ();
+
+  uint32_t existing = hasHash ? FindSlotByHash (hash) : (hasName ? FindSlotByName (name) : NoSlot);
+
+  if (existing != NoSlot)
+    {
+      NS_LOG_INFO ("content object already present in CS packet=" << *cPacket);
+    }
+  else if ((hasHash || hasName) && m_objectCapacity > 0)
+    {
+      if (m_objectCount >= GetObjectCapacity ())
+        {
+          ReleaseSlot (m_lruTail);
+        }
+
+      ReserveIndexes (m_objectCount + 1);
+
+      uint32_t slot = AllocateSlot ();
+      Slot &s = m_slab[slot];
+      s.m_entry = Create<CCNxStandardContentStoreEntry> (cPacket);
+      s.m_inNameIndex = hasName;
+      s.m_inHashIndex = hasHash;
+      s.m_nameTag = hasName ? MakeTag (name->GetHash ()) : 0;
+      s.m_hashTag = hasHash ? MakeTag (DigestHash (hash)) : 0;
+
+      if (hasHash)
+        {
+          IndexInsert (m_hashIndex, s.m_hashTag, slot);
+        }
+
+      if (hasName)
+        {
+          // A newer object with the same name (but a different hash) takes over the name
+          uint32_t sameName = FindSlotByName (name);
+          if (sameName != NoSlot)
+            {
+              IndexErase (m_nameIndex, m_slab[sameName].m_nameTag, sameName);
+              m_slab[sameName].m_inNameIndex = false;
+            }
+          IndexInsert (m_nameIndex, s.m_nameTag, slot);
+        }
+
+      LruPushFront (slot);
+      m_objectCount++;
+      result = true;
+    }
+
+  workItem->SetContentAddedFlag (result);
+  NS_LOG_INFO ((result ? "added" : "did not add") << " content object=" << *cPacket << " to CS");
+  return result;
+}
+
+bool
+CCNxStandardSlabContentStore::DeleteContentObject (Ptr<CCNxPacket> cPacket)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t slot = FindSlotByPacket (cPacket);
+  if (slot == NoSlot)
+    {
+      NS_LOG_ERROR ("could not find cPacket in Content Store.");
+      return false;
+    }
+
+  ReleaseSlot (slot);
+  return true;
+}
+
+Ptr<CCNxStandardContentStoreEntry>
+CCNxStandardSlabContentStore::FindEntry (Ptr<CCNxPacket> cPacket) const
+{
+  uint32_t slot = FindSlotByPacket (cPacket);
+  return slot == NoSlot ? Ptr<CCNxStandardContentStoreEntry> (0) : m_slab[slot].m_entry;
+}
+
+Ptr<CCNxStandardContentStoreEntry>
+CCNxStandardSlabContentStore::GetLruEntry () const
+{
+  return m_lruTail == NoSlot ? Ptr<CCNxStandardContentStoreEntry> (0) : m_slab[m_lruTail].m_entry;
+}
+
+size_t
+CCNxStandardSlabContentStore::GetObjectCount () const
+{
+  return m_objectCount;
+}
+
+size_t
+CCNxStandardSlabContentStore::GetObjectCapacity () const
+{
+  return m_objectCapacity;
+}
+
+size_t
+CCNxStandardSlabContentStore::GetIndexCapacity () const
+{
+  return m_nameIndex.size ();
+}
+
+// ============= SLAB AND INDEX ROUTINES
+
+uint32_t
+CCNxStandardSlabContentStore::MakeTag (uint64_t digest)
+{
+  return (uint32_t) (digest ^ (digest >> 32));
+}
+
+uint64_t
+CCNxStandardSlabContentStore::DigestHash (Ptr<const CCNxByteArray> hash)
+{
+  // FNV-1a over the hash bytes
+  uint64_t digest = 0xCBF29CE484222325ULL;
+  for (size_t i = 0; i < hash->size (); ++i)
+    {
+      digest ^= (*hash)[i];
+      digest *= 0x00000100000001B3ULL;
+    }
+  return digest;
+}
+
+bool
+CCNxStandardSlabContentStore::IsNonNullHash (Ptr<const CCNxByteArray> hash)
+{
+  return hash && *hash != *_nullHash;
+}
+
+uint32_t
+CCNxStandardSlabContentStore::FindSlotByName (Ptr<const CCNxName> name) const
+{
+  if (m_nameIndex.empty ())
+    {
+      return NoSlot;
+    }
+
+  uint32_t tag = MakeTag (name->GetHash ());
+  size_t mask = m_nameIndex.size () - 1;
+  for (size_t i = tag & mask; m_nameIndex[i].m_slot != NoSlot; i = (i + 1) & mask)
+    {
+      const Bucket &bucket = m_nameIndex[i];
+      if (bucket.m_tag == tag && m_slab[bucket.m_slot].m_entry->GetPacket ()->GetMessage ()->GetName ()->Equals (*name))
+        {
+          return bucket.m_slot;
+        }
+    }
+  return NoSlot;
+}
+
+uint32_t
+CCNxStandardSlabContentStore::FindSlotByHash (Ptr<const CCNxByteArray> hash) const
+{
+  if (m_hashIndex.empty ())
+    {
+      return NoSlot;
+    }
+
+  uint32_t tag = MakeTag (DigestHash (hash));
+  size_t mask = m_hashIndex.size () - 1;
+  for (size_t i = tag & mask; m_hashIndex[i].m_slot != NoSlot; i = (i + 1) & mask)
+    {
+      const Bucket &bucket = m_hashIndex[i];
+      if (bucket.m_tag == tag && *m_slab[bucket.m_slot].m_entry->GetPacket ()->GetContentObjectHash ()->GetValue () == *hash)
+        {
+          return bucket.m_slot;
+        }
+    }
+  return NoSlot;
+}
+
+uint32_t
+CCNxStandardSlabContentStore::FindSlotByPacket (Ptr<CCNxPacket> cPacket) const
+{
+  Ptr<const CCNxByteArray> hash = cPacket->GetContentObjectHash ()->GetValue ();
+  if (IsNonNullHash (hash))
+    {
+      return FindSlotByHash (hash);
+    }
+
+  Ptr<const CCNxName> name = cPacket->GetMessage ()->GetName ();
+  if (name && name->GetSegmentCount ())
+    {
+      return FindSlotByName (name);
+    }
+
+  return NoSlot;
+}
+
+void
+CCNxStandardSlabContentStore::IndexInsert (IndexType &index, uint32_t tag, uint32_t slot)
+{
+  size_t mask = index.size () - 1;
+  size_t i = tag & mask;
+  while (index[i].m_slot != NoSlot)
+    {
+      i = (i + 1) & mask;
+    }
+  index[i].m_tag = tag;
+  index[i].m_slot = slot;
+}
+
+void
+CCNxStandardSlabContentStore::IndexErase (IndexType &index, uint32_t tag, uint32_t slot)
+{
+  size_t mask = index.size () - 1;
+  size_t i = tag & mask;
+  while (index[i].m_slot != slot)
+    {
+      NS_ASSERT_MSG (index[i].m_slot != NoSlot, "Slot " << slot << " is not in the index");
+      i = (i + 1) & mask;
+    }
+
+  // Backward-shift the rest of the probe run so no tombstone is needed.
+  size_t j = i;
+  for (;;)
+    {
+      j = (j + 1) & mask;
+      if (index[j].m_slot == NoSlot)
+        {
+          break;
+        }
+
+      // bucket j may move to i unless its home is cyclically in (i, j]
+      size_t home = index[j].m_tag & mask;
+      bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+      if (!stays)
+        {
+          index[i] = index[j];
+          i = j;
+        }
+    }
+  index[i].m_slot = NoSlot;
+}
+
+void
+CCNxStandardSlabContentStore::ReserveIndexes (size_t objectCount)
+{
+  size_t capacity = _minimumIndexCapacity;
+  while (capacity < 2 * objectCount)
+    {
+      capacity <<= 1;
+    }
+
+  if (capacity <= m_nameIndex.size ())
+    {
+      return;
+    }
+
+  Bucket empty;
+  empty.m_tag = 0;
+  empty.m_slot = NoSlot;
+  m_nameIndex.assign (capacity, empty);
+  m_hashIndex.assign (capacity, empty);
+
+  for (uint32_t slot = m_lruHead; slot != NoSlot; slot = m_slab[slot].m_next)
+    {
+      if (m_slab[slot].m_inNameIndex)
+        {
+          IndexInsert (m_nameIndex, m_slab[slot].m_nameTag, slot);
+        }
+      if (m_slab[slot].m_inHashIndex)
+        {
+          IndexInsert (m_hashIndex, m_slab[slot].m_hashTag, slot);
+        }
+    }
+}
+
+uint32_t
+CCNxStandardSlabContentStore::AllocateSlot ()
+{
+  uint32_t slot = m_freeHead;
+  if (slot != NoSlot)
+    {
+      m_freeHead = m_slab[slot].m_next;
+    }
+  else
+    {
+      NS_ASSERT_MSG (m_slab.size () < NoSlot, "Content store slab is full");
+      slot = m_slab.size ();
+      m_slab.push_back (Slot ());
+    }
+  return slot;
+}
+
+void
+CCNxStandardSlabContentStore::ReleaseSlot (uint32_t slot)
+{
+  Slot &s = m_slab[slot];
+  if (s.m_inNameIndex)
+    {
+      IndexErase (m_nameIndex, s.m_nameTag, slot);
+    }
+  if (s.m_inHashIndex)
+    {
+      IndexErase (m_hashIndex, s.m_hashTag, slot);
+    }
+  LruUnlink (slot);
+
+  s.m_entry = 0;
+  s.m_inNameIndex = false;
+  s.m_inHashIndex = false;
+  s.m_next = m_freeHead;
+  m_freeHead = slot;
+  m_objectCount--;
+}
+
+void
+CCNxStandardSlabContentStore::LruUnlink (uint32_t slot)
+{
+  Slot &s = m_slab[slot];
+  if (s.m_prev != NoSlot)
+    {
+      m_slab[s.m_prev].m_next = s.m_next;
+    }
+  else
+    {
+      m_lruHead = s.m_next;
+    }
+
+  if (s.m_next != NoSlot)
+    {
+      m_slab[s.m_next].m_prev = s.m_prev;
+    }
+  else
+    {
+      m_lruTail = s.m_prev;
+    }
+  s.m_prev = s.m_next = NoSlot;
+}
+
+void
+CCNxStandardSlabContentStore::LruPushFront (uint32_t slot)
+{
+  Slot &s = m_slab[slot];
+  s.m_prev = NoSlot;
+  s.m_next = m_lruHead;
+  if (m_lruHead != NoSlot)
+    {
+      m_slab[m_lruHead].m_prev = slot;
+    }
+  m_lruHead = slot;
+  if (m_lruTail == NoSlot)
+    {
+      m_lruTail = slot;
+    }
+}
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_SLAB_CONTENT_STORE_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_SLAB_CONTENT_STORE_H_
+
+#include <vector>
+#include <stdint.h>
+#include "ns3/ccnx-content-store.h"
+#include "ns3/ccnx-standard-content-store-entry.h"
+#include "ns3/ccnx-standard-forwarder-work-item.h"
+#include "ns3/ccnx-delay-queue.h"
+#include "ns3/ccnx-name.h"
+#include "ns3/ccnx-hash-value.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * A content store that keeps every object in a single slab of entries and finds them
+ * through two compact hash indexes of 32-bit slot ids.
+ *
+ * `CCNxStandardContentStore` puts each object in up to four `std::map`s plus an LRU list
+ * and an LRU map.  This store has one `Slot` per object in a `std::vector`.  The LRU order
+ * is a doubly linked list threaded through the slots by slot id.  The name index and the
+ * hash index are open-addressed tables of 8-byte buckets (a 32-bit tag of the key digest
+ * and a 32-bit slot id).  A lookup probes one index, compares the tag, then compares the
+ * full key against the slot.  Insert and evict are one or two index probes and no tree
+ * rebalancing.
+ *
+ * The matching rules are the same as `CCNxStandardContentStore`:
+ * - An Interest with a name matches by name (and KeyId restriction, if present).
+ * - An Interest without a name matches by its ContentObjectHash restriction.
+ * - A Content Object is indexed by hash if it has a non-zero hash and by name if it has a name.
+ *
+ * In addition, an Interest with both a name and a hash restriction only matches an object
+ * with that hash.  If two objects have the same name, the name index points to the newer one.
+ *
+ * Select it with `CCNxStandardSlabContentStoreFactory`.  It supports the "ObjectCapacity",
+ * "LayerDelayConstant", "LayerDelaySlope", "LayerDelayServers" and "LayerDelayBatchSize"
+ * attributes of `CCNxStandardContentStore`.  It always evicts in LRU order and only bounds the
+ * object count, so it has no "ReplacementPolicy", "ByteCapacity" or "TinyLfuAdmission".  It
+ * has no expiry reaper ("ReapInterval", "ReapBatchSize"); an expired or stale object is removed
+ * when an Interest finds it or when it reaches the LRU end.
+ */
+class CCNxStandardSlabContentStore : public CCNxContentStore
+{
+public:
+  /**
+   * Returns the NS3 runtime type of the class ("ns3::ccnx::CCNxStandardSlabContentStore")
+   * @return The NS3 runtime type
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * Create a slab content store.  It is configured via the NS attribute system.
+   */
+  CCNxStandardSlabContentStore ();
+
+  /**
+   * Virtual destructor for inheritance
+   */
+  virtual ~CCNxStandardSlabContentStore ();
+
+  /**
+   * @copydoc CCNxContentStore::MatchInterest()
+   */
+  virtual void MatchInterest (Ptr<CCNxForwarderMessage> message);
+
+  /**
+   * @copydoc CCNxContentStore::SetMatchInterestCallback()
+   */
+  virtual void SetMatchInterestCallback (MatchInterestCallback matchInterestCallback);
+
+  /**
+   * @copydoc CCNxContentStore::AddContentObject()
+   */
+  virtual void AddContentObject (Ptr<CCNxForwarderMessage> message, Ptr<CCNxConnectionList> egressConnections);
+
+  /**
+   * @copydoc CCNxContentStore::SetAddContentObjectCallback()
+   */
+  virtual void SetAddContentObjectCallback (AddContentObjectCallback addContentObjectCallback);
+
+  /**
+   * Deletes the given object from the content store.  The object is found the same
+   * way as on insert (by hash if it has a non-zero hash, otherwise by name).
+   *
+   * @param cPacket The content object packet to remove
+   * @return true if removed
+   * @return false If not removed (i.e. not found)
+   */
+  virtual bool DeleteContentObject (Ptr<CCNxPacket> cPacket);
+
+  /**
+   * @copydoc CCNxStandardContentStore::GetObjectCount()
+   */
+  virtual size_t GetObjectCount () const;
+
+  /**
+   * @copydoc CCNxStandardContentStore::GetObjectCapacity()
+   */
+  virtual size_t GetObjectCapacity () const;
+
+  /**
+   * The stored entry for the content object, or null if not in the store
+   *
+   * @param cPacket [in] A content object packet
+   * @return The entry (by hash if the packet has a non-zero hash, otherwise by name)
+   */
+  Ptr<CCNxStandardContentStoreEntry> FindEntry (Ptr<CCNxPacket> cPacket) const;
+
+  /**
+   * The least recently used entry, which is the next to be evicted
+   *
+   * @return The LRU entry, or null if the store is empty
+   */
+  Ptr<CCNxStandardContentStoreEntry> GetLruEntry () const;
+
+  /**
+   * The number of buckets in each secondary index.  Exposed for unit tests.
+   */
+  size_t GetIndexCapacity () const;
+
+protected:
+  /**
+   * DoInitialize - called in Object Initialize()
+   */
+  virtual void DoInitialize ();
+
+  /**
+   * DoDispose - called in Object Dispose()
+   */
+  virtual void DoDispose ();
+
+private:
+  /**
+   * Marks the end of a slot list and an empty index bucket
+   */
+  static const uint32_t NoSlot = 0xFFFFFFFF;
+
+  /**
+   * One stored object.  `m_prev` and `m_next` link the slot into either the LRU
+   * list (most recent at the head) or the free list.
+   */
+  struct Slot
+  {
+    Ptr<CCNxStandardContentStoreEntry> m_entry;
+    uint32_t m_nameTag;
+    uint32_t m_hashTag;
+    uint32_t m_prev;
+    uint32_t m_next;
+    bool m_inNameIndex;
+    bool m_inHashIndex;
+  };
+
+  /**
+   * A secondary index bucket.  The home bucket is derived from `m_tag`, so the index
+   * can be re-organized without the original key.
+   */
+  struct Bucket
+  {
+    uint32_t m_tag;
+    uint32_t m_slot;
+  };
+
+  typedef std::vector<Bucket> IndexType;
+
+  /**
+   * Reduce a 64-bit key digest to the 32-bit tag stored in an index bucket
+   */
+  static uint32_t MakeTag (uint64_t digest);
+
+  /**
+   * The digest of a ContentObjectHash or hash restriction
+   */
+  static uint64_t DigestHash (Ptr<const CCNxByteArray> hash);
+
+  /**
+   * Is this a real hash (not the zero hash used when there is no hash)?
+   */
+  static bool IsNonNullHash (Ptr<const CCNxByteArray> hash);
+
+  /**
+   * Returns the slot of the object with this name, or NoSlot
+   */
+  uint32_t FindSlotByName (Ptr<const CCNxName> name) const;
+
+  /**
+   * Returns the slot of the object with this hash, or NoSlot
+   */
+  uint32_t FindSlotByHash (Ptr<const CCNxByteArray> hash) const;
+
+  /**
+   * Returns the slot of a content object packet (by hash if non-zero, else by name), or NoSlot
+   */
+  uint32_t FindSlotByPacket (Ptr<CCNxPacket> cPacket) const;
+
+  /**
+   * Add (tag, slot) to an index.  The index must have a free bucket.
+   */
+  void IndexInsert (IndexType &index, uint32_t tag, uint32_t slot);
+
+  /**
+   * Remove (tag, slot) from an index using backward-shift deletion (no tombstones).
+   */
+  void IndexErase (IndexType &index, uint32_t tag, uint32_t slot);
+
+  /**
+   * Size the indexes so they are at most half full for `objectCount` objects,
+   * re-inserting every stored object if they grow.
+   */
+  void ReserveIndexes (size_t objectCount);
+
+  /**
+   * Take a slot off the free list (or grow the slab)
+   */
+  uint32_t AllocateSlot ();
+
+  /**
+   * Remove a slot from all indexes and the LRU list and put it on the free list
+   */
+  void ReleaseSlot (uint32_t slot);
+
+  void LruUnlink (uint32_t slot);
+  void LruPushFront (uint32_t slot);
+
+  /**
+   * Callback from delay queue to compute the service time of a work item.
+   * The lookup is done here so the delay can depend on the result.
+   */
+  Time GetServiceTime (Ptr<CCNxStandardForwarderWorkItem> workItem);
+
+  /**
+   * Callback from delay queue after a work item has waited its service time
+   */
+  void DequeueCallback (Ptr<CCNxStandardForwarderWorkItem> workItem);
+
+  bool ServiceMatchInterest (Ptr<CCNxStandardForwarderWorkItem> workItem);
+  bool ServiceAddContentObject (Ptr<CCNxStandardForwarderWorkItem> workItem);
+
+  std::vector<Slot> m_slab;
+  uint32_t m_freeHead;
+  uint32_t m_lruHead;
+  uint32_t m_lruTail;
+  size_t m_objectCount;
+
+  IndexType m_nameIndex;
+  IndexType m_hashIndex;
+
+  /** Maxium number of content objects to store in content store */
+  long long m_objectCapacity;
+
+  MatchInterestCallback m_matchInterestCallback;
+  AddContentObjectCallback m_addContentObjectCallback;
+
+  typedef CCNxDelayQueue <CCNxStandardForwarderWorkItem> DelayQueueType;
+  Ptr<DelayQueueType> m_inputQueue;
+
+  /**
+   * The layer delay is:
+   *
+   * \f$time = m\_layerDelayConstant + m\_layerDelaySlope * payloadBytes\f$
+   */
+  Time m_layerDelayConstant;
+  Time m_layerDelaySlope;
+  unsigned m_layerDelayServers;
+
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1.
+   *
+   * @see CCNxDelayQueue::SetBatchSize
+   */
+  unsigned m_layerDelayBatchSize;
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_SLAB_CONTENT_STORE_H_ */
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#ifndef CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_TRIE_FIB_FACTORY_H_
+#define CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_TRIE_FIB_FACTORY_H_
+
+#include "ns3/object-factory.h"
+#include "ns3/nstime.h"
+#include "ns3/ccnx-standard-forwarding-strategy.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * Factory to create a `CCNxStandardTrieFib`.  Use it as the forwarder's "FibFactory":
+ *
+ * @code
+ * {
+ *   CCNxStandardTrieFibFactory fibFactory;
+ *   fibFactory.SetLayerDelaySlope (NanoSeconds (7));
+ *   forwarderHelper.SetFibFactory (fibFactory);
+ * }
+ * @endcode
+ */
+class CCNxStandardTrieFibFactory : public ns3::ObjectFactory
+{
+public:
+
+  CCNxStandardTrieFibFactory ();
+
+  virtual ~CCNxStandardTrieFibFactory ();
+
+  /**
+   * Sets the constant of the layer delay (FIB processing time)
+   *
+   * The layer delay is:
+   *
+   * \f$time = m\_layerDelayConstant + m\_layerDelaySlope * nameComponents\f$
+   *
+   * This value is set via the attribute "LayerDelayConstant".  The default is 1 micro-second.
+   */
+  void SetLayerDelayConstant (Time delay);
+
+  /**
+   * Sets the slope of the layer delay (FIB processing time)
+   *
+   * The layer delay is:
+   *
+   * \f$time = m\_layerDelayConstant + m\_layerDelaySlope * nameComponents\f$
+   *
+   * This value is set via the attribute "LayerDelaySlope".  The default is 10 nano-seconds.
+   */
+  void SetLayerDelaySlope (Time slope);
+
+  /**
+   * The number of parallel servers processing the input delay queue.
+   * The more servers there are, the lower the amortized delay is.
+   *
+   * This value is set via the attribute "LayerDelayServers".  The default is 1.
+   */
+  void SetLayerDelayServers (unsigned serverCount);
+
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.  Larger
+   * batches use fewer events but deliver the earlier items of a batch when the last one is done.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1 (unbatched).
+   */
+  void SetLayerDelayBatchSize (unsigned batchSize);
+
+  /**
+   * Selects how the next hops of the matching FIB entry are chosen for an Interest.
+   *
+   * This value is set via the attribute "ForwardingStrategy".  The default is Multicast.
+   */
+  void SetForwardingStrategy (CCNxStandardForwardingStrategy::StrategyType strategy);
+};
+
+}   /* namespace ccnx */
+} /* namespace ns3 */
+
+#endif /* CCNS3SIM_MODEL_FORWARDING_STANDARD_CCNX_STANDARD_TRIE_FIB_FACTORY_H_ */
@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <vector>
+
+#include "ccnx-standard-trie-fib.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/integer.h"
+#include "ns3/enum.h"
+#include "ns3/ccnx-standard-forwarder-work-item.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+NS_LOG_COMPONENT_DEFINE ("CCNxStandardTrieFib");
+NS_OBJECT_ENSURE_REGISTERED (CCNxStandardTrieFib);
+
+static const Time _defaultLayerDelayConstant = MicroSeconds (1);
+static const Time _defaultLayerDelaySlope = NanoSeconds (10);
+static unsigned _defaultLayerDelayServers = 1;
+static unsigned _defaultLayerDelayBatchSize = 1;
+
+/**
+ * Used as a default callback for m_LookupCallback in case the user does not set it.
+ */
+static void
+NullLookupCallback (Ptr<CCNxForwarderMessage>, Ptr<CCNxConnectionList> egressConnections)
+{
+  NS_ASSERT_MSG (false, "You must set the Lookup Callback via SetLookupCallback()");
+}
+
+TypeId
+CCNxStandardTrieFib::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ccnx::CCNxStandardTrieFib")
+    .SetParent<CCNxFib> ()
+    .SetGroupName ("CCNx")
+    .AddConstructor<CCNxStandardTrieFib> ()
+    .AddAttribute ("LayerDelayConstant", "The amount of constant layer delay",
+                   TimeValue (_defaultLayerDelayConstant),
+                   MakeTimeAccessor (&CCNxStandardTrieFib::m_layerDelayConstant),
+                   MakeTimeChecker ())
+    .AddAttribute ("LayerDelaySlope", "The slope of the layer delay (in terms of name components)",
+                   TimeValue (_defaultLayerDelaySlope),
+                   MakeTimeAccessor (&CCNxStandardTrieFib::m_layerDelaySlope),
+                   MakeTimeChecker ())
+    .AddAttribute ("LayerDelayServers", "The number of servers for the layer delay input queue",
+                   IntegerValue (_defaultLayerDelayServers),
+                   MakeIntegerAccessor (&CCNxStandardTrieFib::m_layerDelayServers),
+                   MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("LayerDelayBatchSize", "The most items a layer delay server takes per scheduler event (1 is unbatched)",
+                   IntegerValue (_defaultLayerDelayBatchSize),
+                   MakeIntegerAccessor (&CCNxStandardTrieFib::m_layerDelayBatchSize),
+                   MakeIntegerChecker<unsigned> ())
+    .AddAttribute ("ForwardingStrategy", "How the next hops of the matching entry are chosen for an Interest",
+                   EnumValue (CCNxStandardForwardingStrategy::Multicast),
+                   MakeEnumAccessor (&CCNxStandardTrieFib::SetForwardingStrategy, &CCNxStandardTrieFib::GetForwardingStrategy),
+                   MakeEnumChecker (CCNxStandardForwardingStrategy::Multicast, "Multicast",
+                                    CCNxStandardForwardingStrategy::BestRoute, "BestRoute",
+                                    CCNxStandardForwardingStrategy::Ecmp, "Ecmp",
+                                    CCNxStandardForwardingStrategy::WeightedSplit, "WeightedSplit",
+                                    CCNxStandardForwardingStrategy::Adaptive, "Adaptive"))
+  ;
+
+  return tid;
+}
+
+size_t
+CCNxStandardTrieFib::SegmentHash::operator() (const SegmentKey &key) const
+{
+  // FNV-1a, 64-bit
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  const uint64_t prime = 0x100000001b3ULL;
+
+  hash ^= (uint64_t) key.m_type;
+  hash *= prime;
+
+  for (size_t i = 0; i < key.m_length; ++i)
+    {
+      hash ^= key.m_data[i];
+      hash *= prime;
+    }
+  return (size_t) hash;
+}
+
+CCNxStandardTrieFib::CCNxStandardTrieFib ()
+  : m_root (Create<TrieNode> ()), m_entryCount (0),
+  m_LookupCallback (MakeCallback (&NullLookupCallback)),
+  m_layerDelayConstant (_defaultLayerDelayConstant), m_layerDelaySlope (_defaultLayerDelaySlope),
+  m_layerDelayServers (_defaultLayerDelayServers),
+  m_layerDelayBatchSize (_defaultLayerDelayBatchSize),
+  m_forwardingStrategyType (CCNxStandardForwardingStrategy::Multicast),
+  m_forwardingStrategy (CCNxStandardForwardingStrategy::CreateStrategy (CCNxStandardForwardingStrategy::Multicast)),
+  m_interestLifetime (Time (0))
+{
+}
+
+CCNxStandardTrieFib::~CCNxStandardTrieFib ()
+{
+}
+
+void
+CCNxStandardTrieFib::DoInitialize ()
+{
+  m_inputQueue = Create<DelayQueueType> (m_layerDelayServers,
+                                         MakeCallback (&CCNxStandardTrieFib::GetServiceTime, this),
+                                         MakeCallback (&CCNxStandardTrieFib::DequeueCallback, this));
+  m_inputQueue->SetBatchSize (m_layerDelayBatchSize);
+}
+
+void
+CCNxStandardTrieFib::DoDispose ()
+{
+  m_root = Create<TrieNode> ();
+  m_entryCount = 0;
+}
+
+void
+CCNxStandardTrieFib::SetLookupCallback (LookupCallback lookupCallback)
+{
+  m_LookupCallback = lookupCallback;
+}
+
+Ptr<CCNxStandardTrieFib::TrieNode>
+CCNxStandardTrieFib::FindNode (Ptr<const CCNxName> ccnxName) const
+{
+  Ptr<TrieNode> node = m_root;
+  for (size_t i = 0; i < ccnxName->GetSegmentCount () && node; ++i)
+    {
+      ChildMapType::const_iterator it = node->m_children.find (SegmentKey (ccnxName, i));
+      node = (it != node->m_children.end ()) ? it->second : Ptr<TrieNode> (0);
+    }
+  return node;
+}
+
+unsigned
+CCNxStandardTrieFib::PerformLookup (Ptr<CCNxStandardForwarderWorkItem> workItem)
+{
+  unsigned nameComponentsUsed = 0;
+
+  Ptr<CCNxConnectionList> egress = Create<CCNxConnectionList> ();
+  workItem->SetConnectionsList (egress);
+
+  Ptr<const CCNxName> ccnxName = workItem->GetPacket ()->GetMessage ()->GetName ();
+  Ptr<CCNxConnection> ingress = workItem->GetIngressConnection ();
+
+  NS_LOG_INFO ( __func__ << " fib size =" << m_entryCount);
+
+  // Walk down the trie one segment at a time, remembering the deepest node that is a route.
+  // Each probe is one hashed name component, even if it misses.
+  TrieNode *node = PeekPointer (m_root);
+  TrieNode *bestMatch = node->m_entry ? node : 0;
+  size_t bestMatchLength = 0;
+  const size_t segmentCount = ccnxName->GetSegmentCount ();
+  for (size_t i = 0; i < segmentCount; ++i)
+    {
+      nameComponentsUsed++;
+      ChildMapType::const_iterator it = node->m_children.find (SegmentKey (ccnxName, i));
+      if (it == node->m_children.end ())
+        {
+          break;
+        }
+
+      node = PeekPointer (it->second);
+      if (node->m_entry)
+        {
+          bestMatch = node;
+          bestMatchLength = i + 1;
+        }
+    }
+
+  if (!bestMatch)
+    {
+      NS_LOG_INFO ( __func__ << " No fib match!");
+    }
+  else         //the forwarding strategy picks the egress connections, never the ingress connection
+    {
+      m_forwardingStrategy->SelectEgress (ccnxName, bestMatchLength, ingress, bestMatch->m_entry->GetNextHops (), egress);
+    }
+
+  NS_LOG_DEBUG ("Lookup match count: " << egress->size () << " components " << nameComponentsUsed);
+  return nameComponentsUsed;
+}
+
+Time
+CCNxStandardTrieFib::GetServiceTime (Ptr<CCNxForwarderMessage> message)
+{
+  Time delay = m_layerDelayConstant;
+
+  Ptr<CCNxStandardForwarderWorkItem> workitem = DynamicCast<CCNxStandardForwarderWorkItem, CCNxForwarderMessage> (message);
+  NS_ASSERT_MSG ( (workitem), "Got null casting CCNxForwarderMessage to CCNxStandardForwarderWorkItem");
+
+  unsigned nameComponentsUsed = PerformLookup (workitem);
+  delay += nameComponentsUsed * m_layerDelaySlope;
+
+  return delay;
+}
+
+void
+CCNxStandardTrieFib::DequeueCallback (Ptr<CCNxForwarderMessage> message)
+{
+  // The lookup was done in GetServiceTime(), so just return the saved result.
+  Ptr<CCNxStandardForwarderWorkItem> workItem = DynamicCast<CCNxStandardForwarderWorkItem, CCNxForwarderMessage> (message);
+
+  m_LookupCallback (message, workItem->GetConnectionsList () );
+}
+
+void
+CCNxStandardTrieFib::Lookup (Ptr<CCNxForwarderMessage> message)
+{
+  NS_ASSERT_MSG (message->GetPacket ()->GetFixedHeader ()->GetPacketType () == CCNxFixedHeaderType_Interest,
+                 "Lookup given a non-Interest packet: " << *message->GetPacket ());
+
+  m_inputQueue->push_back (message);
+}
+
+bool
+CCNxStandardTrieFib::AddRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection, uint32_t cost)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<TrieNode> node = m_root;
+  for (size_t i = 0; i < ccnxName->GetSegmentCount (); ++i)
+    {
+      SegmentKey key (ccnxName, i);
+      ChildMapType::iterator it = node->m_children.find (key);
+      if (it == node->m_children.end ())
+        {
+          // The stored key points into ccnxName, which the new child keeps alive
+          Ptr<TrieNode> child = Create<TrieNode> ();
+          child->m_keyName = ccnxName;
+          it = node->m_children.insert (std::make_pair (key, child)).first;
+        }
+      node = it->second;
+    }
+
+  if (!node->m_entry)
+    {
+      NS_LOG_DEBUG ( __func__ << " adding new route[" << *ccnxName << "] = [" << connection->GetConnectionId () << "]");
+      node->m_entry = Create<CCNxStandardFibEntry> ();
+      node->m_name = ccnxName;
+      m_entryCount++;
+    }
+
+  node->m_entry->AddConnection (connection, cost);
+  m_connectionIndex[connection->GetConnectionId ()][PeekPointer (node->m_entry)] = node->m_name;
+  return true;
+}
+
+void
+CCNxStandardTrieFib::EraseEntry (Ptr<const CCNxName> ccnxName)
+{
+  // Remember the path so we can prune from the leaf back towards the root
+  std::vector< Ptr<TrieNode> > path;
+  path.reserve (ccnxName->GetSegmentCount () + 1);
+
+  Ptr<TrieNode> node = m_root;
+  path.push_back (node);
+  for (size_t i = 0; i < ccnxName->GetSegmentCount (); ++i)
+    {
+      node = node->m_children.find (SegmentKey (ccnxName, i))->second;
+      path.push_back (node);
+    }
+
+  node->m_entry = 0;
+  node->m_name = 0;
+  m_entryCount--;
+
+  for (size_t depth = ccnxName->GetSegmentCount (); depth > 0; --depth)
+    {
+      Ptr<TrieNode> child = path[depth];
+      if (child->m_entry || !child->m_children.empty ())
+        {
+          break;
+        }
+      path[depth - 1]->m_children.erase (SegmentKey (ccnxName, depth - 1));
+    }
+}
+
+bool
+CCNxStandardTrieFib::DeleteRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection)
+{
+  Ptr<TrieNode> node = FindNode (ccnxName);
+
+  if (node && node->m_entry)
+    {
+      std::pair <bool,int > rvPair = node->m_entry->RemoveConnection (connection);
+      if (rvPair.first)
+        {
+          UnindexConnection (connection->GetConnectionId (), PeekPointer (node->m_entry));
+        }
+      if (rvPair.second == 0)
+        {
+          EraseEntry (ccnxName);
+        }
+      NS_LOG_INFO ( __func__ << " successful.");
+      return rvPair.first;
+    }
+  else
+    {
+      NS_LOG_INFO ( __func__ << " unsuccessful. no such route.");
+      return false;
+    }
+}
+
+void
+CCNxStandardTrieFib::UnindexConnection (CCNxConnection::ConnIdType connectionId, CCNxStandardFibEntry *entry)
+{
+  ConnectionIndexType::iterator index = m_connectionIndex.find (connectionId);
+  if (index != m_connectionIndex.end ())
+    {
+      index->second.erase (entry);
+      if (index->second.empty ())
+        {
+          m_connectionIndex.erase (index);
+        }
+    }
+}
+
+bool
+CCNxStandardTrieFib::RemoveConnection (Ptr<CCNxConnection>  connection)
+{
+  m_forwardingStrategy->RemoveConnection (connection);
+
+  ConnectionIndexType::iterator index = m_connectionIndex.find (connection->GetConnectionId ());
+  if (index == m_connectionIndex.end ())
+    {
+      NS_LOG_INFO ( __func__ << " no routes use connection " << connection->GetConnectionId ());
+      return true;
+    }
+
+  EntrySetType entries;
+  entries.swap (index->second);
+  m_connectionIndex.erase (index);
+
+  for (EntrySetType::iterator it = entries.begin (); it != entries.end (); ++it)
+    {
+      std::pair<bool,int> rvPair = it->first->RemoveConnection (connection);
+      if (rvPair.second == 0)
+        {
+          EraseEntry (it->second);
+        }
+    }
+
+  NS_LOG_INFO ( __func__ << " successful, " << entries.size () << " routes.");
+  return true;
+}
+
+size_t
+CCNxStandardTrieFib::CountConnectionEntries (Ptr<const CCNxConnection> connection) const
+{
+  ConnectionIndexType::const_iterator index = m_connectionIndex.find (connection->GetConnectionId ());
+  return (index == m_connectionIndex.end ()) ? 0 : index->second.size ();
+}
+
+void
+CCNxStandardTrieFib::SetForwardingStrategy (CCNxStandardForwardingStrategy::StrategyType strategy)
+{
+  NS_LOG_FUNCTION (this << strategy);
+  m_forwardingStrategyType = strategy;
+  m_forwardingStrategy = CCNxStandardForwardingStrategy::CreateStrategy (strategy);
+  if (m_interestLifetime.IsStrictlyPositive ())
+    {
+      m_forwardingStrategy->SetInterestLifetime (m_interestLifetime);
+    }
+}
+
+CCNxStandardForwardingStrategy::StrategyType
+CCNxStandardTrieFib::GetForwardingStrategy () const
+{
+  return m_forwardingStrategyType;
+}
+
+void
+CCNxStandardTrieFib::ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress)
+{
+  m_forwardingStrategy->ContentReceived (name, ingress);
+}
+
+void
+CCNxStandardTrieFib::SetInterestLifetime (Time lifetime)
+{
+  NS_LOG_FUNCTION (this << lifetime);
+  m_interestLifetime = lifetime;
+  m_forwardingStrategy->SetInterestLifetime (lifetime);
+}
+
+int
+CCNxStandardTrieFib::CountEntries ()
+{
+  return m_entryCount;
+}
+
+void
+CCNxStandardTrieFib::PrintSubtree (std::ostream & os, Ptr<TrieNode> node)
+{
+  if (node->m_entry)
+    {
+      os << "Key = " << *node->m_name;
+      os << " Value =" << *node->m_entry;
+      os << std::endl;
+    }
+
+  for (ChildMapType::iterator it = node->m_children.begin (); it != node->m_children.end (); ++it)
+    {
+      PrintSubtree (os, it->second);
+    }
+}
+
+std::ostream&
+CCNxStandardTrieFib::PrintRoutes (std::ostream & os)
+{
+  os << __func__ << "--------------------Routing Table--------------------" << std::endl;
+  os <<  "Fib Entry Count =" << CountEntries () << std::endl;
+  PrintSubtree (os, m_root);
+  os << this << "----------------End of Routing Table-----------------" << std::endl;
+  return os;
+}
+
+std::ostream&
+CCNxStandardTrieFib::PrintRoute (std::ostream & os, Ptr<const CCNxName> ccnxName)
+{
+  Ptr<TrieNode> node = FindNode (ccnxName);
+  if (node && node->m_entry)
+    {
+      os << "Key = " << *ccnxName;
+      os << " Value =" << *node->m_entry;
+      os << std::endl;
+    }
+  return os;
+}
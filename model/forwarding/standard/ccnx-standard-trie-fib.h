@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+
+#ifndef CCNS3SIM_CCNXSTANDARDTRIEFIB_H
+#define CCNS3SIM_CCNXSTANDARDTRIEFIB_H
+
+#include <map>
+#include <unordered_map>
+#include <string.h>
+
+#include "ns3/ccnx-fib.h"
+#include "ns3/ccnx-forwarder.h"
+#include "ns3/ccnx-standard-fibEntry.h"
+#include "ns3/ccnx-standard-forwarding-strategy.h"
+#include "ns3/ccnx-delay-queue.h"
+#include "ns3/ccnx-standard-forwarder-work-item.h"
+
+namespace ns3 {
+namespace ccnx {
+
+/**
+ * @ingroup ccnx-standard-forwarder
+ *
+ * A FIB organized as a hashed name-component trie.  It is a drop-in replacement for
+ * `CCNxStandardFib` and is selected via the forwarder's "FibFactory" attribute using
+ * `CCNxStandardTrieFibFactory`.
+ *
+ * Each trie node corresponds to one name prefix and holds an unordered_map from the
+ * next name segment to the child node.  A node only carries a `CCNxStandardFibEntry`
+ * if that exact prefix was added as a route; intermediate nodes exist only to reach
+ * longer prefixes and are pruned when their last route is deleted.
+ *
+ * A lookup walks the Interest name once from the root, doing one hash probe per
+ * name segment, and remembers the deepest node with a FIB entry (true longest
+ * prefix match).  It does not build any intermediate names, so there is no
+ * allocation on the lookup path.  The number of segments probed is returned as
+ * the `nameComponentsUsed`, so the "LayerDelaySlope" is charged per component.
+ */
+class CCNxStandardTrieFib : public CCNxFib
+{
+public:
+  CCNxStandardTrieFib ();
+
+  virtual ~CCNxStandardTrieFib ();
+
+  /**
+   *  Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  //! @copydoc CCNxFib::RemoveConnection(Ptr<CCNxConnection>)
+  virtual bool RemoveConnection (Ptr<CCNxConnection>  connection);
+
+  //! @copydoc CCNxFib::Lookup
+  virtual void Lookup (Ptr<CCNxForwarderMessage> message);
+
+  //! @copydoc CCNxFib::SetLookupCallback()
+  virtual void SetLookupCallback (LookupCallback lookupCallback);
+
+  //! @copydoc CCNxFib::AddRoute()
+  virtual bool AddRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection, uint32_t cost = 0);
+
+  //! @copydoc CCNxFib::DeleteRoute()
+  virtual bool DeleteRoute (Ptr<const CCNxName> ccnxName,  Ptr<CCNxConnection>  connection);
+
+  //! @copydoc CCNxFib::PrintRoutes()
+  virtual std::ostream & PrintRoutes (std::ostream & os);
+
+  //! @copydoc CCNxFib::PrintRoute()
+  virtual std::ostream & PrintRoute (std::ostream & os, Ptr<const CCNxName> ccnxName);
+
+  /**
+   *  Count total number of entries in fib.
+   */
+  virtual int CountEntries ();
+
+  /**
+   * The number of FIB entries that route to `connection`
+   */
+  size_t CountConnectionEntries (Ptr<const CCNxConnection> connection) const;
+
+  /**
+   * Selects how the next hops of the matching entry are chosen for an Interest.
+   *
+   * This value is set via the attribute "ForwardingStrategy".  The default is Multicast.
+   */
+  void SetForwardingStrategy (CCNxStandardForwardingStrategy::StrategyType strategy);
+
+  CCNxStandardForwardingStrategy::StrategyType GetForwardingStrategy () const;
+
+  //! @copydoc CCNxFib::ContentReceived(Ptr<const CCNxName>, Ptr<CCNxConnection>)
+  virtual void ContentReceived (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress);
+
+  //! @copydoc CCNxFib::SetInterestLifetime(Time)
+  virtual void SetInterestLifetime (Time lifetime);
+
+protected:
+  // ns3::Object::DoInitialize()
+  void DoInitialize ();
+
+  // ns3::Object::DoDispose()
+  void DoDispose ();
+
+private:
+  /**
+   * A trie child key: the type, length and value of one name segment.  It does not own the
+   * value bytes, it points into the segment buffer of a CCNxName (see `CCNxName::GetSegmentData()`).
+   * A key stored in a child map points into the name kept in that child's `m_keyName`, so a
+   * lookup key can be built straight from the Interest name without creating a CCNxNameSegment.
+   */
+  struct SegmentKey
+  {
+    SegmentKey (Ptr<const CCNxName> name, size_t index)
+      : m_type (name->GetSegmentType (index)),
+      m_length (name->GetSegmentLength (index)),
+      m_data (name->GetSegmentData (index))
+    {
+    }
+
+    CCNxNameSegmentType m_type;
+    size_t m_length;
+    const uint8_t *m_data;
+  };
+
+  /**
+   * Hash of a segment key used by the child map.  It is FNV-1a over the segment type
+   * followed by the value bytes.
+   */
+  struct SegmentHash
+  {
+    size_t operator() (const SegmentKey &key) const;
+  };
+
+  /**
+   * Equality of two segment keys (same type and same value).
+   */
+  struct SegmentEqual
+  {
+    bool operator() (const SegmentKey &a, const SegmentKey &b) const
+    {
+      return a.m_type == b.m_type && a.m_length == b.m_length
+             && (a.m_length == 0 || memcmp (a.m_data, b.m_data, a.m_length) == 0);
+    }
+  };
+
+  class TrieNode;
+
+  /**
+   * Children of a trie node, keyed by the next name segment.
+   */
+  typedef std::unordered_map< SegmentKey, Ptr<TrieNode>, SegmentHash, SegmentEqual > ChildMapType;
+
+  /**
+   * One node in the trie.  `m_name` and `m_entry` are only set if this node is a route.
+   * `m_keyName` is the name the node was created from; it keeps alive the bytes of this
+   * node's key in its parent's `m_children`.
+   */
+  class TrieNode : public SimpleRefCount<TrieNode>
+  {
+public:
+    ChildMapType m_children;
+    Ptr<const CCNxName> m_keyName;
+    Ptr<const CCNxName> m_name;
+    Ptr<CCNxStandardFibEntry> m_entry;
+  };
+
+  /**
+   * Returns the node for the exact name, or null if the trie has no such node.
+   */
+  Ptr<TrieNode> FindNode (Ptr<const CCNxName> ccnxName) const;
+
+  /**
+   * Removes the FIB entry from the node at `ccnxName` and prunes any nodes on the path
+   * that no longer lead to a route.
+   */
+  void EraseEntry (Ptr<const CCNxName> ccnxName);
+
+  /**
+   * Remove `entry` from the reverse index of `connectionId`
+   */
+  void UnindexConnection (CCNxConnection::ConnIdType connectionId, CCNxStandardFibEntry *entry);
+
+  /**
+   * Depth-first walk used by `PrintRoutes()`
+   */
+  void PrintSubtree (std::ostream & os, Ptr<TrieNode> node);
+
+  /**
+   * Perform the actual route lookup.
+   *
+   * This is called within the `GetServiceTime()` function.  It returns the number of
+   * name components that we had to process.
+   *
+   * Side effect: The result of the FIB lookup will be put in the CCNxStandardForwarderWorkItem's egressConnections.
+   *
+   * @param workItem [in] The forwarder message to lookup in the FIB (must be CCNxInterest)
+   * @return The number of name components processed.
+   */
+  unsigned PerformLookup (Ptr<CCNxStandardForwarderWorkItem> workItem);
+
+  /**
+   * The root of the trie, which represents the zero-length name.
+   */
+  Ptr<TrieNode> m_root;
+
+  /**
+   * The number of trie nodes that carry a FIB entry
+   */
+  int m_entryCount;
+
+  /**
+   * The entries that route to one connection, with the name of each entry's trie node.
+   */
+  typedef std::map< CCNxStandardFibEntry *, Ptr<const CCNxName> > EntrySetType;
+
+  typedef std::map< CCNxConnection::ConnIdType, EntrySetType > ConnectionIndexType;
+
+  /**
+   * Reverse index from a connection to the entries that use it, kept in step with `AddRoute()`,
+   * `DeleteRoute()`, and `RemoveConnection()`, so removing a connection only touches its own routes.
+   */
+  ConnectionIndexType m_connectionIndex;
+
+  /**
+   * Set by the forwarder as the callback for Lookup
+   */
+  LookupCallback m_LookupCallback;
+
+  /**
+   * The storage type of the CCNxDelayQueue
+   */
+  typedef CCNxDelayQueue<CCNxForwarderMessage> DelayQueueType;
+
+  /**
+   * Input queue used to simulate processing delay
+   */
+  Ptr<DelayQueueType> m_inputQueue;
+
+  /**
+   * Callback from delay queue to compute the service time of a work item
+   *
+   * @param item [in] The work item being serviced
+   * @return The service time of the work item
+   */
+  Time GetServiceTime (Ptr<CCNxForwarderMessage> item);
+
+  /**
+   * Callback from delay queue after a work item has waited its service time
+   *
+   * @param item [in] The work item to service
+   */
+  void DequeueCallback (Ptr<CCNxForwarderMessage> item);
+
+  /**
+   * The layer delay is a linear function of the number of name components looked up.
+   *
+   * \f$time = m\_layerDelayConstant + m\_layerDelaySlope * nameComponents\f$
+   *
+   * It is set via the attribute "LayerDelayConstant".  The default is 1 usec.
+   */
+  Time m_layerDelayConstant;
+
+  /**
+   * The layer delay is a linear function of the number of name components looked up.
+   *
+   * \f$time = m\_layerDelayConstant + m\_layerDelaySlope * nameComponents\f$
+   *
+   * It is set via the attribute "LayerDelaySlope".  The default is 10 nsec.
+   */
+  Time m_layerDelaySlope;
+
+  /**
+   * The number of parallel servers processing the input delay queue.
+   * The more servers there are, the lower the amortized delay is.
+   *
+   * This value is set via the attribute "LayerDelayServers".  The default is 1.
+   */
+  unsigned m_layerDelayServers;
+
+  /**
+   * The most items a server of the input delay queue takes per scheduler event.
+   *
+   * This value is set via the attribute "LayerDelayBatchSize".  The default is 1.
+   *
+   * @see CCNxDelayQueue::SetBatchSize
+   */
+  unsigned m_layerDelayBatchSize;
+
+  /**
+   * The strategy type, set via the attribute "ForwardingStrategy"
+   */
+  CCNxStandardForwardingStrategy::StrategyType m_forwardingStrategyType;
+
+  /**
+   * Picks the egress connections from the matching entry's next hops
+   */
+  Ptr<CCNxStandardForwardingStrategy> m_forwardingStrategy;
+
+  /**
+   * From `SetInterestLifetime()`, given to each new strategy.  Zero until set.
+   */
+  Time m_interestLifetime;
+};
+
+}    //namespace
+} //namespace
+
+#endif //CCNS3SIM_CCNXSTANDARDTRIEFIB_H
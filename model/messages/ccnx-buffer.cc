@@ -54,11 +54,67 @@
  */
 
 
+#include "ns3/header.h"
 #include "ccnx-buffer.h"
 
 using namespace ns3;
 using namespace ns3::ccnx;
 
+namespace {
+
+/**
+ * A Header that reads every byte it is given in to a Buffer.  Packet::PeekHeader() hands it an
+ * iterator over the packet's own buffer, so the bytes are copied once without a scratch array.
+ */
+class CCNxBufferPacketReader : public Header
+{
+public:
+  CCNxBufferPacketReader (Buffer &output, uint32_t length) : m_output (output), m_length (length)
+  {
+  }
+
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::ccnx::CCNxBufferPacketReader")
+      .SetParent<Header> ()
+      .SetGroupName ("CCNx");
+    return tid;
+  }
+
+  virtual TypeId GetInstanceTypeId (void) const
+  {
+    return GetTypeId ();
+  }
+
+  virtual uint32_t GetSerializedSize (void) const
+  {
+    return m_length;
+  }
+
+  virtual void Serialize (Buffer::Iterator start) const
+  {
+    NS_ASSERT_MSG (false, "CCNxBufferPacketReader only reads");
+  }
+
+  virtual uint32_t Deserialize (Buffer::Iterator start)
+  {
+    m_output.AddAtStart (m_length);
+    start.Read (m_output.Begin (), m_length);
+    return m_length;
+  }
+
+  virtual void Print (std::ostream &os) const
+  {
+    os << "CCNxBuffer " << m_length << " bytes";
+  }
+
+private:
+  Buffer &m_output;
+  uint32_t m_length;
+};
+
+} // namespace
+
 
 CCNxBuffer::CCNxBuffer (size_t length)
 {
@@ -79,11 +135,25 @@ CCNxBuffer::CCNxBuffer (size_t length, const char *data)
   i.Write ((uint8_t *)data, length);
 }
 
-CCNxBuffer::CCNxBuffer (Buffer &data)
+CCNxBuffer::CCNxBuffer (const Buffer &data)
 {
   m_data = data;
 }
 
+CCNxBuffer::CCNxBuffer (Ptr<const Packet> packet)
+{
+  m_data = Buffer (0);
+  CCNxBufferPacketReader reader (m_data, packet->GetSize ());
+  packet->PeekHeader (reader);
+}
+
+Ptr<CCNxBuffer>
+CCNxBuffer::CreateFragment (size_t start, size_t length) const
+{
+  NS_ASSERT_MSG (start + length <= GetSize (), "Fragment goes beyond end of buffer");
+  return Create<CCNxBuffer> (m_data.CreateFragment ((uint32_t) start, (uint32_t) length));
+}
+
 /**
  * Allocate length bytes at the start of the buffer
  */
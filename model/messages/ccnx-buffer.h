@@ -59,6 +59,7 @@
 
 #include "ns3/simple-ref-count.h"
 #include "ns3/buffer.h"
+#include "ns3/packet.h"
 #include "ns3/ptr.h"
 
 namespace ns3 {
@@ -69,6 +70,10 @@ namespace ccnx {
  *
  * Similar signatures to ns3::Buffer, but inherits from SimpleRefCount so we can
  * pass it around with a Ptr.
+ *
+ * The bytes live in an ns3::Buffer, which is reference counted and copy-on-write.  A CCNxBuffer
+ * made from another Buffer or with CreateFragment() shares the same memory, so large payloads can
+ * be handed around without copying.  Shared bytes must not be modified through Begin().
  */
 class CCNxBuffer : public SimpleRefCount<CCNxBuffer>
 {
@@ -89,9 +94,20 @@ public:
   CCNxBuffer (size_t length, const char *data);
 
   /**
-   * Initialize CCNxBuffer with given data
+   * Initialize CCNxBuffer with given data.  The storage is shared with `data`, not copied.
+   */
+  CCNxBuffer (const Buffer &data);
+
+  /**
+   * Initialize CCNxBuffer with the bytes of an ns3::Packet.  The bytes are copied once,
+   * straight from the packet's buffer.
+   */
+  CCNxBuffer (Ptr<const Packet> packet);
+
+  /**
+   * Returns a CCNxBuffer of `length` bytes starting at `start` that shares this buffer's storage.
    */
-  CCNxBuffer (Buffer &data);
+  Ptr<CCNxBuffer> CreateFragment (size_t start, size_t length) const;
 
   /**
    * Allocate length bytes at the start of the buffer
@@ -83,13 +83,9 @@ static const char * hexStrings[] = {
   "f0", "f1", "f2", "f3", "f4", "f5", "f6", "f7", "f8", "f9", "fa", "fb", "fc", "fd", "fe", "ff",
 };
 
-CCNxByteArray::CCNxByteArray (size_t length, const uint8_t *bytes)
+CCNxByteArray::CCNxByteArray (size_t length, const uint8_t *bytes) : m_bytes (bytes, bytes + length)
 {
-  m_bytes = StorageType (length, 0);
-  for (int i = 0; i < length; ++i)
-    {
-      m_bytes[i] = bytes[i];
-    }
+  // empty
 }
 
 CCNxByteArray::CCNxByteArray (const std::vector< uint8_t > &value)
@@ -148,10 +144,14 @@ ns3::ccnx::operator << (std::ostream &os, CCNxByteArray const &array)
 Ptr<CCNxBuffer>
 CCNxByteArray::CreateBuffer () const
 {
-  // Exploits the fact that a std::vector will be linear memory from begin()
-  const uint8_t *p = &m_bytes[0];
-  Ptr<CCNxBuffer> buffer = Create<CCNxBuffer>(m_bytes.size(), (const char *) p );
-  return buffer;
+  if (!m_buffer)
+    {
+      // Exploits the fact that a std::vector will be linear memory from begin()
+      m_buffer = Create<CCNxBuffer> (m_bytes.size (), (const char *) m_bytes.data ());
+    }
+
+  // The byte array is immutable, so every caller can share the same storage
+  return Create<CCNxBuffer> (m_buffer->GetBuffer ());
 }
 
 // ==========
@@ -102,7 +102,8 @@ public:
   const uint8_t operator [] (size_t index) const;
 
   /**
-   * Represents the byte array as a CCNxBuffer
+   * Represents the byte array as a CCNxBuffer.  The bytes are copied in to a buffer on the first
+   * call only, later calls return buffers that share it, so they must not be modified.
    *
    * @return A CCNxBuffer wraped around the byte array
    */
@@ -154,6 +155,11 @@ public:
 protected:
   StorageType m_bytes;
 
+  /**
+   * Built by the first CreateBuffer() and shared by every buffer it returns.
+   */
+  mutable Ptr<CCNxBuffer> m_buffer;
+
 public:
   typedef std::allocator< uint8_t > allocator_type;
 
@@ -67,7 +67,7 @@ NS_LOG_COMPONENT_DEFINE ("CCNxCachetime");
 
 NS_OBJECT_ENSURE_REGISTERED(CCNxCachetime);
 
-const uint32_t CCNxCachetime::m_cachetimeTLVType = 2;
+const uint32_t CCNxCachetime::m_cachetimeTLVType = CCNxSchemaV1::T_CACHE_TIME;
 
 TypeId
 CCNxCachetime::GetTypeId (void)
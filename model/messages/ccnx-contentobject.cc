@@ -118,7 +118,7 @@ bool
 CCNxContentObject::Equals (CCNxContentObject const &other) const
 {
   bool result = false;
-  if (m_payload->Equals (*other.m_payload)
+  if (GetPayload ()->Equals (*other.GetPayload ())
       && m_name->Equals (*other.m_name)
       && m_expiryTime->Equals (*other.m_expiryTime)
       && m_payloadType == other.m_payloadType)
@@ -140,7 +140,7 @@ std::ostream &
 ns3::ccnx::operator<< (std::ostream &os, CCNxContentObject const &content)
 {
   os << "{ Content Object " << *content.GetName ();
-  os << ", PayloadSize " << content.GetPayload ()->GetSize ();
+  os << ", PayloadSize " << content.GetPayloadSize ();
   os << ", payloadType " << content.GetPayloadType ();
   os << ", expiryTime "  << content.GetExpiryTime ()->getTime () << " }";
   return os;
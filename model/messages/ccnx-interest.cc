@@ -144,7 +144,7 @@ bool
 CCNxInterest::Equals (CCNxInterest const &other) const
 {
   bool result = false;
-  if (m_payload->Equals (*other.m_payload)
+  if (GetPayload ()->Equals (*other.GetPayload ())
       && *m_keyidRestriction == *other.m_keyidRestriction
       && *m_hashRestriction == *other.m_hashRestriction
       && m_name->Equals (*other.m_name) )
@@ -164,9 +164,9 @@ std::ostream &
 ns3::ccnx::operator<< (std::ostream &os, CCNxInterest const &interest)
 {
   os << "{ Interest " << *interest.GetName ();
-  if (interest.GetPayload ())
+  if (interest.HasPayload ())
     {
-      os << ", PayloadSize " << interest.GetPayload ()->GetSize ();
+      os << ", PayloadSize " << interest.GetPayloadSize ();
     }
   else
     {
@@ -67,7 +67,7 @@ NS_LOG_COMPONENT_DEFINE ("CCNxInterestLifetime");
 
 NS_OBJECT_ENSURE_REGISTERED(CCNxInterestLifetime);
 
-const uint32_t CCNxInterestLifetime::m_interestLifetimeTLVType = 1;
+const uint32_t CCNxInterestLifetime::m_interestLifetimeTLVType = CCNxSchemaV1::T_INT_LIFE;
 
 TypeId
 CCNxInterestLifetime::GetTypeId (void)
@@ -103,10 +103,14 @@ CCNxMessage::GetName () const
 size_t
 CCNxMessage::GetPayloadSize () const
 {
-  if (HasPayload ())
+  if (m_payload)
     {
       return m_payload->GetSize ();
     }
+  else if (m_encodedPayload)
+    {
+      return m_encodedPayload->GetSize ();
+    }
   else
     {
       return m_virtualPayloadLength;
@@ -116,14 +120,32 @@ CCNxMessage::GetPayloadSize () const
 Ptr<CCNxBuffer>
 CCNxMessage::GetPayload () const
 {
+  if (m_encodedPayload)
+    {
+      m_payload = Create<CCNxBuffer> (m_encodedPayload);
+      m_encodedPayload = 0;
+    }
   return m_payload;
 }
 
+void
+CCNxMessage::SetEncodedPayload (Ptr<const Packet> encoded)
+{
+  NS_ASSERT_MSG (!HasPayload (), "Message already has a payload");
+  m_encodedPayload = encoded;
+}
+
+bool
+CCNxMessage::IsPayloadEncoded (void) const
+{
+  return m_encodedPayload ? true : false;
+}
+
 bool
 CCNxMessage::HasPayload () const
 {
   bool result = false;
-  if (m_payload || m_virtualPayloadLength > 0)
+  if (m_payload || m_encodedPayload || m_virtualPayloadLength > 0)
     {
       result = true;
     }
@@ -59,6 +59,7 @@
 #include "ns3/object.h"
 #include "ns3/ccnx-name.h"
 #include "ns3/buffer.h"
+#include "ns3/packet.h"
 #include "ns3/ccnx-buffer.h"
 
 namespace ns3  {
@@ -78,6 +79,11 @@ namespace ccnx {
  * No payload means the physical payload is null (Ptr<CCNxBuffer>(0)) and the virtual payload size is 0.
  * A CCNxMessage cannot have both a physical payload and a virtual payload size, at most one can be set.
  *
+ * A physical payload may also be left encoded.  A message decoded from the wire keeps its payload
+ * as a fragment of the received ns3::Packet (see SetEncodedPayload()) and only copies it in to a
+ * CCNxBuffer the first time GetPayload() is called.  GetPayloadSize() and HasPayload() do not
+ * decode it, so a forwarder that never reads the payload never copies it.
+ *
  * Implementation classes: CCNxInterest, CCNxContentObject.
  */
 class CCNxMessage : public Object
@@ -133,6 +139,21 @@ public:
    */
   Ptr<CCNxBuffer> GetPayload () const;
 
+  /**
+   * Sets the physical payload to the bytes of `encoded`, which are decoded in to a CCNxBuffer
+   * on the first call to GetPayload().  Used by the codecs for lazy decoding, the message
+   * must not already have a payload.
+   *
+   * @param [in] encoded The payload bytes (without the T_PAYLOAD type and length)
+   */
+  void SetEncodedPayload (Ptr<const Packet> encoded);
+
+  /**
+   * Returns true if the payload is still encoded, i.e. it was set by SetEncodedPayload()
+   * and GetPayload() has not been called yet.
+   */
+  bool IsPayloadEncoded (void) const;
+
   /**
    * Returns whether message has a payload or not.  Will return true if constructed with a non-null payload
    * or if created with a virtual payload of positive size.
@@ -171,7 +192,8 @@ public:
 
 protected:
   Ptr<const CCNxName> m_name;
-  Ptr<CCNxBuffer> m_payload;
+  mutable Ptr<CCNxBuffer> m_payload;
+  mutable Ptr<const Packet> m_encodedPayload;     //<! Payload not yet decoded in to m_payload
   size_t m_virtualPayloadLength;
 };
 
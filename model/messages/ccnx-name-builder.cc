@@ -103,7 +103,22 @@ CCNxNameBuilder::CreateName ()
 
   // Call the protected default constructor
   Ptr<CCNxName> name = Ptr<CCNxName> (new CCNxName (), false);
-  name->m_segments.insert (name->m_segments.begin (), this->m_segments.cbegin (), this->m_segments.cend ());
+  size_t bytes = 0;
+  for (size_t i = 0; i < m_segments.size (); ++i)
+    {
+      bytes += 4 + m_segments[i]->GetValue ().size ();
+    }
+  name->m_storage->m_bytes.reserve (bytes);
+  name->m_storage->m_offsets.reserve (m_segments.size () + 1);
+
+  for (size_t i = 0; i < m_segments.size (); ++i)
+    {
+      const std::string &value = m_segments[i]->GetValue ();
+      name->AppendSegment (m_segments[i]->GetType (), (const uint8_t *) value.data (), value.size ());
+    }
+
+  // we already have the segment objects, so GetSegment() does not need to create them
+  name->m_storage->m_segments = m_segments;
   return name;
 }
 
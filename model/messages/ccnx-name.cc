@@ -59,25 +59,43 @@
 #include "ccnx-name.h"
 
 #include <exception>
+#include <string.h>
 
 using namespace ns3;
 using namespace ns3::ccnx;
 
 NS_LOG_COMPONENT_DEFINE ("CCNxName");
 
+/**
+ * Bytes of type and length in front of each segment value in the segment buffer
+ */
+static const size_t _segmentHeaderBytes = 4;
+
+CCNxName::CCNxNameStorage::CCNxNameStorage ()
+{
+  m_offsets.push_back (0);
+}
+
 CCNxName::CCNxName ()
+  : m_storage (Create<CCNxNameStorage> ()), m_count (0)
 {
 }
 
 CCNxName::CCNxName (const std::string &uri)
+  : m_storage (Create<CCNxNameStorage> ()), m_count (0)
 {
-  m_segments = parse_uri (uri);
+  parse_uri (uri);
 }
 
 CCNxName::CCNxName (const CCNxName &copy)
+  : m_storage (copy.m_storage), m_count (copy.m_count)
+{
+  // shares the segment buffer, nothing is copied
+}
+
+CCNxName::CCNxName (Ptr<CCNxNameStorage> storage, size_t count)
+  : m_storage (storage), m_count (count)
 {
-  // allocates a new vector, but uses the same Ptr<NameSegment> inside the vector.
-  m_segments = copy.m_segments;
 }
 
 CCNxName::~CCNxName ()
@@ -85,10 +103,40 @@ CCNxName::~CCNxName ()
 
 }
 
+uint8_t *
+CCNxName::AppendSegment (CCNxNameSegmentType type, size_t length)
+{
+  NS_ASSERT_MSG (m_count + 1 == m_storage->m_offsets.size (), "Can only append to the end of the segment buffer");
+  NS_ASSERT_MSG (length <= 0xFFFF, "Name segment length too large");
+
+  std::vector<uint8_t> &bytes = m_storage->m_bytes;
+  size_t start = bytes.size ();
+  bytes.resize (start + _segmentHeaderBytes + length);
+  bytes[start] = (uint8_t) ((unsigned) type >> 8);
+  bytes[start + 1] = (uint8_t) type;
+  bytes[start + 2] = (uint8_t) (length >> 8);
+  bytes[start + 3] = (uint8_t) length;
+
+  m_storage->m_offsets.push_back ((uint32_t) bytes.size ());
+  m_count++;
+  m_storage->m_prefixHashes.clear ();
+  return bytes.data () + start + _segmentHeaderBytes;
+}
+
+void
+CCNxName::AppendSegment (CCNxNameSegmentType type, const uint8_t *value, size_t length)
+{
+  uint8_t *p = AppendSegment (type, length);
+  if (length > 0)
+    {
+      memcpy (p, value, length);
+    }
+}
+
 size_t
 CCNxName::GetSegmentCount () const
 {
-  return m_segments.size ();
+  return m_count;
 }
 
 Ptr<const CCNxNameSegment>
@@ -96,30 +144,74 @@ CCNxName::GetSegment (size_t index) const
 {
   NS_ASSERT_MSG (index < GetSegmentCount (), "Index must be less than GetSegmentCount()");
 
-  return m_segments[index];
+  std::vector< Ptr<const CCNxNameSegment> > &segments = m_storage->m_segments;
+  if (segments.size () <= index)
+    {
+      segments.resize (m_storage->m_offsets.size () - 1);
+    }
+
+  if (!segments[index])
+    {
+      std::string value ((const char *) GetSegmentData (index), GetSegmentLength (index));
+      segments[index] = Create<const CCNxNameSegment> (GetSegmentType (index), value);
+    }
+  return segments[index];
+}
+
+CCNxNameSegmentType
+CCNxName::GetSegmentType (size_t index) const
+{
+  NS_ASSERT_MSG (index < GetSegmentCount (), "Index must be less than GetSegmentCount()");
+  const uint8_t *p = &m_storage->m_bytes[m_storage->m_offsets[index]];
+  return (CCNxNameSegmentType) (((unsigned) p[0] << 8) | p[1]);
+}
+
+size_t
+CCNxName::GetSegmentLength (size_t index) const
+{
+  NS_ASSERT_MSG (index < GetSegmentCount (), "Index must be less than GetSegmentCount()");
+  return m_storage->m_offsets[index + 1] - m_storage->m_offsets[index] - _segmentHeaderBytes;
+}
+
+const uint8_t *
+CCNxName::GetSegmentData (size_t index) const
+{
+  NS_ASSERT_MSG (index < GetSegmentCount (), "Index must be less than GetSegmentCount()");
+  return m_storage->m_bytes.data () + m_storage->m_offsets[index] + _segmentHeaderBytes;
+}
+
+size_t
+CCNxName::GetEncodedSize () const
+{
+  return m_storage->m_offsets[m_count];
 }
 
+Ptr<const CCNxName>
+CCNxName::GetPrefix (size_t count) const
+{
+  NS_ASSERT_MSG (count <= GetSegmentCount (), "Prefix must not be longer than the name");
+  return Ptr<const CCNxName> (new CCNxName (m_storage, count), false);
+}
 
 bool
 CCNxName::Equals (const CCNxName &other) const
 {
-  bool result = false;
-  if (m_segments.size () == other.m_segments.size ())
+  if (m_count != other.m_count)
     {
-      result = true;
-      for (int i = 0; i < m_segments.size (); i++)
-        {
-          Ptr <const CCNxNameSegment> a = GetSegment (i);
-          Ptr <const CCNxNameSegment> b = other.GetSegment (i);
+      return false;
+    }
 
-          if (!a->Equals (*b))
-            {
-              result = false;
-              break;
-            }
-        }
+  if (!m_storage->m_prefixHashes.empty () && !other.m_storage->m_prefixHashes.empty () && GetHash () != other.GetHash ())
+    {
+      return false;
     }
-  return result;
+
+  // Same TLV bytes means same segments, because the TLVs delimit the segments
+  size_t bytes = GetEncodedSize ();
+  return bytes == other.GetEncodedSize ()
+         && (m_storage == other.m_storage
+             || bytes == 0
+             || memcmp (m_storage->m_bytes.data (), other.m_storage->m_bytes.data (), bytes) == 0);
 }
 
 bool
@@ -133,12 +225,21 @@ CCNxName::operator < (const CCNxName &other) const
     }
   else if (GetSegmentCount () == other.GetSegmentCount ())
     {
-      for (int i = 0; i < GetSegmentCount (); i++)
+      for (size_t i = 0; i < GetSegmentCount (); i++)
         {
-          Ptr<const CCNxNameSegment> a = GetSegment (i);
-          Ptr<const CCNxNameSegment> b = other.GetSegment (i);
-
-          int cmp = a->Compare (*b);
+          // same order as CCNxNameSegment::Compare: by type, then by value
+          int cmp = (int) GetSegmentType (i) - (int) other.GetSegmentType (i);
+          if (cmp == 0)
+            {
+              size_t a = GetSegmentLength (i);
+              size_t b = other.GetSegmentLength (i);
+              size_t n = a < b ? a : b;
+              cmp = n ? memcmp (GetSegmentData (i), other.GetSegmentData (i), n) : 0;
+              if (cmp == 0)
+                {
+                  cmp = (a < b) ? -1 : (a > b) ? 1 : 0;
+                }
+            }
 
           if ( cmp < 0 )
             {
@@ -164,32 +265,59 @@ bool
 CCNxName::IsPrefixOf (const CCNxName &other) const
 {
   bool result = false;
-  if (m_segments.size () <= other.m_segments.size ())
+  if (m_count <= other.m_count && GetHash () == other.GetPrefixHash (m_count))
     {
-      // assume its true and look for a negative
-      result = true;
-      for (int i = 0; i < GetSegmentCount (); ++i)
-        {
-          Ptr<const CCNxNameSegment> a = GetSegment (i);
-          Ptr<const CCNxNameSegment> b = other.GetSegment (i);
+      // If the first GetEncodedSize() bytes are the same, they are the same segments
+      size_t bytes = GetEncodedSize ();
+      result = m_storage == other.m_storage
+        || bytes == 0
+        || memcmp (m_storage->m_bytes.data (), other.m_storage->m_bytes.data (), bytes) == 0;
+    }
+  return result;
+}
+
+uint64_t
+CCNxName::GetHash () const
+{
+  return GetPrefixHash (m_count);
+}
+
+uint64_t
+CCNxName::GetPrefixHash (size_t count) const
+{
+  NS_ASSERT_MSG (count <= GetSegmentCount (), "Prefix must not be longer than the name");
 
-          if (a->Compare (*b) != 0)
+  std::vector<uint64_t> &chain = m_storage->m_prefixHashes;
+  if (chain.empty ())
+    {
+      // FNV-1a, 64-bit, over the segment buffer.  Each segment's type and length
+      // are in the buffer so segment boundaries are part of the digest.  The state
+      // at the end of segment i is the digest of the first i + 1 segments.
+      const uint64_t prime = 0x00000100000001B3ULL;
+      uint64_t hash = 0xCBF29CE484222325ULL;
+
+      const std::vector<uint32_t> &offsets = m_storage->m_offsets;
+      const uint8_t *p = m_storage->m_bytes.data ();
+      chain.reserve (offsets.size ());
+      chain.push_back (hash);
+      for (size_t i = 1; i < offsets.size (); ++i)
+        {
+          for (size_t j = offsets[i - 1]; j < offsets[i]; ++j)
             {
-              result = false;
-              break;
+              hash ^= p[j];
+              hash *= prime;
             }
+          chain.push_back (hash);
         }
     }
-  return result;
+  return chain[count];
 }
 
-CCNxName::CCNxNameStorageType
+void
 CCNxName::parse_uri (const std::string &uri)
 {
   NS_LOG_FUNCTION (this << uri);
 
-  CCNxNameStorageType result;
-
   const std::string schema ("ccnx:/");
   const int schemaOffset = schema.length ();
 
@@ -204,8 +332,8 @@ CCNxName::parse_uri (const std::string &uri)
           size_t pos = uri.find ("/", start);
 
           std::string segment = uri.substr (start, pos - start);
-          Ptr<CCNxNameSegment> seg = Create<CCNxNameSegment> (segment);
-          result.push_back (seg);
+          CCNxNameSegment seg (segment);
+          AppendSegment (seg.GetType (), (const uint8_t *) seg.GetValue ().data (), seg.GetValue ().size ());
 
           start = pos + 1;
 
@@ -220,8 +348,6 @@ CCNxName::parse_uri (const std::string &uri)
       NS_ASSERT_MSG (false, "URI must start with 'ccnx:/'");
       std::terminate ();
     }
-
-  return result;
 }
 
 std::ostream&
@@ -236,4 +362,3 @@ ns3::ccnx::operator<< (std::ostream& os, CCNxName const& name)
     }
   return os;
 }
-
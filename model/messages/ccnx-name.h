@@ -61,6 +61,7 @@
 #include <string>
 #include <memory>
 
+#include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include "ns3/output-stream-wrapper.h"
 
@@ -78,11 +79,19 @@ namespace ccnx {
  * Names are constructed using the class CCNxNameBuilder.  Once built, a name is immutable.
  *
  * Each name segment has a type and a value.
+ *
+ * All segments are stored in one contiguous buffer of (type, length, value) TLVs with an offset
+ * table, so the number of heap objects in a name does not grow with its length.  The buffer is shared by copies
+ * and by the prefixes returned from `GetPrefix()`, so neither copies any segment bytes.  Comparisons
+ * run over the encoded bytes.  `GetSegment()` creates CCNxNameSegment objects on first use and keeps
+ * them with the buffer; code on the fast path should use `GetSegmentType()`, `GetSegmentLength()`
+ * and `GetSegmentData()` instead.
  */
 class CCNxName : public SimpleRefCount<CCNxName>
 {
 public:
   friend class CCNxNameBuilder;
+  friend class CCNxCodecName;
 
   /**
    * Function to compare two smart pointers to CCNx names.  May be used in std::map as the
@@ -110,7 +119,7 @@ public:
   CCNxName (const std::string &uri);
 
   /**
-   * Copies the given name.  The NameSegments are references to the same Ptr<CCNxNameSegment>.
+   * Copies the given name.  The copy shares the segment buffer of `copy`.
    */
   CCNxName (const CCNxName &copy);
 
@@ -127,6 +136,40 @@ public:
    */
   Ptr<const CCNxNameSegment> GetSegment (size_t index) const;
 
+  /**
+   * Returns the type of the specified name segment without creating a CCNxNameSegment.
+   * Will assert if the index is beyond the end of the GetSegmentCount().
+   */
+  CCNxNameSegmentType GetSegmentType (size_t index) const;
+
+  /**
+   * Returns the length, in bytes, of the value of the specified name segment.
+   * Will assert if the index is beyond the end of the GetSegmentCount().
+   */
+  size_t GetSegmentLength (size_t index) const;
+
+  /**
+   * Returns a pointer to the value of the specified name segment.  It is valid as long as the
+   * name (or any name sharing its buffer) exists.  Will assert if the index is beyond the end of
+   * the GetSegmentCount().
+   */
+  const uint8_t * GetSegmentData (size_t index) const;
+
+  /**
+   * The number of bytes used by the segment TLVs, 4 bytes of type and length per segment plus the
+   * values.  This is the length of the name in the wire format, less the outer T_NAME.
+   */
+  size_t GetEncodedSize () const;
+
+  /**
+   * Returns the first `count` segments of this name.  The prefix shares this name's buffer, so
+   * no segment bytes are copied.  Will assert if `count` is more than GetSegmentCount().
+   *
+   * @param count The number of segments in the prefix
+   * @return The prefix (this name if `count` is GetSegmentCount())
+   */
+  Ptr<const CCNxName> GetPrefix (size_t count) const;
+
   /**
    * Determines if the name is equal to the other name.  For two names to be equal, they
    * must be the same length and each name segment must be of the same type and value.
@@ -153,6 +196,30 @@ public:
    */
   bool IsPrefixOf (const CCNxName &other) const;
 
+  /**
+   * A 64-bit digest of the name (FNV-1a over each segment's type, length, and value).
+   *
+   * Because a name is immutable, the digest is computed on first use and cached (see `GetPrefixHash()`).  Two
+   * equal names always have the same digest, but equal digests do not guarantee
+   * equal names, so hash tables must still call `Equals()` on a digest hit.
+   *
+   * @return The digest of the name
+   */
+  uint64_t GetHash () const;
+
+  /**
+   * The digest of the first `count` segments, equal to `GetPrefix (count)->GetHash ()`.
+   *
+   * The digests of every prefix length are computed together on first use and kept with the
+   * segment buffer, so each call after that is O(1).  A table of names can therefore test
+   * "is the prefix of length i present?" with one probe per length without building names.
+   * Will assert if `count` is more than GetSegmentCount().
+   *
+   * @param count The number of segments in the prefix
+   * @return The digest of the prefix
+   */
+  uint64_t GetPrefixHash (size_t count) const;
+
 protected:
   /**
    * Creates a name with zero name segments.
@@ -160,19 +227,65 @@ protected:
   CCNxName ();
 
   /**
-   * The data structure used to store name segments.
+   * The segment buffer, shared by a name, its copies and its prefixes.  Segments are only ever
+   * appended while the name that owns the buffer is being built.
    */
-  typedef std::vector< Ptr<const CCNxNameSegment> > CCNxNameStorageType;
+  struct CCNxNameStorage : public SimpleRefCount<CCNxNameStorage>
+  {
+    /**
+     * Each segment is a 2-byte type (CCNxNameSegmentType), a 2-byte length and the value, in network byte order.
+     */
+    std::vector<uint8_t> m_bytes;
+
+    /**
+     * m_offsets[i] is the start of segment i in m_bytes.  There is one extra entry for the end of the buffer.
+     */
+    std::vector<uint32_t> m_offsets;
+
+    /**
+     * The CCNxNameSegment objects handed out by `GetSegment()`, created on first use.
+     */
+    std::vector< Ptr<const CCNxNameSegment> > m_segments;
+
+    /**
+     * m_prefixHashes[i] is the digest of the first i segments, computed on first use.
+     */
+    std::vector<uint64_t> m_prefixHashes;
+
+    CCNxNameStorage ();
+  };
 
   /**
-   * Parse a URI in to a name segment vector.
+   * Creates a name of the first `count` segments in `storage`.
    */
-  CCNxNameStorageType parse_uri (const std::string &uri);
+  CCNxName (Ptr<CCNxNameStorage> storage, size_t count);
 
   /**
-   * Internal storage of name segments.
+   * Appends a segment to the buffer.  Only valid while building a name.
    */
-  CCNxNameStorageType m_segments;
+  void AppendSegment (CCNxNameSegmentType type, const uint8_t *value, size_t length);
+
+  /**
+   * Appends a segment of `length` bytes to the buffer and returns where to write its value.
+   * The pointer is only valid until the next append.  Only valid while building a name.
+   */
+  uint8_t * AppendSegment (CCNxNameSegmentType type, size_t length);
+
+  /**
+   * Parse a URI in to the segment buffer.
+   */
+  void parse_uri (const std::string &uri);
+
+  /**
+   * The (possibly shared) segment buffer.
+   */
+  Ptr<CCNxNameStorage> m_storage;
+
+  /**
+   * The number of segments of m_storage in this name.
+   */
+  size_t m_count;
+
 };
 
 std::ostream &operator<< (std::ostream &os, const CCNxName &name);
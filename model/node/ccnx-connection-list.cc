@@ -94,9 +94,19 @@ Ptr<CCNxConnection> CCNxConnectionList::front () const
   return m_storage.front ();
 }
 
+bool CCNxConnectionList::push_back_unique (Ptr<CCNxConnection> connection)
+{
+  if (m_storage.find (connection) != m_storage.end ())
+    {
+      return false;
+    }
+  m_storage.push_back (connection);
+  return true;
+}
+
 void CCNxConnectionList::pop_front ()
 {
-  m_storage.pop_front ();
+  m_storage.erase (m_storage.begin ());
 }
 
 Ptr<CCNxConnection> CCNxConnectionList::back () const
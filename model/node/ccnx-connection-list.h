@@ -56,9 +56,11 @@
 #ifndef CCNS3SIM_MODEL_NODE_CCNX_CONNECTION_LIST_H_
 #define CCNS3SIM_MODEL_NODE_CCNX_CONNECTION_LIST_H_
 
-#include <list>
+#include <iterator>
 #include "ns3/simple-ref-count.h"
 #include "ns3/ccnx-connection.h"
+#include "ns3/ccnx-small-vector.h"
+#include "ns3/ccnx-pool-allocator.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -69,9 +71,10 @@ namespace ccnx {
  * A memory managed list of `Ptr<CCNxConnection>`s.  This is so we don't
  * need to toss around a `std::list< Ptr<CCNxConnection> >`.
  *
- * Roughly resembles the same API as std::list<> but we do not have an iterator.
+ * Roughly resembles the same API as std::list<>.  One is created for most packets, so the list
+ * itself comes from CCNxPoolAllocator and keeps its first few connections inline.
  */
-class CCNxConnectionList : public SimpleRefCount<CCNxConnectionList>
+class CCNxConnectionList : public SimpleRefCount<CCNxConnectionList>, public CCNxPoolAllocated
 {
 public:
   CCNxConnectionList ();
@@ -87,11 +90,27 @@ public:
 
   Ptr<CCNxConnection> front () const;
 
+  /**
+   * Removes the first connection.  This shifts the others, which is cheap for the short
+   * lists the forwarder uses.
+   */
   void pop_front ();
 
   Ptr<CCNxConnection> back () const;
 
-  typedef std::list< Ptr<CCNxConnection> > StorageType;
+  /**
+   * Appends `connection` unless it is already in the list
+   *
+   * @return true if it was appended
+   */
+  bool push_back_unique (Ptr<CCNxConnection> connection);
+
+  /**
+   * The number of connections kept without allocating
+   */
+  static const size_t InlineConnections = 4;
+
+  typedef CCNxSmallVector< Ptr<CCNxConnection>, InlineConnections > StorageType;
 
 
 private:
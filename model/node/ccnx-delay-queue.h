@@ -56,12 +56,16 @@
 #ifndef CCNS3SIM_MODEL_NODE_CCNX_DELAY_QUEUE_H_
 #define CCNS3SIM_MODEL_NODE_CCNX_DELAY_QUEUE_H_
 
+#include <algorithm>
 #include <deque>
 #include <vector>
+#include "ns3/assert.h"
 #include "ns3/simple-ref-count.h"
 #include "ns3/nstime.h"
 #include "ns3/callback.h"
-#include "ns3/timer.h"
+#include "ns3/event-id.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
 
 namespace ns3 {
 namespace ccnx {
@@ -101,7 +105,113 @@ namespace ccnx {
  * simulation delay to wait.  Once the delay is over and the item is passed
  * to `DequeueCallback(T item)`, no further calculation is done and `item` is
  * passed to the next step in the service pipeline.
+ *
+ * @subsection Batched Service
+ *
+ * With `SetBatchSize()`, a free server takes several head-of-line items at once with one timer,
+ * which cuts the number of scheduler events under load.  Each item is still given its own start
+ * and completion time on the earliest free of the `servers`, as it would be without batching.
+ * The timer expires when the last item of the batch is done and the items are handed on then,
+ * each with its completion time (see `CCNxDelayQueueClock`).  A queue fed from the
+ * `DequeueCallback` takes that time as the arrival time, so the timing of the next queue does
+ * not depend on the batching.
+ *
+ * @subsection Capacity
+ *
+ * By default the backlog is unbounded.  With `SetCapacity()`, at most that many items wait
+ * for a server and further arrivals are dropped (tail drop).  With `SetRed()`, arrivals are
+ * also dropped early with Random Early Detection on the average backlog.  Dropped items are
+ * passed to the `DropCallback` and `push_back()` returns false.
+ *
+ * @subsection Service Classes
+ *
+ * With `SetClasses()`, a `ClassifyCallback` puts each item in one of several classes.  Each
+ * class has its own FIFO and a free server takes its next item by strict priority (class 0
+ * first) or weighted round robin (up to `weight` items from a class before moving to the next).
+ * Queueing delay (time from `push_back()` to the start of service) is kept per class,
+ * see `GetClassStats()`.
+ */
+
+/**
+ * @ingroup ccnx-l3-base
+ *
+ * The completion time of the item a CCNxDelayQueue is passing to its `DequeueCallback`.
+ * A batched queue hands on items after their service ended, so `CCNxDelayQueue::push_back()`
+ * uses this, not `Simulator::Now()`, as the arrival time.  Outside of a `DequeueCallback`, it is
+ * `Simulator::Now()`.
  */
+class CCNxDelayQueueClock
+{
+private:
+  struct State
+  {
+    State () : delivering (false)
+    {
+    }
+
+    bool delivering;
+    Time time;
+  };
+
+  static State & GetState (void)
+  {
+    static State state;
+    return state;
+  }
+
+public:
+  /**
+   * The completion time of the item being delivered, or `Simulator::Now()`
+   */
+  static Time Now (void)
+  {
+    const State &state = GetState ();
+    return state.delivering ? state.time : Simulator::Now ();
+  }
+
+  /**
+   * Sets the clock to `time` for the life of the object, then restores it (deliveries nest
+   * when a `DequeueCallback` feeds another queue).
+   */
+  class Delivery
+  {
+  public:
+    explicit Delivery (Time time)
+      : m_previous (GetState ())
+    {
+      State &state = GetState ();
+      state.delivering = true;
+      state.time = time;
+    }
+
+    ~Delivery ()
+    {
+      GetState () = m_previous;
+    }
+
+  private:
+    State m_previous;
+  };
+};
+
+/**
+ * How a CCNxDelayQueue drops arrivals
+ */
+typedef enum
+{
+  CCNxDelayQueueDropPolicy_TailDrop, /**< Drop only when the backlog is at capacity */
+  CCNxDelayQueueDropPolicy_Red       /**< Random Early Detection, plus tail drop at capacity */
+} CCNxDelayQueueDropPolicy;
+
+/**
+ * How a CCNxDelayQueue with several classes picks the next item
+ */
+typedef enum
+{
+  CCNxDelayQueueScheduler_Fifo,               /**< One FIFO for all classes (classes only keep statistics) */
+  CCNxDelayQueueScheduler_StrictPriority,     /**< The lowest numbered non-empty class first */
+  CCNxDelayQueueScheduler_WeightedRoundRobin  /**< Up to the class weight items from each class in turn */
+} CCNxDelayQueueScheduler;
 
 template <class T>
 class CCNxDelayQueue : public SimpleRefCount< CCNxDelayQueue<T> >
@@ -110,54 +220,278 @@ public:
   typedef Callback<Time, Ptr<T> > GetServiceTimeCallback;
   typedef Callback<void, Ptr<T> > DequeueCallback;
 
+  /**
+   * An item whose service is over and the simulation time its service ended.
+   */
+  struct Completion
+  {
+    Ptr<T> item;
+    Time time;
+  };
+
+  typedef std::vector<Completion> CompletionList;
+  typedef Callback<void, const CompletionList &> BatchDequeueCallback;
+
+  typedef Callback<void, Ptr<T> > DropCallback;
+  typedef Callback<unsigned, Ptr<T> > ClassifyCallback;
+
+  /**
+   * Per class counters
+   */
+  struct ClassStats
+  {
+    uint64_t enqueued;  //<! Items accepted by push_back()
+    uint64_t dropped;   //<! Items refused by push_back()
+    uint64_t served;    //<! Items that started service
+    Time totalDelay;    //<! Sum of the queueing delay of served items
+    Time maxDelay;      //<! Largest queueing delay of a served item
+  };
+
   CCNxDelayQueue (unsigned servers, GetServiceTimeCallback getServiceTime, DequeueCallback dequeue)
-    : m_serverCount (servers), m_GetServiceTime (getServiceTime), m_DequeueCallback (dequeue), m_backlogCount (0)
+    : m_serverCount (servers), m_GetServiceTime (getServiceTime), m_DequeueCallback (dequeue), m_backlogCount (0),
+    m_batchSize (1), m_serviceEvents (0), m_capacity (0), m_dropPolicy (CCNxDelayQueueDropPolicy_TailDrop),
+    m_redMinThreshold (0), m_redMaxThreshold (0), m_redMaxProbability (0), m_redQueueWeight (0), m_redAverage (0),
+    m_dropCount (0), m_scheduler (CCNxDelayQueueScheduler_Fifo), m_waitingCount (0), m_wrrClass (0), m_wrrCredit (0)
   {
     NS_ASSERT_MSG (servers > 0, "Cannot specify 0 servers, must be positive.");
 
+    m_classQueues.resize (1);
+    m_classStats.resize (1);
+    m_classWeights.resize (1, 1);
+
     m_servers = ServerArrayType (m_serverCount);
-    for (int i = 0; i < m_serverCount; i++)
+    m_serverFreeTimes.assign (m_serverCount, Time (0));
+
+    // Stack the free servers so server 0 is used first
+    m_freeServers.reserve (m_serverCount);
+    for (unsigned i = m_serverCount; i > 0; i--)
       {
-        m_servers[i] = new Timer (Timer::REMOVE_ON_DESTROY);
-        m_servers[i]->SetFunction (&CCNxDelayQueue::TimerExpired, this);
+        m_freeServers.push_back (i - 1);
       }
   }
 
   virtual ~CCNxDelayQueue ()
   {
-    for (int i = 0; i < m_serverCount; i++)
+    for (unsigned i = 0; i < m_serverCount; i++)
       {
-        delete m_servers[i];
+        if (m_servers[i].event.IsRunning ())
+          {
+            Simulator::Remove (m_servers[i].event);
+          }
       }
   }
 
   /**
-   * Enqueues an item.  If there's an available server timer, it will be put
-   * at the head-of-line immediately and wait its delay.  Otherwise, it will stay
-   * in the backlog queue until it reaches the head-of-line.
+   * Turns on batched service.  When a server timer is free it takes up to `batchSize` items
+   * from the head of the queue and calls `GetServiceTime()` on each.  Each item starts at the later
+   * of its arrival and the time the earliest free server is done, so with the FIFO scheduler the
+   * start and completion times are the ones the items would have without batching, whatever the
+   * number of servers.  The timer expires when the last item of the batch is done.
+   *
+   * When the timer expires, the whole batch is passed to `batchDequeue` with each item's
+   * completion time.  If `batchDequeue` is null, each item is passed to the `DequeueCallback`
+   * in completion order, with `CCNxDelayQueueClock::Now()` set to its completion time, so a
+   * queue fed from the callback starts its timing from there.
+   *
+   * What does change is the simulation time code runs at: the items are handed on when the
+   * batch timer expires, up to one batch of service time after they are done.  Anything that
+   * reads `Simulator::Now()` in the callback (e.g. handing a packet to a link), and the order
+   * of items from two batches on different timers, may differ from unbatched service.  With
+   * several classes, the scheduler picks a whole batch at once, so later arrivals of a higher
+   * priority class do not overtake the items already in it.
+   *
+   * A `batchSize` of 1 (the default) is the unbatched behavior.  This should be set before
+   * any items are queued.
+   *
+   * @param batchSize The maximum number of items a server takes at once (must be positive)
+   * @param batchDequeue Optional callback for the completed batch
+   */
+  void SetBatchSize (unsigned batchSize, BatchDequeueCallback batchDequeue = BatchDequeueCallback ())
+  {
+    NS_ASSERT_MSG (batchSize > 0, "Cannot specify a batch size of 0, must be positive.");
+    m_batchSize = batchSize;
+    m_BatchDequeueCallback = batchDequeue;
+  }
+
+  unsigned GetBatchSize () const
+  {
+    return m_batchSize;
+  }
+
+  /**
+   * Bounds the number of items waiting for a server (not counting those in service).
+   * An arrival that finds `capacity` items waiting is dropped.
+   *
+   * @param capacity The most waiting items, 0 (the default) is unbounded
+   */
+  void SetCapacity (size_t capacity)
+  {
+    m_capacity = capacity;
+  }
+
+  size_t GetCapacity () const
+  {
+    return m_capacity;
+  }
+
+  /**
+   * Turns on Random Early Detection.  On each arrival the average backlog is updated as
+   * `avg = (1 - queueWeight) * avg + queueWeight * waiting`.  Below `minThreshold` nothing is
+   * dropped, at or above `maxThreshold` every arrival is dropped, and in between an arrival
+   * is dropped with probability rising linearly from 0 to `maxProbability`.
+   *
+   * The capacity from `SetCapacity()` still applies.
+   */
+  void SetRed (size_t minThreshold, size_t maxThreshold, double maxProbability, double queueWeight)
+  {
+    NS_ASSERT_MSG (minThreshold < maxThreshold, "RED minThreshold must be less than maxThreshold");
+    NS_ASSERT_MSG (maxProbability >= 0 && maxProbability <= 1, "RED maxProbability must be in [0, 1]");
+    NS_ASSERT_MSG (queueWeight > 0 && queueWeight <= 1, "RED queueWeight must be in (0, 1]");
+
+    m_dropPolicy = CCNxDelayQueueDropPolicy_Red;
+    m_redMinThreshold = minThreshold;
+    m_redMaxThreshold = maxThreshold;
+    m_redMaxProbability = maxProbability;
+    m_redQueueWeight = queueWeight;
+    m_redAverage = 0;
+    if (!m_random)
+      {
+        m_random = CreateObject<UniformRandomVariable> ();
+      }
+  }
+
+  CCNxDelayQueueDropPolicy GetDropPolicy () const
+  {
+    return m_dropPolicy;
+  }
+
+  /**
+   * Assign a fixed random variable stream number to the RED drop decision
+   *
+   * @return The number of streams used (0 if RED is off)
+   */
+  int64_t AssignStreams (int64_t stream)
+  {
+    if (m_random)
+      {
+        m_random->SetStream (stream);
+        return 1;
+      }
+    return 0;
+  }
+
+  /**
+   * Split the queue in to `weights.size()` service classes.  `classify` returns the class
+   * of an item, which must be less than the number of classes.  For weighted round robin, each
+   * weight must be positive.  This should be set before any items are queued.
+   *
+   * @param classify Returns the class of an item
+   * @param scheduler How a free server picks among the classes
+   * @param weights One weight per class (only used by weighted round robin)
+   */
+  void SetClasses (ClassifyCallback classify, CCNxDelayQueueScheduler scheduler, const std::vector<unsigned> &weights)
+  {
+    NS_ASSERT_MSG (weights.size () > 0, "Must have at least one class");
+    NS_ASSERT_MSG (m_waitingCount == 0, "Cannot change the classes of a non-empty queue");
+
+    m_classify = classify;
+    m_scheduler = scheduler;
+    m_classWeights = weights;
+    if (m_scheduler == CCNxDelayQueueScheduler_WeightedRoundRobin)
+      {
+        for (size_t i = 0; i < m_classWeights.size (); i++)
+          {
+            NS_ASSERT_MSG (m_classWeights[i] > 0, "Weighted round robin class " << i << " has weight 0");
+          }
+      }
+
+    m_classQueues.assign (m_scheduler == CCNxDelayQueueScheduler_Fifo ? 1 : weights.size (), EntryQueue ());
+    m_classStats.assign (weights.size (), ClassStats ());
+    m_wrrClass = 0;
+    m_wrrCredit = m_classWeights[0];
+  }
+
+  CCNxDelayQueueScheduler GetScheduler () const
+  {
+    return m_scheduler;
+  }
+
+  size_t GetClassCount () const
+  {
+    return m_classStats.size ();
+  }
+
+  const ClassStats & GetClassStats (unsigned serviceClass) const
+  {
+    NS_ASSERT_MSG (serviceClass < m_classStats.size (), "Invalid class " << serviceClass);
+    return m_classStats[serviceClass];
+  }
+
+  /**
+   * Called with each item dropped by `push_back()`
+   */
+  void SetDropCallback (DropCallback drop)
+  {
+    m_DropCallback = drop;
+  }
+
+  /**
+   * Enqueues an item that arrives at `CCNxDelayQueueClock::Now()`.  If there's an available
+   * server, it will be put at the head-of-line immediately and wait its delay.  Otherwise, it
+   * will stay in the backlog queue until it reaches the head-of-line.
    *
    * @param item
+   * @return true if queued, false if dropped by the capacity or RED
    */
-  void push_back (Ptr<T> item)
+  bool push_back (Ptr<T> item)
   {
-    m_inputQueue.push_back (item);
-    m_backlogCount++;
+    return push_back (item, CCNxDelayQueueClock::Now ());
+  }
+
+  /**
+   * Enqueues an item that arrived at `arrivalTime`, which may be earlier than now (e.g. the
+   * completion time of an item from a batched queue).  Its service does not start before then.
+   *
+   * @param item
+   * @param arrivalTime When the item arrived, no later than `Simulator::Now()`
+   * @return true if queued, false if dropped by the capacity or RED
+   */
+  bool push_back (Ptr<T> item, Time arrivalTime)
+  {
+    NS_ASSERT_MSG (arrivalTime <= Simulator::Now (), "Arrival time " << arrivalTime << " is in the future");
+
+    unsigned serviceClass = m_classify.IsNull () ? 0 : m_classify (item);
+    NS_ASSERT_MSG (serviceClass < m_classStats.size (), "Classify returned invalid class " << serviceClass);
+    ClassStats &stats = m_classStats[serviceClass];
 
-    if (m_backlogCount <= m_serverCount)
+    if (!Admit ())
       {
-        // find a free server
-        bool foundServer = false;
-        for (int i = 0; i < m_serverCount; i++)
+        m_dropCount++;
+        stats.dropped++;
+        if (!m_DropCallback.IsNull ())
           {
-            if (!m_servers[i]->IsRunning ())
-              {
-                BeginService (m_servers[i]);
-                foundServer = true;
-                break;
-              }
+            m_DropCallback (item);
           }
-        NS_ASSERT_MSG (foundServer, "backlog <= m_serverCount, but did not find free server");
+        return false;
+      }
+
+    Entry entry;
+    entry.item = item;
+    entry.enqueueTime = arrivalTime;
+    entry.serviceClass = serviceClass;
+    m_classQueues[m_scheduler == CCNxDelayQueueScheduler_Fifo ? 0 : serviceClass].push_back (entry);
+    m_waitingCount++;
+    m_backlogCount++;
+    stats.enqueued++;
+
+    // A server is only free while the backlog queue is empty, so the new item is the head-of-line
+    if (!m_freeServers.empty ())
+      {
+        unsigned index = m_freeServers.back ();
+        m_freeServers.pop_back ();
+        BeginService (index);
       }
+    return true;
   }
 
 
@@ -172,46 +506,198 @@ public:
     return m_backlogCount;
   }
 
+  /**
+   * The number of server timers that have expired, i.e. the scheduler events used
+   */
+  uint64_t GetServiceEventCount () const
+  {
+    return m_serviceEvents;
+  }
+
+  /**
+   * The number of items dropped by `push_back()`
+   */
+  uint64_t GetDropCount () const
+  {
+    return m_dropCount;
+  }
+
 private:
   /**
-   * Begin servicing the top of the input queue in the server `server`.  Will get the
-   * delay time by calling m_GetServiceTime().
+   * A waiting item
+   */
+  struct Entry
+  {
+    Ptr<T> item;
+    Time enqueueTime;
+    unsigned serviceClass;
+  };
+
+  typedef std::deque< Entry > EntryQueue;
+
+  /**
+   * Decide if an arrival may join the backlog
+   */
+  bool Admit ()
+  {
+    size_t waiting = m_waitingCount;
+
+    if (m_dropPolicy == CCNxDelayQueueDropPolicy_Red)
+      {
+        m_redAverage = (1 - m_redQueueWeight) * m_redAverage + m_redQueueWeight * waiting;
+        if (m_redAverage >= m_redMaxThreshold)
+          {
+            return false;
+          }
+        if (m_redAverage > m_redMinThreshold)
+          {
+            double probability = m_redMaxProbability * (m_redAverage - m_redMinThreshold)
+              / (m_redMaxThreshold - m_redMinThreshold);
+            if (m_random->GetValue () < probability)
+              {
+                return false;
+              }
+          }
+      }
+
+    return m_capacity == 0 || waiting < m_capacity;
+  }
+
+  /**
+   * Remove the next item to serve according to `m_scheduler`.  There must be a waiting item.
+   */
+  Entry PopNext ()
+  {
+    size_t queueIndex = 0;
+    switch (m_scheduler)
+      {
+      case CCNxDelayQueueScheduler_Fifo:
+        break;
+
+      case CCNxDelayQueueScheduler_StrictPriority:
+        while (m_classQueues[queueIndex].empty ())
+          {
+            queueIndex++;
+          }
+        break;
+
+      case CCNxDelayQueueScheduler_WeightedRoundRobin:
+        while (m_classQueues[m_wrrClass].empty () || m_wrrCredit == 0)
+          {
+            m_wrrClass = (m_wrrClass + 1) % m_classQueues.size ();
+            m_wrrCredit = m_classWeights[m_wrrClass];
+          }
+        m_wrrCredit--;
+        queueIndex = m_wrrClass;
+        break;
+      }
+
+    EntryQueue &queue = m_classQueues[queueIndex];
+    Entry entry = queue.front ();
+    queue.pop_front ();
+    m_waitingCount--;
+    return entry;
+  }
+
+  /**
+   * The queueing delay of `entry` ends at `serviceStart`
+   */
+  void RecordServiceStart (const Entry &entry, Time serviceStart)
+  {
+    ClassStats &stats = m_classStats[entry.serviceClass];
+    Time delay = serviceStart - entry.enqueueTime;
+    stats.served++;
+    stats.totalDelay += delay;
+    if (delay > stats.maxDelay)
+      {
+        stats.maxDelay = delay;
+      }
+  }
+
+  /**
+   * Orders completions by time, for a stable sort of a batch
+   */
+  static bool CompletesBefore (const Completion &a, const Completion &b)
+  {
+    return a.time < b.time;
+  }
+
+  /**
+   * Begin servicing the top of the input queue with server timer `index`, which must be free.  Takes up to
+   * `m_batchSize` items and gets each one's delay by calling m_GetServiceTime().  Each item starts on
+   * the server that is free first (see `m_serverFreeTimes`), but not before it arrived.
    *
-   * @param server [in] The server to use for the scheduling
+   * @param index [in] The server timer to use for the scheduling
    */
-  void BeginService (Timer *server)
+  void BeginService (unsigned index)
   {
-    if (!m_inputQueue.empty ())
+    NS_ASSERT_MSG (m_waitingCount > 0, "BeginService with an empty backlog");
+
+    Server &server = m_servers[index];
+    Time now = Simulator::Now ();
+    Time lastCompletion = now;
+
+    while (m_waitingCount > 0 && server.batch.size () < m_batchSize)
       {
-        Ptr<T> item = m_inputQueue.front ();
-        m_inputQueue.pop_front ();
+        Entry entry = PopNext ();
+        std::vector<Time>::iterator freeTime = std::min_element (m_serverFreeTimes.begin (), m_serverFreeTimes.end ());
+        Time start = std::max (entry.enqueueTime, *freeTime);
+        RecordServiceStart (entry, start);
 
-        Time serviceTime = m_GetServiceTime (item);
-        server->SetDelay (serviceTime);
-        server->SetArguments (item, server);
-        server->Schedule ();
+        Completion completion;
+        completion.item = entry.item;
+        completion.time = start + m_GetServiceTime (entry.item);
+        *freeTime = completion.time;
+        lastCompletion = std::max (lastCompletion, completion.time);
+        server.batch.push_back (completion);
       }
+
+    // On several servers the items may finish out of order
+    std::stable_sort (server.batch.begin (), server.batch.end (), &CCNxDelayQueue::CompletesBefore);
+    server.event = Simulator::Schedule (lastCompletion - now, &CCNxDelayQueue::TimerExpired, this, index);
   }
 
   /**
-   * Function called when a timer expires.  It will pass the `item` to
+   * Function called when a timer expires.  It will pass the server's items to
    * the dequeue function, then check the backlog queue to
    * see if there's a new item to put in the timer.
    *
-   * @param item
-   * @param server The timer that just expired, which is not free and can be loaded with a new item
+   * @param index The server whose timer just expired, which is not free and can be loaded with new items
    */
-  void TimerExpired (Ptr<T> item, Timer *server)
+  void TimerExpired (unsigned index)
   {
-    NS_ASSERT_MSG (m_backlogCount > 0, "Timer expired, but backlog count is 0");
+    Server &server = m_servers[index];
+    size_t count = server.batch.size ();
+    NS_ASSERT_MSG (m_backlogCount >= count, "Timer expired, but backlog count is less than the batch");
+    m_serviceEvents++;
 
-    // It's possible that calling m_DequeueCallback will immediately queue another packet,
-    // so do not decrement the backlog until after.  Otherwise, we might get
+    // It's possible that calling the dequeue callback will immediately queue another packet,
+    // so do not free the server until after.  Otherwise, we might get
     // overlapping calls to BeginService()
-    m_DequeueCallback (item);
+    if (!m_BatchDequeueCallback.IsNull ())
+      {
+        m_BatchDequeueCallback (server.batch);
+      }
+    else
+      {
+        for (size_t i = 0; i < count; i++)
+          {
+            CCNxDelayQueueClock::Delivery delivery (server.batch[i].time);
+            m_DequeueCallback (server.batch[i].item);
+          }
+      }
+
+    server.batch.clear ();
+    m_backlogCount -= count;
 
-    m_backlogCount--;
-    BeginService (server);
+    if (m_waitingCount == 0)
+      {
+        m_freeServers.push_back (index);
+      }
+    else
+      {
+        BeginService (index);
+      }
   }
 
 private:
@@ -231,17 +717,43 @@ private:
    */
   DequeueCallback m_DequeueCallback;
 
-  typedef std::deque< Ptr<T> > QueueType;
+  /**
+   * If not null, used instead of m_DequeueCallback to deliver a whole batch
+   */
+  BatchDequeueCallback m_BatchDequeueCallback;
+
+  /**
+   * If not null, called with each dropped item
+   */
+  DropCallback m_DropCallback;
+
+  /**
+   * This is the delay queue.  One FIFO per class (or a single FIFO) with multiple parallel servers.
+   */
+  std::vector< EntryQueue > m_classQueues;
+
+  /**
+   * Each head-of-line batch is delayed by a scheduled event.  When it expires
+   * it calls TimerExpired().  TimerExpired passes the batch to
+   * the dequeue callback then checks the backlog to see if there are new items that
+   * can be put in the server.
+   */
+  struct Server
+  {
+    EventId event;
+    CompletionList batch;
+  };
 
   /**
-   * This is the delay queue.  FIFO with multiple parallel servers.
+   * The array of server timers, held by value.
    */
-  QueueType m_inputQueue;
+  typedef std::vector< Server > ServerArrayType;
 
   /**
-   * The array of servers.
+   * When each server is done with the items given to it so far.  A batch on one timer
+   * may use all of them.
    */
-  typedef std::vector< Timer * > ServerArrayType;
+  std::vector<Time> m_serverFreeTimes;
 
   /**
    * The number of items in the queue plus servers
@@ -249,12 +761,57 @@ private:
   size_t m_backlogCount;
 
   /**
-   * Each head-of-line item is delayed using a Timer.  When the timer expires
-   * it calls TimerExpired().  TimerExpired passes the head-of-line item to
-   * m_service then checks the backlog to see if there's a new item that
-   * can be put in the timer.
+   * The most items a server takes at once
    */
+  unsigned m_batchSize;
+
+  /**
+   * The number of timer expiries
+   */
+  uint64_t m_serviceEvents;
+
   ServerArrayType m_servers;
+
+  /**
+   * Indices of the idle servers in m_servers, used as a stack
+   */
+  std::vector<unsigned> m_freeServers;
+
+  /**
+   * The most items waiting for a server, 0 is unbounded
+   */
+  size_t m_capacity;
+
+  CCNxDelayQueueDropPolicy m_dropPolicy;
+  size_t m_redMinThreshold;
+  size_t m_redMaxThreshold;
+  double m_redMaxProbability;
+  double m_redQueueWeight;
+
+  /**
+   * The RED moving average of the number of waiting items
+   */
+  double m_redAverage;
+
+  Ptr<UniformRandomVariable> m_random;
+
+  uint64_t m_dropCount;
+
+  ClassifyCallback m_classify;
+  CCNxDelayQueueScheduler m_scheduler;
+  std::vector<unsigned> m_classWeights;
+  std::vector<ClassStats> m_classStats;
+
+  /**
+   * The number of items in all of m_classQueues
+   */
+  size_t m_waitingCount;
+
+  /**
+   * The class weighted round robin is serving and how many more items it may take from it
+   */
+  size_t m_wrrClass;
+  unsigned m_wrrCredit;
 };
 
 }   /* namespace ccnx */
@@ -332,6 +332,8 @@ public:
     DROP_NO_ROUTE,          /**< No route to host */
     DROP_INTERFACE_DOWN,    /**< Interface is down so can not send packet */
     DROP_ROUTE_ERROR,       /**< Route error */
+    DROP_BAD_HEADER,        /**< Malformed or truncated fixed header */
+    DROP_UNSUPPORTED_TYPE,  /**< Packet type with no message codec (e.g. InterestReturn) */
   };
 
   /**
@@ -360,7 +362,8 @@ public:
    *
    * @param [in] ccnx The CCNx L3 reporting the trace
    * @param [in] packet The packet.
-   * @param [in] ccnxPacket The CCNx Packet
+   * @param [in] ccnxPacket The CCNx Packet, null if the packet was dropped before it was decoded
+   *             (DROP_BAD_HEADER, DROP_UNSUPPORTED_TYPE, and a DROP_TTL_EXPIRED on receive)
    * @param [in] interface
    * @param [in] reason The reason the packet was dropped.
    */
@@ -99,6 +99,18 @@ CCNxRoute::AddNexthop (Ptr<const CCNxRouteEntry> nexthop)
     }
 }
 
+Ptr<const CCNxRouteEntry>
+CCNxRoute::GetNexthop (Ptr<CCNxConnection> connection) const
+{
+  Ptr<const CCNxRouteEntry> entry;
+  ConnectionMapType::const_iterator i = m_connectionsMap.find (connection);
+  if (i != m_connectionsMap.end ())
+    {
+      entry = i->second;
+    }
+  return entry;
+}
+
 const CCNxRoute::NexthopListType
 CCNxRoute::GetNexthops (void) const
 {
@@ -121,6 +121,14 @@ public:
   size_t RemoveNexthop (Ptr<CCNxConnection> connection);
 
 
+  /**
+   * Returns the nexthop entry for a connection.
+   *
+   * @param [in] connection The connection to look up
+   * @return The entry for the connection, or null if the connection is not a nexthop
+   */
+  Ptr<const CCNxRouteEntry> GetNexthop (Ptr<CCNxConnection> connection) const;
+
   typedef std::vector< Ptr<const CCNxRouteEntry> > NexthopListType;
 
   /**
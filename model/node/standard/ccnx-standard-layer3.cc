@@ -343,13 +343,19 @@ void
 CCNxStandardLayer3::RouteCallback (Ptr<CCNxPacket> ccnxPacket, Ptr<CCNxConnection> ingress,
                                    enum CCNxRoutingError::RoutingErrno routingErrno, Ptr<CCNxConnectionList> egress)
 {
+  // Serialized once and shared by every trace below and by each egress connection
+  Ptr<const Packet> ns3Packet = ccnxPacket->GetNs3Packet ();
 
   if (egress->size () == 0)
     {
       NS_LOG_WARN ("forwarder return an empty result " << *ccnxPacket->GetMessage ()->GetName ());
-      m_dropTrace (this, ccnxPacket->CreateNs3Packet (), ccnxPacket, ingress->GetConnectionId (), DROP_NO_ROUTE);
+      m_dropTrace (this, ns3Packet, ccnxPacket, ingress->GetConnectionId (), DROP_NO_ROUTE);
     }
 
+  // An Interest with no hops left may only go to local (layer 4) connections
+  bool hopLimitExpired = ccnxPacket->GetFixedHeader ()->GetPacketType () == CCNxFixedHeaderType_Interest
+    && ccnxPacket->GetHopLimit () == 0;
+
   Ptr<CCNxConnection> egressFromForwarder;
 
   for (CCNxConnectionList::iterator it = egress->begin (); it != egress->end (); it++)
@@ -358,19 +364,26 @@ CCNxStandardLayer3::RouteCallback (Ptr<CCNxPacket> ccnxPacket, Ptr<CCNxConnectio
 
       if (routingErrno == CCNxRoutingError::CCNxRoutingError_NoError)
         {
-          NS_LOG_DEBUG ("SendCCNxPacket using egress connid " << egressFromForwarder->GetConnectionId () << " packet " << *ccnxPacket->CreateNs3Packet ());
-          m_txTrace (this, ccnxPacket->CreateNs3Packet (), ccnxPacket, egressFromForwarder->GetConnectionId ());
+          if (hopLimitExpired && DynamicCast<CCNxConnectionDevice, CCNxConnection> (egressFromForwarder))
+            {
+              NS_LOG_INFO ("Hop limit expired, not sending to connid " << egressFromForwarder->GetConnectionId ());
+              m_dropTrace (this, ns3Packet, ccnxPacket, egressFromForwarder->GetConnectionId (), DROP_TTL_EXPIRED);
+              continue;
+            }
+
+          NS_LOG_DEBUG ("SendCCNxPacket using egress connid " << egressFromForwarder->GetConnectionId () << " packet " << *ns3Packet);
+          m_txTrace (this, ns3Packet, ccnxPacket, egressFromForwarder->GetConnectionId ());
           bool result = egressFromForwarder->Send (ccnxPacket, ingress);
           if (!result)     //Send failed
             {
               NS_LOG_WARN ("Send failed!");
-              m_dropTrace (this, ccnxPacket->CreateNs3Packet (), ccnxPacket, -1, DROP_INTERFACE_DOWN);
+              m_dropTrace (this, ns3Packet, ccnxPacket, -1, DROP_INTERFACE_DOWN);
             }
         }
       else
         {
           NS_LOG_WARN ("Routing Error " << *ccnxPacket->GetMessage ()->GetName ());
-          m_dropTrace (this, ccnxPacket->CreateNs3Packet (), ccnxPacket, ingress->GetConnectionId (), DROP_NO_ROUTE);
+          m_dropTrace (this, ns3Packet, ccnxPacket, ingress->GetConnectionId (), DROP_NO_ROUTE);
         }
     }
 }
@@ -401,7 +414,7 @@ CCNxStandardLayer3::SendFromLayer4 (const CCNxL4Protocol &protocol, Ptr<CCNxPack
   NS_LOG_FUNCTION (this << &protocol << ccnxPacket);
 
   // serialize it
-  Ptr<Packet> ns3Packet = ccnxPacket->CreateNs3Packet ();
+  Ptr<const Packet> ns3Packet = ccnxPacket->GetNs3Packet ();
 
   m_rxTrace (this, ns3Packet, ccnxPacket, id);
 
@@ -431,7 +444,7 @@ CCNxStandardLayer3::SendToFromLayer4 (const CCNxL4Protocol &protocol, Ptr<CCNxPa
   NS_LOG_FUNCTION (this << &protocol << ccnxPacket);
 
   // serialize it
-  Ptr<Packet> ns3Packet = ccnxPacket->CreateNs3Packet ();
+  Ptr<const Packet> ns3Packet = ccnxPacket->GetNs3Packet ();
 
   m_rxTrace (this, ns3Packet, ccnxPacket, id);
 
@@ -492,16 +505,49 @@ CCNxStandardLayer3::ReceiveFromLayer2 (Ptr<NetDevice> device, Ptr<const Packet>
           ingress = i->second;
         }
 
+      // Look at only the fixed header first, so a packet we would drop is never decoded
+      CCNxFixedHeaderType packetType;
+      uint8_t hopLimit;
+      CCNxCodecFixedHeader::CheckResult check = CCNxCodecFixedHeader::Check (packet, packetType, hopLimit);
+      if (check == CCNxCodecFixedHeader::CHECK_UNSUPPORTED_PACKET_TYPE)
+        {
+          NS_LOG_INFO ("Node " << m_node->GetId () << " unsupported packet type from " << from);
+          m_dropTrace (this, packet, Ptr<const CCNxPacket> (0), ingress->GetConnectionId (), DROP_UNSUPPORTED_TYPE);
+          return;
+        }
+
+      if (check != CCNxCodecFixedHeader::CHECK_OK)
+        {
+          NS_LOG_WARN ("Node " << m_node->GetId () << " bad fixed header (" << check << ") from " << from);
+          m_dropTrace (this, packet, Ptr<const CCNxPacket> (0), ingress->GetConnectionId (), DROP_BAD_HEADER);
+          return;
+        }
+
+      // An Interest from another forwarder must arrive with a positive hop limit
+      if (packetType == CCNxFixedHeaderType_Interest && hopLimit == 0)
+        {
+          NS_LOG_INFO ("Node " << m_node->GetId () << " hop limit expired from " << from);
+          m_dropTrace (this, packet, Ptr<const CCNxPacket> (0), ingress->GetConnectionId (), DROP_TTL_EXPIRED);
+          return;
+        }
+
       // Deserialize the packet, then grab the output from the ccnxPacket, as that
       // will be properly trimed of any layer 3 bloat in the ns3 packet.
       Ptr<CCNxPacket> ccnxPacket = CCNxPacket::CreateFromNs3Packet (packet);
-      packet = ccnxPacket->CreateNs3Packet ();
+      Ptr<const Packet> ns3Packet = ccnxPacket->GetNs3Packet ();
 
-      NS_ASSERT_MSG (ccnxPacket->GetFixedHeader ()->GetPacketLength () == packet->GetSize (),
+      NS_ASSERT_MSG (ccnxPacket->GetFixedHeader ()->GetPacketLength () == ns3Packet->GetSize (),
                      "Packet wrong size, FixedHeader = " << (uint32_t) ccnxPacket->GetFixedHeader ()->GetPacketLength () <<
-                     ", packet->GetSize() = " << packet->GetSize () << ", packet = " << *packet);
+                     ", packet->GetSize() = " << ns3Packet->GetSize () << ", packet = " << *ns3Packet);
+
+      m_rxTrace (this, ns3Packet, ccnxPacket, ingress->GetConnectionId ());
 
-      m_rxTrace (this, packet, ccnxPacket, ingress->GetConnectionId ());
+      // Count this hop.  An Interest that reaches 0 may still go to a local application,
+      // but RouteCallback() will not send it to another forwarder.
+      if (packetType == CCNxFixedHeaderType_Interest)
+        {
+          ccnxPacket->SetHopLimit (hopLimit - 1);
+        }
 
       m_forwarder->RouteInput (ccnxPacket, ingress);
     } //GetInterfaceForwarding
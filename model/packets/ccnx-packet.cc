@@ -56,12 +56,87 @@
 #include "ns3/tag.h"
 #include "ns3/ccnx-packet.h"
 #include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/object-factory.h"
+#include "ns3/ccnx-codec-registry.h"
 
 using namespace ns3;
 using namespace ns3::ccnx;
 
 NS_LOG_COMPONENT_DEFINE ("CCNxPacket");
 
+static GlobalValue g_contentObjectHasher ("CCNxContentObjectHasher",
+                                          "The TypeId of the CCNxHasher used for the ContentObjectHash",
+                                          StringValue ("ns3::ccnx::CCNxHasherFnv1a"),
+                                          MakeStringChecker ());
+
+static GlobalValue g_lazyDecode ("CCNxPacketLazyDecode",
+                                  "If true, a received CCNxPacket decodes its message on first access "
+                                  "and keeps the payload encoded until it is read",
+                                  BooleanValue (true),
+                                  MakeBooleanChecker ());
+
+static Ptr<CCNxHasher> _contentObjectHasher;
+
+/**
+ * Cached value of g_lazyDecode, -1 until read.
+ */
+static int _lazyDecode = -1;
+
+const uint8_t CCNxPacket::DefaultHopLimit;
+
+/**
+ * Not a real header: `Packet::PeekHeader()` hands its `Deserialize()` an iterator over the packet's
+ * own buffer, so the hasher reads the message in place without copying it out of the packet.
+ */
+class CCNxContentObjectHashReader : public Header
+{
+public:
+  explicit CCNxContentObjectHashReader (Ptr<CCNxHasher> hasher) : m_hasher (hasher), m_length (0)
+  {
+  }
+
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::ccnx::CCNxContentObjectHashReader")
+      .SetParent<Header> ()
+      .SetGroupName ("CCNx");
+    return tid;
+  }
+
+  virtual TypeId GetInstanceTypeId (void) const
+  {
+    return GetTypeId ();
+  }
+
+  virtual uint32_t GetSerializedSize (void) const
+  {
+    return m_length;
+  }
+
+  virtual void Serialize (Buffer::Iterator start) const
+  {
+    NS_FATAL_ERROR ("CCNxContentObjectHashReader only reads");
+  }
+
+  virtual uint32_t Deserialize (Buffer::Iterator start)
+  {
+    m_length = m_hasher->Update (start);
+    return m_length;
+  }
+
+  virtual void Print (std::ostream &os) const
+  {
+    os << "hashed " << m_length << " bytes";
+  }
+
+private:
+  Ptr<CCNxHasher> m_hasher;
+  uint32_t m_length;
+};
+
 //static inline void
 //hexdump (const char *label, size_t size, const uint8_t *data)
 //{
@@ -114,7 +189,7 @@ CCNxPacket::CreateFromNs3Packet (Ptr<const Packet> ns3Packet)
   return packet;
 }
 
-CCNxPacket::CCNxPacket () : m_hash (0)
+CCNxPacket::CCNxPacket () : m_messageSize (0), m_hash (0), m_hashValid (false)
 {
   // emtpy protected method
 }
@@ -127,6 +202,7 @@ CCNxPacket::~CCNxPacket ()
 void CCNxPacket::DoDispose (void)
 {
   m_ns3Packet = 0;
+  m_ns3Message = 0;
 }
 
 Ptr<Packet>
@@ -140,6 +216,23 @@ CCNxPacket::CreateNs3Packet ()
   return m_ns3Packet->Copy ();
 }
 
+Ptr<const Packet>
+CCNxPacket::GetNs3Packet ()
+{
+  if (m_ns3Packet == NULL)
+    {
+      m_ns3Packet = GenerateNs3Packet ();
+    }
+
+  return m_ns3Packet;
+}
+
+uint32_t
+CCNxPacket::GetWireSize (void) const
+{
+  return ComputePacketSize ();
+}
+
 Ptr<CCNxFixedHeader>
 CCNxPacket::GetFixedHeader () const
 {
@@ -149,6 +242,10 @@ CCNxPacket::GetFixedHeader () const
 Ptr<CCNxMessage>
 CCNxPacket::GetMessage () const
 {
+  if (!m_message && m_ns3Message)
+    {
+      DecodeMessage ();
+    }
   return m_message;
 }
 
@@ -167,65 +264,48 @@ CCNxPacket::GetPerhopHeaders() const
 size_t
 CCNxPacket::ComputePacketSize () const
 {
-  size_t length = 0;
-
-  length += m_codecFixedHeader.GetSerializedSize ();
-
-  CCNxMessage::MessageType messageType = m_message->GetMessageType ();
-  if ( messageType == CCNxMessage::Interest)
-    {
-      Ptr<CCNxInterest> interest = DynamicCast<CCNxInterest, CCNxMessage> (m_message);
-      CCNxCodecInterest codec;
-      codec.SetHeader (interest);
-      length += codec.GetSerializedSize ();
+  return m_codecFixedHeader.GetSerializedSize () + GetMessageSize ();
+}
 
-    }
-  else if (messageType == CCNxMessage::ContentObject)
-    {
-      Ptr<CCNxContentObject> content = DynamicCast<CCNxContentObject, CCNxMessage> (m_message);
-      CCNxCodecContentObject codec;
-      codec.SetHeader (content);
-      length += codec.GetSerializedSize ();
-    }
-  else
+uint32_t
+CCNxPacket::GetMessageSize () const
+{
+  if (m_messageSize == 0)
     {
-      NS_ASSERT_MSG (false, "Unsupported m_message run time type " << messageType);
+      const CCNxCodecRegistry::MessageCodec &codec = CCNxCodecRegistry::LookupMessageCodec (m_message->GetMessageType ());
+      m_messageSize = codec.GetSerializedSize (m_message);
     }
-  return length;
+  return m_messageSize;
 }
 
 /*
- * This will create a virtual packet that does not actually allocate any bytes for payload.
- * We tell it how big it is and attach the CCNxPacket as a tag.
+ * The message is encoded only the first time.  Later versions of the packet (e.g. after
+ * adding a per hop header) put a new fixed header in front of a copy of the cached message,
+ * which shares its buffer.
  */
 Ptr<Packet>
 CCNxPacket::GenerateNs3Packet ()
 {
-  Ptr<CCNxFixedHeader> fh = GenerateFixedHeader (m_message->GetMessageType ());
-  m_codecFixedHeader.SetFixedHeader (fh);
-
-  Ptr<Packet> p = Create<Packet> ();
+  // A received packet might not have decoded its message, so go by the fixed header
+  const CCNxCodecRegistry::MessageCodec &codec = CCNxCodecRegistry::LookupMessageCodec (GetFixedHeader ()->GetPacketType ());
+  CCNxMessage::MessageType messageType = codec.messageType;
 
-  CCNxMessage::MessageType messageType = m_message->GetMessageType ();
-  if ( messageType == CCNxMessage::Interest)
+  if (m_ns3Message == NULL)
     {
-      Ptr<CCNxInterest> interest = DynamicCast<CCNxInterest, CCNxMessage> (m_message);
-      m_codecInterest.SetHeader (interest);
-      p->AddHeader (m_codecInterest);
+      m_ns3Message = Create<Packet> ();
+      codec.Serialize (m_message, m_ns3Message);
 
-    }
-  else if (messageType == CCNxMessage::ContentObject)
-    {
-      Ptr<CCNxContentObject> content = DynamicCast<CCNxContentObject, CCNxMessage> (m_message);
-      m_codecContentObject.SetHeader (content);
-      p->AddHeader (m_codecContentObject);
-    }
-  else
-    {
-      NS_ASSERT_MSG (false, "Unsupported m_message run time type " << messageType);
+      if (messageType == CCNxMessage::ContentObject && !m_hashValid)
+        {
+          ComputeContentObjectHash (m_ns3Message);
+        }
     }
 
+  Ptr<CCNxFixedHeader> fh = GenerateFixedHeader (messageType);
+  m_codecFixedHeader.SetFixedHeader (fh);
+
   // The fixed header/per hop header goes outside the message header
+  Ptr<Packet> p = m_ns3Message->Copy ();
   p->AddHeader (m_codecFixedHeader);
 
   size_t expectedSize = ComputePacketSize ();
@@ -234,8 +314,6 @@ CCNxPacket::GenerateNs3Packet ()
   NS_ASSERT_MSG (expectedSize == fh->GetPacketLength (), "Fixed Header size " << fh->GetPacketLength () <<
                  " does not match expected size " << expectedSize);
 
-  // TODO: Add PacketTag of the Hash
-
   return p;
 }
 
@@ -246,8 +324,13 @@ CCNxPacket::GenerateFixedHeader (CCNxMessage::MessageType messageType) const
   size_t packetLength = ComputePacketSize ();
   CCNxFixedHeaderType type = GetMessageTypeAsPacketType (messageType);
   uint32_t headerLength = m_codecFixedHeader.GetSerializedSize ();
+  // Keep the fields of the current fixed header, if any (e.g. a received packet)
   uint8_t hopLimit = GetHopLimit ();
   uint8_t returnCode = GetReturnCode ();
+  if (!GetFixedHeader () && type == CCNxFixedHeaderType_Interest)
+    {
+      hopLimit = DefaultHopLimit;
+    }
 
   NS_ASSERT_MSG (headerLength <= 0xFF, "headerLength too long");
   NS_ASSERT_MSG (packetLength <= 0xFFFF, "packetLength too long");
@@ -260,26 +343,28 @@ CCNxPacket::GenerateFixedHeader (CCNxMessage::MessageType messageType) const
 CCNxFixedHeaderType
 CCNxPacket::GetMessageTypeAsPacketType (CCNxMessage::MessageType messageType = CCNxMessage::Interest) const
 {
-  CCNxFixedHeaderType packetType = CCNxFixedHeaderType_Interest;
-  if (messageType == CCNxMessage::ContentObject)
-    {
-      packetType = CCNxFixedHeaderType_Object;
-    }
-  return packetType;
+  return CCNxCodecRegistry::LookupMessageCodec (messageType).packetType;
 }
 
 uint8_t
 CCNxPacket::GetHopLimit (void) const
 {
-  // FIXME
-  return 0;
+  Ptr<CCNxFixedHeader> fh = GetFixedHeader ();
+  return fh ? fh->GetHopLimit () : 0;
+}
+
+void
+CCNxPacket::SetHopLimit (uint8_t hopLimit)
+{
+  GetFixedHeader ()->SetHopLimit (hopLimit);
+  m_ns3Packet = 0;
 }
 
 uint8_t
 CCNxPacket::GetReturnCode (void) const
 {
-  // FIXME
-  return 0;
+  Ptr<CCNxFixedHeader> fh = GetFixedHeader ();
+  return fh ? fh->GetReturnCode () : 0;
 }
 
 /**
@@ -312,38 +397,98 @@ CCNxPacket::Deserialize ()
   uint32_t hdrSize = copy->RemoveHeader (m_codecFixedHeader);
   NS_LOG_DEBUG ("Deserialize: hdrSize = " << hdrSize);
 
-  switch (m_codecFixedHeader.GetFixedHeader ()->GetPacketType ())
+  // Keep the encoded message so a new version of this packet only re-encodes the fixed header
+  m_messageSize = GetFixedHeader ()->GetPacketLength () - hdrSize;
+  m_ns3Message = copy->CreateFragment (0, m_messageSize);
+
+  // Asserts on a packet type we cannot decode
+  CCNxCodecRegistry::LookupMessageCodec (GetFixedHeader ()->GetPacketType ());
+
+  if (!GetLazyDecode ())
     {
-    case CCNxFixedHeaderType_Interest:
-      {
-        uint32_t msgSize = copy->RemoveHeader (m_codecInterest);
-        NS_LOG_DEBUG ("Deserialize: interest = " << msgSize);
-        m_message = m_codecInterest.GetHeader ();
-        break;
-      }
-    case CCNxFixedHeaderType_Object:
-      {
-        uint32_t msgSize = copy->RemoveHeader (m_codecContentObject);
-        NS_LOG_DEBUG ("Deserialize: content = " << msgSize);
-        m_message = m_codecContentObject.GetHeader ();
-        break;
-      }
-    default:
-      NS_ASSERT_MSG (false, "Unsupported Packet Type");
+      DecodeMessage ();
+      GetPerhopHeaders ();
+      GetContentObjectHash ();
     }
 
   TrimNs3Packet ();
 }
 
+void
+CCNxPacket::DecodeMessage () const
+{
+  const CCNxCodecRegistry::MessageCodec &codec = CCNxCodecRegistry::LookupMessageCodec (GetFixedHeader ()->GetPacketType ());
+  m_message = codec.Deserialize (m_ns3Message, GetLazyDecode ());
+  NS_LOG_DEBUG ("Deserialize: message type " << m_message->GetMessageType ());
+}
+
+void
+CCNxPacket::ComputeContentObjectHash (Ptr<const Packet> message) const
+{
+  Ptr<CCNxHasher> hasher = GetContentObjectHasher ();
+  hasher->Init ();
+  CCNxContentObjectHashReader reader (hasher);
+  uint32_t length = message->PeekHeader (reader);
+  NS_ASSERT_MSG (length == message->GetSize (), "Hashed " << length << " bytes of a " << message->GetSize () << " byte message");
+  m_hash = *hasher->Finalize ();
+  m_hashValid = true;
+}
+
 void
 CCNxPacket::SetContentObjectHash (Ptr<CCNxHashValue> hash)
 {
   m_hash = hash->GetValue();
+  m_hashValid = true;
+}
+
+void
+CCNxPacket::SetContentObjectHasher (Ptr<CCNxHasher> hasher)
+{
+  _contentObjectHasher = hasher;
+}
+
+Ptr<CCNxHasher>
+CCNxPacket::GetContentObjectHasher (void)
+{
+  if (!_contentObjectHasher)
+    {
+      StringValue typeName;
+      g_contentObjectHasher.GetValue (typeName);
+      ObjectFactory factory;
+      factory.SetTypeId (typeName.Get ());
+      _contentObjectHasher = factory.Create<CCNxHasher> ();
+      NS_ASSERT_MSG (_contentObjectHasher, "Could not create CCNxContentObjectHasher " << typeName.Get ());
+    }
+  return _contentObjectHasher;
+}
+
+void
+CCNxPacket::SetLazyDecode (bool lazy)
+{
+  _lazyDecode = lazy ? 1 : 0;
+}
+
+bool
+CCNxPacket::GetLazyDecode (void)
+{
+  if (_lazyDecode < 0)
+    {
+      BooleanValue lazy;
+      g_lazyDecode.GetValue (lazy);
+      _lazyDecode = lazy.Get () ? 1 : 0;
+    }
+  return _lazyDecode == 1;
 }
 
 Ptr<CCNxHashValue>
 CCNxPacket::GetContentObjectHash (void) const
 {
+  // A received Content Object computes its hash on first use
+  if (!m_hashValid && m_ns3Message && GetFixedHeader ()->GetPacketType () == CCNxFixedHeaderType_Object)
+    {
+      ComputeContentObjectHash (m_ns3Message);
+    }
+
   Ptr<CCNxHashValue> hash = Create<CCNxHashValue> (m_hash.GetValue());
   return hash;
 }
@@ -352,6 +497,7 @@ void
 CCNxPacket::AddPerHopHeaderEntry (Ptr<CCNxPerHopHeaderEntry> perHopHeaderEntry)
 {
   m_codecFixedHeader.GetPerHopHeader()->AddHeader(perHopHeaderEntry);
+  m_ns3Packet = 0;
 }
 
 std::ostream &
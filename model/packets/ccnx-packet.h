@@ -63,6 +63,7 @@
 #include "ns3/ccnx-message.h"
 #include "ns3/ccnx-validation.h"
 #include "ns3/ccnx-hash-value.h"
+#include "ns3/ccnx-hasher.h"
 
 #include "ns3/ccnx-codec-fixedheader.h"
 #include "ns3/ccnx-codec-interest.h"
@@ -87,13 +88,24 @@ namespace ccnx {
  * to avoid using cryptographic functions in simulation.  We only use uint64_t, which the
  * user (applications) are responsible for assigning.
  *
- * The Packet carries a virtual uint64_t hash field that can be used to set the ContentObjectHash
- * value of the packet.  This is supposed to be the SHA256 of the (Message, ValidationAlg).  It is
- * carried as a PacketTag so it is not serialized as part of the packet payload.
+ * The ContentObjectHash of a Content Object is computed once over the serialized message, when the
+ * packet is serialized (`CreateNs3Packet()`) or on the first `GetContentObjectHash()` of a received
+ * packet, and cached on the packet.  The hasher reads the message straight from the ns3::Packet buffer.  The hash function is the CCNxHasher named by the global value "CCNxContentObjectHasher"
+ * (default ns3::ccnx::CCNxHasherFnv1a; ns3::ccnx::CCNxHasherSha256 gives the hash of the
+ * specification, ns3::ccnx::CCNxHasherXxHash64 the cheapest).  Interests have a zero hash.
  *
- * TODO: the virtual hash is not implemented yet.
+ * A packet is serialized at most once per version.  The encoded message is kept for the life of the
+ * packet and only the fixed header is re-encoded when a per hop header is added.  The wire size is
+ * memoized, so GetWireSize() and the fixed header do not serialize anything.  Trace sinks should use
+ * GetNs3Packet(), which shares the cached buffer; egress devices use CreateNs3Packet(), whose
+ * copy-on-write copy also shares it until the device prepends its own headers.
  *
- * TODO: To access the FixedHeader you have to GetNs3Packet() to serialize it.  That's very expensive.
+ * A packet created from an ns3::Packet is decoded lazily (global value "CCNxPacketLazyDecode", default
+ * true).  Deserialization only reads the fixed header.  The message is decoded on the first call
+ * to GetMessage(), but its payload stays a fragment of the received packet until
+ * CCNxMessage::GetPayload() is called.  The per hop headers are decoded by GetPerhopHeaders(), and the
+ * ContentObjectHash is computed by GetContentObjectHash().  A transit hop that only looks at the
+ * name never copies the payload.  With lazy decoding off, everything is decoded in CreateFromNs3Packet().
  *
  * You create a CCNxPacket by using one of the static CreateFromX() methods.
  * This is because there is a problem with overloading constructors in CCNxPacket because they are all flavors
@@ -117,14 +129,43 @@ public:
 
   Ptr<CCNxFixedHeader> GetFixedHeader () const;
 
+  /**
+   * Returns the message.  For a received packet, the message is decoded on the first call.
+   */
   Ptr<CCNxMessage> GetMessage () const;
 
   Ptr<CCNxValidation> GetValidation () const;
 
   Ptr<CCNxPerHopHeader> GetPerhopHeaders() const;
 
+  /**
+   * Adds a per hop header.  This starts a new version of the packet: the next serialization
+   * re-encodes the fixed header in front of the cached message.
+   */
   void AddPerHopHeaderEntry (Ptr<CCNxPerHopHeaderEntry> perHopHeaderEntry);
 
+  /**
+   * The HopLimit from the fixed header.  A new Interest starts at `DefaultHopLimit`, a
+   * new Content Object at 0.
+   */
+  uint8_t GetHopLimit (void) const;
+
+  /**
+   * Sets the HopLimit in the fixed header.  Like AddPerHopHeaderEntry(), this starts a new
+   * version of the packet without re-encoding the message.
+   */
+  void SetHopLimit (uint8_t hopLimit);
+
+  /**
+   * The ReturnCode from the fixed header
+   */
+  uint8_t GetReturnCode (void) const;
+
+  /**
+   * The HopLimit of an Interest created by CreateFromMessage()
+   */
+  static const uint8_t DefaultHopLimit = 255;
+
   /**
    * This serializes in to the NS3 Packet format and returns the result.
    *
@@ -134,17 +175,52 @@ public:
   Ptr<Packet> CreateNs3Packet ();
 
   /**
-   * Set a virtual ContentObjectHash on the packet.  The hash is carried along with the packet to
-   * allow "calculating" the hash without using a SHA.  It is carried in an ns3::Packet as a PacketTag.
+   * Returns the cached NS3 Packet, serializing it on first use.  The packet is shared
+   * by all callers and must not be modified, so use it for traces and logging.
+   */
+  Ptr<const Packet> GetNs3Packet ();
+
+  /**
+   * The length in bytes of the serialized packet (fixed header, per hop headers, message).
+   * The message length is computed once and remembered.
+   */
+  uint32_t GetWireSize (void) const;
+
+  /**
+   * Set the ContentObjectHash of the packet.  It replaces the computed hash on this packet only, it
+   * is not carried to the next hop.
    */
   void SetContentObjectHash (Ptr<CCNxHashValue> hash);
 
   /**
-   * Get a virtual ContentObjectHash on the packet.  The hash is carried along with the packet to
-   * allow "calculating" the hash without using a SHA.  It is carried in an ns3::Packet as a PacketTag.
+   * Get the ContentObjectHash of the packet.  It is zero until the packet is serialized or if it
+   * was created from an Interest.
    */
   Ptr<CCNxHashValue> GetContentObjectHash (void) const;
 
+  /**
+   * Sets the hasher used for the ContentObjectHash of all packets, replacing the one from
+   * the global value "CCNxContentObjectHasher".
+   */
+  static void SetContentObjectHasher (Ptr<CCNxHasher> hasher);
+
+  /**
+   * The hasher used for the ContentObjectHash.  Created from the global value
+   * "CCNxContentObjectHasher" on first use.
+   */
+  static Ptr<CCNxHasher> GetContentObjectHasher (void);
+
+  /**
+   * Sets whether packets created by CreateFromNs3Packet() are decoded lazily, replacing the
+   * global value "CCNxPacketLazyDecode".
+   */
+  static void SetLazyDecode (bool lazy);
+
+  /**
+   * True if packets created by CreateFromNs3Packet() are decoded lazily.
+   */
+  static bool GetLazyDecode (void);
+
 protected:
   /**
    * Generic packet creation, use one of the static factories.
@@ -160,32 +236,46 @@ protected:
 
   uint32_t GetPerHopHeaderLength (void) const;
 
-  uint8_t GetHopLimit (void) const;
-
-  uint8_t GetReturnCode (void) const;
-
   size_t ComputePacketSize (void) const;
 
+  /**
+   * The serialized length of m_message.  Computed on first use and remembered.
+   */
+  uint32_t GetMessageSize (void) const;
+
   virtual void DoDispose (void);
 
   /**
-   * Set the fixed header, message, validation from the m_ns3Packet member.
+   * Set the fixed header and the encoded message from the m_ns3Packet member.  The message
+   * is decoded here only if lazy decoding is off.
    */
   void Deserialize ();
 
+  /**
+   * Set m_message from m_ns3Message.  In lazy mode the payload is left encoded.
+   */
+  void DecodeMessage () const;
+
   /**
    * Trim m_ns3Packet to the length specified in the Fixed Header.
    */
   void TrimNs3Packet ();
 
+  /**
+   * Set m_hash to the hash of `message`, the encoded message.  The hasher reads the packet's
+   * buffer in place.
+   */
+  void ComputeContentObjectHash (Ptr<const Packet> message) const;
+
   CCNxCodecFixedHeader m_codecFixedHeader;
-  CCNxCodecInterest m_codecInterest;
-  CCNxCodecContentObject m_codecContentObject;
 
-  Ptr<CCNxMessage> m_message;
+  mutable Ptr<CCNxMessage> m_message;                //<! 0 until decoded from m_ns3Message
   Ptr<CCNxValidation> m_validation;
-  Ptr<Packet> m_ns3Packet;
-  CCNxHashValue m_hash;                              //<! virtual PacketTag for ContentObjectHash
+  Ptr<Packet> m_ns3Packet;                           //<! Serialized packet, 0 if not current
+  Ptr<Packet> m_ns3Message;                          //<! Serialized message without the fixed header
+  mutable uint32_t m_messageSize;                    //<! Memoized message length, 0 if not computed
+  mutable CCNxHashValue m_hash;                      //<! ContentObjectHash
+  mutable bool m_hashValid;                          //<! true if m_hash was computed or set
 };
 
 std::ostream &operator<< (std::ostream &os, CCNxPacket const &packet);
@@ -99,9 +99,9 @@ CCNxCodecContentObject::GetSerializedSize (void) const
       bytes += CCNxTlv::GetTLSize () + 8;
     }
 
-  if (m_content->GetPayload ())
+  if (m_content->HasPayload ())
     {
-      bytes += CCNxTlv::GetTLSize () + m_content->GetPayload ()->GetSize ();
+      bytes += CCNxTlv::GetTLSize () + m_content->GetPayloadSize ();
     }
 
   return bytes;
@@ -154,6 +154,7 @@ CCNxCodecContentObject::Deserialize (Buffer::Iterator inputIterator)
   Buffer::Iterator iterator = inputIterator;
 
   uint32_t bytesRead = 0;
+  m_payloadDeferred = false;
 
   uint16_t messageType = CCNxTlv::ReadType (iterator);
   if (messageType == CCNxSchemaV1::T_OBJECT)
@@ -161,6 +162,10 @@ CCNxCodecContentObject::Deserialize (Buffer::Iterator inputIterator)
       uint16_t messageLength = CCNxTlv::ReadLength (iterator);
       NS_LOG_DEBUG ("Message type " << messageType << " length " << messageLength);
 
+      // The message TLVs are walked with the Buffer::Iterator, not a CCNxTlvCursor.  The cursor needs
+      // the container in contiguous memory, and copying the message out would also copy the T_PAYLOAD
+      // value that SetDeferPayload() skips.  The T_NAME container is walked with the cursor by CCNxCodecName.
+      //
       // Do not count the initial 4 bytes read until the very end so we can compare
       // bytesRead against messageLength (which is the inner length)
 
@@ -194,7 +199,18 @@ CCNxCodecContentObject::Deserialize (Buffer::Iterator inputIterator)
               break;
 
             case CCNxSchemaV1::T_PAYLOAD:
-              payload = DeserializePayload (iterator, nestedLength);
+              if (m_deferPayload)
+                {
+                  // bytesRead does not yet include the message TL
+                  m_payloadDeferred = true;
+                  m_payloadOffset = CCNxTlv::GetTLSize () + bytesRead;
+                  m_payloadLength = nestedLength;
+                  iterator.Next (nestedLength);
+                }
+              else
+                {
+                  payload = DeserializePayload (iterator, nestedLength);
+                }
               break;
 
             default:
@@ -286,7 +302,8 @@ CCNxCodecContentObject::Print (std::ostream &os) const
     }
 }
 
-CCNxCodecContentObject::CCNxCodecContentObject () : m_content (0)
+CCNxCodecContentObject::CCNxCodecContentObject () : m_content (0), m_deferPayload (false), m_payloadDeferred (false),
+  m_payloadOffset (0), m_payloadLength (0)
 {
   // empty
 }
@@ -309,6 +326,30 @@ CCNxCodecContentObject::SetHeader (Ptr<CCNxContentObject> content)
   m_nameCodec.SetHeader (m_content->GetName ());
 }
 
+void
+CCNxCodecContentObject::SetDeferPayload (bool defer)
+{
+  m_deferPayload = defer;
+}
+
+bool
+CCNxCodecContentObject::HasDeferredPayload (void) const
+{
+  return m_payloadDeferred;
+}
+
+uint32_t
+CCNxCodecContentObject::GetDeferredPayloadOffset (void) const
+{
+  return m_payloadOffset;
+}
+
+uint32_t
+CCNxCodecContentObject::GetDeferredPayloadLength (void) const
+{
+  return m_payloadLength;
+}
+
 uint8_t
 CCNxCodecContentObject::SerializePayloadTypeToSchemaValue (CCNxContentObjectPayloadType type)
 {
@@ -55,6 +55,7 @@
 
 #include "ns3/log.h"
 #include "ccnx-codec-fixedheader.h"
+#include "ns3/ccnx-schema-v1.h"
 #include "ns3/ccnx-tlv.h"
 #include "ccnx-codec-registry.h"
 
@@ -88,6 +89,11 @@ CCNxCodecFixedHeader::GetSerializedSize (void) const
 {
   uint32_t length = 8; // Length of fixed size header
 
+  if (m_perHopEncoded)
+    {
+      return length + m_encodedPerHop.GetSize ();
+    }
+
   // Check if there are any per hop headers and add length (if any)
   for (size_t i = 0; i < GetPerHopHeader()->size(); ++i)
   {
@@ -115,6 +121,12 @@ CCNxCodecFixedHeader::Serialize (Buffer::Iterator start) const
   i.WriteU8 (0); // reserved byte
   i.WriteU8 (GetSerializedSize());
 
+  if (m_perHopEncoded)
+    {
+      i.Write (m_encodedPerHop.Begin (), m_encodedPerHop.End ());
+      return;
+    }
+
   for (size_t k = 0; k < GetPerHopHeader()->size(); ++k)
   {
       Ptr<CCNxPerHopHeaderEntry> perhopEntry = GetPerHopHeader()->GetHeader(k);
@@ -146,8 +158,78 @@ CCNxCodecFixedHeader::Deserialize (Buffer::Iterator start)
 
   NS_LOG_DEBUG ("Fixed Header: " << *m_fixedheader);
 
+  NS_ASSERT_MSG (headerLength >= 8, "Header length must be at least 8 bytes");
   uint32_t perhopLen = headerLength - 8;
 
+  // Keep the per hop headers encoded until someone asks for them
+  m_perHopHeader = Create<CCNxPerHopHeader> ();
+  m_encodedPerHop = Buffer (0);
+  m_perHopEncoded = perhopLen > 0;
+  if (m_perHopEncoded)
+    {
+      Buffer::Iterator end = i;
+      end.Next (perhopLen);
+      m_encodedPerHop.AddAtStart (perhopLen);
+      m_encodedPerHop.Begin ().Write (i, end);
+    }
+
+  return headerLength;
+}
+
+CCNxCodecFixedHeader::CheckResult
+CCNxCodecFixedHeader::Check (Ptr<const Packet> packet, CCNxFixedHeaderType &packetType, uint8_t &hopLimit)
+{
+  uint8_t header[CCNxSchemaV1::FIXED_HEADER_LENGTH];
+  uint32_t size = packet->GetSize ();
+  if (size < sizeof(header))
+    {
+      return CHECK_TRUNCATED;
+    }
+  packet->CopyData (header, sizeof(header));
+
+  if (header[0] != CCNxSchemaV1::VERSION)
+    {
+      return CHECK_BAD_VERSION;
+    }
+
+  if (header[1] != CCNxSchemaV1::PT_INTEREST && header[1] != CCNxSchemaV1::PT_CONTENT
+      && header[1] != CCNxSchemaV1::PT_RETURN)
+    {
+      return CHECK_BAD_PACKET_TYPE;
+    }
+
+  uint16_t packetLength = (uint16_t) ((header[2] << 8) | header[3]);
+  uint8_t headerLength = header[7];
+  if (headerLength < sizeof(header))
+    {
+      return CHECK_BAD_HEADER_LENGTH;
+    }
+
+  // There must be room for at least the message TL after the headers
+  if (packetLength > size || packetLength < headerLength + CCNxTlv::GetTLSize ())
+    {
+      return CHECK_TRUNCATED;
+    }
+
+  // A well formed packet we cannot decode
+  CCNxFixedHeaderType type = PacketTypeEnumFromValue (header[1]);
+  if (!CCNxCodecRegistry::HasMessageCodec (type))
+    {
+      return CHECK_UNSUPPORTED_PACKET_TYPE;
+    }
+
+  packetType = type;
+  hopLimit = header[4];
+  return CHECK_OK;
+}
+
+void
+CCNxCodecFixedHeader::DecodePerHopHeader () const
+{
+  Buffer::Iterator i = m_encodedPerHop.Begin ();
+  uint32_t perhopLen = m_encodedPerHop.GetSize ();
+  m_perHopEncoded = false;
+
   while (perhopLen != 0)
   {
       NS_ASSERT_MSG(perhopLen >= 4, "underrun - not enough bytes for a T and L");
@@ -173,7 +255,7 @@ CCNxCodecFixedHeader::Deserialize (Buffer::Iterator start)
       perhopLen = perhopLen - bytesRead;
   }
 
-    return GetSerializedSize();
+  m_encodedPerHop = Buffer (0);
 }
 
 void
@@ -198,7 +280,7 @@ CCNxCodecFixedHeader::Print (std::ostream &os) const
   }
 }
 
-CCNxCodecFixedHeader::CCNxCodecFixedHeader () : m_fixedheader (0)
+CCNxCodecFixedHeader::CCNxCodecFixedHeader () : m_fixedheader (0), m_perHopEncoded (false)
 {
   m_perHopHeader = Create<CCNxPerHopHeader>();
 }
@@ -223,6 +305,10 @@ CCNxCodecFixedHeader::SetFixedHeader (Ptr<CCNxFixedHeader> header)
 Ptr<CCNxPerHopHeader>
 CCNxCodecFixedHeader::GetPerHopHeader () const
 {
+  if (m_perHopEncoded)
+    {
+      DecodePerHopHeader ();
+    }
   return m_perHopHeader;
 }
 
@@ -231,11 +317,11 @@ CCNxCodecFixedHeader::PacketTypeEnumFromValue (uint8_t value)
 {
   switch (value)
     {
-    case 1:
+    case CCNxSchemaV1::PT_INTEREST:
       return CCNxFixedHeaderType_Interest;
-    case 2:
+    case CCNxSchemaV1::PT_CONTENT:
       return CCNxFixedHeaderType_Object;
-    case 3:
+    case CCNxSchemaV1::PT_RETURN:
       return CCNxFixedHeaderType_InterestReturn;
     default:
       NS_ASSERT_MSG (false, "Unsupported value: " << (uint32_t) value);
@@ -249,11 +335,11 @@ CCNxCodecFixedHeader::PacketTypeValueFromEnum (CCNxFixedHeaderType type)
   switch (type)
     {
     case CCNxFixedHeaderType_Interest:
-      return 1;
+      return CCNxSchemaV1::PT_INTEREST;
     case CCNxFixedHeaderType_Object:
-      return 2;
+      return CCNxSchemaV1::PT_CONTENT;
     case CCNxFixedHeaderType_InterestReturn:
-      return 3;
+      return CCNxSchemaV1::PT_RETURN;
     default:
       NS_ASSERT_MSG (false, "Unsupported value");
     }
@@ -57,6 +57,7 @@
 #define CCNS3SIM_CCNXCODECFIXEDHEADER_H
 
 #include "ns3/header.h"
+#include "ns3/packet.h"
 #include "ns3/ccnx-fixedheader.h"
 #include "ns3/ccnx-perhopheader.h"
 #include "ns3/ccnx-codec-perhopheaderentry.h"
@@ -70,6 +71,10 @@ namespace ccnx {
  * Codec for reading/writing a CCNxFixedHeader. This codec takes care of
  * reading/writing CCNx Per hop header as well.
  *
+ * Deserialize() only decodes the 8 byte fixed header.  The per hop headers are kept
+ * encoded and decoded on the first call to GetPerHopHeader().  Until then Serialize()
+ * writes the encoded bytes back unchanged.
+ *
  */
 class CCNxCodecFixedHeader : public Header
 {
@@ -125,10 +130,34 @@ public:
   void SetFixedHeader (Ptr<CCNxFixedHeader> header);
 
   /**
-   * Returns the internal CCNxPerHopHeader
+   * Returns the internal CCNxPerHopHeader, decoding it if needed.
    */
   Ptr<CCNxPerHopHeader> GetPerHopHeader () const;
 
+  /**
+   * The result of `Check()`
+   */
+  enum CheckResult
+  {
+    CHECK_OK,
+    CHECK_TRUNCATED,          //<! Shorter than 8 bytes, the PacketLength or the HeaderLength plus a message TL
+    CHECK_BAD_VERSION,        //<! Not CCNxSchemaV1::VERSION
+    CHECK_BAD_PACKET_TYPE,    //<! Not one of the CCNxSchemaV1::PT_ values
+    CHECK_BAD_HEADER_LENGTH,  //<! HeaderLength less than 8
+    CHECK_UNSUPPORTED_PACKET_TYPE, //<! A valid packet type with no message codec (InterestReturn)
+  };
+
+  /**
+   * Reads and validates only the 8 byte fixed header at the front of `packet`.  Nothing else
+   * is decoded, so a receiver can reject a packet (or look at its hop limit) before paying for
+   * a full decode.  A packet that passes can be given to Deserialize() and CCNxPacket::CreateFromNs3Packet().
+   *
+   * @param [in] packet The received packet.  It may be longer than the PacketLength (e.g. layer 2 padding).
+   * @param [out] packetType Set if the result is CHECK_OK
+   * @param [out] hopLimit Set if the result is CHECK_OK
+   */
+  static CheckResult Check (Ptr<const Packet> packet, CCNxFixedHeaderType &packetType, uint8_t &hopLimit);
+
 private:
   /**
    * Convert the value of the PacketType byte in to the enum
@@ -140,9 +169,16 @@ private:
    */
   static uint8_t PacketTypeValueFromEnum (CCNxFixedHeaderType type);
 
+  /**
+   * Decode m_encodedPerHop in to m_perHopHeader.
+   */
+  void DecodePerHopHeader () const;
+
   Ptr<CCNxFixedHeader> m_fixedheader;
 
-  Ptr<CCNxPerHopHeader> m_perHopHeader;
+  mutable Ptr<CCNxPerHopHeader> m_perHopHeader;
+  mutable Buffer m_encodedPerHop;             //<! Per hop headers from Deserialize() not yet decoded
+  mutable bool m_perHopEncoded;               //<! true if m_encodedPerHop has not been decoded
 };
 
 } // namespace ccnx
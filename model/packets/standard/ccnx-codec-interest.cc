@@ -99,9 +99,9 @@ CCNxCodecInterest::GetSerializedSize (void) const
       bytes += CCNxTlv::GetTLSize () + 32;
     }
 
-  if (m_interest->GetPayload ())
+  if (m_interest->HasPayload ())
     {
-      bytes += CCNxTlv::GetTLSize () + m_interest->GetPayload ()->GetSize ();
+      bytes += CCNxTlv::GetTLSize () + m_interest->GetPayloadSize ();
     }
 
   return bytes;
@@ -155,6 +155,7 @@ CCNxCodecInterest::Deserialize (Buffer::Iterator inputIterator)
   Buffer::Iterator iterator = inputIterator;
 
   uint32_t bytesRead = 0;
+  m_payloadDeferred = false;
 
   uint16_t messageType = CCNxTlv::ReadType (iterator);
   if (messageType == CCNxSchemaV1::T_INTEREST)
@@ -162,6 +163,10 @@ CCNxCodecInterest::Deserialize (Buffer::Iterator inputIterator)
       uint16_t messageLength = CCNxTlv::ReadLength (iterator);
       NS_LOG_DEBUG ("Message type " << messageType << " length " << messageLength);
 
+      // The message TLVs are walked with the Buffer::Iterator, not a CCNxTlvCursor.  The cursor needs
+      // the container in contiguous memory, and copying the message out would also copy the T_PAYLOAD
+      // value that SetDeferPayload() skips.  The T_NAME container is walked with the cursor by CCNxCodecName.
+      //
       // Do not count the initial 4 bytes read until the very end so we can compare
       // bytesRead against messageLength (which is the inner length)
 
@@ -195,7 +200,18 @@ CCNxCodecInterest::Deserialize (Buffer::Iterator inputIterator)
               break;
 
             case CCNxSchemaV1::T_PAYLOAD:
-              payload = DeserializePayload (iterator, nestedLength);
+              if (m_deferPayload)
+                {
+                  // bytesRead does not yet include the message TL
+                  m_payloadDeferred = true;
+                  m_payloadOffset = CCNxTlv::GetTLSize () + bytesRead;
+                  m_payloadLength = nestedLength;
+                  iterator.Next (nestedLength);
+                }
+              else
+                {
+                  payload = DeserializePayload (iterator, nestedLength);
+                }
               break;
 
             default:
@@ -291,7 +307,8 @@ CCNxCodecInterest::Print (std::ostream &os) const
     }
 }
 
-CCNxCodecInterest::CCNxCodecInterest () : m_interest (0)
+CCNxCodecInterest::CCNxCodecInterest () : m_interest (0), m_deferPayload (false), m_payloadDeferred (false),
+  m_payloadOffset (0), m_payloadLength (0)
 {
   // empty
 }
@@ -314,3 +331,27 @@ CCNxCodecInterest::SetHeader (Ptr<CCNxInterest> interest)
   m_nameCodec.SetHeader (m_interest->GetName ());
 }
 
+void
+CCNxCodecInterest::SetDeferPayload (bool defer)
+{
+  m_deferPayload = defer;
+}
+
+bool
+CCNxCodecInterest::HasDeferredPayload (void) const
+{
+  return m_payloadDeferred;
+}
+
+uint32_t
+CCNxCodecInterest::GetDeferredPayloadOffset (void) const
+{
+  return m_payloadOffset;
+}
+
+uint32_t
+CCNxCodecInterest::GetDeferredPayloadLength (void) const
+{
+  return m_payloadLength;
+}
+
@@ -128,6 +128,28 @@ public:
    */
   void SetHeader (Ptr<CCNxInterest> interest);
 
+  /**
+   * If true, Deserialize() does not copy the T_PAYLOAD value in to the message.  It records
+   * where the value is so the caller can attach the encoded bytes with
+   * CCNxMessage::SetEncodedPayload().  The default is false.
+   */
+  void SetDeferPayload (bool defer);
+
+  /**
+   * True if the last Deserialize() skipped over a T_PAYLOAD because of SetDeferPayload().
+   */
+  bool HasDeferredPayload (void) const;
+
+  /**
+   * The offset of the deferred T_PAYLOAD value from the start of the message TLV.
+   */
+  uint32_t GetDeferredPayloadOffset (void) const;
+
+  /**
+   * The length of the deferred T_PAYLOAD value.
+   */
+  uint32_t GetDeferredPayloadLength (void) const;
+
 private:
   /**
    * The interest to serialize (from SetHeader) or the interest we got from
@@ -136,6 +158,11 @@ private:
   Ptr<CCNxInterest> m_interest;
   CCNxCodecName m_nameCodec;
 
+  bool m_deferPayload;          //<! Skip the payload in Deserialize()
+  bool m_payloadDeferred;       //<! The last Deserialize() skipped a payload
+  uint32_t m_payloadOffset;     //<! Offset of the skipped payload value in the message
+  uint32_t m_payloadLength;     //<! Length of the skipped payload value
+
   /**
    * The start iterator points to the T_NAME Value.  It will be rewinded 4
    * bytes and passed to m_nameCodec for processing.  Side effect is that m_nameCodec
@@ -57,7 +57,6 @@
 #include "ns3/ccnx-codec-name.h"
 #include "ns3/ccnx-schema-v1.h"
 #include "ns3/ccnx-tlv.h"
-#include "ns3/ccnx-name-builder.h"
 
 using namespace ns3;
 using namespace ns3::ccnx;
@@ -90,18 +89,8 @@ CCNxCodecName::GetInstanceTypeId (void) const
 uint32_t
 CCNxCodecName::GetSerializedSize (void) const
 {
-  // TODO: Cache this result
-  uint32_t bytes = typeLengthBytes;   // opening T_NAME
-  unsigned count = m_name->GetSegmentCount ();
-  bytes += typeLengthBytes * count;
-
-  for (unsigned i = 0; i < count; i++)
-    {
-      Ptr<const CCNxNameSegment> segment = m_name->GetSegment (i);
-      bytes += segment->GetValue ().size ();
-    }
-
-  return bytes;
+  // opening T_NAME plus the segment TLVs, which the name keeps in wire layout
+  return typeLengthBytes + m_name->GetEncodedSize ();
 }
 
 void
@@ -112,15 +101,17 @@ CCNxCodecName::Serialize (Buffer::Iterator start) const
 
   CCNxTlv::WriteTypeLength (start, CCNxSchemaV1::T_NAME, bytes - typeLengthBytes);
 
-  unsigned count = m_name->GetSegmentCount ();
-  for (unsigned i = 0; i < count; i++)
+  // The name already holds its segments in wire layout, except the type field is a
+  // CCNxNameSegmentType.  Write the schema type, then the length and value straight
+  // from the name's storage.
+  const uint8_t *storage = m_name->m_storage->m_bytes.data ();
+  const std::vector<uint32_t> &offsets = m_name->m_storage->m_offsets;
+  for (size_t i = 0; i < m_name->m_count; ++i)
     {
-      Ptr<const CCNxNameSegment> segment = m_name->GetSegment (i);
-
-      size_t len = segment->GetValue ().size ();
-      NS_ASSERT_MSG (len <= 0xFFFF, "Name segment length too large");
-      CCNxTlv::WriteTypeLength (start, NameSegmentTypeToSchemaValue (segment->GetType ()), (uint16_t) len);
-      start.Write ((const uint8_t *) segment->GetValue ().c_str (), (uint16_t) len);
+      const uint8_t *p = storage + offsets[i];
+      CCNxNameSegmentType type = (CCNxNameSegmentType) ((p[0] << 8) | p[1]);
+      start.WriteHtonU16 (NameSegmentTypeToSchemaValue (type));
+      start.Write (p + 2, offsets[i + 1] - offsets[i] - 2);
     }
 }
 
@@ -129,7 +120,7 @@ CCNxCodecName::Deserialize (Buffer::Iterator start)
 {
   NS_ASSERT_MSG (start.GetSize () >= CCNxTlv::GetTLSize (), "Must have at least 4 bytes in buffer");
 
-  // don't count the outer T_NAME bytes until after the while() loop so we
+  // don't count the outer T_NAME bytes until after the scan so we
   // can compare directly against outerLength
   uint32_t bytesRead = 0;
   uint16_t outerType = CCNxTlv::ReadType (start);
@@ -139,30 +130,40 @@ CCNxCodecName::Deserialize (Buffer::Iterator start)
 
   m_name = 0;
 
-  CCNxNameBuilder builder;
-
-  while (bytesRead < outerLength)
+  // Read all the segments straight in to the name's segment buffer, then make one pass
+  // over it to check the TLVs, translate the types and record the segment offsets.
+  // Call the protected default constructor
+  Ptr<CCNxName> name = Ptr<CCNxName> (new CCNxName (), false);
+  std::vector<uint8_t> &bytes = name->m_storage->m_bytes;
+  std::vector<uint32_t> &offsets = name->m_storage->m_offsets;
+  bytes.resize (outerLength);
+  if (outerLength > 0)
     {
-      uint16_t innerType = CCNxTlv::ReadType (start);
-      uint16_t innerLength = CCNxTlv::ReadLength (start);
-      bytesRead += typeLengthBytes;
+      start.Read (bytes.data (), outerLength);
+    }
 
-      NS_ASSERT_MSG (innerLength + bytesRead <= outerLength, "innerLength goes beyond end of Name");
+  CCNxTlvCursor cursor (bytes.data (), outerLength);
+  uint16_t innerType;
+  uint16_t innerLength;
+  const uint8_t *value;
+  while (cursor.Next (innerType, innerLength, value))
+    {
       NS_ASSERT_MSG (innerLength > 0, "Empty segments not supported");
 
-      // This is very inefficient.  Need to figure out a better way of managing this memory.
-      uint8_t temp[innerLength];
-      start.Read (temp, innerLength);
-      std::string s ((char *) temp, innerLength);
-      Ptr<const CCNxNameSegment> segment = Create<const CCNxNameSegment> (SchemaValueToNameSegmentType (innerType), s);
-      builder.Append (segment);
+      uint8_t *p = bytes.data () + offsets.back ();
+      uint16_t segmentType = (uint16_t) SchemaValueToNameSegmentType (innerType);
+      p[0] = (uint8_t) (segmentType >> 8);
+      p[1] = (uint8_t) segmentType;
 
-      bytesRead += innerLength;
+      offsets.push_back (cursor.GetOffset ());
     }
 
-  NS_ASSERT_MSG (bytesRead == outerLength, "Did not consume all bytes");
+  NS_ASSERT_MSG (!cursor.HasError (), "innerLength goes beyond end of Name");
+  NS_ASSERT_MSG (cursor.IsEnd (), "Did not consume all bytes");
+  bytesRead = cursor.GetOffset ();
+  name->m_count = offsets.size () - 1;
 
-  m_name = builder.CreateName ();
+  m_name = name;
 
   // Add in the initial 4 bytes from the T_NAME bytes
   return bytesRead + CCNxTlv::GetTLSize ();
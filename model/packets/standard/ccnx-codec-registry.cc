@@ -53,27 +53,153 @@
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
 
+#include "ns3/log.h"
+#include "ns3/ccnx-schema-v1.h"
+#include "ns3/ccnx-codec-interest.h"
+#include "ns3/ccnx-codec-contentobject.h"
 #include "ccnx-codec-registry.h"
 
 using namespace ns3;
 using namespace ns3::ccnx;
 
-CCNxCodecRegistry::PerHopRegistryType CCNxCodecRegistry::m_perHopRegistry("PerHop Registry");
+CCNxCodecRegistry::PerHopRegistryType &
+CCNxCodecRegistry::GetPerHopRegistry ()
+{
+  static PerHopRegistryType registry ("PerHop Registry");
+  return registry;
+}
+
+Ptr<CCNxCodecPerHopHeaderEntry> *
+CCNxCodecRegistry::GetPerHopTable ()
+{
+  static Ptr<CCNxCodecPerHopHeaderEntry> table[PerHopTableSize];
+  return table;
+}
 
 void
 CCNxCodecRegistry::PerHopRegisterCodec(TlvTypeType tlvType, Ptr<CCNxCodecPerHopHeaderEntry> codec)
 {
-  m_perHopRegistry.Register(tlvType, codec);
+  GetPerHopRegistry ().Register(tlvType, codec);
+  if (tlvType < PerHopTableSize)
+    {
+      GetPerHopTable ()[tlvType] = codec;
+    }
 }
 
 void
 CCNxCodecRegistry::PerHopUnegisterCodec(TlvTypeType tlvType)
 {
-  m_perHopRegistry.UnRegister(tlvType);
+  GetPerHopRegistry ().UnRegister(tlvType);
+  if (tlvType < PerHopTableSize)
+    {
+      GetPerHopTable ()[tlvType] = 0;
+    }
 }
 
 Ptr<CCNxCodecPerHopHeaderEntry>
 CCNxCodecRegistry::PerHopLookupCodec(TlvTypeType tlvType)
 {
-  return m_perHopRegistry.Lookup(tlvType);
+  if (tlvType < PerHopTableSize)
+    {
+      return GetPerHopTable ()[tlvType];
+    }
+  return GetPerHopRegistry ().Lookup(tlvType);
+}
+
+namespace {
+
+/*
+ * The MessageCodec functions for a message class and its codec.  The table below only
+ * hands a message to the functions for its own MessageType, so a static cast is safe.
+ */
+template <class Message, class Codec>
+struct MessageCodecFunctions
+{
+  static uint32_t GetSerializedSize (Ptr<CCNxMessage> message)
+  {
+    Codec codec;
+    codec.SetHeader (StaticCast<Message, CCNxMessage> (message));
+    return codec.GetSerializedSize ();
+  }
+
+  static void Serialize (Ptr<CCNxMessage> message, Ptr<Packet> packet)
+  {
+    Codec codec;
+    codec.SetHeader (StaticCast<Message, CCNxMessage> (message));
+    packet->AddHeader (codec);
+  }
+
+  static Ptr<CCNxMessage> Deserialize (Ptr<const Packet> encoded, bool deferPayload)
+  {
+    Codec codec;
+    codec.SetDeferPayload (deferPayload);
+    encoded->PeekHeader (codec);
+    Ptr<CCNxMessage> message = codec.GetHeader ();
+    if (codec.HasDeferredPayload ())
+      {
+        message->SetEncodedPayload (encoded->CreateFragment (codec.GetDeferredPayloadOffset (),
+                                                             codec.GetDeferredPayloadLength ()));
+      }
+    return message;
+  }
+};
+
+typedef MessageCodecFunctions<CCNxInterest, CCNxCodecInterest> InterestFunctions;
+typedef MessageCodecFunctions<CCNxContentObject, CCNxCodecContentObject> ContentObjectFunctions;
+
+/*
+ * Indexed by CCNxFixedHeaderType.  InterestReturn has no message codec yet.
+ */
+constexpr CCNxCodecRegistry::MessageCodec _messageCodecs[] = {
+  { CCNxFixedHeaderType_Interest, CCNxMessage::Interest, CCNxSchemaV1::T_INTEREST,
+    &InterestFunctions::GetSerializedSize, &InterestFunctions::Serialize, &InterestFunctions::Deserialize },
+  { CCNxFixedHeaderType_Object, CCNxMessage::ContentObject, CCNxSchemaV1::T_OBJECT,
+    &ContentObjectFunctions::GetSerializedSize, &ContentObjectFunctions::Serialize, &ContentObjectFunctions::Deserialize },
+  { CCNxFixedHeaderType_InterestReturn, CCNxMessage::Interest, CCNxSchemaV1::T_INTEREST,
+    0, 0, 0 },
+};
+
+const size_t _messageCodecCount = sizeof(_messageCodecs) / sizeof(_messageCodecs[0]);
+
+/*
+ * Maps CCNxMessage::MessageType to its CCNxFixedHeaderType
+ */
+constexpr CCNxFixedHeaderType _messageTypeToPacketType[] = {
+  CCNxFixedHeaderType_Interest,       // CCNxMessage::Interest
+  CCNxFixedHeaderType_Object,         // CCNxMessage::ContentObject
+};
+
+static_assert (_messageCodecs[CCNxFixedHeaderType_Interest].packetType == CCNxFixedHeaderType_Interest,
+               "Message codec table out of order");
+static_assert (_messageCodecs[CCNxFixedHeaderType_Object].packetType == CCNxFixedHeaderType_Object,
+               "Message codec table out of order");
+static_assert (_messageCodecs[CCNxFixedHeaderType_InterestReturn].packetType == CCNxFixedHeaderType_InterestReturn,
+               "Message codec table out of order");
+static_assert (_messageCodecs[_messageTypeToPacketType[CCNxMessage::Interest]].messageType == CCNxMessage::Interest,
+               "Message type table out of order");
+static_assert (_messageCodecs[_messageTypeToPacketType[CCNxMessage::ContentObject]].messageType == CCNxMessage::ContentObject,
+               "Message type table out of order");
+
+} // namespace
+
+const CCNxCodecRegistry::MessageCodec &
+CCNxCodecRegistry::LookupMessageCodec (CCNxFixedHeaderType packetType)
+{
+  NS_ASSERT_MSG ((size_t) packetType < _messageCodecCount && _messageCodecs[packetType].Serialize,
+                 "No message codec for packet type " << packetType);
+  return _messageCodecs[packetType];
+}
+
+bool
+CCNxCodecRegistry::HasMessageCodec (CCNxFixedHeaderType packetType)
+{
+  return (size_t) packetType < _messageCodecCount && _messageCodecs[packetType].Deserialize;
+}
+
+const CCNxCodecRegistry::MessageCodec &
+CCNxCodecRegistry::LookupMessageCodec (CCNxMessage::MessageType messageType)
+{
+  NS_ASSERT_MSG ((size_t) messageType < sizeof(_messageTypeToPacketType) / sizeof(_messageTypeToPacketType[0]),
+                 "No message codec for message type " << messageType);
+  return LookupMessageCodec (_messageTypeToPacketType[messageType]);
 }
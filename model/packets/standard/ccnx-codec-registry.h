@@ -56,7 +56,10 @@
 #ifndef CCNS3SIM_MODEL_PACKETS_CCNX_CODEC_REGISTRY_H_
 #define CCNS3SIM_MODEL_PACKETS_CCNX_CODEC_REGISTRY_H_
 
+#include "ns3/packet.h"
 #include "ns3/ccnx-type-registry.h"
+#include "ns3/ccnx-message.h"
+#include "ns3/ccnx-fixedheader.h"
 #include "ccnx-codec-perhopheaderentry.h"
 
 namespace ns3 {
@@ -68,14 +71,14 @@ namespace ccnx {
    * Registry of the codecs for each message element.  This allows a user to override a codec or
    * supply a new codec for a new TLV field.
    *
-   * Per hop headers are a simple list, so the registry is only a single TLV type.
+   * Per hop headers are a simple list, so the registry is only a single TLV type.  Codecs register
+   * themselves (see CCNxCodecInterestLifetime), so a new per hop header needs no change here.  Types
+   * below `PerHopTableSize`, which covers all of the CCNxSchemaV1 hop-by-hop types, are looked up by
+   * direct index; larger types fall back to a map.
    *
-   * CCNxMessages are a hierarchical listing of TLV type.  Therefore, they must be specified as a list.
-   * For example, the Name codec of an Interest is ".1.0" because an Interest is TLV type "1" and a Name is
-   * TLV type "0".  The list can be specified as a string (like the previous exampe) or as a std::vector of
-   * uint32_t.
-   *
-   * N.B. Only Per Hop headers are currently implemented
+   * Messages are dispatched through a compile-time table with one entry per CCNxFixedHeaderType,
+   * built from the CCNxSchemaV1 top-level types.  The packet path uses it instead of
+   * casting the CCNxMessage to its run time type.
    */
 class CCNxCodecRegistry
 {
@@ -84,6 +87,11 @@ public:
 
   typedef uint32_t TlvTypeType;
 
+  /**
+   * Per hop TLV types below this value are kept in a direct-index table
+   */
+  static const TlvTypeType PerHopTableSize = 256;
+
   /**
    * Create a mapping between TLV type and codec
    */
@@ -105,7 +113,50 @@ public:
   static Ptr<CCNxCodecPerHopHeaderEntry> PerHopLookupCodec(TlvTypeType tlvType);
 
   // ========
-  // CCNx Message & Validation Registry
+  // CCNx Message Registry
+
+  /**
+   * The codec functions for one kind of message.  `message` is always of the run time type
+   * that goes with `messageType`.
+   */
+  struct MessageCodec
+  {
+    CCNxFixedHeaderType packetType;
+    CCNxMessage::MessageType messageType;
+    uint16_t tlvType;                     //<! The top-level TLV type, e.g. CCNxSchemaV1::T_INTEREST
+
+    /**
+     * The encoded size of the message, including its top-level TL
+     */
+    uint32_t (*GetSerializedSize) (Ptr<CCNxMessage> message);
+
+    /**
+     * Add the encoded message to the front of `packet`
+     */
+    void (*Serialize) (Ptr<CCNxMessage> message, Ptr<Packet> packet);
+
+    /**
+     * Decode the message at the front of `encoded`.  If `deferPayload` is true, the payload is
+     * attached to the message as a fragment of `encoded` (see CCNxMessage::SetEncodedPayload()).
+     */
+    Ptr<CCNxMessage> (*Deserialize) (Ptr<const Packet> encoded, bool deferPayload);
+  };
+
+  /**
+   * The codec for a fixed header packet type.  Asserts if the packet type has no codec.
+   */
+  static const MessageCodec & LookupMessageCodec (CCNxFixedHeaderType packetType);
+
+  /**
+   * The codec for a message type.  Asserts if the message type has no codec.
+   */
+  static const MessageCodec & LookupMessageCodec (CCNxMessage::MessageType messageType);
+
+  /**
+   * True if the packet type has a message codec, so LookupMessageCodec() will not assert.
+   * InterestReturn has none yet.
+   */
+  static bool HasMessageCodec (CCNxFixedHeaderType packetType);
 
 protected:
   /**
@@ -114,7 +165,13 @@ protected:
   CCNxCodecRegistry ();
 
   typedef CCNxTypeRegistry< TlvTypeType, CCNxCodecPerHopHeaderEntry > PerHopRegistryType;
-  static PerHopRegistryType m_perHopRegistry;
+
+  /**
+   * The per hop codecs.  Codecs register from static initializers in other translation units,
+   * so the tables are function-local statics built on first use.
+   */
+  static PerHopRegistryType & GetPerHopRegistry ();
+  static Ptr<CCNxCodecPerHopHeaderEntry> * GetPerHopTable ();
 };
 
 } /* namespace ccnx */
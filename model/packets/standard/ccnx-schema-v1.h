@@ -71,6 +71,15 @@ namespace ccnx {
 class CCNxSchemaV1
 {
 public:
+  // fixed header
+  static const uint8_t VERSION = 0x01;
+  static const uint8_t FIXED_HEADER_LENGTH = 8;
+
+  // fixed header packet types
+  static const uint8_t PT_INTEREST = 0x01;
+  static const uint8_t PT_CONTENT = 0x02;
+  static const uint8_t PT_RETURN = 0x03;
+
   // hop-by-hop headers
   static const uint16_t T_INT_LIFE = 0x0001;
   static const uint16_t T_CACHE_TIME = 0x0002;
@@ -81,4 +81,4 @@ uint16_t
 CCNxTlv::GetTLSize (void)
 {
   return 4;
-}
\ No newline at end of file
+}
@@ -77,6 +77,103 @@ public:
   static uint16_t GetTLSize (void);
 };
 
+/**
+ * \ingroup ccnx-packet
+ *
+ * A read cursor over the TLVs of a container held in contiguous memory.  Unlike the
+ * `Buffer::Iterator` path, which bounds checks every byte it reads, the cursor checks each
+ * TLV once against the end of the container and then hands out a pointer to the value.
+ *
+ * The cursor does not own the memory, which must outlive it.
+ *
+ * Example:
+ * <code>
+ *    CCNxTlvCursor cursor (data, length);
+ *    uint16_t type, length;
+ *    const uint8_t *value;
+ *    while (cursor.Next (type, length, value))
+ *      {
+ *        ...
+ *      }
+ *    NS_ASSERT_MSG (cursor.IsEnd (), "Malformed TLV");
+ * </code>
+ */
+class CCNxTlvCursor
+{
+public:
+  CCNxTlvCursor (const uint8_t *data, uint32_t length)
+    : m_data (data), m_length (length), m_offset (0), m_error (false)
+  {
+  }
+
+  /**
+   * Reads the next TLV and advances past it.
+   *
+   * @return false at the end of the container, or if the next TLV does not fit in
+   * what remains of it (see `HasError()`).
+   */
+  bool Next (uint16_t &type, uint16_t &length, const uint8_t * &value)
+  {
+    if (m_length - m_offset < 4)
+      {
+        m_error = m_offset != m_length;
+        return false;
+      }
+
+    const uint8_t *p = m_data + m_offset;
+    uint16_t len = (uint16_t) ((p[2] << 8) | p[3]);
+    if (len > m_length - m_offset - 4)
+      {
+        m_error = true;
+        return false;
+      }
+
+    type = (uint16_t) ((p[0] << 8) | p[1]);
+    length = len;
+    value = p + 4;
+    m_offset += 4 + len;
+    return true;
+  }
+
+  /**
+   * True if all of the container has been consumed
+   */
+  bool IsEnd () const
+  {
+    return m_offset == m_length;
+  }
+
+  /**
+   * True if `Next()` stopped at a TLV that overruns the container
+   */
+  bool HasError () const
+  {
+    return m_error;
+  }
+
+  /**
+   * The offset of the next TLV from the start of the container
+   */
+  uint32_t GetOffset () const
+  {
+    return m_offset;
+  }
+
+  /**
+   * The number of bytes of the container after the next TLV's offset
+   */
+  uint32_t GetRemaining () const
+  {
+    return m_length - m_offset;
+  }
+
+private:
+  const uint8_t *m_data;
+  uint32_t m_length;
+  uint32_t m_offset;
+  bool m_error;
+};
+
 }
 }
 
@@ -54,6 +54,7 @@
  */
 
 #include <stdint.h>
+#include <algorithm>
 #include "ns3/log.h"
 #include "nfp-advertise.h"
 #include "ns3/ccnx-tlv.h"
@@ -64,6 +65,8 @@ using namespace ns3::ccnx;
 
 NS_LOG_COMPONENT_DEFINE ("NfpAdvertise");
 
+const uint16_t NfpAdvertise::InfiniteDistance;
+
 NfpAdvertise::NfpAdvertise ()
 {
   m_anchorSeqnum = 0;
@@ -88,8 +91,7 @@ NfpAdvertise::NfpAdvertise (NfpAdvertise const &copy, uint16_t linkcost)
   m_anchorSeqnum = copy.GetAnchorSeqnum ();
 
   uint32_t newDistance = (uint32_t) copy.GetDistance () + linkcost;
-  NS_ASSERT_MSG (newDistance <= std::numeric_limits<uint16_t>::max (), "distance + linkcost exceed 16-bits");
-  m_distance = (uint16_t) newDistance;
+  m_distance = (uint16_t) std::min (newDistance, (uint32_t) InfiniteDistance);
 }
 
 NfpAdvertise::~NfpAdvertise ()
@@ -121,6 +123,12 @@ NfpAdvertise::GetDistance (void) const
   return m_distance;
 }
 
+bool
+NfpAdvertise::IsInfinite (void) const
+{
+  return m_distance == InfiniteDistance;
+}
+
 uint32_t
 NfpAdvertise::GetSerializedSize (void) const
 {
@@ -74,13 +74,20 @@ namespace ccnx {
 class NfpAdvertise : public NfpMessage
 {
 public:
+  /**
+   * The distance of an unreachable route.  A distance plus link cost that does not fit in
+   * 16 bits saturates to this value, and such an advertisement is treated as a withdraw.
+   */
+  static const uint16_t InfiniteDistance = 0xFFFF;
+
   NfpAdvertise ();
   NfpAdvertise (Ptr<const CCNxName> anchorName, Ptr<const CCNxName> prefix, uint32_t anchorSeqnum, uint16_t distance);
 
   /**
    * Create a new advertisement based on an old one.  The distnace will be increased based on
    * the `linkcost` parameter.  This is typically used by a node to re-advertise a route with
-   * increased distance due to the link cost to the nexthop.
+   * increased distance due to the link cost to the nexthop.  The distance saturates at
+   * `InfiniteDistance`.
    *
    * @param copy The original advertisement
    * @param linkcost The linkcost by which to increase the distance.
@@ -94,6 +101,11 @@ public:
   uint32_t GetAnchorSeqnum (void) const;
   uint16_t GetDistance (void) const;
 
+  /**
+   * True if the distance is `InfiniteDistance`, i.e. the route is unreachable.
+   */
+  bool IsInfinite (void) const;
+
   /**
    * Return the number of bytes required to serialize this header
    */
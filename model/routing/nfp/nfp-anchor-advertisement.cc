@@ -284,6 +284,20 @@ NfpAnchorAdvertisement::GetNexthopCount (void)
   return m_equalCostPaths->size ();
 }
 
+Time
+NfpAnchorAdvertisement::GetNextExpiryTime (void) const
+{
+  Time next = Time::Max ();
+  for (ExpiryTimeMap::const_iterator i = m_expiryTimes.cbegin (); i != m_expiryTimes.cend (); ++i)
+    {
+      if (i->second < next)
+        {
+          next = i->second;
+        }
+    }
+  return next;
+}
+
 std::ostream &
 ns3::ccnx::operator << (std::ostream &os, const NfpAnchorAdvertisement &anchorAdvertise)
 {
@@ -127,7 +127,9 @@ public:
   *
   * This will update the internal state by pruning the nexthop list of any expired nexthops.
   *
-  * NOTE: The Cost of the route entries does not include link costs to the next hop connection IDs
+  * NOTE: The Cost of the route entries is the advertised distance.  NfpRoutingProtocol adds the
+  * link cost of the ingress interface to an advertisement before it gets here, so it already
+  * includes the cost of the link to the next hop.
   *
   * @return The set of valid next hops.
   */
@@ -175,6 +177,14 @@ public:
    */
   size_t GetNexthopCount (void);
 
+  /**
+   * Returns the earliest time at which one of the next hops will expire.  Until then,
+   * the route returned by GetRouteNoLinkCosts() cannot change unless this object is updated.
+   *
+   * @return The earliest expiry time, or Time::Max() if there are no next hops
+   */
+  Time GetNextExpiryTime (void) const;
+
   /**
    * Overload output operator as a friend method so we can do this without exposing non-cost methods.
    *
@@ -59,8 +59,8 @@
 using namespace ns3;
 using namespace ns3::ccnx;
 
-NfpLinkCost::NfpLinkCost (uint32_t connectionId, uint16_t cost) :
-  m_connId (connectionId), m_cost (cost)
+NfpLinkCost::NfpLinkCost (uint32_t interface, uint16_t cost) :
+  m_interface (interface), m_cost (cost)
 {
   // empty
 }
@@ -71,9 +71,9 @@ NfpLinkCost::~NfpLinkCost ()
 }
 
 uint32_t
-NfpLinkCost::GetConnectionId (void) const
+NfpLinkCost::GetInterface (void) const
 {
-  return m_connId;
+  return m_interface;
 }
 
 uint16_t
@@ -66,23 +66,28 @@ namespace ccnx {
  * @ingroup nfp-routing
  *
  * An entry in the link cost table.  A link cost entry tracks the cost of
- * a link represented by a Layer 3 CCNxConnection.
+ * a Layer 3 interface, identified by its interface index (NetDevice::GetIfIndex()).
+ * Every neighbor reached through the interface uses the same cost.
  */
 class NfpLinkCost : public SimpleRefCount<NfpLinkCost>
 {
 public:
-  NfpLinkCost (uint32_t connectionId, uint16_t cost);
+  /**
+   * @param [in] interface The interface index
+   * @param [in] cost The cost added to the distance of advertisements received on the interface
+   */
+  NfpLinkCost (uint32_t interface, uint16_t cost);
 
   virtual ~NfpLinkCost ();
 
-  uint32_t GetConnectionId (void) const;
+  uint32_t GetInterface (void) const;
 
   uint16_t GetCost (void) const;
 
   void SetCost (uint16_t cost);
 
 protected:
-  uint32_t m_connId;
+  uint32_t m_interface;
   uint16_t m_cost;
 };
 
@@ -53,8 +53,13 @@
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
 
+#include <cstring>
+#include <algorithm>
+
 #include "ns3/log.h"
 #include "ns3/ccnx-tlv.h"
+#include "ns3/ccnx-name-builder.h"
+#include "ns3/ccnx-schema-v1.h"
 
 #include "nfp-payload.h"
 #include "nfp-schema.h"
@@ -69,16 +74,19 @@ NfpPayload::NfpPayload ()
   m_capacity = 0;
   m_remaining = 0;
   m_msgSeqnum = 0;
+  m_compact = false;
 }
 
 NfpPayload::NfpPayload (size_t capacity, Ptr<const CCNxName> routerName,
-                        uint16_t msgSeqnum)
+                        uint16_t msgSeqnum, bool compact)
 {
-  NS_LOG_FUNCTION (this << capacity << routerName << msgSeqnum);
+  NS_LOG_FUNCTION (this << capacity << routerName << msgSeqnum << compact);
 
   m_routerNameCodec.SetHeader (routerName);
   m_capacity = capacity;
   m_msgSeqnum = msgSeqnum;
+  m_compact = compact;
+  m_compactState.Reset (routerName);
 
   size_t fixedOverhead = CCNxTlv::GetTLSize (); // T_MSG
   fixedOverhead += m_routerNameCodec.GetSerializedSize ();
@@ -108,19 +116,40 @@ NfpPayload::GetMessageSeqnum (void) const
   return m_msgSeqnum;
 }
 
+bool
+NfpPayload::IsCompact (void) const
+{
+  return m_compact;
+}
+
 void
 NfpPayload::AppendMessage (Ptr<NfpMessage> message)
 {
   NS_LOG_FUNCTION (this << message);
 
-  size_t messageSize = message->GetSerializedSize ();
+  size_t messageSize = GetMessageSize (message);
   NS_ASSERT_MSG (messageSize <= GetRemaining (),
                  "Message does not fit in payload.");
 
+  if (m_compact)
+    {
+      m_compactState.Append (message);
+    }
+
   m_remaining -= messageSize;
   m_messages.push_back (message);
 }
 
+uint32_t
+NfpPayload::GetMessageSize (Ptr<const NfpMessage> message) const
+{
+  if (m_compact)
+    {
+      return m_compactState.GetMessageSize (message);
+    }
+  return message->GetSerializedSize ();
+}
+
 /**
  * Returns the number of messages contained in this payload.
  *
@@ -169,10 +198,23 @@ NfpPayload::Serialize (Buffer::Iterator start) const
   CCNxTlv::WriteTypeLength (start, NfpSchema::T_MSG_SEQNUM, 2);
   start.WriteHtonU16 (m_msgSeqnum);
 
-  for (int i = 0; i < m_messages.size (); i++)
+  if (m_compact)
     {
-      m_messages[i]->Serialize (start);
-      start.Next (m_messages[i]->GetSerializedSize ());
+      // replay the encoder from the router name so the indices match what AppendMessage() counted
+      CompactState state;
+      state.Reset (m_routerNameCodec.GetHeader ());
+      for (int i = 0; i < m_messages.size (); i++)
+        {
+          state.Serialize (m_messages[i], start);
+        }
+    }
+  else
+    {
+      for (int i = 0; i < m_messages.size (); i++)
+        {
+          m_messages[i]->Serialize (start);
+          start.Next (m_messages[i]->GetSerializedSize ());
+        }
     }
 }
 
@@ -244,6 +286,18 @@ NfpPayload::DeserializeWithdraw (Buffer::Iterator const &start, Buffer::Iterator
   return length;
 }
 
+uint32_t
+NfpPayload::DeserializeCompact (Buffer::Iterator const &start, Buffer::Iterator &current, CompactState &state)
+{
+  uint32_t length = 0;
+  Ptr<NfpMessage> message = state.Deserialize (current, length);
+  m_messages.push_back (message);
+  m_compact = true;
+  NS_LOG_DEBUG ("Compact message offset " << current.GetDistanceFrom (start));
+
+  return length;
+}
+
 uint32_t
 NfpPayload::Deserialize (Buffer::Iterator start)
 {
@@ -264,6 +318,9 @@ NfpPayload::Deserialize (Buffer::Iterator start)
   bytesRead += DeserializeRouterName (start, current);
   bytesRead += DeserializeMessageSeqnum (start, current);
 
+  CompactState state;
+  state.Reset (m_routerNameCodec.GetHeader ());
+
   // Now loop and read messages until the end of the packet
   while (bytesRead < outerLength)
     {
@@ -287,6 +344,12 @@ NfpPayload::Deserialize (Buffer::Iterator start)
           readLength = DeserializeWithdraw (start, current);
           break;
 
+        case NfpSchema::T_ADV_COMPACT:
+        // fallthrough
+        case NfpSchema::T_WITHDRAW_COMPACT:
+          readLength = DeserializeCompact (start, current, state);
+          break;
+
         default:
           NS_ASSERT_MSG (false, "Unsupported message type " << innerType << " offset " << current.GetDistanceFrom (start));
 
@@ -339,8 +402,404 @@ ns3::ccnx::operator << (std::ostream &os, const NfpPayload &payload)
   os << ", seq " << (uint32_t) payload.GetMessageSeqnum ();
   os << ", cap " << payload.m_capacity;
   os << ", remain " << payload.GetRemaining ();
+  if (payload.IsCompact ())
+    {
+      os << ", compact";
+    }
   os << ", count " << payload.GetMessageCount ();
   os << " }";
 
   return os;
 }
+
+// ========================================
+// Compact encoding
+
+NfpPayload::CompactState::CompactState ()
+{
+  m_hasLastPrefix = false;
+  m_lastPrefix = 0;
+  m_hasAdvertiseData = false;
+  m_anchorSeqnum = 0;
+  m_distance = 0;
+}
+
+void
+NfpPayload::CompactState::Reset (Ptr<const CCNxName> routerName)
+{
+  m_names.clear ();
+  m_nameIndex.clear ();
+  m_hasLastPrefix = false;
+  m_lastPrefix = 0;
+  m_hasAdvertiseData = false;
+  m_anchorSeqnum = 0;
+  m_distance = 0;
+
+  if (routerName)
+    {
+      m_names.push_back (routerName);
+      m_nameIndex[routerName] = 0;
+    }
+}
+
+/**
+ * The number of leading segments that `a` and `b` have in common.
+ */
+static size_t
+CountSharedSegments (Ptr<const CCNxName> a, Ptr<const CCNxName> b)
+{
+  size_t limit = std::min (a->GetSegmentCount (), b->GetSegmentCount ());
+  size_t shared = 0;
+  while (shared < limit
+         && a->GetSegmentType (shared) == b->GetSegmentType (shared)
+         && a->GetSegmentLength (shared) == b->GetSegmentLength (shared)
+         && memcmp (a->GetSegmentData (shared), b->GetSegmentData (shared), a->GetSegmentLength (shared)) == 0)
+    {
+      shared++;
+    }
+  return shared;
+}
+
+NfpPayload::CompactState::NameEncoding
+NfpPayload::CompactState::EncodeName (Ptr<const CCNxName> name) const
+{
+  NameEncoding encoding;
+  encoding.index = 0;
+  encoding.shared = 0;
+
+  NameIndexType::const_iterator i = m_nameIndex.find (name);
+  if (i != m_nameIndex.end ())
+    {
+      encoding.type = NfpSchema::T_NAME_REF;
+      encoding.index = i->second;
+      encoding.size = CCNxTlv::GetTLSize () + sizeof(uint16_t);
+      return encoding;
+    }
+
+  encoding.type = NfpSchema::T_NAME;
+  encoding.size = CCNxTlv::GetTLSize () + name->GetEncodedSize ();
+
+  if (m_hasLastPrefix)
+    {
+      Ptr<const CCNxName> base = m_names[m_lastPrefix];
+      size_t shared = std::min (CountSharedSegments (base, name), (size_t) 0xFFFF);
+      if (shared > 0)
+        {
+          // index + shared count + the remaining name segments
+          uint32_t deltaSize = CCNxTlv::GetTLSize () + 2 * sizeof(uint16_t);
+          for (size_t segment = shared; segment < name->GetSegmentCount (); ++segment)
+            {
+              deltaSize += CCNxTlv::GetTLSize () + name->GetSegmentLength (segment);
+            }
+
+          if (deltaSize < encoding.size)
+            {
+              encoding.type = NfpSchema::T_NAME_DELTA;
+              encoding.index = m_lastPrefix;
+              encoding.shared = (uint16_t) shared;
+              encoding.size = deltaSize;
+            }
+        }
+    }
+
+  return encoding;
+}
+
+void
+NfpPayload::CompactState::WriteName (Ptr<const CCNxName> name, const NameEncoding &encoding, Buffer::Iterator &start) const
+{
+  CCNxCodecName codec;
+  switch (encoding.type)
+    {
+    case NfpSchema::T_NAME_REF:
+      CCNxTlv::WriteTypeLength (start, NfpSchema::T_NAME_REF, sizeof(uint16_t));
+      start.WriteHtonU16 (encoding.index);
+      break;
+
+    case NfpSchema::T_NAME_DELTA:
+      {
+        CCNxNameBuilder builder;
+        for (size_t segment = encoding.shared; segment < name->GetSegmentCount (); ++segment)
+          {
+            builder.Append (name->GetSegment (segment));
+          }
+        codec.SetHeader (builder.CreateName ());
+
+        // the codec writes a T_NAME around the segments, copy only the segments
+        Buffer scratch (0);
+        scratch.AddAtStart (codec.GetSerializedSize ());
+        codec.Serialize (scratch.Begin ());
+        Buffer::Iterator segments = scratch.Begin ();
+        segments.Next (CCNxTlv::GetTLSize ());
+
+        CCNxTlv::WriteTypeLength (start, NfpSchema::T_NAME_DELTA, encoding.size - CCNxTlv::GetTLSize ());
+        start.WriteHtonU16 (encoding.index);
+        start.WriteHtonU16 (encoding.shared);
+        for (uint32_t i = CCNxTlv::GetTLSize (); i < scratch.GetSize (); ++i)
+          {
+            start.WriteU8 (segments.ReadU8 ());
+          }
+        break;
+      }
+
+    default:
+      codec.SetHeader (name);
+      codec.Serialize (start);
+      start.Next (codec.GetSerializedSize ());
+      break;
+    }
+}
+
+Ptr<const CCNxName>
+NfpPayload::CompactState::ReadName (Buffer::Iterator &start, uint32_t &length, bool &isReference) const
+{
+  uint16_t type = CCNxTlv::ReadType (start);
+  uint16_t valueLength = CCNxTlv::ReadLength (start);
+  isReference = false;
+
+  Ptr<const CCNxName> name;
+  if (type == NfpSchema::T_NAME_REF)
+    {
+      NS_ASSERT_MSG (valueLength == sizeof(uint16_t), "T_NAME_REF must be length " << sizeof(uint16_t));
+      uint16_t index = start.ReadNtohU16 ();
+      NS_ASSERT_MSG (index < m_names.size (), "T_NAME_REF index " << index << " not in payload");
+      name = m_names[index];
+      isReference = true;
+    }
+  else if (type == NfpSchema::T_NAME_DELTA)
+    {
+      uint16_t index = start.ReadNtohU16 ();
+      uint16_t shared = start.ReadNtohU16 ();
+      NS_ASSERT_MSG (index < m_names.size (), "T_NAME_DELTA index " << index << " not in payload");
+
+      Ptr<const CCNxName> base = m_names[index];
+      NS_ASSERT_MSG (shared <= base->GetSegmentCount (), "T_NAME_DELTA shares more segments than its base");
+
+      NS_ASSERT_MSG (valueLength >= 2 * sizeof(uint16_t), "T_NAME_DELTA too short");
+
+      // put a T_NAME around the remaining segments so the codec can read them
+      uint16_t segmentsLength = valueLength - 2 * sizeof(uint16_t);
+      Buffer scratch (0);
+      scratch.AddAtStart (CCNxTlv::GetTLSize () + segmentsLength);
+      Buffer::Iterator suffixStart = scratch.Begin ();
+      CCNxTlv::WriteTypeLength (suffixStart, CCNxSchemaV1::T_NAME, segmentsLength);
+      for (uint16_t i = 0; i < segmentsLength; ++i)
+        {
+          suffixStart.WriteU8 (start.ReadU8 ());
+        }
+
+      CCNxCodecName codec;
+      codec.Deserialize (scratch.Begin ());
+
+      CCNxNameBuilder builder (*base->GetPrefix (shared));
+      Ptr<const CCNxName> suffix = codec.GetHeader ();
+      for (size_t segment = 0; segment < suffix->GetSegmentCount (); ++segment)
+        {
+          builder.Append (suffix->GetSegment (segment));
+        }
+      name = builder.CreateName ();
+    }
+  else
+    {
+      // a full name, let the codec read its own TL
+      start.Prev (CCNxTlv::GetTLSize ());
+      CCNxCodecName codec;
+      uint32_t nameLength = codec.Deserialize (start);
+      start.Next (nameLength);
+      name = codec.GetHeader ();
+    }
+
+  length = CCNxTlv::GetTLSize () + valueLength;
+  return name;
+}
+
+void
+NfpPayload::CompactState::AddNames (Ptr<const CCNxName> anchorName, bool anchorIsReference,
+                                    Ptr<const CCNxName> prefix, bool prefixIsReference, uint16_t prefixIndex)
+{
+  // indices are 16 bits; once full, later names are simply sent in full
+  if (!anchorIsReference && m_names.size () < 0xFFFF)
+    {
+      m_nameIndex.insert (std::make_pair (anchorName, (uint16_t) m_names.size ()));
+      m_names.push_back (anchorName);
+    }
+
+  if (prefixIsReference)
+    {
+      m_hasLastPrefix = true;
+      m_lastPrefix = prefixIndex;
+    }
+  else if (m_names.size () < 0xFFFF)
+    {
+      m_hasLastPrefix = true;
+      m_lastPrefix = (uint16_t) m_names.size ();
+      m_nameIndex.insert (std::make_pair (prefix, (uint16_t) m_names.size ()));
+      m_names.push_back (prefix);
+    }
+}
+
+bool
+NfpPayload::CompactState::IsAdvertiseDataRepeated (uint32_t anchorSeqnum, uint16_t distance) const
+{
+  return m_hasAdvertiseData && m_anchorSeqnum == anchorSeqnum && m_distance == distance;
+}
+
+void
+NfpPayload::CompactState::SetAdvertiseData (uint32_t anchorSeqnum, uint16_t distance)
+{
+  m_hasAdvertiseData = true;
+  m_anchorSeqnum = anchorSeqnum;
+  m_distance = distance;
+}
+
+/**
+ * Returns the anchor name and prefix of an Advertise or Withdraw.
+ */
+static void
+GetMessageNames (Ptr<const NfpMessage> message, Ptr<const CCNxName> &anchorName, Ptr<const CCNxName> &prefix)
+{
+  if (message->IsAdvertise ())
+    {
+      Ptr<const NfpAdvertise> advertise = DynamicCast<const NfpAdvertise, const NfpMessage> (message);
+      anchorName = advertise->GetAnchorName ();
+      prefix = advertise->GetPrefix ();
+    }
+  else
+    {
+      Ptr<const NfpWithdraw> withdraw = DynamicCast<const NfpWithdraw, const NfpMessage> (message);
+      anchorName = withdraw->GetAnchorName ();
+      prefix = withdraw->GetPrefix ();
+    }
+}
+
+uint32_t
+NfpPayload::CompactState::GetMessageSize (Ptr<const NfpMessage> message) const
+{
+  Ptr<const CCNxName> anchorName;
+  Ptr<const CCNxName> prefix;
+  GetMessageNames (message, anchorName, prefix);
+
+  uint32_t size = CCNxTlv::GetTLSize ();
+  size += EncodeName (anchorName).size;
+  size += EncodeName (prefix).size;
+
+  if (message->IsAdvertise ())
+    {
+      Ptr<const NfpAdvertise> advertise = DynamicCast<const NfpAdvertise, const NfpMessage> (message);
+      if (!IsAdvertiseDataRepeated (advertise->GetAnchorSeqnum (), advertise->GetDistance ()))
+        {
+          size += CCNxTlv::GetTLSize () + sizeof(uint32_t) + sizeof(uint16_t);
+        }
+    }
+  return size;
+}
+
+void
+NfpPayload::CompactState::Append (Ptr<const NfpMessage> message)
+{
+  Ptr<const CCNxName> anchorName;
+  Ptr<const CCNxName> prefix;
+  GetMessageNames (message, anchorName, prefix);
+
+  NameEncoding anchorEncoding = EncodeName (anchorName);
+  NameEncoding prefixEncoding = EncodeName (prefix);
+  AddNames (anchorName, anchorEncoding.type == NfpSchema::T_NAME_REF,
+            prefix, prefixEncoding.type == NfpSchema::T_NAME_REF, prefixEncoding.index);
+
+  if (message->IsAdvertise ())
+    {
+      Ptr<const NfpAdvertise> advertise = DynamicCast<const NfpAdvertise, const NfpMessage> (message);
+      SetAdvertiseData (advertise->GetAnchorSeqnum (), advertise->GetDistance ());
+    }
+}
+
+void
+NfpPayload::CompactState::Serialize (Ptr<const NfpMessage> message, Buffer::Iterator &start)
+{
+  Ptr<const CCNxName> anchorName;
+  Ptr<const CCNxName> prefix;
+  GetMessageNames (message, anchorName, prefix);
+
+  uint32_t size = GetMessageSize (message);
+  NS_ASSERT_MSG (size <= 0xFFFF, "Total size too large");
+
+  uint16_t type = message->IsAdvertise () ? NfpSchema::T_ADV_COMPACT : NfpSchema::T_WITHDRAW_COMPACT;
+  CCNxTlv::WriteTypeLength (start, type, (uint16_t) (size - CCNxTlv::GetTLSize ()));
+
+  NameEncoding anchorEncoding = EncodeName (anchorName);
+  NameEncoding prefixEncoding = EncodeName (prefix);
+  WriteName (anchorName, anchorEncoding, start);
+  WriteName (prefix, prefixEncoding, start);
+
+  if (message->IsAdvertise ())
+    {
+      Ptr<const NfpAdvertise> advertise = DynamicCast<const NfpAdvertise, const NfpMessage> (message);
+      if (!IsAdvertiseDataRepeated (advertise->GetAnchorSeqnum (), advertise->GetDistance ()))
+        {
+          CCNxTlv::WriteTypeLength (start, NfpSchema::T_ADV_DATA, sizeof(uint32_t) + sizeof(uint16_t));
+          start.WriteHtonU32 (advertise->GetAnchorSeqnum ());
+          start.WriteHtonU16 (advertise->GetDistance ());
+        }
+    }
+
+  Append (message);
+}
+
+Ptr<NfpMessage>
+NfpPayload::CompactState::Deserialize (Buffer::Iterator &start, uint32_t &length)
+{
+  uint16_t outerType = CCNxTlv::ReadType (start);
+  uint16_t outerLength = CCNxTlv::ReadLength (start);
+  NS_ASSERT_MSG (outerType == NfpSchema::T_ADV_COMPACT || outerType == NfpSchema::T_WITHDRAW_COMPACT,
+                 "Outer type must be T_ADV_COMPACT or T_WITHDRAW_COMPACT");
+
+  uint32_t bytesRead = 0;
+  uint32_t nameLength = 0;
+  bool anchorIsReference = false;
+  bool prefixIsReference = false;
+
+  Ptr<const CCNxName> anchorName = ReadName (start, nameLength, anchorIsReference);
+  bytesRead += nameLength;
+  Ptr<const CCNxName> prefix = ReadName (start, nameLength, prefixIsReference);
+  bytesRead += nameLength;
+
+  // AddNames() only uses the index of a referenced prefix, which maps back to the same name
+  uint16_t prefixIndex = 0;
+  if (prefixIsReference)
+    {
+      prefixIndex = m_nameIndex.find (prefix)->second;
+    }
+
+  Ptr<NfpMessage> message;
+  if (outerType == NfpSchema::T_ADV_COMPACT)
+    {
+      if (bytesRead < outerLength)
+        {
+          uint16_t innerType = CCNxTlv::ReadType (start);
+          uint16_t innerLength = CCNxTlv::ReadLength (start);
+          NS_ASSERT_MSG (innerType == NfpSchema::T_ADV_DATA, "Inner type must be T_ADV_DATA");
+          NS_ASSERT_MSG (innerLength == 6, "Inner type must be length 6");
+
+          uint32_t anchorSeqnum = start.ReadNtohU32 ();
+          uint16_t distance = start.ReadNtohU16 ();
+          SetAdvertiseData (anchorSeqnum, distance);
+          bytesRead += CCNxTlv::GetTLSize () + innerLength;
+        }
+      else
+        {
+          NS_ASSERT_MSG (m_hasAdvertiseData, "T_ADV_COMPACT without T_ADV_DATA must follow an advertisement");
+        }
+
+      message = Create<NfpAdvertise> (anchorName, prefix, m_anchorSeqnum, m_distance);
+    }
+  else
+    {
+      message = Create<NfpWithdraw> (anchorName, prefix);
+    }
+
+  NS_ASSERT_MSG (bytesRead == outerLength, "Did not consume all bytes");
+  AddNames (anchorName, anchorIsReference, prefix, prefixIsReference, prefixIndex);
+
+  length = bytesRead + CCNxTlv::GetTLSize ();
+  return message;
+}
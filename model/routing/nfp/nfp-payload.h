@@ -57,6 +57,7 @@
 #define CCNS3SIM_NFPPAYLOAD_H
 
 #include <vector>
+#include <map>
 
 #include "ns3/simple-ref-count.h"
 #include "ns3/ccnx-name.h"
@@ -74,6 +75,24 @@ namespace ccnx {
  * NFP data is carried in the Payload field of a CCNxInterest.
  *
  * The payload of an Interest.
+ *
+ * A payload may use the compact encoding, which replaces T_ADV and T_WITHDRAW with
+ * T_ADV_COMPACT and T_WITHDRAW_COMPACT.  In those, a name that the payload already
+ * carries (the router name or a name from an earlier message) is sent as a T_NAME_REF
+ * to its index, a name that shares leading segments with the previous prefix is sent
+ * as a T_NAME_DELTA (index, shared segment count, then the remaining segment TLVs),
+ * and an advertisement with the same anchor seqnum and distance as the previous
+ * advertisement omits its T_ADV_DATA.  The references never leave the payload, so
+ * each payload decodes on its own and a lost payload does not affect the next one.
+ *
+ * <pre>
+ * T_ADV_COMPACT      := name name [T_ADV_DATA]
+ * T_WITHDRAW_COMPACT := name name
+ * name               := T_NAME | T_NAME_REF(index) | T_NAME_DELTA(index, shared, segments)
+ * </pre>
+ *
+ * The names that are not a T_NAME_REF are numbered in the order they appear, after the
+ * router name at index 0.  A message only refers to names of earlier messages.
  */
 class NfpPayload : public SimpleRefCount<NfpPayload>
 {
@@ -101,8 +120,9 @@ public:
    * @param capacity The maximum number of bytes
    * @param routerName The router's name
    * @param msgSeqnum The message sequence number.
+   * @param compact If true, use the compact encoding for the messages
    */
-  NfpPayload (size_t capacity, Ptr<const CCNxName> routerName, uint16_t msgSeqnum);
+  NfpPayload (size_t capacity, Ptr<const CCNxName> routerName, uint16_t msgSeqnum, bool compact = false);
 
   virtual ~NfpPayload ();
 
@@ -120,12 +140,20 @@ public:
    */
   uint16_t GetMessageSeqnum (void) const;
 
+  /**
+   * True if the payload uses the compact encoding.  A deserialized payload is compact
+   * if it carried any compact message.
+   *
+   * @return true for the compact encoding
+   */
+  bool IsCompact (void) const;
+
   /**
    * Appends a message (Advertise or Withdraw) to the payload.
    *
    * You must ensure it will fit before calling this method.  Get the
-   * remaining capacity via GetCapacity() and make sure it is no smaller
-   * than the message's GetSerializeSize().  This method will assert if
+   * remaining capacity via GetRemaining() and make sure it is no smaller
+   * than GetMessageSize() of the message.  This method will assert if
    * you append something that would extend beyond the remaining
    * capacity.
    *
@@ -133,6 +161,16 @@ public:
    */
   void AppendMessage (Ptr<NfpMessage> message);
 
+  /**
+   * Returns the number of bytes the message would use if appended next.  For a
+   * compact payload this depends on the messages already appended, otherwise it is
+   * the message's GetSerializedSize().
+   *
+   * @param message The message (Advertise or Withdraw)
+   * @return The bytes the message would use in this payload
+   */
+  uint32_t GetMessageSize (Ptr<const NfpMessage> message) const;
+
   /**
    * Returns the number of messages contained in this payload.
    *
@@ -188,8 +226,88 @@ public:
   friend std::ostream & operator << (std::ostream &os, const NfpPayload &payload);
 
 protected:
+  /**
+   * The state of the compact encoding after some number of messages: the names the payload
+   * carries so far and the anchor seqnum and distance of the last advertisement.  AppendMessage()
+   * keeps one in m_compactState, while Serialize() and Deserialize() rebuild one as they walk
+   * the messages, so the sizes and name indices always agree.
+   */
+  class CompactState
+  {
+  public:
+    CompactState ();
+
+    /**
+     * Clears the state and puts the router name at index 0.
+     */
+    void Reset (Ptr<const CCNxName> routerName);
+
+    /**
+     * The compact size of the message if it were the next one.
+     */
+    uint32_t GetMessageSize (Ptr<const NfpMessage> message) const;
+
+    /**
+     * Updates the state as if the message were encoded next.
+     */
+    void Append (Ptr<const NfpMessage> message);
+
+    /**
+     * Writes the compact encoding of the message at `start`, advances `start` past it,
+     * and updates the state.
+     */
+    void Serialize (Ptr<const NfpMessage> message, Buffer::Iterator &start);
+
+    /**
+     * Reads a T_ADV_COMPACT or T_WITHDRAW_COMPACT at `start`, advances `start` past it,
+     * and updates the state.
+     *
+     * @param [out] length The number of bytes read
+     * @return The decoded message
+     */
+    Ptr<NfpMessage> Deserialize (Buffer::Iterator &start, uint32_t &length);
+
+  private:
+    /**
+     * How one name is encoded.  `type` is NfpSchema::T_NAME_REF, NfpSchema::T_NAME_DELTA,
+     * or NfpSchema::T_NAME for the full name.
+     */
+    struct NameEncoding
+    {
+      uint16_t type;
+      uint16_t index;
+      uint16_t shared;
+      uint32_t size;
+    };
+
+    NameEncoding EncodeName (Ptr<const CCNxName> name) const;
+    void WriteName (Ptr<const CCNxName> name, const NameEncoding &encoding, Buffer::Iterator &start) const;
+    Ptr<const CCNxName> ReadName (Buffer::Iterator &start, uint32_t &length, bool &isReference) const;
+
+    /**
+     * Adds the names of a message that were not sent as a T_NAME_REF, after the message.
+     */
+    void AddNames (Ptr<const CCNxName> anchorName, bool anchorIsReference,
+                   Ptr<const CCNxName> prefix, bool prefixIsReference, uint16_t prefixIndex);
+
+    bool IsAdvertiseDataRepeated (uint32_t anchorSeqnum, uint16_t distance) const;
+    void SetAdvertiseData (uint32_t anchorSeqnum, uint16_t distance);
+
+    typedef std::map< Ptr<const CCNxName>, uint16_t, CCNxName::isLessPtrCCNxName > NameIndexType;
+
+    std::vector< Ptr<const CCNxName> > m_names;         //<! names by index
+    NameIndexType m_nameIndex;                           //<! first index of each name
+    bool m_hasLastPrefix;
+    uint16_t m_lastPrefix;                               //<! index of the last prefix, the T_NAME_DELTA base
+    bool m_hasAdvertiseData;
+    uint32_t m_anchorSeqnum;                             //<! of the last advertisement
+    uint16_t m_distance;                                 //<! of the last advertisement
+  };
+
   size_t m_capacity;
   size_t m_remaining;
+  bool m_compact;
+  CompactState m_compactState;
 
   CCNxCodecName m_routerNameCodec;
   uint16_t m_msgSeqnum;
@@ -198,6 +316,7 @@ protected:
   uint32_t DeserializeMessageSeqnum (Buffer::Iterator const &start, Buffer::Iterator &current);
   uint32_t DeserializeAdvertise (Buffer::Iterator const &start, Buffer::Iterator &current);
   uint32_t DeserializeWithdraw (Buffer::Iterator const &start, Buffer::Iterator &current);
+  uint32_t DeserializeCompact (Buffer::Iterator const &start, Buffer::Iterator &current, CompactState &state);
 
   typedef std::vector< Ptr<NfpMessage> > MessageListType;
   MessageListType m_messages;
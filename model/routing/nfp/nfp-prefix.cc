@@ -53,10 +53,12 @@
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
 
+#include <algorithm>
 #include <iostream>
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/simulator.h"
 #include "nfp-prefix.h"
 
 using namespace ns3;
@@ -65,7 +67,8 @@ using namespace ns3::ccnx;
 NS_LOG_COMPONENT_DEFINE ("NfpPrefix");
 
 NfpPrefix::NfpPrefix (Ptr<const CCNxName> prefix, Time advertisementTimeout, PrefixStateChangeCallback callback)
-  : m_prefix (prefix), m_advertisementTimeout (advertisementTimeout), m_stateChangeCallback (callback)
+  : m_prefix (prefix), m_advertisementTimeout (advertisementTimeout), m_stateChangeCallback (callback),
+  m_routeExpiryTime (Time::Max ())
 {
   NS_LOG_FUNCTION (this << prefix << advertisementTimeout);
 }
@@ -103,6 +106,8 @@ NfpPrefix::ReceiveAdvertisement (Ptr<NfpAdvertise> advertisement, Ptr<CCNxConnec
 
       m_computationCost.IncrementEvents();
       m_anchors[anchorName] = aa;
+      m_anchorsByConnection[ingressConnection->GetConnectionId ()].insert (anchorName);
+      InvalidateRoute ();
       result = Advertisement_ImprovedRoute;
       notify = true;
     }
@@ -113,9 +118,19 @@ NfpPrefix::ReceiveAdvertisement (Ptr<NfpAdvertise> advertisement, Ptr<CCNxConnec
         {
 	  m_computationCost.IncrementEvents();
           Time expiryTime = now + m_advertisementTimeout;
-          bool wasReachable = aa->GetNexthopCount () > 0;
+          size_t previousCount = aa->GetNexthopCount ();
           NfpAnchorAdvertisement::CompareResult compareResult = aa->UpdateAdvertisement (advertisement, ingressConnection, expiryTime);
-          bool isReachable = aa->GetNexthopCount () > 0;
+          size_t count = aa->GetNexthopCount ();
+          bool wasReachable = previousCount > 0;
+          bool isReachable = count > 0;
+
+          m_anchorsByConnection[ingressConnection->GetConnectionId ()].insert (anchorName);
+
+          // A refresh of an existing equal cost path only moves its expiry time, the route is the same
+          if (compareResult == NfpAnchorAdvertisement::REPLACE || count != previousCount)
+            {
+              InvalidateRoute ();
+            }
 
           switch (compareResult) {
             case NfpAnchorAdvertisement::REPLACE:
@@ -156,6 +171,10 @@ NfpPrefix::ReceiveWithdraw (Ptr<NfpWithdraw> withdraw, Ptr<CCNxConnection> ingre
       Ptr<NfpAnchorAdvertisement> aa = i->second;
       bool wasReachable = aa->GetNexthopCount () > 0;
       result = aa->RemoveNexthop (ingressConnection);
+      if (result)
+        {
+          InvalidateRoute ();
+        }
       if (wasReachable && aa->GetNexthopCount () == 0)
         {
           NS_LOG_DEBUG ("Prefix " << *m_prefix << " anchor " << *anchorName << " no longer reachable");
@@ -172,16 +191,34 @@ NfpPrefix::RemoveConnection (Ptr<CCNxConnection> connection)
 {
   NS_LOG_FUNCTION (this << connection->GetConnectionId ());
 
-  for (AnchorMapType::iterator i = m_anchors.begin (); i != m_anchors.end (); ++i)
+  AnchorsByConnectionType::iterator index = m_anchorsByConnection.find (connection->GetConnectionId ());
+  if (index == m_anchorsByConnection.end ())
+    {
+      return;
+    }
+
+  // take the set out of the index first so the state change callback cannot invalidate it
+  AnchorNameSetType anchorNames;
+  anchorNames.swap (index->second);
+  m_anchorsByConnection.erase (index);
+
+  for (AnchorNameSetType::iterator j = anchorNames.begin (); j != anchorNames.end (); ++j)
     {
       m_computationCost.IncrementLoopIterations();
-      Ptr<NfpAnchorAdvertisement> aa = i->second;
-      bool wasReachable = aa->GetNexthopCount () > 0;
-      aa->RemoveNexthop (connection);
-      bool isReachable = aa->GetNexthopCount () > 0;
-      if (wasReachable != isReachable)
+      AnchorMapType::iterator i = m_anchors.find (*j);
+      if (i != m_anchors.end ())
         {
-          m_stateChangeCallback (m_prefix, aa->GetAnchorName ());
+          Ptr<NfpAnchorAdvertisement> aa = i->second;
+          bool wasReachable = aa->GetNexthopCount () > 0;
+          if (aa->RemoveNexthop (connection))
+            {
+              InvalidateRoute ();
+            }
+          bool isReachable = aa->GetNexthopCount () > 0;
+          if (wasReachable != isReachable)
+            {
+              m_stateChangeCallback (m_prefix, aa->GetAnchorName ());
+            }
         }
     }
 }
@@ -190,17 +227,9 @@ NfpPrefix::RemoveConnection (Ptr<CCNxConnection> connection)
 bool
 NfpPrefix::IsReachable (void)
 {
-  bool result = false;
-  for (AnchorMapType::const_iterator i = m_anchors.cbegin (); i != m_anchors.cend (); ++i)
-    {
-      m_computationCost.IncrementLoopIterations();
-      if (i->second->GetNexthopCount () > 0)
-        {
-          result = true;
-          break;
-        }
-    }
-  return result;
+  // The route is the union of the next hops of all anchors, so it is empty exactly when
+  // no anchor has a next hop.
+  return !GetRoute ()->empty ();
 }
 
 bool
@@ -220,17 +249,29 @@ NfpPrefix::IsReachable (Ptr<const CCNxName> anchorName)
   return result;
 }
 
-Ptr<CCNxRoute>
+Ptr<const CCNxRoute>
 NfpPrefix::GetRoute (void)
 {
-  // TODO: cache this
-  Ptr<CCNxRoute> route = Create<CCNxRoute> (m_prefix);
-  for (AnchorMapType::const_iterator i = m_anchors.begin (); i != m_anchors.end (); ++i)
+  if (!m_route || m_routeExpiryTime <= Simulator::Now ())
     {
-      m_computationCost.IncrementLoopIterations();
-      route->AddRoute (i->second->GetRouteNoLinkCosts ());
+      // Build a new object rather than modify m_route, a caller may still hold the old one
+      Ptr<CCNxRoute> route = Create<CCNxRoute> (m_prefix);
+      m_routeExpiryTime = Time::Max ();
+      for (AnchorMapType::const_iterator i = m_anchors.begin (); i != m_anchors.end (); ++i)
+        {
+          m_computationCost.IncrementLoopIterations();
+          route->AddRoute (i->second->GetRouteNoLinkCosts ());
+          m_routeExpiryTime = std::min (m_routeExpiryTime, i->second->GetNextExpiryTime ());
+        }
+      m_route = route;
     }
-  return route;
+  return m_route;
+}
+
+void
+NfpPrefix::InvalidateRoute (void)
+{
+  m_route = 0;
 }
 
 Ptr<const NfpAdvertise>
@@ -58,6 +58,7 @@
 
 #include <map>
 #include <queue>
+#include <set>
 
 #include "ns3/simple-ref-count.h"
 #include "ns3/nstime.h"
@@ -88,6 +89,11 @@ namespace ccnx {
  * The prefix table also tracks the last time an advertisement was sent for each anchor
  * for this prefix.  This allows the routing protocol to read off times from the heap
  * so it can send advertisements at the right interval.
+ *
+ * Updates are incremental.  m_anchorsByConnection indexes the anchors learned on each
+ * connection, so RemoveConnection() only visits the (anchor, prefix) pairs that used the
+ * connection.  The union route returned by GetRoute() is cached and only rebuilt after an
+ * anchor's next hops change or the earliest next hop expiry passes.
  */
 class NfpPrefix : public SimpleRefCount<NfpPrefix>
 {
@@ -160,7 +166,8 @@ public:
   bool ReceiveWithdraw (Ptr<NfpWithdraw> withdraw, Ptr<CCNxConnection> ingressConnection, Time now);
 
   /**
-   * Remove a connection id from all routes.
+   * Remove a connection id from all routes.  Only the anchors that were learned on the
+   * connection are visited.
    *
    * @param [in] connection The connection id to remove from all routes.
    */
@@ -169,7 +176,8 @@ public:
   /**
    * Determines if we can reach the prefix.
    *
-   * To be reachable, we must know of at least one anchor with at least one nexthop
+   * To be reachable, we must know of at least one anchor with at least one nexthop.
+   * This is answered from the cached route (see GetRoute()).
    *
    * @return True if reachable, false if not reachable
    */
@@ -201,9 +209,12 @@ public:
    * possible next hops for all anchors.  This is the image of what the FIB entry should
    * look like for the prefix.
    *
+   * The route is cached.  A new route object is built only when an anchor has changed or
+   * a next hop has expired since the last call, so callers may hold on to the returned route.
+   *
    * @return The route for this prefix.
    */
-  Ptr<CCNxRoute> GetRoute (void);
+  Ptr<const CCNxRoute> GetRoute (void);
 
   /**
    * Dump the state of this prefix entry and all AnchorAdvertisements it contains.
@@ -234,6 +245,32 @@ protected:
 
   AnchorMapType m_anchors;
 
+  typedef std::set< Ptr<const CCNxName>, CCNxName::isLessPtrCCNxName > AnchorNameSetType;
+
+  typedef std::map< CCNxConnection::ConnIdType, AnchorNameSetType > AnchorsByConnectionType;
+
+  /**
+   * Reverse index of m_anchors by the connection an advertisement was received on.  An anchor
+   * may stay in the set of a connection it no longer uses; RemoveConnection() ignores those.
+   */
+  AnchorsByConnectionType m_anchorsByConnection;
+
+  /**
+   * The cached result of GetRoute(), or null if it must be rebuilt
+   */
+  Ptr<const CCNxRoute> m_route;
+
+  /**
+   * The earliest next hop expiry time of all anchors when m_route was built.
+   * m_route is stale once the simulation time reaches it.
+   */
+  Time m_routeExpiryTime;
+
+  /**
+   * Forces the next GetRoute() to rebuild the route
+   */
+  void InvalidateRoute (void);
+
   NfpComputationCost m_computationCost;
 };
 }   /* namespace ccnx */
@@ -57,6 +57,8 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <limits>
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
@@ -68,6 +70,10 @@
 #include "ns3/nfp-payload.h"
 #include "ns3/buffer.h"
 #include "ns3/ccnx-name-builder.h"
+#include "ns3/ccnx-connection-device.h"
+#include "ns3/channel.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 
 using namespace ns3;
 using namespace ns3::ccnx;
@@ -102,7 +108,23 @@ NfpRoutingProtocol::GetTypeId ()
     .AddAttribute ("NeighborTimeout", "Timeout a neighbor if not heard in this period.",
                    TimeValue (Seconds (6)),
                    MakeTimeAccessor (&NfpRoutingProtocol::m_neighborTimeout),
-                   MakeTimeChecker ());
+                   MakeTimeChecker ())
+    .AddAttribute ("LinkCost", "Link cost of an interface with no other configured cost.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&NfpRoutingProtocol::m_defaultLinkCost),
+                   MakeUintegerChecker<uint16_t> (1))
+    .AddAttribute ("LinkCostDelayUnit", "If positive, an interface's link cost is its channel delay in these units.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&NfpRoutingProtocol::m_linkCostDelayUnit),
+                   MakeTimeChecker ())
+    .AddAttribute ("CompactPayloads", "Send payloads with name back-references and repeated advertisement data omitted.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&NfpRoutingProtocol::m_compactPayloads),
+                   MakeBooleanChecker ())
+    .AddAttribute ("FullRefreshInterval", "Send every route in full at least once in this many refresh intervals, and only changes in between.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&NfpRoutingProtocol::m_fullRefreshInterval),
+                   MakeUintegerChecker<uint32_t> (1));
   return tid;
 }
 
@@ -112,7 +134,12 @@ NfpRoutingProtocol::GetTypeId ()
 NfpRoutingProtocol::NfpRoutingProtocol ()
 {
   m_anchorSeqnum = 0;
+  m_anchorRefreshCount = 0;
+  m_fullRefreshInterval = 1;
   m_messageSeqnum = 1;
+  m_defaultLinkCost = 1;
+  m_compactPayloads = true;
+  m_packetOverhead = 0;
   m_helloTimer = Timer (Timer::REMOVE_ON_DESTROY);
   m_advertiseTimer = Timer (Timer::REMOVE_ON_DESTROY);
   m_anchorRouteTimer = Timer (Timer::REMOVE_ON_DESTROY);
@@ -423,11 +450,16 @@ NfpRoutingProtocol::AnchorRouteTimerExpired ()
     {
       NS_LOG_DEBUG ("AnchorRouteTimerExpired Node " << m_node->GetId() << " injecting routes for our anchor names (timeout = " << m_routeTimeout << ")");
 
-      uint32_t anchorSeqnum = m_anchorSeqnum++;
-      // Create an advertise for each anchor name and inject it into our RIB.
-      for (AnchorNameMapType::const_iterator i = m_anchorNames.cbegin (); i != m_anchorNames.cend (); ++i)
+      // With delta refreshes our anchor routes only change every m_fullRefreshInterval expiries.  In
+      // between there is nothing to inject, as the RIB keeps them for that many route timeouts.
+      if (m_anchorRefreshCount++ % m_fullRefreshInterval == 0)
         {
-          InjectAnchorRoute (i->first, anchorSeqnum);
+          uint32_t anchorSeqnum = m_anchorSeqnum++;
+          // Create an advertise for each anchor name and inject it into our RIB.
+          for (AnchorNameMapType::const_iterator i = m_anchorNames.cbegin (); i != m_anchorNames.cend (); ++i)
+            {
+              InjectAnchorRoute (i->first, anchorSeqnum);
+            }
         }
      }
 
@@ -458,8 +490,17 @@ NfpRoutingProtocol::AdvertiseTimerExpired ()
       if (entry->GetTime () <= GetCurrentTime () + m_jitter)
         {
           // process entry
-          AddWorkQueueEntry (entry->GetAnchorName (), entry->GetPrefix ());
           m_prefixTimerHeap.Pop ();
+          if (IsRefreshNeeded (entry->GetPrefix (), entry->GetAnchorName ()))
+            {
+              AddWorkQueueEntry (entry->GetAnchorName (), entry->GetPrefix ());
+            }
+          else
+            {
+              // unchanged since we sent it, so leave it out of this delta refresh
+              m_prefixTimerHeap.Insert (entry->GetPrefix (), entry->GetAnchorName (),
+                                        GetCurrentTime () + CalculateJitteredTime (m_routeTimeout, m_jitter));
+            }
         }
       else
         {
@@ -493,12 +534,31 @@ NfpRoutingProtocol::GetNextMessageSeqnum (void)
   return m_messageSeqnum++;
 }
 
+uint32_t
+NfpRoutingProtocol::GetPacketOverhead (void)
+{
+  if (m_packetOverhead == 0)
+    {
+      // The Interest name and all TLV lengths are fixed, so an empty payload has the same
+      // overhead as a full one.
+      Ptr<NfpPayload> empty = Create<NfpPayload> (std::numeric_limits<uint16_t>::max (), m_routerName, 0);
+      Ptr<CCNxPacket> packet = CreatePacket (empty);
+      m_packetOverhead = packet->GetWireSize () - empty->GetSerializedSize ();
+      NS_LOG_DEBUG ("Packet overhead " << m_packetOverhead);
+    }
+  return m_packetOverhead;
+}
+
 Ptr<NfpPayload>
 NfpRoutingProtocol::CreatePayload (void)
 {
-  // FIXME: need to subtract the FixedHeader and Interest overhead.  The "50" is just a hack.
-  size_t packetOverhead = 50;
-  Ptr<NfpPayload> payload = Create<NfpPayload> (m_minimumMtu - packetOverhead, m_routerName, GetNextMessageSeqnum ());
+  uint32_t packetOverhead = GetPacketOverhead ();
+  NS_ASSERT_MSG (m_minimumMtu > packetOverhead, "MTU " << m_minimumMtu << " smaller than Interest overhead " << packetOverhead);
+
+  // The packet has a 16-bit length, which also bounds the payload when no interface is up.
+  size_t capacity = std::min (m_minimumMtu - packetOverhead,
+                              (uint32_t) std::numeric_limits<uint16_t>::max () - packetOverhead);
+  Ptr<NfpPayload> payload = Create<NfpPayload> (capacity, m_routerName, GetNextMessageSeqnum (), m_compactPayloads);
 
   NS_LOG_DEBUG("Create payload " << *payload);
 
@@ -517,7 +577,7 @@ NfpRoutingProtocol::CreatePacket (Ptr<NfpPayload> payload)
 
   Ptr<CCNxInterest> interest = Create<CCNxInterest> (b.CreateName(), buffer);
   Ptr<CCNxPacket> packet = CCNxPacket::CreateFromMessage (interest);
-  packet->GetFixedHeader ()->SetHopLimit (1);
+  packet->SetHopLimit (1);
 
   return packet;
 }
@@ -616,7 +676,8 @@ void
 NfpRoutingProtocol::AddAdvertise (Ptr<NfpAdvertise> advertise, Ptr<CCNxConnection> ingressConnection)
 {
   Ptr<const CCNxName> prefixName = advertise->GetPrefix ();
-  Ptr<NfpPrefix> prefixEntry = Create<NfpPrefix> (prefixName, m_routeTimeout,
+  // With delta refreshes a neighbor may only re-send an unchanged route every m_fullRefreshInterval intervals
+  Ptr<NfpPrefix> prefixEntry = Create<NfpPrefix> (prefixName, m_routeTimeout * m_fullRefreshInterval,
                                                   MakeCallback (&NfpRoutingProtocol::PrefixStateChanged, this));
 
   // must do this before calling ReceiveAdvertisement because if that triggers the PrefixStateChagned callback,
@@ -638,7 +699,25 @@ NfpRoutingProtocol::ReceiveAdvertise (Ptr<NfpAdvertise> advertise, Ptr<CCNxConne
 
   m_stats.IncrementAdvertiseReceived();
   m_computationCost.IncrementEvents();
+
+  // The RIB stores distances that include the link to the neighbor, so we can
+  // compare paths through different links and re-advertise them unchanged.
+  uint16_t linkCost = GetIngressLinkCost (ingressConnection);
+  if (linkCost > 0)
+    {
+      advertise = Create<NfpAdvertise> (*advertise, linkCost);
+    }
+
+  // A path cost that saturated is unreachable, so it replaces any route we had through this neighbor
+  if (advertise->IsInfinite ())
+    {
+      NS_LOG_INFO ("Infinite distance advertisement " << *advertise << " ingress " << ingressConnection->GetConnectionId () << ", withdrawing");
+      WithdrawRoute (Create<NfpWithdraw> (advertise->GetAnchorName (), advertise->GetPrefix ()), ingressConnection);
+      return;
+    }
+
   Ptr<const CCNxName> prefixName = advertise->GetPrefix ();
+  m_prefixesByConnection[ingressConnection->GetConnectionId ()].insert (prefixName);
   PrefixMapType::iterator i = m_prefixes.find (prefixName);
   if (i == m_prefixes.end ())
     {
@@ -668,7 +747,12 @@ NfpRoutingProtocol::ReceiveWithdraw (Ptr<NfpWithdraw> withdraw, Ptr<CCNxConnecti
   NS_LOG_FUNCTION (this << withdraw << ingressConnection->GetConnectionId ());
 
   m_stats.IncrementWithdrawReceived();
+  WithdrawRoute (withdraw, ingressConnection);
+}
 
+void
+NfpRoutingProtocol::WithdrawRoute (Ptr<NfpWithdraw> withdraw, Ptr<CCNxConnection> ingressConnection)
+{
   m_computationCost.IncrementEvents();
   Ptr<const CCNxName> prefixName = withdraw->GetPrefix ();
   PrefixMapType::iterator i = m_prefixes.find (prefixName);
@@ -752,11 +836,11 @@ NfpRoutingProtocol::NeighborStateChanged (Ptr<NfpNeighborKey> neighborKey)
     }
 }
 
-Ptr<CCNxRoute>
+Ptr<const CCNxRoute>
 NfpRoutingProtocol::GetModelFibRoute (Ptr<const CCNxName> prefix)
 {
   m_computationCost.IncrementEvents();
-  Ptr<CCNxRoute> route;
+  Ptr<const CCNxRoute> route;
   ModelFibType::iterator i = m_modelFib.find (prefix);
   if (i == m_modelFib.end ())
     {
@@ -775,19 +859,7 @@ NfpRoutingProtocol::AddAnchorToFib (Ptr<NfpPrefix> prefixEntry, Ptr<const CCNxNa
 {
   NS_LOG_FUNCTION (this << *prefixEntry << *anchorName);
   NS_LOG_DEBUG ("AddAnchorToFib: prefix " << *prefixEntry->GetPrefix ());
-
-  Ptr<CCNxL3Protocol> ccnx = m_node->GetObject<CCNxL3Protocol> ();
-  Ptr<CCNxForwarder> forwarder = m_node->GetObject<CCNxForwarder> ();
-
-  Ptr<CCNxRoute> currentRoute = prefixEntry->GetRoute ();
-  Ptr<CCNxRoute> modelRoute   = GetModelFibRoute (prefixEntry->GetPrefix ());
-
-  // For now, we simply remove everything from modelRoute then add everything from currentRoute.
-  forwarder->RemoveRoute (modelRoute);
-  forwarder->AddRoute (currentRoute);
-
-  m_computationCost.IncrementEvents();
-  m_modelFib[prefixEntry->GetPrefix ()] = currentRoute;
+  UpdateFib (prefixEntry);
 }
 
 void
@@ -795,16 +867,57 @@ NfpRoutingProtocol::RemoveAnchorFromFib (Ptr<NfpPrefix> prefixEntry, Ptr<const C
 {
   NS_LOG_FUNCTION (this << *prefixEntry << *anchorName);
   NS_LOG_DEBUG ("RemoveAnchorFromFib: prefix " << *prefixEntry->GetPrefix ());
+  UpdateFib (prefixEntry);
+}
+
+void
+NfpRoutingProtocol::UpdateFib (Ptr<NfpPrefix> prefixEntry)
+{
+  NS_LOG_FUNCTION (this << *prefixEntry);
 
-  Ptr<CCNxL3Protocol> ccnx = m_node->GetObject<CCNxL3Protocol> ();
   Ptr<CCNxForwarder> forwarder = m_node->GetObject<CCNxForwarder> ();
 
-  Ptr<CCNxRoute> currentRoute = prefixEntry->GetRoute ();
-  Ptr<CCNxRoute> modelRoute   = GetModelFibRoute (prefixEntry->GetPrefix ());
+  Ptr<const CCNxRoute> currentRoute = prefixEntry->GetRoute ();
+  Ptr<const CCNxRoute> modelRoute   = GetModelFibRoute (prefixEntry->GetPrefix ());
+
+  if (currentRoute == modelRoute)
+    {
+      // NfpPrefix returns the same route object until something changes
+      return;
+    }
 
-  // For now, we simply remove everything from modelRoute then add everything from currentRoute.
-  forwarder->RemoveRoute (modelRoute);
-  forwarder->AddRoute (currentRoute);
+  // Next hops that are new, or whose cost changed
+  Ptr<CCNxRoute> added = Create<CCNxRoute> (prefixEntry->GetPrefix ());
+  for (CCNxRoute::const_iterator i = currentRoute->cbegin (); i != currentRoute->cend (); ++i)
+    {
+      m_computationCost.IncrementLoopIterations();
+      Ptr<const CCNxRouteEntry> modelEntry = modelRoute->GetNexthop ((*i)->GetConnection ());
+      if (!modelEntry || modelEntry->GetCost () != (*i)->GetCost ())
+        {
+          added->AddNexthop (*i);
+        }
+    }
+
+  // Next hops that are no longer in the RIB
+  Ptr<CCNxRoute> removed = Create<CCNxRoute> (prefixEntry->GetPrefix ());
+  for (CCNxRoute::const_iterator i = modelRoute->cbegin (); i != modelRoute->cend (); ++i)
+    {
+      m_computationCost.IncrementLoopIterations();
+      if (!currentRoute->GetNexthop ((*i)->GetConnection ()))
+        {
+          removed->AddNexthop (*i);
+        }
+    }
+
+  if (!added->empty ())
+    {
+      forwarder->AddRoute (added);
+    }
+
+  if (!removed->empty ())
+    {
+      forwarder->RemoveRoute (removed);
+    }
 
   m_computationCost.IncrementEvents();
   m_modelFib[prefixEntry->GetPrefix ()] = currentRoute;
@@ -851,13 +964,28 @@ NfpRoutingProtocol::RemoveNeighborRoutes (Ptr<const CCNxName> neighborName, Ptr<
 {
   NS_LOG_FUNCTION (this << *neighborName << connection->GetConnectionId ());
 
-  for (PrefixMapType::iterator i = m_prefixes.begin (); i != m_prefixes.end (); ++i)
+  PrefixesByConnectionType::iterator index = m_prefixesByConnection.find (connection->GetConnectionId ());
+  if (index == m_prefixesByConnection.end ())
+    {
+      return;
+    }
+
+  // take the set out of the index first so callbacks made while removing cannot invalidate it
+  PrefixNameSetType prefixNames;
+  prefixNames.swap (index->second);
+  m_prefixesByConnection.erase (index);
+
+  for (PrefixNameSetType::iterator j = prefixNames.begin (); j != prefixNames.end (); ++j)
     {
       m_computationCost.IncrementLoopIterations();
-      Ptr<NfpPrefix> prefix = i->second;
+      PrefixMapType::iterator i = m_prefixes.find (*j);
+      if (i != m_prefixes.end ())
+        {
+          Ptr<NfpPrefix> prefix = i->second;
 
-      // this may induce a callback to PrefixStateChanged()
-      prefix->RemoveConnection (connection);
+          // this may induce a callback to PrefixStateChanged()
+          prefix->RemoveConnection (connection);
+        }
     }
 }
 
@@ -913,11 +1041,11 @@ NfpRoutingProtocol::ProcessWorkQueue (void)
                   Ptr<const NfpAdvertise> bestInRib = prefixEntry->GetAdvertisement (workEntry->GetAnchorName ());
                   NS_ASSERT_MSG (bestInRib, "Failed to retrieve stored advertisement for someting in workqueue");
 
-                  // TODO: Implement link cost table
-                  uint16_t linkcost = 1;
-                  Ptr<NfpAdvertise> advertise = Create<NfpAdvertise> (*bestInRib, linkcost);
+                  // The RIB distance already includes the link cost to our next hop (see ReceiveAdvertise),
+                  // so we advertise the stored message as is.  Messages are not modified once created.
+                  Ptr<NfpAdvertise> advertise = ConstCast<NfpAdvertise> (bestInRib);
 
-                  if (advertise->GetSerializedSize () > payload->GetRemaining ())
+                  if (payload->GetMessageSize (advertise) > payload->GetRemaining ())
                     {
                       SendFromWorkQueue (payload);
                       payload = CreatePayload ();
@@ -925,6 +1053,7 @@ NfpRoutingProtocol::ProcessWorkQueue (void)
 
                   NS_LOG_DEBUG("Append to payload " << *advertise);
                   payload->AppendMessage (advertise);
+                  RecordSent (workEntry, advertise);
 
                   m_stats.IncrementAdvertiseSent();
                 }
@@ -933,7 +1062,7 @@ NfpRoutingProtocol::ProcessWorkQueue (void)
                   // send a withdraw
 
                   Ptr<NfpWithdraw> withdraw = Create<NfpWithdraw> (workEntry->GetAnchorName (), prefixEntry->GetPrefix ());
-                  if (withdraw->GetSerializedSize () > payload->GetRemaining ())
+                  if (payload->GetMessageSize (withdraw) > payload->GetRemaining ())
                     {
                       SendFromWorkQueue (payload);
                       payload = CreatePayload ();
@@ -941,6 +1070,7 @@ NfpRoutingProtocol::ProcessWorkQueue (void)
 
                   NS_LOG_DEBUG("Append to payload " << *withdraw);
                   payload->AppendMessage (withdraw);
+                  RecordSent (workEntry, Ptr<const NfpAdvertise> (0));
                   m_stats.IncrementWithdrawSent();
                 }
 
@@ -962,6 +1092,54 @@ NfpRoutingProtocol::ProcessWorkQueue (void)
   }
 }
 
+void
+NfpRoutingProtocol::RecordSent (Ptr<NfpWorkQueueEntry> workEntry, Ptr<const NfpAdvertise> advertise)
+{
+  if (m_fullRefreshInterval > 1)
+    {
+      SentState &sent = m_sentState[workEntry];
+      sent.isAdvertise = advertise ? true : false;
+      sent.anchorSeqnum = advertise ? advertise->GetAnchorSeqnum () : 0;
+      sent.distance = advertise ? advertise->GetDistance () : 0;
+      sent.skippedRefreshes = 0;
+    }
+}
+
+bool
+NfpRoutingProtocol::IsRefreshNeeded (Ptr<const CCNxName> prefix, Ptr<const CCNxName> anchorName)
+{
+  if (m_fullRefreshInterval <= 1)
+    {
+      return true;
+    }
+
+  m_computationCost.IncrementEvents();
+  SentStateMapType::iterator i = m_sentState.find (Create<NfpWorkQueueEntry> (anchorName, prefix));
+  PrefixMapType::const_iterator p = m_prefixes.find (prefix);
+  if (i == m_sentState.end () || p == m_prefixes.end ())
+    {
+      return true;
+    }
+
+  SentState &sent = i->second;
+  if (++sent.skippedRefreshes >= m_fullRefreshInterval)
+    {
+      // full refresh
+      return true;
+    }
+
+  // an unreachable route changed if we last sent an advertisement for it
+  bool changed = sent.isAdvertise;
+  if (p->second->IsReachable (anchorName))
+    {
+      Ptr<const NfpAdvertise> bestInRib = p->second->GetAdvertisement (anchorName);
+      changed = !sent.isAdvertise || sent.anchorSeqnum != bestInRib->GetAnchorSeqnum () || sent.distance != bestInRib->GetDistance ();
+    }
+
+  NS_LOG_DEBUG ("Refresh " << *prefix << " anchor " << *anchorName << (changed ? " changed" : " unchanged, skipped"));
+  return changed;
+}
+
 void
 NfpRoutingProtocol::Broadcast (Ptr<CCNxPacket> packet)
 {
@@ -996,6 +1174,12 @@ NfpRoutingProtocol::NotifyInterfaceUp (uint32_t interface)
   m_interfaces[interface] = l3interface;
   m_minimumMtu = GetMinimumMtu ();
 
+  // keep a cost set by SetLinkCost() before the interface came up
+  if (m_linkCosts.find (interface) == m_linkCosts.end ())
+    {
+      m_linkCosts[interface] = Create<NfpLinkCost> (interface, CalculateLinkCost (interface));
+    }
+
   NS_LOG_INFO ("Add interface " << interface << " mtu " << l3interface->GetMtu ());
 }
 
@@ -1015,6 +1199,74 @@ NfpRoutingProtocol::NotifyInterfaceDown (uint32_t interface)
   m_minimumMtu = GetMinimumMtu ();
 }
 
+void
+NfpRoutingProtocol::SetLinkCost (uint32_t interface, uint16_t cost)
+{
+  NS_LOG_FUNCTION (this << interface << cost);
+  NS_ASSERT_MSG (cost > 0, "Link cost must be positive");
+
+  LinkCostMapType::iterator i = m_linkCosts.find (interface);
+  if (i != m_linkCosts.end ())
+    {
+      i->second->SetCost (cost);
+    }
+  else
+    {
+      m_linkCosts[interface] = Create<NfpLinkCost> (interface, cost);
+    }
+}
+
+uint16_t
+NfpRoutingProtocol::GetLinkCost (uint32_t interface) const
+{
+  uint16_t cost = m_defaultLinkCost;
+  LinkCostMapType::const_iterator i = m_linkCosts.find (interface);
+  if (i != m_linkCosts.end ())
+    {
+      cost = i->second->GetCost ();
+    }
+  return cost;
+}
+
+uint16_t
+NfpRoutingProtocol::GetIngressLinkCost (Ptr<CCNxConnection> connection) const
+{
+  if (connection->GetConnectionId () == CCNxConnection::ConnIdLocalHost)
+    {
+      return 0;
+    }
+
+  uint16_t cost = m_defaultLinkCost;
+  Ptr<CCNxConnectionDevice> deviceConnection = DynamicCast<CCNxConnectionDevice, CCNxConnection> (connection);
+  if (deviceConnection && deviceConnection->GetOutputDevice ())
+    {
+      cost = GetLinkCost (deviceConnection->GetOutputDevice ()->GetIfIndex ());
+    }
+  return cost;
+}
+
+uint16_t
+NfpRoutingProtocol::CalculateLinkCost (uint32_t interface) const
+{
+  uint16_t cost = m_defaultLinkCost;
+  if (m_linkCostDelayUnit.IsStrictlyPositive ())
+    {
+      Ptr<Channel> channel = m_node->GetDevice (interface)->GetChannel ();
+      TimeValue delay;
+      if (channel && channel->GetAttributeFailSafe ("Delay", delay))
+        {
+          int64_t units = delay.Get ().GetNanoSeconds () / m_linkCostDelayUnit.GetNanoSeconds ();
+          units = std::max (units, (int64_t) 1);
+          // one less than infinite, so a directly attached anchor is still reachable
+          units = std::min (units, (int64_t) NfpAdvertise::InfiniteDistance - 1);
+          cost = (uint16_t) units;
+        }
+    }
+
+  NS_LOG_INFO ("Interface " << interface << " link cost " << cost);
+  return cost;
+}
+
 void
 NfpRoutingProtocol::SetNode (Ptr<Node> node)
 {
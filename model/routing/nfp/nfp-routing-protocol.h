@@ -58,6 +58,7 @@
 
 #include <list>
 #include <map>
+#include <set>
 
 #include "ns3/ccnx-l3-protocol.h"
 #include "ns3/ccnx-routing-protocol.h"
@@ -69,6 +70,7 @@
 
 #include "ns3/nfp-prefix.h"
 #include "ns3/nfp-workqueue.h"
+#include "ns3/nfp-link-cost.h"
 
 #include "ns3/timer.h"
 #include "ns3/random-variable-stream.h"
@@ -108,7 +110,11 @@ namespace ccnx {
  * - A route advertisement is feasible at a node if (a) the sequence number is larger than stored, or (b) the sequence
  *   number is equal to store and the hop count is not less than stored.  This allows equal cost multipath.
  *
- * - Each link (neighbor adjacency) has a positive cost.  We use "1" for all link costs.
+ * - Each link (neighbor adjacency) has a positive cost.  The cost is per interface, "1" by default (see
+ *   the LinkCost and LinkCostDelayUnit attributes and SetLinkCost()).  A node adds the cost of the ingress
+ *   interface to each advertisement it receives, so the distance in the RIB and FIB is the path cost.
+ *   The sum saturates at NfpAdvertise::InfiniteDistance; such a route is unreachable and is handled as
+ *   a withdraw from that neighbor.
  *
  * - Each node has a unique name, for example a cryptographic hash of a public key.  It is set in the configuration file.
  *   If it is not set, it will default to ccnx:/name=nfp/name=rtr/name=<nodeid>.
@@ -129,6 +135,15 @@ namespace ccnx {
  *         ccnx:/name=nfp/name=adv
  *         ccnx:/name=nfp/name=withdraw
  * @endcode
+ *   A payload is filled up to the minimum interface MTU less the Interest overhead.  With the CompactPayloads
+ *   attribute (default true), a payload sends repeated anchor and prefix names as back-references and omits the
+ *   (anchorPrefixSeqnum, distance) of an advertisement that repeats the previous one (see NfpPayload).
+ *
+ * - With the FullRefreshInterval attribute K greater than 1, periodic refreshes are deltas.  A refresh
+ *   only re-sends a (prefix, anchor) whose (anchorPrefixSeqnum, distance), or withdrawn state, changed since
+ *   we last sent it, and each (prefix, anchor) is sent in full at least every K refresh intervals.  An anchor
+ *   only advances its anchorPrefixSeqnum every K intervals, and a route times out after K times RouteTimeout.
+ *   Changes are still sent right away; only unchanged refreshes are left out.
  *
  * - The router will also register its name with the local forwarder.
  * @code
@@ -181,13 +196,17 @@ namespace ccnx {
  *      m_anchorNames : CCNxName -> uint32_t     (local anchor name -> refcount)
  *
  * @subsection link-cost-table Link Cost Table
- *      The link cost table should be interface # (GetIfIndex()), but we only store
- *      connection IDs.  We'd need to lookup the connection, then query for its interface number...
- *      This needs some re-thinking.
+ *      The link cost table is indexed by interface number (GetIfIndex()).  An advertisement received
+ *      on a CCNxConnectionDevice uses the cost of the connection's output device.  Advertisements we inject
+ *      as an anchor (on the local host connection) have no link cost.  Any other connection uses the
+ *      LinkCost attribute.
  *
- *      This table is currently not used and we only use a cost of "1"
+ *      An entry is created when the interface comes up, with the LinkCost attribute or, if LinkCostDelayUnit
+ *      is positive, with the channel delay in units of LinkCostDelayUnit (at most one less than
+ *      NfpAdvertise::InfiniteDistance).  SetLinkCost() overrides it.  A
+ *      changed cost applies to advertisements received after the change.
  *
- *      m_linkcosts   : uint32_t -> NfpLinkCost  (??? -> link cost)
+ *      m_linkCosts   : uint32_t -> NfpLinkCost  (interface -> link cost)
  *
  * @subsection prefix-timer-heap Prefix Timer Heap
  *      The heap tracks the expiry time of each (prefix, anchorName) pair.  We insert a record into the heap
@@ -223,9 +242,10 @@ namespace ccnx {
  *
  *
  * Notes:
- * - If a neighbor goes down, we need to scan m_prefixes to find any entries that use the
- *   neighbor as a nexthop and remove them.  There's no quick way to do this, as we don't maintain
- *   a separate list in m_neighbors.
+ * - If a neighbor goes down, we need to find any entries in m_prefixes that use the
+ *   neighbor as a nexthop and remove them.  m_prefixesByConnection indexes the prefixes
+ *   learned on each connection so we only visit those, not the whole RIB.  The index may hold
+ *   prefixes that no longer use the connection; NfpPrefix::RemoveConnection() ignores those.
  *
  * @see NfpPrefixTimerHeap, NfpPrefix, NfpNeighbor, NfpWorkQueue
  */
@@ -270,6 +290,23 @@ public:
 
   void PrintRoutingStats (Ptr<OutputStreamWrapper> streamWrapper) const;
 
+  /**
+   * Sets the link cost of an interface.  It may be called before the interface is up.
+   *
+   * @param [in] interface The interface index (NetDevice::GetIfIndex())
+   * @param [in] cost The positive cost added to advertisements received on the interface
+   */
+  void SetLinkCost (uint32_t interface, uint16_t cost);
+
+  /**
+   * Returns the link cost of an interface.  If the interface is not in the link cost table,
+   * returns the LinkCost attribute.
+   *
+   * @param [in] interface The interface index (NetDevice::GetIfIndex())
+   * @return The link cost of the interface
+   */
+  uint16_t GetLinkCost (uint32_t interface) const;
+
   // ========================================
   // === Getters for parameters
 
@@ -398,6 +435,16 @@ protected:
     */
   void ReceiveWithdraw (Ptr<NfpWithdraw> withdraw, Ptr<CCNxConnection> ingressConnection);
 
+  /**
+   * Removes the route to the withdrawn (prefix, anchor) through `ingressConnection` and queues the
+   * prefix if it is no longer reachable.  Used by ReceiveWithdraw() and by ReceiveAdvertise() for an
+   * advertisement whose distance plus link cost is infinite.
+   *
+   * @param withdraw The route to remove.
+   * @param ingressConnection The L3 connection ID that points to the neighbor.
+   */
+  void WithdrawRoute (Ptr<NfpWithdraw> withdraw, Ptr<CCNxConnection> ingressConnection);
+
   /**
    * Receive a Hello from a neighbor.
    *
@@ -471,6 +518,54 @@ protected:
    */
   uint32_t m_anchorSeqnum;
 
+  /**
+   * The number of times m_anchorRouteTimer expired.  m_anchorSeqnum only advances on every
+   * m_fullRefreshInterval-th expiry.
+   */
+  uint32_t m_anchorRefreshCount;
+
+  /**
+   * Every (prefix, anchor) is sent in full at least once in this many refresh intervals; the
+   * refreshes in between only send what changed.  1 sends every refresh in full.
+   */
+  uint32_t m_fullRefreshInterval;
+
+  /**
+   * What we last sent for one (prefix, anchor) and how many refreshes were skipped since.
+   */
+  struct SentState
+  {
+    bool isAdvertise;
+    uint32_t anchorSeqnum;
+    uint16_t distance;
+    uint32_t skippedRefreshes;
+  };
+
+  typedef std::map< Ptr<NfpWorkQueueEntry>, SentState, NfpWorkQueueEntry::islessPtrWorkQueueEntry > SentStateMapType;
+
+  /**
+   * The last message sent for each (prefix, anchor).  Only kept if m_fullRefreshInterval is more than 1.
+   */
+  SentStateMapType m_sentState;
+
+  /**
+   * Records what ProcessWorkQueue() sent for the work entry.
+   *
+   * @param workEntry The (prefix, anchor) sent
+   * @param advertise The advertisement sent, or null for a withdraw
+   */
+  void RecordSent (Ptr<NfpWorkQueueEntry> workEntry, Ptr<const NfpAdvertise> advertise);
+
+  /**
+   * Decides if a periodic refresh of (prefix, anchor) must be sent.  It must if this is a full
+   * refresh or if the RIB state differs from what we last sent.
+   *
+   * @param prefix The prefix whose refresh timer expired
+   * @param anchorName The anchor of the prefix
+   * @return true to send the refresh, false to skip it
+   */
+  bool IsRefreshNeeded (Ptr<const CCNxName> prefix, Ptr<const CCNxName> anchorName);
+
   /**
    * The name used by this router in the NFP message header.
    *
@@ -496,7 +591,8 @@ protected:
    * to ourself and thus they go in to the RIB and are treated just like any other router update.  This
    * means the process for advertising them is the same as all other routes.
    *
-   * With each timer expiry, we increment m_anchorSeqnum and then send all the prefixes with that seqnum.
+   * With each timer expiry (every m_fullRefreshInterval-th expiry with delta refreshes), we increment
+   * m_anchorSeqnum and then send all the prefixes with that seqnum.
    * @see m_anchorSeqnum, AnchorRouteTimerExpired()
    */
   Timer m_anchorRouteTimer;
@@ -586,6 +682,18 @@ protected:
    */
   PrefixMapType m_prefixes;
 
+  /**
+   * The prefix names we have received an advertisement for on each connection
+   */
+  typedef std::set< Ptr<const CCNxName>, CCNxName::isLessPtrCCNxName > PrefixNameSetType;
+
+  typedef std::map< CCNxConnection::ConnIdType, PrefixNameSetType > PrefixesByConnectionType;
+
+  /**
+   * Reverse index of m_prefixes by ingress connection, used by RemoveNeighborRoutes()
+   */
+  PrefixesByConnectionType m_prefixesByConnection;
+
   /**
    * Timers associated with the PrefixMapType
    */
@@ -595,13 +703,48 @@ protected:
    * The type we use to store the model FIB.  The model FIB stores our image of what is in
    * the actual FIB so we know what our diffs look like.
    */
-  typedef std::map< Ptr<const CCNxName>, Ptr<CCNxRoute> > ModelFibType;
+  typedef std::map< Ptr<const CCNxName>, Ptr<const CCNxRoute> > ModelFibType;
 
   /**
    * Stores the model FIB.
    */
   ModelFibType m_modelFib;
 
+  /**
+   * The link cost table, indexed by interface number
+   */
+  typedef std::map< uint32_t, Ptr<NfpLinkCost> > LinkCostMapType;
+
+  LinkCostMapType m_linkCosts;
+
+  /**
+   * The link cost of an interface that is not in the link cost table, and of a
+   * connection that is not on an interface.
+   */
+  uint16_t m_defaultLinkCost;
+
+  /**
+   * If positive, the link cost of a new interface is its channel delay in these units.
+   */
+  Time m_linkCostDelayUnit;
+
+  /**
+   * Returns the link cost for an advertisement received on the connection.
+   *
+   * @param [in] connection The ingress connection
+   * @return 0 for the local host, the interface cost for a device connection, otherwise m_defaultLinkCost
+   */
+  uint16_t GetIngressLinkCost (Ptr<CCNxConnection> connection) const;
+
+  /**
+   * Returns the initial link cost of an interface, from the channel delay if
+   * m_linkCostDelayUnit is positive or m_defaultLinkCost otherwise.
+   *
+   * @param [in] interface The interface index
+   * @return The link cost
+   */
+  uint16_t CalculateLinkCost (uint32_t interface) const;
+
   /**
    * Looks up an entry from the Model FIB.  If no entry is found, an empty CCNxRoute is created
    * and inserted in to the Model FIB.
@@ -609,7 +752,7 @@ protected:
    * @param [in] prefix The prefix to lookup.
    * @return The route for the given prefix.
    */
-  Ptr<CCNxRoute> GetModelFibRoute (Ptr<const CCNxName> prefix);
+  Ptr<const CCNxRoute> GetModelFibRoute (Ptr<const CCNxName> prefix);
 
   /**
    * We get a callback from NfpPrefix whenever the state of a prefix changes.
@@ -635,6 +778,15 @@ protected:
    */
   void RemoveAnchorFromFib (Ptr<NfpPrefix> prefixEntry, Ptr<const CCNxName> anchorName);
 
+  /**
+   * Brings the FIB entry for a prefix in line with its RIB route.  Only the next hops that differ
+   * between the model FIB and the RIB are added to or removed from the forwarder.  Additions are made
+   * before removals so there's always a route in the FIB, if possible.
+   *
+   * @param [in] prefixEntry The prefix record
+   */
+  void UpdateFib (Ptr<NfpPrefix> prefixEntry);
+
   /**
    * The work queue keeps a list of the (anchor, prefix) pairs that have recently changed.
    *
@@ -708,7 +860,28 @@ protected:
   void SetRouterName (void);
 
   /**
-   * Creates an empty payload that we can then append messages to.
+   * If true, payloads use the compact encoding (see NfpPayload).
+   */
+  bool m_compactPayloads;
+
+  /**
+   * The bytes an Interest adds around its NFP payload.  0 until GetPacketOverhead()
+   * computes it.
+   */
+  uint32_t m_packetOverhead;
+
+  /**
+   * Returns the bytes an Interest from CreatePacket() adds around the payload (fixed
+   * header, Interest name, payload TL).  It is computed once from an empty payload,
+   * so call it only after the router name is set.
+   *
+   * @return The packet overhead in bytes
+   */
+  uint32_t GetPacketOverhead (void);
+
+  /**
+   * Creates an empty payload that we can then append messages to.  The payload capacity
+   * is the minimum MTU less the packet overhead, so the Interest fits in every interface.
    * @return An empty NfpPayload (only has the T_MSG header).
    */
   Ptr<NfpPayload> CreatePayload (void);
@@ -127,6 +127,12 @@ public:
   static const uint16_t T_MSG = 0x0004;
   static const uint16_t T_MSG_SEQNUM = 0x0005;
   static const uint16_t T_ADV_DATA = 0x0006;
+
+  // compact payload encoding (see NfpPayload)
+  static const uint16_t T_ADV_COMPACT = 0x0007;
+  static const uint16_t T_WITHDRAW_COMPACT = 0x0008;
+  static const uint16_t T_NAME_REF = 0x0009;
+  static const uint16_t T_NAME_DELTA = 0x000A;
 };
 }
 }
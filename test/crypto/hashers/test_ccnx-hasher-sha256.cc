@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "ns3/test.h"
+#include "ns3/ccnx-hasher-sha256.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxHasherSha256 {
+
+static Ptr<CCNxHashValue>
+FromHex (const char *hex)
+{
+  std::vector<uint8_t> bytes;
+  for (size_t i = 0; hex[i] && hex[i + 1]; i += 2)
+    {
+      bytes.push_back ((uint8_t) strtoul (std::string (hex + i, 2).c_str (), NULL, 16));
+    }
+  return Create<CCNxHashValue> (Create<const CCNxByteArray> (bytes));
+}
+
+BeginTest (Constructor)
+{
+  Ptr<CCNxHasherSha256> hasher = CreateObject<CCNxHasherSha256> ();
+  Ptr<CCNxHashValue> value = hasher->Finalize ();
+  NS_TEST_EXPECT_MSG_EQ (value->size (), 32, "SHA-256 should be 32 bytes");
+  NS_TEST_EXPECT_MSG_EQ (*value == *FromHex ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"), true,
+                         "Wrong hash of the empty string");
+}
+EndTest ()
+
+BeginTest (KnownVectors)
+{
+  struct vectors
+  {
+    const char *input;
+    const char *digest;
+  } testVectors[] = {
+    { "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+    { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+    { NULL, NULL },
+  };
+
+  Ptr<CCNxHasherSha256> hasher = CreateObject<CCNxHasherSha256> ();
+  for (int i = 0; testVectors[i].input != NULL; ++i)
+    {
+      hasher->Init ();
+      hasher->Update ((const uint8_t *) testVectors[i].input, strlen (testVectors[i].input));
+      NS_TEST_EXPECT_MSG_EQ (*hasher->Finalize () == *FromHex (testVectors[i].digest), true, "Wrong hash vector " << i);
+    }
+}
+EndTest ()
+
+BeginTest (Incremental)
+{
+  // one million 'a' in uneven pieces crosses many block boundaries
+  std::vector<uint8_t> a (1000, 'a');
+  Ptr<CCNxHasherSha256> hasher = CreateObject<CCNxHasherSha256> ();
+  size_t total = 0;
+  size_t piece = 1;
+  while (total < 1000000)
+    {
+      size_t n = std::min (piece, (size_t) 1000000 - total);
+      hasher->Update (a.data (), n);
+      total += n;
+      piece = (piece * 7) % 1000 + 1;
+    }
+  NS_TEST_EXPECT_MSG_EQ (*hasher->Finalize () == *FromHex ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"), true,
+                         "Wrong hash of one million 'a'");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxHasherSha256
+ */
+static class TestSuiteCCNxHasherSha256 : public TestSuite
+{
+public:
+  TestSuiteCCNxHasherSha256 () : TestSuite ("ccnx-hasher-sha256", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new KnownVectors (), TestCase::QUICK);
+    AddTestCase (new Incremental (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxHasherSha256;
+
+} // namespace TestSuiteCCNxHasherSha256
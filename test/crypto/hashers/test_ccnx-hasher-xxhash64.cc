@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <algorithm>
+
+#include "ns3/test.h"
+#include "ns3/ccnx-hasher-xxhash64.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxHasherXxHash64 {
+
+BeginTest (Constructor)
+{
+  Ptr<CCNxHasherXxHash64> hasher = CreateObject<CCNxHasherXxHash64> ();
+  Ptr<CCNxHashValue> value = hasher->Finalize ();
+  NS_TEST_EXPECT_MSG_EQ (value->size (), 8, "XXH64 should be 8 bytes");
+  NS_TEST_EXPECT_MSG_EQ (*value == CCNxHashValue (0xEF46DB3751D8E999ULL, 8), true, "Wrong hash of the empty string");
+}
+EndTest ()
+
+BeginTest (KnownVectors)
+{
+  Ptr<CCNxHasherXxHash64> hasher = CreateObject<CCNxHasherXxHash64> ();
+  hasher->Update ((const uint8_t *) "abc", 3);
+  NS_TEST_EXPECT_MSG_EQ (*hasher->Finalize () == CCNxHashValue (0x44BC2CF5AD770999ULL, 8), true, "Wrong hash of 'abc'");
+}
+EndTest ()
+
+BeginTest (Incremental)
+{
+  // the same bytes in one call and in uneven pieces must hash the same
+  std::vector<uint8_t> data (1000);
+  for (size_t i = 0; i < data.size (); ++i)
+    {
+      data[i] = (uint8_t) (i * 131 + 7);
+    }
+
+  Ptr<CCNxHasherXxHash64> hasher = CreateObject<CCNxHasherXxHash64> ();
+  hasher->Update (data.data (), data.size ());
+  Ptr<CCNxHashValue> whole = hasher->Finalize ();
+
+  hasher->Init ();
+  size_t offset = 0;
+  size_t piece = 1;
+  while (offset < data.size ())
+    {
+      size_t n = std::min (piece, data.size () - offset);
+      hasher->Update (data.data () + offset, n);
+      offset += n;
+      piece = (piece * 5) % 40 + 1;
+    }
+  NS_TEST_EXPECT_MSG_EQ (*hasher->Finalize () == *whole, true, "Incremental hash differs");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxHasherXxHash64
+ */
+static class TestSuiteCCNxHasherXxHash64 : public TestSuite
+{
+public:
+  TestSuiteCCNxHasherXxHash64 () : TestSuite ("ccnx-hasher-xxhash64", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new KnownVectors (), TestCase::QUICK);
+    AddTestCase (new Incremental (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxHasherXxHash64;
+
+} // namespace TestSuiteCCNxHasherXxHash64
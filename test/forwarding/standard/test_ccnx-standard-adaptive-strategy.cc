@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <sstream>
+
+#include "../../mockups/mockup_ccnx-virtual-connection.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/ccnx-standard-adaptive-strategy.h"
+#include "ns3/ccnx-standard-pit.h"
+#include "ns3/log.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxStandardAdaptiveStrategy {
+
+/*
+ * The FIB prefix is ccnx:/name=apple
+ */
+static const size_t _prefixLength = 1;
+
+static Ptr<const CCNxName>
+CreateName (int i)
+{
+  std::ostringstream uri;
+  uri << "ccnx:/name=apple/name=" << i;
+  return Create<CCNxName> (uri.str ());
+}
+
+static uint64_t
+PrefixHash ()
+{
+  return CreateName (0)->GetPrefixHash (_prefixLength);
+}
+
+/*
+ * Forward Interest i with the next hops {first, second} (in cost order) and return what the strategy picked
+ */
+static Ptr<CCNxConnectionList>
+SendInterest (Ptr<CCNxStandardAdaptiveStrategy> strategy, int i, Ptr<CCNxConnection> first, Ptr<CCNxConnection> second)
+{
+  Ptr<CCNxStandardFibEntry> entry = Create<CCNxStandardFibEntry> ();
+  entry->AddConnection (first, 1);
+  entry->AddConnection (second, 2);
+
+  Ptr<CCNxConnectionList> egress = Create<CCNxConnectionList> ();
+  strategy->SelectEgress (CreateName (i), _prefixLength, Ptr<CCNxConnection> (0), entry->GetNextHops (), egress);
+  return egress;
+}
+
+BeginTest (UnmeasuredUsesFirst)
+{
+  printf ("TestCCNxStandardAdaptiveStrategyUnmeasuredUsesFirst DoRun\n");
+
+  Ptr<CCNxConnection> c1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxConnection> c2 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxStandardAdaptiveStrategy> strategy = Create<CCNxStandardAdaptiveStrategy> (0.5, 100, Seconds (0.2));
+
+  Ptr<CCNxConnectionList> egress = SendInterest (strategy, 0, c1, c2);
+  NS_TEST_EXPECT_MSG_EQ (egress->size (), 1, "Should narrow to one next hop");
+  NS_TEST_EXPECT_MSG_EQ (egress->front (), c1, "With no measurements should use the first next hop");
+  NS_TEST_EXPECT_MSG_EQ (strategy->GetOutstandingCount (), 1, "Should track the Interest");
+
+  strategy->ContentReceived (CreateName (0), c1);
+  NS_TEST_EXPECT_MSG_EQ (strategy->GetOutstandingCount (), 0, "Content should clear the Interest");
+
+  // a Content Object for an Interest we never sent is ignored
+  strategy->ContentReceived (CreateName (99), c2);
+  CCNxStandardAdaptiveStrategy::FaceStats stats;
+  NS_TEST_EXPECT_MSG_EQ (strategy->GetFaceStats (PrefixHash (), c2->GetConnectionId (), stats), true, "Should have stats for c2");
+  NS_TEST_EXPECT_MSG_EQ (stats.measured, false, "c2 should not be measured");
+}
+EndTest ()
+
+/*
+ * The scenario run by the simulator in FollowsRttAndSatisfaction.  With a probe interval of 2, every
+ * second Interest also goes to the next hop the strategy would not have chosen.
+ */
+class AdaptiveScenario
+{
+public:
+  Ptr<CCNxConnection> c1;
+  Ptr<CCNxConnection> c2;
+  Ptr<CCNxStandardAdaptiveStrategy> strategy;
+  Ptr<CCNxConnectionList> egress[5];
+
+  void Send (int i)
+  {
+    egress[i] = SendInterest (strategy, i, c1, c2);
+  }
+
+  void Receive (int i, Ptr<CCNxConnection> ingress)
+  {
+    strategy->ContentReceived (CreateName (i), ingress);
+  }
+};
+
+BeginTest (FollowsRttAndSatisfaction)
+{
+  printf ("TestCCNxStandardAdaptiveStrategyFollowsRttAndSatisfaction DoRun\n");
+
+  AdaptiveScenario s;
+  s.c1 = Create<CCNxVirtualConnection> ();
+  s.c2 = Create<CCNxVirtualConnection> ();
+  s.strategy = Create<CCNxStandardAdaptiveStrategy> (0.5, 2, Seconds (0.2));
+
+  // c1 answers in 50 msec, the probe to c2 answers in 10 msec
+  Simulator::Schedule (Seconds (0.0), &AdaptiveScenario::Send, &s, 0);
+  Simulator::Schedule (Seconds (0.05), &AdaptiveScenario::Receive, &s, 0, s.c1);
+  Simulator::Schedule (Seconds (0.1), &AdaptiveScenario::Send, &s, 1);
+  Simulator::Schedule (Seconds (0.11), &AdaptiveScenario::Receive, &s, 1, s.c2);
+
+  // c2 is now the fastest, but stops answering
+  Simulator::Schedule (Seconds (0.2), &AdaptiveScenario::Send, &s, 2);
+  Simulator::Schedule (Seconds (0.3), &AdaptiveScenario::Send, &s, 3);
+  Simulator::Schedule (Seconds (0.6), &AdaptiveScenario::Send, &s, 4);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (s.egress[0]->size (), 1, "First Interest should go to one next hop");
+  NS_TEST_EXPECT_MSG_EQ (s.egress[0]->front (), s.c1, "First Interest should go to the first next hop");
+  NS_TEST_EXPECT_MSG_EQ (s.egress[1]->size (), 2, "Second Interest should carry a probe");
+  NS_TEST_EXPECT_MSG_EQ (s.egress[2]->size (), 1, "Third Interest should go to one next hop");
+  NS_TEST_EXPECT_MSG_EQ (s.egress[2]->front (), s.c2, "Third Interest should follow the lower RTT");
+  NS_TEST_EXPECT_MSG_EQ (s.egress[4]->size (), 1, "Fifth Interest should go to one next hop");
+  NS_TEST_EXPECT_MSG_EQ (s.egress[4]->front (), s.c1, "Fifth Interest should avoid the unsatisfied next hop");
+
+  CCNxStandardAdaptiveStrategy::FaceStats stats;
+  NS_TEST_EXPECT_MSG_EQ (s.strategy->GetFaceStats (PrefixHash (), s.c2->GetConnectionId (), stats), true, "Should have stats for c2");
+  NS_TEST_EXPECT_MSG_EQ (stats.satisfied, 1, "c2 should have one satisfied Interest");
+  NS_TEST_EXPECT_MSG_EQ (stats.unsatisfied, 2, "c2 should have two unsatisfied Interests");
+  NS_TEST_EXPECT_MSG_LT (stats.satisfaction, 0.5, "c2 should no longer be live");
+
+  NS_TEST_EXPECT_MSG_EQ (s.strategy->GetProbeCount (), 2, "Should have sent two probes");
+  NS_TEST_EXPECT_MSG_EQ (s.strategy->GetOutstandingCount (), 1, "Only the last Interest should be outstanding");
+}
+EndTest ()
+
+BeginTest (PrunesRemovedConnection)
+{
+  printf ("TestCCNxStandardAdaptiveStrategyPrunesRemovedConnection DoRun\n");
+
+  AdaptiveScenario s;
+  s.c1 = Create<CCNxVirtualConnection> ();
+  s.c2 = Create<CCNxVirtualConnection> ();
+  s.strategy = Create<CCNxStandardAdaptiveStrategy> (0.5, 100, Seconds (0.2));
+
+  // Interest 0 goes to c1, then c1 goes down before the Interest times out.  The unrelated
+  // Content Object at 0.3 seconds expires the Interest.
+  Simulator::Schedule (Seconds (0.0), &AdaptiveScenario::Send, &s, 0);
+  Simulator::Schedule (Seconds (0.1), &CCNxStandardAdaptiveStrategy::RemoveConnection, s.strategy, s.c1);
+  Simulator::Schedule (Seconds (0.3), &AdaptiveScenario::Receive, &s, 99, s.c2);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (s.egress[0]->front (), s.c1, "First Interest should go to the first next hop");
+  NS_TEST_EXPECT_MSG_EQ (s.strategy->GetOutstandingCount (), 0, "The Interest should have timed out");
+
+  CCNxStandardAdaptiveStrategy::FaceStats stats;
+  NS_TEST_EXPECT_MSG_EQ (s.strategy->GetFaceStats (PrefixHash (), s.c1->GetConnectionId (), stats), false, "Stats for c1 should be gone");
+  NS_TEST_EXPECT_MSG_EQ (s.strategy->GetFaceStats (PrefixHash (), s.c2->GetConnectionId (), stats), true, "Should have stats for c2");
+  NS_TEST_EXPECT_MSG_EQ (stats.unsatisfied, 0, "c2 was not used");
+}
+EndTest ()
+
+BeginTest (TimeoutFromPitLifetime)
+{
+  printf ("TestCCNxStandardAdaptiveStrategyTimeoutFromPitLifetime DoRun\n");
+
+  TimeValue lifetime;
+  Ptr<CCNxStandardPit> pit = CreateObject<CCNxStandardPit> ();
+  pit->GetAttribute ("DefaultLifetime", lifetime);
+
+  Ptr<CCNxStandardForwardingStrategy> strategy =
+    CCNxStandardForwardingStrategy::CreateStrategy (CCNxStandardForwardingStrategy::Adaptive);
+  Ptr<CCNxStandardAdaptiveStrategy> adaptive = DynamicCast<CCNxStandardAdaptiveStrategy> (strategy);
+  NS_TEST_ASSERT_MSG_EQ ((adaptive != 0), true, "Adaptive should create a CCNxStandardAdaptiveStrategy");
+  NS_TEST_EXPECT_MSG_EQ (adaptive->GetTimeout (), lifetime.Get (), "Default timeout should be the PIT default lifetime");
+
+  strategy->SetInterestLifetime (Seconds (1));
+  NS_TEST_EXPECT_MSG_EQ (adaptive->GetTimeout (), Seconds (1), "Timeout should follow the PIT lifetime");
+}
+EndTest ()
+
+/**
+ * \ingroup ccnx-test
+ *
+ * \brief Test Suite for CCNxStandardAdaptiveStrategy
+ */
+static class TestSuiteCCNxStandardAdaptiveStrategy : public TestSuite
+{
+public:
+  TestSuiteCCNxStandardAdaptiveStrategy () : TestSuite ("ccnx-standard-adaptive-strategy", UNIT)
+  {
+    AddTestCase (new UnmeasuredUsesFirst (), TestCase::QUICK);
+    AddTestCase (new FollowsRttAndSatisfaction (), TestCase::QUICK);
+    AddTestCase (new PrunesRemovedConnection (), TestCase::QUICK);
+    AddTestCase (new TimeoutFromPitLifetime (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxStandardAdaptiveStrategy;
+
+} // namespace TestSuiteCCNxStandardAdaptiveStrategy
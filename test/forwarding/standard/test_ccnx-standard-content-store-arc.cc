@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/ccnx-standard-content-store-arc.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxStandardContentStoreArc {
+
+static Ptr<CCNxStandardContentStoreEntry>
+CreateEntry (int i)
+{
+  std::ostringstream nameString;
+  nameString << "ccnx:/name=foo/name=sink/name=kitchen" << i;
+  Ptr<CCNxName> name = Create<CCNxName> (nameString.str ());
+  Ptr<CCNxContentObject> content = Create<CCNxContentObject> (name, Create<CCNxBuffer> (128, true));
+  return Create<CCNxStandardContentStoreEntry> (CCNxPacket::CreateFromMessage (content));
+}
+
+typedef std::vector<Ptr<CCNxStandardContentStoreEntry> > EntryVectorType;
+
+static EntryVectorType
+CreateEntries (int count)
+{
+  EntryVectorType entries;
+  for (int i = 0; i < count; i++)
+    {
+      entries.push_back (CreateEntry (i));
+    }
+  return entries;
+}
+
+/**
+ * Evict the victim, as the content store does when full
+ */
+static Ptr<CCNxStandardContentStoreEntry>
+Evict (Ptr<CCNxStandardContentStoreArc> dut)
+{
+  Ptr<CCNxStandardContentStoreEntry> victim = dut->GetVictimEntry ();
+  dut->EvictEntry (victim);
+  return victim;
+}
+
+BeginTest (Constructor)
+{
+  Ptr<CCNxStandardContentStoreArc> dut = Create<CCNxStandardContentStoreArc> (4);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 0, "New ARC should be empty");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetTarget (), 0, "Initial target should be 0");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), Ptr<CCNxStandardContentStoreEntry> (0), "Empty ARC should have no victim");
+}
+EndTest ()
+
+BeginTest (HitMovesToFrequent)
+{
+  EntryVectorType entries = CreateEntries (3);
+  Ptr<CCNxStandardContentStoreArc> dut = Create<CCNxStandardContentStoreArc> (3);
+
+  for (size_t i = 0; i < entries.size (); i++)
+    {
+      dut->AddEntry (entries[i]);
+    }
+  NS_TEST_EXPECT_MSG_EQ (dut->GetRecentSize (), 3, "New entries should be in T1");
+
+  dut->RefreshEntry (entries[0]);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetRecentSize (), 2, "Hit entry should leave T1");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetFrequentSize (), 1, "Hit entry should be in T2");
+
+  // T1 is larger than the target (0), so the victim is the LRU of T1
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), entries[1], "Wrong victim");
+}
+EndTest ()
+
+BeginTest (GhostHitAdapts)
+{
+  EntryVectorType entries = CreateEntries (3);
+  Ptr<CCNxStandardContentStoreArc> dut = Create<CCNxStandardContentStoreArc> (2);
+
+  dut->AddEntry (entries[0]);
+  dut->RefreshEntry (entries[0]);
+  dut->AddEntry (entries[1]);
+  NS_TEST_EXPECT_MSG_EQ (Evict (dut), entries[1], "Victim should be the LRU of T1");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetGhostSize (), 1, "Evicted key should be remembered");
+
+  dut->AddEntry (entries[2]);
+  NS_TEST_EXPECT_MSG_EQ (Evict (dut), entries[2], "Victim should be the LRU of T1");
+
+  // entries[1] comes back as a new entry: a B1 hit grows the T1 target and it goes to T2
+  dut->AddEntry (CreateEntry (1));
+  NS_TEST_EXPECT_MSG_EQ (dut->GetTarget (), 1, "B1 hit should grow the target");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetFrequentSize (), 2, "Ghost hit should go to T2");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetRecentSize (), 0, "T1 should be empty");
+}
+EndTest ()
+
+BeginTest (DeleteForgets)
+{
+  EntryVectorType entries = CreateEntries (2);
+  Ptr<CCNxStandardContentStoreArc> dut = Create<CCNxStandardContentStoreArc> (2);
+
+  dut->AddEntry (entries[0]);
+  dut->AddEntry (entries[1]);
+  NS_TEST_EXPECT_MSG_EQ (dut->DeleteEntry (entries[0]), true, "Delete should succeed");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetGhostSize (), 0, "Deleted entries are not remembered");
+  NS_TEST_EXPECT_MSG_EQ (dut->DeleteEntry (entries[0]), false, "Second delete should fail");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 1, "Wrong size");
+}
+EndTest ()
+
+BeginTest (GhostsBounded)
+{
+  EntryVectorType entries = CreateEntries (100);
+  Ptr<CCNxStandardContentStoreArc> dut = Create<CCNxStandardContentStoreArc> (8);
+
+  for (size_t i = 0; i < entries.size (); i++)
+    {
+      if (dut->GetSize () >= 8)
+        {
+          Evict (dut);
+        }
+      dut->AddEntry (entries[i]);
+      if (i % 3 == 0)
+        {
+          dut->RefreshEntry (entries[i]);
+        }
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 8, "Wrong size");
+  bool bounded = dut->GetSize () + dut->GetGhostSize () <= 16;
+  NS_TEST_EXPECT_MSG_EQ (bounded, true, "Resident plus ghost entries should be at most 2c");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxStandardContentStoreArc
+ */
+static class TestSuiteCCNxStandardContentStoreArc : public TestSuite
+{
+public:
+  TestSuiteCCNxStandardContentStoreArc () : TestSuite ("ccnx-standard-content-store-arc", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new HitMovesToFrequent (), TestCase::QUICK);
+    AddTestCase (new GhostHitAdapts (), TestCase::QUICK);
+    AddTestCase (new DeleteForgets (), TestCase::QUICK);
+    AddTestCase (new GhostsBounded (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxStandardContentStoreArc;
+
+} // namespace TestSuiteCCNxStandardContentStoreArc
@@ -55,6 +55,7 @@
 
 #include "ns3/test.h"
 #include "ns3/ccnx-standard-content-store-entry.h"
+#include "ns3/ccnx-cachetime.h"
 
 #include "../../TestMacros.h"
 
@@ -71,6 +72,54 @@ BeginTest (Constructor)
 }
 EndTest ()
 
+BeginTest (GetFootprint)
+{
+  printf ("TestCCNxStandardContentStoreEntry_GetFootprint DoRun\n");
+  Ptr<CCNxName> name = Create<CCNxName> ("ccnx:/name=foo/name=sink");
+  Ptr<CCNxContentObject> small = Create<CCNxContentObject> (name, Create<CCNxBuffer> (100, true));
+  Ptr<CCNxContentObject> large = Create<CCNxContentObject> (name, Create<CCNxBuffer> (1100, true));
+
+  Ptr<CCNxStandardContentStoreEntry> a = Create<CCNxStandardContentStoreEntry> (CCNxPacket::CreateFromMessage (small));
+  Ptr<CCNxStandardContentStoreEntry> b = Create<CCNxStandardContentStoreEntry> (CCNxPacket::CreateFromMessage (large));
+
+  bool overhead = a->GetFootprint () > 100;
+  NS_TEST_EXPECT_MSG_EQ (overhead, true, "Footprint should include more than the payload");
+  NS_TEST_EXPECT_MSG_EQ (b->GetFootprint () - a->GetFootprint (), 1000, "Footprint should grow with the payload");
+}
+EndTest ()
+
+BeginTest (GetKey)
+{
+  printf ("TestCCNxStandardContentStoreEntry_GetKey DoRun\n");
+  Ptr<CCNxName> name = Create<CCNxName> ("ccnx:/name=foo/name=sink");
+  Ptr<CCNxContentObject> content = Create<CCNxContentObject> (name);
+  Ptr<CCNxStandardContentStoreEntry> a = Create<CCNxStandardContentStoreEntry> (CCNxPacket::CreateFromMessage (content));
+
+  NS_TEST_EXPECT_MSG_EQ (a->GetKey (), name->GetHash (), "Key of a named object should be the name hash");
+  NS_TEST_EXPECT_MSG_EQ (a->GetKey (), CCNxStandardContentStoreEntry::MakeKey (name, Ptr<const CCNxByteArray> (0)), "MakeKey should match GetKey");
+}
+EndTest ()
+
+BeginTest (GetDeadline)
+{
+  printf ("TestCCNxStandardContentStoreEntry_GetDeadline DoRun\n");
+  Ptr<CCNxName> name = Create<CCNxName> ("ccnx:/name=foo/name=sink");
+  Ptr<CCNxContentObject> forever = Create<CCNxContentObject> (name);
+  Ptr<CCNxStandardContentStoreEntry> a = Create<CCNxStandardContentStoreEntry> (CCNxPacket::CreateFromMessage (forever));
+  NS_TEST_EXPECT_MSG_EQ (a->GetDeadline (), Time::Max (), "Object without ExpiryTime or CacheTime should have no deadline");
+
+  Ptr<CCNxContentObject> expiring = Create<CCNxContentObject> (name, Create<CCNxBuffer> (0), CCNxContentObjectPayloadType_Data,
+                                                               Create<CCNxTime> (2000));
+  Ptr<CCNxPacket> packet = CCNxPacket::CreateFromMessage (expiring);
+  Ptr<CCNxStandardContentStoreEntry> b = Create<CCNxStandardContentStoreEntry> (packet);
+  NS_TEST_EXPECT_MSG_EQ (b->GetDeadline (), Time (2000), "Deadline should be the ExpiryTime");
+
+  packet->AddPerHopHeaderEntry (Create<CCNxCachetime> (Create<CCNxTime> (1000)));
+  Ptr<CCNxStandardContentStoreEntry> c = Create<CCNxStandardContentStoreEntry> (packet);
+  NS_TEST_EXPECT_MSG_EQ (c->GetDeadline (), Time (1000), "Deadline should be the earlier of ExpiryTime and CacheTime");
+}
+EndTest ()
+
 
 /**
  * @ingroup ccnx-test
@@ -83,6 +132,9 @@ public:
   TestSuiteCCNxStandardContentStoreEntry () : TestSuite ("ccnx-standard-content-store-entry", UNIT)
   {
     AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new GetFootprint (), TestCase::QUICK);
+    AddTestCase (new GetKey (), TestCase::QUICK);
+    AddTestCase (new GetDeadline (), TestCase::QUICK);
 
   }
 } g_TestSuiteCCNxStandardContentStoreEntry;
@@ -75,6 +75,18 @@ BeginTest (Constructor)
 }
 EndTest ()
 
+BeginTest (SetReplacementPolicy)
+{
+  CCNxStandardContentStoreFactory factory;
+  factory.SetReplacementPolicy (CCNxStandardContentStore::S3Fifo);
+  factory.SetTinyLfuAdmission (true);
+
+  Ptr<CCNxStandardContentStore> contentStore = factory.Create<CCNxStandardContentStore> ();
+  NS_TEST_EXPECT_MSG_EQ (contentStore->GetReplacementPolicy (), CCNxStandardContentStore::S3Fifo, "Wrong replacement policy");
+  NS_TEST_EXPECT_MSG_EQ (contentStore->GetTinyLfuAdmission (), true, "TinyLFU admission should be enabled");
+}
+EndTest ()
+
 /**
  * @ingroup ccnx-test
  *
@@ -86,6 +98,7 @@ public:
   TestSuiteCCNxStandardContentStoreFactory () : TestSuite ("ccnx-standard-content-store-factory", UNIT)
   {
     AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new SetReplacementPolicy (), TestCase::QUICK);
   }
 } g_TestSuiteCCNxStandardContentStoreFactory;
 
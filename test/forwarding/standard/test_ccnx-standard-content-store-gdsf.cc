@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/ccnx-standard-content-store-gdsf.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxStandardContentStoreGdsf {
+
+static Ptr<CCNxStandardContentStoreEntry>
+CreateEntry (int i, uint32_t payloadSize)
+{
+  std::ostringstream nameString;
+  nameString << "ccnx:/name=foo/name=sink/name=kitchen" << i;
+  Ptr<CCNxName> name = Create<CCNxName> (nameString.str ());
+  Ptr<CCNxContentObject> content = Create<CCNxContentObject> (name, Create<CCNxBuffer> (payloadSize, true));
+  return Create<CCNxStandardContentStoreEntry> (CCNxPacket::CreateFromMessage (content));
+}
+
+BeginTest (Constructor)
+{
+  Ptr<CCNxStandardContentStoreGdsf> dut = Create<CCNxStandardContentStoreGdsf> ();
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 0, "New GDSF should be empty");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetInflation (), 0, "Initial inflation should be 0");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), Ptr<CCNxStandardContentStoreEntry> (0), "Empty GDSF should have no victim");
+}
+EndTest ()
+
+BeginTest (VictimIsLargest)
+{
+  Ptr<CCNxStandardContentStoreGdsf> dut = Create<CCNxStandardContentStoreGdsf> ();
+  Ptr<CCNxStandardContentStoreEntry> small = CreateEntry (0, 100);
+  Ptr<CCNxStandardContentStoreEntry> large = CreateEntry (1, 1000);
+
+  dut->AddEntry (large);
+  dut->AddEntry (small);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), large, "With equal frequency the larger object is the victim");
+
+  // 20 hits on the large object make it worth more than 1 hit on the small one
+  for (int i = 0; i < 20; i++)
+    {
+      dut->RefreshEntry (large);
+    }
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), small, "A popular large object should outlive a cold small one");
+}
+EndTest ()
+
+BeginTest (EvictInflates)
+{
+  Ptr<CCNxStandardContentStoreGdsf> dut = Create<CCNxStandardContentStoreGdsf> ();
+  Ptr<CCNxStandardContentStoreEntry> a = CreateEntry (0, 100);
+  Ptr<CCNxStandardContentStoreEntry> b = CreateEntry (1, 200);
+
+  dut->AddEntry (a);
+  dut->AddEntry (b);
+  dut->EvictEntry (dut->GetVictimEntry ());
+  NS_TEST_EXPECT_MSG_EQ (dut->GetInflation (), 1.0 / 200, "Inflation should be the evicted priority");
+
+  // a new entry starts from the inflation value
+  Ptr<CCNxStandardContentStoreEntry> c = CreateEntry (2, 100);
+  dut->AddEntry (c);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetPriority (c), 1.0 / 200 + 1.0 / 100, "Wrong priority");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), a, "Older entry of the same size should be the victim");
+
+  // delete does not inflate
+  dut->DeleteEntry (a);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetInflation (), 1.0 / 200, "Delete should not change the inflation");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 1, "Wrong size");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxStandardContentStoreGdsf
+ */
+static class TestSuiteCCNxStandardContentStoreGdsf : public TestSuite
+{
+public:
+  TestSuiteCCNxStandardContentStoreGdsf () : TestSuite ("ccnx-standard-content-store-gdsf", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new VictimIsLargest (), TestCase::QUICK);
+    AddTestCase (new EvictInflates (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxStandardContentStoreGdsf;
+
+} // namespace TestSuiteCCNxStandardContentStoreGdsf
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/ccnx-standard-content-store-lfu.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxStandardContentStoreLfu {
+
+static Ptr<CCNxStandardContentStoreEntry>
+CreateEntry (int i)
+{
+  std::ostringstream nameString;
+  nameString << "ccnx:/name=foo/name=sink/name=kitchen" << i;
+  Ptr<CCNxName> name = Create<CCNxName> (nameString.str ());
+  Ptr<CCNxContentObject> content = Create<CCNxContentObject> (name, Create<CCNxBuffer> (128, true));
+  return Create<CCNxStandardContentStoreEntry> (CCNxPacket::CreateFromMessage (content));
+}
+
+typedef std::vector<Ptr<CCNxStandardContentStoreEntry> > EntryVectorType;
+
+static EntryVectorType
+CreateEntries (int count)
+{
+  EntryVectorType entries;
+  for (int i = 0; i < count; i++)
+    {
+      entries.push_back (CreateEntry (i));
+    }
+  return entries;
+}
+
+BeginTest (Constructor)
+{
+  Ptr<CCNxStandardContentStoreLfu> dut = Create<CCNxStandardContentStoreLfu> ();
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 0, "New LFU should be empty");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), Ptr<CCNxStandardContentStoreEntry> (0), "Empty LFU should have no victim");
+}
+EndTest ()
+
+BeginTest (VictimIsLeastFrequent)
+{
+  EntryVectorType entries = CreateEntries (3);
+  Ptr<CCNxStandardContentStoreLfu> dut = Create<CCNxStandardContentStoreLfu> ();
+
+  for (size_t i = 0; i < entries.size (); i++)
+    {
+      dut->AddEntry (entries[i]);
+    }
+
+  // 0 is the oldest, but hit twice.  1 is hit once.  2 is never hit.
+  dut->RefreshEntry (entries[0]);
+  dut->RefreshEntry (entries[0]);
+  dut->RefreshEntry (entries[1]);
+
+  NS_TEST_EXPECT_MSG_EQ (dut->GetFrequency (entries[0]), 3, "Wrong frequency");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetFrequency (entries[1]), 2, "Wrong frequency");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetFrequency (entries[2]), 1, "Wrong frequency");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), entries[2], "Victim should be the least frequent");
+
+  dut->DeleteEntry (entries[2]);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), entries[1], "Victim should be the least frequent");
+
+  dut->DeleteEntry (entries[1]);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), entries[0], "Victim should be the only entry");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 1, "Wrong size");
+}
+EndTest ()
+
+BeginTest (TieIsLeastRecent)
+{
+  EntryVectorType entries = CreateEntries (3);
+  Ptr<CCNxStandardContentStoreLfu> dut = Create<CCNxStandardContentStoreLfu> ();
+
+  for (size_t i = 0; i < entries.size (); i++)
+    {
+      dut->AddEntry (entries[i]);
+      dut->RefreshEntry (entries[i]);
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), entries[0], "Victim should be the least recent of equal frequency");
+}
+EndTest ()
+
+BeginTest (DeleteNonExistentEntry)
+{
+  EntryVectorType entries = CreateEntries (2);
+  Ptr<CCNxStandardContentStoreLfu> dut = Create<CCNxStandardContentStoreLfu> ();
+  dut->AddEntry (entries[0]);
+
+  NS_TEST_EXPECT_MSG_EQ (dut->DeleteEntry (entries[1]), false, "Delete of missing entry should fail");
+  NS_TEST_EXPECT_MSG_EQ (dut->RefreshEntry (entries[1]), false, "Refresh of missing entry should fail");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 1, "Wrong size");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxStandardContentStoreLfu
+ */
+static class TestSuiteCCNxStandardContentStoreLfu : public TestSuite
+{
+public:
+  TestSuiteCCNxStandardContentStoreLfu () : TestSuite ("ccnx-standard-content-store-lfu", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new VictimIsLeastFrequent (), TestCase::QUICK);
+    AddTestCase (new TieIsLeastRecent (), TestCase::QUICK);
+    AddTestCase (new DeleteNonExistentEntry (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxStandardContentStoreLfu;
+
+} // namespace TestSuiteCCNxStandardContentStoreLfu
@@ -249,6 +249,23 @@ BeginTest (DeleteNonExistentEntry)
 }
 EndTest ()
 
+BeginTest (GetVictimEntry)
+{
+  // the victim is the back entry, null when empty
+  printf ("TestCCNxStandardContentStoreLruList_GetVictimEntry DoRun\n");
+
+  CreateEntries (2);
+
+  Ptr<CCNxStandardContentStoreLruList> dut = CreateLruList ();
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry(), Ptr<CCNxStandardContentStoreEntry> (0), "empty list should have no victim !");
+
+  dut->AddEntry(CCNxEntryVector[0]);
+  dut->AddEntry(CCNxEntryVector[1]);
+  dut->RefreshEntry(CCNxEntryVector[0]);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry(), CCNxEntryVector[1], "victim entry incorrect !");
+}
+EndTest ()
+
 BeginTest (ScaleTest)
 {
   // add 10K MAX_ENTRIES, refresh random MAX_ENTRIES,delete all MAX_ENTRIES, see no mem leak
@@ -297,6 +314,7 @@ public:
     AddTestCase (new RefreshEntry (), TestCase::QUICK);
     AddTestCase (new DeleteEntry (), TestCase::QUICK);
     AddTestCase (new DeleteNonExistentEntry (), TestCase::QUICK);
+    AddTestCase (new GetVictimEntry (), TestCase::QUICK);
     AddTestCase (new ScaleTest (), TestCase::QUICK);
 
   }
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "ns3/ccnx-standard-content-store-s3fifo.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxStandardContentStoreS3Fifo {
+static Ptr<CCNxStandardContentStoreEntry>
+CreateEntry (int i)
+{
+  std::ostringstream nameString;
+  nameString << "ccnx:/name=foo/name=sink/name=kitchen" << i;
+  Ptr<CCNxName> name = Create<CCNxName> (nameString.str ());
+  Ptr<CCNxContentObject> content = Create<CCNxContentObject> (name, Create<CCNxBuffer> (128, true));
+  return Create<CCNxStandardContentStoreEntry> (CCNxPacket::CreateFromMessage (content));
+}
+
+/**
+ * Evict the victim, as the content store does when full
+ */
+static Ptr<CCNxStandardContentStoreEntry>
+Evict (Ptr<CCNxStandardContentStoreS3Fifo> dut)
+{
+  Ptr<CCNxStandardContentStoreEntry> victim = dut->GetVictimEntry ();
+  dut->EvictEntry (victim);
+  return victim;
+}
+
+BeginTest (Constructor)
+{
+  Ptr<CCNxStandardContentStoreS3Fifo> dut = Create<CCNxStandardContentStoreS3Fifo> (10);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 0, "New S3-FIFO should be empty");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), Ptr<CCNxStandardContentStoreEntry> (0), "Empty S3-FIFO should have no victim");
+}
+EndTest ()
+
+BeginTest (HitInSmallPromotes)
+{
+  Ptr<CCNxStandardContentStoreS3Fifo> dut = Create<CCNxStandardContentStoreS3Fifo> (10);
+  std::vector<Ptr<CCNxStandardContentStoreEntry> > entries;
+  for (int i = 0; i < 10; i++)
+    {
+      entries.push_back (CreateEntry (i));
+      dut->AddEntry (entries[i]);
+    }
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSmallSize (), 10, "New entries should be in S");
+
+  // 0 is the oldest, but it was hit so it moves to M and 1 is the victim
+  dut->RefreshEntry (entries[0]);
+  NS_TEST_EXPECT_MSG_EQ (Evict (dut), entries[1], "Wrong victim");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetMainSize (), 1, "Hit entry should be in M");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetGhostSize (), 1, "Victim from S should be in G");
+
+  // 1 comes back as a new entry and goes straight to M
+  dut->AddEntry (CreateEntry (1));
+  NS_TEST_EXPECT_MSG_EQ (dut->GetMainSize (), 2, "Ghost hit should go to M");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetGhostSize (), 0, "Ghost hit should leave G");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 10, "Wrong size");
+}
+EndTest ()
+
+BeginTest (MainReinsertsHit)
+{
+  Ptr<CCNxStandardContentStoreS3Fifo> dut = Create<CCNxStandardContentStoreS3Fifo> (10);
+
+  // put a and b in M via G
+  dut->AddEntry (CreateEntry (0));
+  Evict (dut);
+  Ptr<CCNxStandardContentStoreEntry> a = CreateEntry (0);
+  dut->AddEntry (a);
+
+  dut->AddEntry (CreateEntry (1));
+  Evict (dut);
+  Ptr<CCNxStandardContentStoreEntry> b = CreateEntry (1);
+  dut->AddEntry (b);
+
+  NS_TEST_EXPECT_MSG_EQ (dut->GetMainSize (), 2, "Both entries should be in M");
+
+  // a is the oldest in M, but it was hit so it is re-inserted
+  dut->RefreshEntry (a);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), b, "Wrong victim");
+
+  dut->DeleteEntry (b);
+  NS_TEST_EXPECT_MSG_EQ (dut->GetVictimEntry (), a, "Victim should be the only entry");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetGhostSize (), 0, "Deleted entries are not remembered");
+}
+EndTest ()
+
+BeginTest (DeleteNonExistentEntry)
+{
+  Ptr<CCNxStandardContentStoreS3Fifo> dut = Create<CCNxStandardContentStoreS3Fifo> (10);
+  dut->AddEntry (CreateEntry (0));
+
+  NS_TEST_EXPECT_MSG_EQ (dut->DeleteEntry (CreateEntry (1)), false, "Delete of missing entry should fail");
+  NS_TEST_EXPECT_MSG_EQ (dut->GetSize (), 1, "Wrong size");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxStandardContentStoreS3Fifo
+ */
+static class TestSuiteCCNxStandardContentStoreS3Fifo : public TestSuite
+{
+public:
+  TestSuiteCCNxStandardContentStoreS3Fifo () : TestSuite ("ccnx-standard-content-store-s3fifo", UNIT)
+  {
+    AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new HitInSmallPromotes (), TestCase::QUICK);
+    AddTestCase (new MainReinsertsHit (), TestCase::QUICK);
+    AddTestCase (new DeleteNonExistentEntry (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxStandardContentStoreS3Fifo;
+
+} // namespace TestSuiteCCNxStandardContentStoreS3Fifo
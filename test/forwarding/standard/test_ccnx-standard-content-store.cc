@@ -60,6 +60,8 @@
 #include "../../mockups/mockup_ccnx-virtual-connection.h"
 #include "../../mockups/ccnx-standard-content-store-with-test-methods.h"
 #include "ns3/integer.h"
+#include "ns3/enum.h"
+#include "ns3/boolean.h"
 #include "../../TestMacros.h"
 #include "ns3/ccnx-cachetime.h"
 #include "ns3/nstime.h"
@@ -460,6 +462,8 @@ BeginTest (AddContentObject)
   a->AddContentObject(data.cWorkItem1,data.eConnList1);  StepSimulatorAddContentObject();
 
   NS_TEST_EXPECT_MSG_EQ(a->GetObjectCount(),1,"Lru list length wrong");
+  NS_TEST_EXPECT_MSG_EQ(a->GetEvictionCount(),1,"wrong eviction count");
+  NS_TEST_EXPECT_MSG_EQ(a->GetExpiryCount(),0,"wrong expiry count");
   NS_TEST_EXPECT_MSG_EQ(a->GetMapByHashCount(),1,"map by hash size wrong");
   NS_TEST_EXPECT_MSG_EQ(a->GetMapByNameCount(),1,"map by name size wrong");
   NS_TEST_EXPECT_MSG_EQ(a->GetMapByNameKeyidCount(),1, "Wrong namekeyid map size"); //if no KEYIDHACK, chg the exp to 0
@@ -678,7 +682,7 @@ BeginTest (MatchInterestWithExpiredContent)
       dut->MatchInterest(data.iWorkItem2); StepSimulatorMatchInterest ();
       NS_TEST_EXPECT_MSG_EQ (_lookupMatchInterestCallbackPacket, Ptr<CCNxPacket>(0), "wrong Packet returned !");
       NS_TEST_EXPECT_MSG_EQ(dut->GetObjectCount(),0,"wrong number of objects in content store!");
-
+      NS_TEST_EXPECT_MSG_EQ(dut->GetExpiryCount(),1,"wrong expiry count");
 
 }
 EndTest ()
@@ -719,6 +723,179 @@ BeginTest (DeleteNonExistentContentObject)
 }
 EndTest ()
 
+BeginTest (ReplacementPolicy_Lfu)
+{
+  printf ("TestCCNxStandardContentStore_ReplacementPolicy_Lfu DoRun\n");
+  //Capacity 2 with LFU. Hit object 1 twice, then object 2 once. LRU would evict 1, LFU evicts 2
+  TestData data = CreateTestData ();
+
+  Ptr<CCNxStandardContentStoreWithTestMethods> a = CreateContentStore ();
+  a->SetAttribute("ObjectCapacity",IntegerValue (2));
+  a->SetAttribute("ReplacementPolicy",EnumValue (CCNxStandardContentStore::Lfu));
+  NS_TEST_EXPECT_MSG_EQ(a->GetReplacementPolicy(),CCNxStandardContentStore::Lfu,"wrong replacement policy");
+
+  a->AddContentObject(data.cWorkItem1,data.eConnList1); StepSimulatorAddContentObject();
+  a->MatchInterest(data.iWorkItem1); StepSimulatorMatchInterest ();
+  a->MatchInterest(data.iWorkItem1); StepSimulatorMatchInterest ();
+  a->AddContentObject(data.cWorkItem2,data.eConnList1); StepSimulatorAddContentObject();
+  a->MatchInterest(data.iWorkItem2); StepSimulatorMatchInterest ();
+  a->AddContentObject(data.cWorkItem3,data.eConnList1); StepSimulatorAddContentObject();
+
+  NS_TEST_EXPECT_MSG_EQ(a->GetObjectCount(),2,"object count wrong");
+  NS_TEST_EXPECT_MSG_NE(a->FindEntryInHashMap(data.cPacket1),Ptr<CCNxStandardContentStoreEntry> (0),"most frequent object should remain");
+  NS_TEST_EXPECT_MSG_EQ(a->FindEntryInHashMap(data.cPacket2),Ptr<CCNxStandardContentStoreEntry> (0),"least frequent object should be evicted");
+}
+EndTest ()
+
+BeginTest (TinyLfuAdmission)
+{
+  printf ("TestCCNxStandardContentStore_TinyLfuAdmission DoRun\n");
+  //Capacity 1 with TinyLFU. An unrequested object is rejected, a requested one replaces the victim
+  TestData data = CreateTestData ();
+
+  Ptr<CCNxStandardContentStoreWithTestMethods> a = CreateContentStore ();
+  a->SetAttribute("ObjectCapacity",IntegerValue (1));
+  a->SetAttribute("TinyLfuAdmission",BooleanValue (true));
+
+  a->AddContentObject(data.cWorkItem1,data.eConnList1); StepSimulatorAddContentObject();
+  a->AddContentObject(data.cWorkItem2,data.eConnList1); StepSimulatorAddContentObject();
+
+  NS_TEST_EXPECT_MSG_EQ(a->GetAdmissionRejectCount(),1,"object 2 should have been rejected");
+  NS_TEST_EXPECT_MSG_NE(a->FindEntryInHashMap(data.cPacket1),Ptr<CCNxStandardContentStoreEntry> (0),"object 1 should remain");
+
+  //two misses for object 2 make it more popular than object 1
+  a->MatchInterest(data.iWorkItem2); StepSimulatorMatchInterest ();
+  a->MatchInterest(data.iWorkItem2); StepSimulatorMatchInterest ();
+  a->AddContentObject(data.cWorkItem2,data.eConnList1); StepSimulatorAddContentObject();
+
+  NS_TEST_EXPECT_MSG_EQ(a->GetAdmissionRejectCount(),1,"object 2 should have been admitted");
+  NS_TEST_EXPECT_MSG_EQ(a->GetObjectCount(),1,"object count wrong");
+  NS_TEST_EXPECT_MSG_NE(a->FindEntryInHashMap(data.cPacket2),Ptr<CCNxStandardContentStoreEntry> (0),"object 2 should be stored");
+}
+EndTest ()
+BeginTest (TinyLfuAdmissionOnce)
+{
+  printf ("TestCCNxStandardContentStore_TinyLfuAdmissionOnce DoRun\n");
+  //A byte capacity that holds objects 1 and 2, and a large object that needs both evicted.  The
+  //large object is more popular than object 1 (the first victim) but not object 2, so the single
+  //admission decision against object 1 admits it and both objects are evicted.
+  TestData data = CreateTestData ();
+
+  Ptr<CCNxStandardContentStoreWithTestMethods> a = CreateContentStore ();
+  a->AddContentObject(data.cWorkItem1,data.eConnList1); StepSimulatorAddContentObject();
+  uint64_t bytes1 = a->GetByteCount();
+  a->AddContentObject(data.cWorkItem2,data.eConnList1); StepSimulatorAddContentObject();
+  uint64_t bytes12 = a->GetByteCount();
+
+  Ptr<const CCNxName> bigName = Create<CCNxName> ("ccnx:/name=my/name=big/name=box");
+  Ptr<CCNxContentObject> big = Create<CCNxContentObject> (bigName, Create<CCNxBuffer> ((bytes12 - bytes1) / 2, true));
+  Ptr<CCNxStandardForwarderWorkItem> bigWorkItem = CreateWorkItem(CCNxPacket::CreateFromMessage (big),data.ingress1);
+  Ptr<CCNxPacket> bigInterest = CCNxPacket::CreateFromMessage (Create<CCNxInterest> (bigName));
+  a->AddContentObject(bigWorkItem,data.eConnList1); StepSimulatorAddContentObject();
+  uint64_t bigBytes = a->GetByteCount() - bytes12;
+  bool needsBoth = bigBytes > bytes12 - bytes1 and bigBytes > bytes1 and bigBytes <= bytes12;
+  NS_TEST_ASSERT_MSG_EQ(needsBoth, true, "the large object should need both victims evicted");
+
+  Ptr<CCNxStandardContentStoreWithTestMethods> b = CreateContentStore ();
+  b->SetAttribute("ByteCapacity",IntegerValue (bytes12));
+  b->SetAttribute("TinyLfuAdmission",BooleanValue (true));
+  b->AddContentObject(data.cWorkItem1,data.eConnList1); StepSimulatorAddContentObject();
+  b->AddContentObject(data.cWorkItem2,data.eConnList1); StepSimulatorAddContentObject();
+
+  //an unrequested object is rejected without evicting anything
+  b->AddContentObject(CreateWorkItem(bigWorkItem->GetPacket(),data.ingress1),data.eConnList1); StepSimulatorAddContentObject();
+  NS_TEST_EXPECT_MSG_EQ(b->GetAdmissionRejectCount(),1,"the large object should have been rejected");
+  NS_TEST_EXPECT_MSG_EQ(b->GetEvictionCount(),0,"a rejected object should not evict anything");
+  NS_TEST_EXPECT_MSG_EQ(b->GetObjectCount(),2,"objects 1 and 2 should remain");
+
+  for (int i = 0; i < 3; ++i)
+    {
+      b->MatchInterest(data.iWorkItem2); StepSimulatorMatchInterest ();
+    }
+  for (int i = 0; i < 2; ++i)
+    {
+      b->MatchInterest(CreateWorkItem(bigInterest,data.ingress1)); StepSimulatorMatchInterest ();
+    }
+  b->AddContentObject(CreateWorkItem(bigWorkItem->GetPacket(),data.ingress1),data.eConnList1); StepSimulatorAddContentObject();
+
+  NS_TEST_EXPECT_MSG_EQ(b->GetAdmissionRejectCount(),1,"the large object should have been admitted");
+  NS_TEST_EXPECT_MSG_EQ(b->GetEvictionCount(),2,"both objects should have been evicted");
+  NS_TEST_EXPECT_MSG_EQ(b->GetObjectCount(),1,"object count wrong");
+  NS_TEST_EXPECT_MSG_NE(b->FindEntryInHashMap(bigWorkItem->GetPacket()),Ptr<CCNxStandardContentStoreEntry> (0),"the large object should be stored");
+}
+EndTest ()
+
+BeginTest (ByteCapacity)
+{
+  printf ("TestCCNxStandardContentStore_ByteCapacity DoRun\n");
+  //measure the footprint of objects 1 and 2, then limit a store to exactly that and add object 3
+  TestData data = CreateTestData ();
+
+  Ptr<CCNxStandardContentStoreWithTestMethods> a = CreateContentStore ();
+  a->AddContentObject(data.cWorkItem1,data.eConnList1); StepSimulatorAddContentObject();
+  uint64_t bytes1 = a->GetByteCount();
+  a->AddContentObject(data.cWorkItem2,data.eConnList1); StepSimulatorAddContentObject();
+  uint64_t bytes12 = a->GetByteCount();
+  bool grew = bytes12 > bytes1 and bytes1 > 0;
+  NS_TEST_EXPECT_MSG_EQ(grew, true, "byte count should grow with each object");
+
+  a->DeleteContentObject(data.cPacket1);
+  a->DeleteContentObject(data.cPacket2);
+  NS_TEST_EXPECT_MSG_EQ(a->GetByteCount(),0,"byte count should be 0 when empty");
+
+  Ptr<CCNxStandardContentStoreWithTestMethods> b = CreateContentStore ();
+  b->SetAttribute("ByteCapacity",IntegerValue (bytes12));
+  NS_TEST_EXPECT_MSG_EQ(b->GetByteCapacity(),bytes12,"wrong byte capacity");
+
+  b->AddContentObject(data.cWorkItem1,data.eConnList1); StepSimulatorAddContentObject();
+  b->AddContentObject(data.cWorkItem2,data.eConnList1); StepSimulatorAddContentObject();
+  NS_TEST_EXPECT_MSG_EQ(b->GetObjectCount(),2,"both objects should fit");
+
+  b->AddContentObject(data.cWorkItem3,data.eConnList1); StepSimulatorAddContentObject();
+  bool fits = b->GetByteCount() <= bytes12;
+  NS_TEST_EXPECT_MSG_EQ(fits, true, "byte count should not exceed the byte capacity");
+  NS_TEST_EXPECT_MSG_EQ(b->FindEntryInHashMap(data.cPacket1),Ptr<CCNxStandardContentStoreEntry> (0),"LRU object should be evicted");
+  NS_TEST_EXPECT_MSG_NE(b->FindEntryInHashMap(data.cPacket3),Ptr<CCNxStandardContentStoreEntry> (0),"new object should be stored");
+}
+EndTest ()
+
+BeginTest (ReapExpiredContent)
+{
+  printf ("TestCCNxStandardContentStore_ReapExpiredContent DoRun\n");
+  //objects that go stale are removed without an Interest; objects without a deadline stay
+  TestData data = CreateTestData ();
+  Ptr<CCNxStandardContentStoreWithTestMethods> a = CreateContentStore ();
+
+  Time deadline = Simulator::Now () + 6 * _layerDelay;
+  data.cPacket1->AddPerHopHeaderEntry(Create<CCNxCachetime> (Create<CCNxTime> (deadline.GetTimeStep ())));
+  data.cPacket2->AddPerHopHeaderEntry(Create<CCNxCachetime> (Create<CCNxTime> (deadline.GetTimeStep ())));
+  a->AddContentObject(data.cWorkItem1,data.eConnList1); StepSimulatorAddContentObject();
+  a->AddContentObject(data.cWorkItem2,data.eConnList1); StepSimulatorAddContentObject();
+  a->AddContentObject(data.cWorkItem3,data.eConnList1); StepSimulatorAddContentObject();
+  NS_TEST_EXPECT_MSG_EQ(a->GetObjectCount(),3,"all objects should be stored before the deadline");
+
+  Simulator::Stop (10 * _layerDelay);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ(a->GetObjectCount(),1,"stale objects should be reaped");
+  NS_TEST_EXPECT_MSG_EQ(a->GetExpiryCount(),2,"wrong expiry count");
+  NS_TEST_EXPECT_MSG_EQ(a->GetEvictionCount(),0,"wrong eviction count");
+  NS_TEST_EXPECT_MSG_NE(a->FindEntryInHashMap(data.cPacket3),Ptr<CCNxStandardContentStoreEntry> (0),"object without deadline should stay");
+
+  //a batch size of 0 disables the reaper
+  TestData data2 = CreateTestData ();
+  Ptr<CCNxStandardContentStoreWithTestMethods> b = CreateContentStore ();
+  b->SetAttribute("ReapBatchSize",IntegerValue (0));
+  deadline = Simulator::Now () + _layerDelay;
+  data2.cPacket1->AddPerHopHeaderEntry(Create<CCNxCachetime> (Create<CCNxTime> (deadline.GetTimeStep ())));
+  b->AddContentObject(data2.cWorkItem1,data2.eConnList1); StepSimulatorAddContentObject();
+
+  Simulator::Stop (5 * _layerDelay);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ(b->GetObjectCount(),1,"reaper should be disabled");
+  NS_TEST_EXPECT_MSG_EQ(b->GetExpiryCount(),0,"wrong expiry count");
+}
+EndTest ()
 
 
 /**
@@ -750,6 +927,11 @@ public:
     AddTestCase (new MatchInterestWithExpiredContent (), TestCase::QUICK);
     AddTestCase (new GetMapCounts (), TestCase::QUICK);
     AddTestCase (new DeleteNonExistentContentObject (), TestCase::QUICK);
+    AddTestCase (new ReplacementPolicy_Lfu (), TestCase::QUICK);
+    AddTestCase (new TinyLfuAdmission (), TestCase::QUICK);
+    AddTestCase (new TinyLfuAdmissionOnce (), TestCase::QUICK);
+    AddTestCase (new ByteCapacity (), TestCase::QUICK);
+    AddTestCase (new ReapExpiredContent (), TestCase::QUICK);
 
 
   }
@@ -485,6 +485,44 @@ BeginTest (RemoveConnection)
 }
 EndTest ()
 
+BeginTest (ConnectionIndex)
+{
+  /* the reverse index follows AddRoute, DeleteRoute, and RemoveConnection
+   */
+  printf ("TestCCNxStandardConnectionIndex DoRun\n");
+
+  Ptr<CCNxStandardFib> fib = CreateFib ();
+
+  Ptr<const CCNxName> name1 = Create<CCNxName> ("ccnx:/name=apple");
+  Ptr<const CCNxName> name2 = Create<CCNxName> ("ccnx:/name=banana");
+  Ptr<const CCNxName> name3 = Create<CCNxName> ("ccnx:/name=cherry");
+  Ptr<CCNxVirtualConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection2 = Create<CCNxVirtualConnection> ();
+
+  fib->AddRoute (name1, connection1);
+  fib->AddRoute (name2, connection1);
+  fib->AddRoute (name3, connection1);
+  fib->AddRoute (name3, connection2);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountConnectionEntries (connection1), 3, "wrong index size for connection1");
+  NS_TEST_EXPECT_MSG_EQ (fib->CountConnectionEntries (connection2), 1, "wrong index size for connection2");
+
+  fib->DeleteRoute (name2, connection1);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountConnectionEntries (connection1), 2, "DeleteRoute did not update the index");
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 2, "wrong number of fib entries");
+
+  fib->RemoveConnection (connection1);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountConnectionEntries (connection1), 0, "RemoveConnection did not clear the index");
+  NS_TEST_EXPECT_MSG_EQ (fib->CountConnectionEntries (connection2), 1, "RemoveConnection touched another connection");
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 1, "wrong number of fib entries");
+
+  // a second removal has nothing left to do
+  fib->RemoveConnection (connection1);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 1, "wrong number of fib entries");
+
+  printf ("TestCCNxStandardConnectionIndex End\n");
+}
+EndTest ()
+
 
 
 
@@ -503,6 +541,7 @@ public:
     AddTestCase (new Lookup (), TestCase::QUICK);
     AddTestCase (new DeleteRoute (), TestCase::QUICK);
     AddTestCase (new RemoveConnection (), TestCase::QUICK);
+    AddTestCase (new ConnectionIndex (), TestCase::QUICK);
     AddTestCase (new DeleteNonExistentRoute (), TestCase::QUICK );
     AddTestCase (new DeleteAllRoutes (), TestCase::QUICK );
     AddTestCase (new LookupBestMatch (), TestCase::QUICK );
@@ -53,6 +53,7 @@
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
 
+#include "../../mockups/mockup_ccnx-virtual-connection.h"
 #include "ns3/test.h"
 #include "ns3/ccnx-standard-fibEntry.h"
 #include "ns3/ccnx-connection.h"
@@ -78,6 +79,42 @@ BeginTest (Constructor)
 }
 EndTest ()
 
+BeginTest (Costs)
+{
+  printf ("TestCCNxStandardFibEntryCosts DoRun\n");
+
+  Ptr<CCNxStandardFibEntry> entry = Create<CCNxStandardFibEntry> ();
+  Ptr<CCNxConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxConnection> connection2 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxConnection> connection3 = Create<CCNxVirtualConnection> ();
+
+  entry->AddConnection (connection1, 30);
+  entry->AddConnection (connection2, 10);
+  entry->AddConnection (connection3, 30);
+
+  // ascending cost, equal costs in the order added
+  const CCNxStandardFibEntry::NextHopsVecType &nextHops = entry->GetNextHops ();
+  NS_TEST_EXPECT_MSG_EQ (nextHops.size (), 3, "wrong number of next hops");
+  NS_TEST_EXPECT_MSG_EQ (nextHops[0].connection, connection2, "lowest cost should be first");
+  NS_TEST_EXPECT_MSG_EQ (nextHops[1].connection, connection1, "equal costs should keep their order");
+  NS_TEST_EXPECT_MSG_EQ (nextHops[2].connection, connection3, "equal costs should keep their order");
+
+  // adding an existing connection updates its cost
+  int count = entry->AddConnection (connection3, 5);
+  NS_TEST_EXPECT_MSG_EQ (count, 3, "updating a cost should not add a connection");
+  NS_TEST_EXPECT_MSG_EQ (entry->GetNextHops ()[0].connection, connection3, "updated cost should move the next hop");
+  NS_TEST_EXPECT_MSG_EQ (entry->GetNextHops ()[0].cost, 5, "wrong cost");
+
+  CCNxStandardFibEntry::ConnectionsVecType connections = entry->GetConnections ();
+  NS_TEST_EXPECT_MSG_EQ (connections.size (), 3, "wrong number of connections");
+  NS_TEST_EXPECT_MSG_EQ (connections[1], connection2, "GetConnections should be in cost order");
+
+  std::pair<bool,int> rvPair = entry->RemoveConnection (connection2);
+  NS_TEST_EXPECT_MSG_EQ (rvPair.first, true, "connection should be removed");
+  NS_TEST_EXPECT_MSG_EQ (rvPair.second, 2, "wrong number of connections left");
+}
+EndTest ()
+
 
 
 
@@ -95,6 +132,7 @@ public:
   TestSuiteCCNxStandardFibEntry () : TestSuite ("ccnx-standard-fibEntry", UNIT)
   {
     AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Costs (), TestCase::QUICK);
 //   AddTestCase (new b1 (), TestCase::QUICK);
 //   AddTestCase (new b1a (), TestCase::QUICK);
 //   AddTestCase (new b2 (), TestCase::QUICK);
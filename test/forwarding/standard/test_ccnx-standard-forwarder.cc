@@ -62,6 +62,8 @@
 #include "ns3/node-container.h"
 #include "ns3/assert.h"
 #include "ns3/integer.h"
+#include "ns3/enum.h"
+#include "ns3/ccnx-standard-fib-factory.h"
 #include "ns3/object-factory.h"
 #include "ns3/ccnx-standard-content-store-factory.h"
 #include "ns3/ccnx-standard-forwarder-helper.h"
@@ -101,7 +103,7 @@ MockupRouteCallback (Ptr<CCNxPacket> packet, Ptr<CCNxConnection> ingress, enum C
   _routeCallbackFired = true;
 }
 
-Ptr<CCNxStandardForwarder> CreateForwarder (bool WithContentStore=true)
+Ptr<CCNxStandardForwarder> CreateForwarder (bool WithContentStore=true, bool adaptive=false)
 {
 #if 1
   LogComponentEnable ("CCNxStandardForwarder", (LogLevel) (LOG_LEVEL_DEBUG | LOG_PREFIX_ALL));
@@ -121,6 +123,12 @@ Ptr<CCNxStandardForwarder> CreateForwarder (bool WithContentStore=true)
   forwarder->SetAttribute ("LayerDelayConstant", TimeValue (_layerDelay));
   forwarder->SetAttribute ("LayerDelaySlope", TimeValue (Seconds (0)));
   forwarder->SetAttribute ("LayerDelayServers", IntegerValue (1));
+  if (adaptive)
+    {
+      CCNxStandardFibFactory fibFactory;
+      fibFactory.SetForwardingStrategy (CCNxStandardForwardingStrategy::Adaptive);
+      forwarder->SetAttribute ("FibFactory", ObjectFactoryValue (fibFactory));
+    }
   forwarder->SetRouteCallback (MakeCallback (&MockupRouteCallback));
   forwarder->Initialize ();  //runs the DoInitialize() method
 
@@ -628,6 +636,59 @@ BeginTest (NoContentStore)
 EndTest ()
 
 
+BeginTest (AdaptiveNamelessContent)
+{
+  // a nameless Content Object matched by hash must not be fed to the adaptive strategy by name
+
+  Ptr<CCNxStandardForwarder> forwarder = CreateForwarder (false, true);
+  TestData data = CreateTestData ();
+  SetupTwoRoutesPrefix1 (forwarder, data);
+
+  Ptr<CCNxHashValue> keyidRest;
+  Ptr<CCNxInterest> interest = Create<CCNxInterest> (data.name1, Create<CCNxBuffer> (0), keyidRest, Create<CCNxHashValue> (7));
+  Ptr<CCNxPacket> iPacket = CCNxPacket::CreateFromMessage (interest);
+
+  Ptr<CCNxContentObject> content = Create<CCNxContentObject> (Ptr<const CCNxName> (0));
+  Ptr<CCNxPacket> cPacket = CCNxPacket::CreateFromMessage (content);
+  cPacket->SetContentObjectHash (Create<CCNxHashValue> (7));
+
+  //route an interest, the adaptive strategy sends it to one of the two next hops
+  forwarder->RouteInput (iPacket, data.ingress1);
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_routeCallbackErrno,CCNxRoutingError::CCNxRoutingError_NoError,"wrong errorno");
+  NS_TEST_EXPECT_MSG_EQ (_routeCallbackConnections->size (), 1, "wrong number of connections");
+  Ptr<CCNxConnection> egress = _routeCallbackConnections->front ();
+  NS_TEST_EXPECT_MSG_EQ (forwarder->CountEntries (CCNxStandardForwarder::PitTable), 1, "wrong number of pit entries");
+
+  //route the nameless content from that next hop
+  forwarder->RouteInput (cPacket, egress);
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_routeCallbackErrno,CCNxRoutingError::CCNxRoutingError_NoError,"wrong errorno");
+  NS_TEST_EXPECT_MSG_EQ (_routeCallbackConnections->size (), 1, "wrong number of connections");
+  NS_TEST_EXPECT_MSG_EQ (_routeCallbackConnections->front ()->GetConnectionId (), data.ingress1->GetConnectionId (), "content not forwarded to interest source");
+  NS_TEST_EXPECT_MSG_EQ (forwarder->CountEntries (CCNxStandardForwarder::PitTable), 0, "wrong number of pit entries");
+
+  Simulator::Destroy ();
+}
+EndTest ()
+
+BeginTest (AssignStreams)
+{
+  printf ("TestCCNxStandardForwarderAssignStreams DoRun\n");
+
+  // tail drop uses no random numbers
+  Ptr<CCNxStandardForwarder> tailDrop = CreateObject<CCNxStandardForwarder> ();
+  NS_TEST_EXPECT_MSG_EQ (tailDrop->AssignStreams (5), 0, "Tail drop should not use a stream");
+
+  // RED takes one stream, both before and after the input queue is created
+  Ptr<CCNxStandardForwarder> red = CreateObject<CCNxStandardForwarder> ();
+  red->SetAttribute ("InputQueueDropPolicy", EnumValue (CCNxDelayQueueDropPolicy_Red));
+  NS_TEST_EXPECT_MSG_EQ (red->AssignStreams (5), 1, "RED should use one stream");
+  red->Initialize ();
+  NS_TEST_EXPECT_MSG_EQ (red->AssignStreams (6), 1, "RED should use one stream");
+}
+EndTest ()
+
 
 BeginTest (PrintForwardingTable)
 {
@@ -735,6 +796,8 @@ public:
     AddTestCase (new RouteExactName (), TestCase::QUICK);
     AddTestCase (new ContentStore (), TestCase::QUICK);
     AddTestCase (new NoContentStore (), TestCase::QUICK);
+    AddTestCase (new AdaptiveNamelessContent (), TestCase::QUICK);
+    AddTestCase (new AssignStreams (), TestCase::QUICK);
     AddTestCase (new PrintForwardingTable (), TestCase::QUICK);
 
   }
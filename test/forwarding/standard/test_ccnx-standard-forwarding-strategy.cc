@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <sstream>
+
+#include "../../mockups/mockup_ccnx-virtual-connection.h"
+#include "ns3/test.h"
+#include "ns3/ccnx-standard-forwarding-strategy.h"
+#include "ns3/log.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxStandardForwardingStrategy {
+
+/*
+ * An entry whose connections 0, 1, 2, 3 have costs 10, 20, 10, 40
+ */
+static Ptr<CCNxStandardFibEntry>
+CreateEntry (Ptr<CCNxConnection> connections[4])
+{
+  static const uint32_t costs[4] = { 10, 20, 10, 40 };
+  Ptr<CCNxStandardFibEntry> entry = Create<CCNxStandardFibEntry> ();
+  for (int i = 0; i < 4; ++i)
+    {
+      connections[i] = Create<CCNxVirtualConnection> ();
+      entry->AddConnection (connections[i], costs[i]);
+    }
+  return entry;
+}
+
+static Ptr<const CCNxName>
+CreateName (int i)
+{
+  std::ostringstream uri;
+  uri << "ccnx:/name=apple/name=" << i;
+  return Create<CCNxName> (uri.str ());
+}
+
+BeginTest (Multicast)
+{
+  printf ("TestCCNxStandardForwardingStrategyMulticast DoRun\n");
+
+  Ptr<CCNxConnection> connections[4];
+  Ptr<CCNxStandardFibEntry> entry = CreateEntry (connections);
+  Ptr<CCNxStandardForwardingStrategy> strategy = CCNxStandardForwardingStrategy::CreateStrategy (CCNxStandardForwardingStrategy::Multicast);
+
+  Ptr<CCNxConnectionList> egress = Create<CCNxConnectionList> ();
+  strategy->SelectEgress (CreateName (0), 1, connections[1], entry->GetNextHops (), egress);
+  NS_TEST_EXPECT_MSG_EQ (egress->size (), 3, "Multicast should use every next hop except the ingress");
+}
+EndTest ()
+
+BeginTest (BestRoute)
+{
+  printf ("TestCCNxStandardForwardingStrategyBestRoute DoRun\n");
+
+  Ptr<CCNxConnection> connections[4];
+  Ptr<CCNxStandardFibEntry> entry = CreateEntry (connections);
+  Ptr<CCNxStandardForwardingStrategy> strategy = CCNxStandardForwardingStrategy::CreateStrategy (CCNxStandardForwardingStrategy::BestRoute);
+
+  Ptr<CCNxConnectionList> egress = Create<CCNxConnectionList> ();
+  strategy->SelectEgress (CreateName (0), 1, Ptr<CCNxConnection> (0), entry->GetNextHops (), egress);
+  NS_TEST_EXPECT_MSG_EQ (egress->size (), 1, "BestRoute should use one next hop");
+  NS_TEST_EXPECT_MSG_EQ (egress->front (), connections[0], "BestRoute should use the first lowest cost next hop");
+
+  // the best route is the ingress, so the next lowest cost
+  egress = Create<CCNxConnectionList> ();
+  strategy->SelectEgress (CreateName (0), 1, connections[0], entry->GetNextHops (), egress);
+  NS_TEST_EXPECT_MSG_EQ (egress->front (), connections[2], "BestRoute should skip the ingress");
+}
+EndTest ()
+
+BeginTest (Ecmp)
+{
+  printf ("TestCCNxStandardForwardingStrategyEcmp DoRun\n");
+
+  Ptr<CCNxConnection> connections[4];
+  Ptr<CCNxStandardFibEntry> entry = CreateEntry (connections);
+  Ptr<CCNxStandardForwardingStrategy> strategy = CCNxStandardForwardingStrategy::CreateStrategy (CCNxStandardForwardingStrategy::Ecmp);
+
+  unsigned counts[4] = { 0, 0, 0, 0 };
+  for (int i = 0; i < 1000; ++i)
+    {
+      Ptr<const CCNxName> name = CreateName (i);
+      Ptr<CCNxConnectionList> egress = Create<CCNxConnectionList> ();
+      strategy->SelectEgress (name, 1, Ptr<CCNxConnection> (0), entry->GetNextHops (), egress);
+      NS_TEST_EXPECT_MSG_EQ (egress->size (), 1, "Ecmp should use one next hop");
+      for (int j = 0; j < 4; ++j)
+        {
+          counts[j] += (egress->front () == connections[j]);
+        }
+
+      // the same name always takes the same path
+      Ptr<CCNxConnectionList> again = Create<CCNxConnectionList> ();
+      strategy->SelectEgress (name, 1, Ptr<CCNxConnection> (0), entry->GetNextHops (), again);
+      NS_TEST_EXPECT_MSG_EQ (again->front (), egress->front (), "Ecmp should be consistent for a name");
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (counts[1] + counts[3], 0, "Ecmp should only use the lowest cost next hops");
+  NS_TEST_EXPECT_MSG_GT (counts[0], 400, "Ecmp should split evenly");
+  NS_TEST_EXPECT_MSG_GT (counts[2], 400, "Ecmp should split evenly");
+}
+EndTest ()
+
+BeginTest (WeightedSplit)
+{
+  printf ("TestCCNxStandardForwardingStrategyWeightedSplit DoRun\n");
+
+  Ptr<CCNxConnection> connections[4];
+  Ptr<CCNxStandardFibEntry> entry = CreateEntry (connections);
+  Ptr<CCNxStandardForwardingStrategy> strategy = CCNxStandardForwardingStrategy::CreateStrategy (CCNxStandardForwardingStrategy::WeightedSplit);
+
+  unsigned counts[4] = { 0, 0, 0, 0 };
+  for (int i = 0; i < 4000; ++i)
+    {
+      Ptr<CCNxConnectionList> egress = Create<CCNxConnectionList> ();
+      strategy->SelectEgress (CreateName (i), 1, connections[0], entry->GetNextHops (), egress);
+      NS_TEST_EXPECT_MSG_EQ (egress->size (), 1, "WeightedSplit should use one next hop");
+      for (int j = 0; j < 4; ++j)
+        {
+          counts[j] += (egress->front () == connections[j]);
+        }
+    }
+
+  // connections 2, 1, 3 have weights 1/11, 1/21, 1/41 (0 is the ingress): about 2080, 1090, 560 Interests
+  NS_TEST_EXPECT_MSG_EQ (counts[0], 0, "WeightedSplit should skip the ingress");
+  NS_TEST_EXPECT_MSG_GT (counts[2], counts[1], "lower cost should get more Interests");
+  NS_TEST_EXPECT_MSG_GT (counts[1], counts[3], "lower cost should get more Interests");
+  NS_TEST_EXPECT_MSG_GT (counts[3], 300, "every next hop should get some Interests");
+}
+EndTest ()
+
+/**
+ * \ingroup ccnx-test
+ *
+ * \brief Test Suite for CCNxStandardForwardingStrategy
+ */
+static class TestSuiteCCNxStandardForwardingStrategy : public TestSuite
+{
+public:
+  TestSuiteCCNxStandardForwardingStrategy () : TestSuite ("ccnx-standard-forwarding-strategy", UNIT)
+  {
+    AddTestCase (new Multicast (), TestCase::QUICK);
+    AddTestCase (new BestRoute (), TestCase::QUICK);
+    AddTestCase (new Ecmp (), TestCase::QUICK);
+    AddTestCase (new WeightedSplit (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxStandardForwardingStrategy;
+
+} // namespace TestSuiteCCNxStandardForwardingStrategy
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <sstream>
+
+#include "ns3/test.h"
+#include "ns3/ccnx-standard-hash-pit.h"
+#include "../../mockups/mockup_ccnx-virtual-connection.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/integer.h"
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxStandardHashPit {
+
+static Time _layerDelay = MilliSeconds (10);
+
+static enum CCNxPit::Verdict _receiveInterestCallbackVerdict;
+static bool _receiveInterestCallbackFired;
+
+static void
+MockupReceiveInterestCallback (Ptr<CCNxForwarderMessage> message, enum CCNxPit::Verdict verdict)
+{
+  _receiveInterestCallbackVerdict = verdict;
+  _receiveInterestCallbackFired = true;
+}
+
+static Ptr<CCNxConnectionList> _satisfyInterestCallbackConnections;
+static bool _satisfyInterestCallbackFired;
+
+static void
+MockupSatisfyInterestCallback (Ptr<CCNxForwarderMessage> message, Ptr<CCNxConnectionList> egress)
+{
+  _satisfyInterestCallbackConnections = egress;
+  _satisfyInterestCallbackFired = true;
+}
+
+static Ptr<CCNxStandardHashPit>
+CreatePit ()
+{
+  Ptr<CCNxStandardHashPit> pit = CreateObject<CCNxStandardHashPit> ();
+  pit->SetAttribute ("InitialCapacity", IntegerValue (16));
+  pit->SetReceiveInterestCallback (MakeCallback (&MockupReceiveInterestCallback));
+  pit->SetSatisfyInterestCallback (MakeCallback (&MockupSatisfyInterestCallback));
+  pit->Initialize ();
+  return pit;
+}
+
+static void
+StepSimulator (bool *fired)
+{
+  unsigned tries = 0;
+  *fired = false;
+  while (!*fired && tries < 4)
+    {
+      Simulator::Stop (_layerDelay);
+      Simulator::Run ();
+      tries++;
+    }
+
+  NS_ASSERT_MSG (*fired, "Did not get a call to the PIT callback");
+}
+
+static Ptr<CCNxPacket>
+InterestPacket (Ptr<const CCNxName> name)
+{
+  return CCNxPacket::CreateFromMessage (Create<CCNxInterest> (name));
+}
+
+static Ptr<CCNxPacket>
+ContentPacket (Ptr<const CCNxName> name)
+{
+  return CCNxPacket::CreateFromMessage (Create<CCNxContentObject> (name));
+}
+
+BeginTest (AggregateAndSatisfy)
+{
+  printf ("TestCCNxStandardHashPitAggregateAndSatisfy DoRun\n");
+
+  Ptr<CCNxStandardHashPit> pit = CreatePit ();
+
+  Ptr<const CCNxName> name1 = Create<CCNxName> ("ccnx:/name=apple/name=pie");
+  Ptr<CCNxVirtualConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection2 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection3 = Create<CCNxVirtualConnection> ();
+
+  pit->ReceiveInterest (Create<CCNxForwarderMessage> (InterestPacket (name1), connection1));
+  StepSimulator (&_receiveInterestCallbackFired);
+  NS_TEST_EXPECT_MSG_EQ (_receiveInterestCallbackVerdict, CCNxPit::Forward, "verdict should be forward");
+
+  // A different Ptr to an equal name must find the same entry
+  Ptr<const CCNxName> name1copy = Create<CCNxName> ("ccnx:/name=apple/name=pie");
+  pit->ReceiveInterest (Create<CCNxForwarderMessage> (InterestPacket (name1copy), connection2));
+  StepSimulator (&_receiveInterestCallbackFired);
+  NS_TEST_EXPECT_MSG_EQ (_receiveInterestCallbackVerdict, CCNxPit::Aggregate, "verdict should be aggregate");
+  NS_TEST_EXPECT_MSG_EQ (pit->CountEntries (), 1, "wrong number of PIT entries");
+
+  pit->SatisfyInterest (Create<CCNxForwarderMessage> (ContentPacket (name1), connection3));
+  StepSimulator (&_satisfyInterestCallbackFired);
+  NS_TEST_EXPECT_MSG_EQ (_satisfyInterestCallbackConnections->size (), 2, "wrong number of connections");
+  NS_TEST_EXPECT_MSG_EQ (pit->CountEntries (), 0, "satisfied entry should be removed");
+}
+EndTest ()
+
+BeginTest (NoMatch)
+{
+  printf ("TestCCNxStandardHashPitNoMatch DoRun\n");
+
+  Ptr<CCNxStandardHashPit> pit = CreatePit ();
+
+  Ptr<const CCNxName> name1 = Create<CCNxName> ("ccnx:/name=apple/name=pie");
+  Ptr<const CCNxName> name2 = Create<CCNxName> ("ccnx:/name=apple/name=pie/name=slice");
+  Ptr<CCNxVirtualConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection2 = Create<CCNxVirtualConnection> ();
+
+  pit->ReceiveInterest (Create<CCNxForwarderMessage> (InterestPacket (name1), connection1));
+  StepSimulator (&_receiveInterestCallbackFired);
+
+  pit->SatisfyInterest (Create<CCNxForwarderMessage> (ContentPacket (name2), connection2));
+  StepSimulator (&_satisfyInterestCallbackFired);
+  NS_TEST_EXPECT_MSG_EQ (_satisfyInterestCallbackConnections->size (), 0, "should not match a longer name");
+  NS_TEST_EXPECT_MSG_EQ (pit->CountEntries (), 1, "unsatisfied entry should remain");
+}
+EndTest ()
+
+BeginTest (ManyEntries)
+{
+  printf ("TestCCNxStandardHashPitManyEntries DoRun\n");
+
+  // Start with a tiny table so the test exercises resizing
+  Ptr<CCNxStandardHashPit> pit = CreatePit ();
+  Ptr<CCNxVirtualConnection> ingress = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> egress = Create<CCNxVirtualConnection> ();
+
+  const int count = 200;
+  for (int i = 0; i < count; ++i)
+    {
+      std::ostringstream uri;
+      uri << "ccnx:/name=apple/chunk=" << i;
+      pit->ReceiveInterest (Create<CCNxForwarderMessage> (InterestPacket (Create<CCNxName> (uri.str ())), ingress));
+      StepSimulator (&_receiveInterestCallbackFired);
+    }
+  NS_TEST_EXPECT_MSG_EQ (pit->CountEntries (), count, "wrong number of PIT entries");
+
+  for (int i = 0; i < count; i += 2)
+    {
+      std::ostringstream uri;
+      uri << "ccnx:/name=apple/chunk=" << i;
+      pit->SatisfyInterest (Create<CCNxForwarderMessage> (ContentPacket (Create<CCNxName> (uri.str ())), egress));
+      StepSimulator (&_satisfyInterestCallbackFired);
+      NS_TEST_EXPECT_MSG_EQ (_satisfyInterestCallbackConnections->size (), 1, "content " << i << " should match");
+    }
+  NS_TEST_EXPECT_MSG_EQ (pit->CountEntries (), count / 2, "wrong number of PIT entries");
+
+  pit->Print (std::cout);
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxStandardHashPit
+ */
+static class TestSuiteCCNxStandardHashPit : public TestSuite
+{
+public:
+  TestSuiteCCNxStandardHashPit () : TestSuite ("ccnx-standard-hash-pit", UNIT)
+  {
+    AddTestCase (new AggregateAndSatisfy (), TestCase::QUICK);
+    AddTestCase (new NoMatch (), TestCase::QUICK);
+    AddTestCase (new ManyEntries (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxStandardHashPit;
+
+} // namespace TestSuiteCCNxStandardHashPit
@@ -59,6 +59,7 @@
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/ccnx-interestlifetime.h"
+#include "ns3/ccnx-hasher-fnv1a.h"
 #include "../../TestMacros.h"
 
 using namespace ns3;
@@ -675,6 +676,66 @@ BeginTest (b6)
 }
 EndTest ()
 
+/**
+ * An FNV-1a hasher that counts the messages it hashes from a packet buffer
+ */
+class CountingHasher : public CCNxHasherFnv1a
+{
+public:
+  CountingHasher () : m_messages (0)
+  {
+  }
+
+  using CCNxHasherFnv1a::Update;
+
+  virtual size_t Update (Buffer::Iterator start)
+  {
+    m_messages++;
+    return CCNxHasherFnv1a::Update (start);
+  }
+
+  unsigned m_messages;
+};
+
+BeginTest (HashOnlyWhenRestricted)
+{
+  //a received Content Object is only hashed if there is a hash restricted PIT entry
+
+  printf ("TestCCNxStandardPitHashOnlyWhenRestricted DoRun\n");
+
+  Ptr<CountingHasher> hasher = CreateObject<CountingHasher> ();
+  CCNxPacket::SetContentObjectHasher (hasher);
+
+  Ptr<CCNxStandardPit> pit = CreatePit ();
+
+  Ptr<CCNxName> name1 = Create<CCNxName> ("ccnx:/name=hash/name=restricted");
+  Ptr<CCNxPacket> cPacket1 = CCNxPacket::CreateFromMessage (Create<CCNxContentObject> (name1));
+  Ptr<Packet> encoded = cPacket1->CreateNs3Packet ();
+  Ptr<CCNxHashValue> hash = cPacket1->GetContentObjectHash ();
+  unsigned producerHashes = hasher->m_messages;
+  Ptr<CCNxVirtualConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection2 = Create<CCNxVirtualConnection> ();
+
+  pit->SatisfyInterest (Create<CCNxForwarderMessage> (CCNxPacket::CreateFromNs3Packet (encoded), connection2));
+  StepSimulatorSatisfyInterest ();
+  NS_TEST_EXPECT_MSG_EQ (_satisfyInterestCallbackConnections->size (), 0, "wrong number of connections!");
+  NS_TEST_EXPECT_MSG_EQ (hasher->m_messages, producerHashes, "Should not hash without hash restricted entries");
+
+  Ptr<CCNxHashValue> keyIdRest;
+  Ptr<CCNxInterest> interest1 = Create<CCNxInterest> (name1, Create<CCNxBuffer> (0), keyIdRest, hash);
+  pit->ReceiveInterest (Create<CCNxForwarderMessage> (CCNxPacket::CreateFromMessage (interest1), connection1));
+  StepSimulatorReceiveInterest ();
+
+  pit->SatisfyInterest (Create<CCNxForwarderMessage> (CCNxPacket::CreateFromNs3Packet (encoded), connection2));
+  StepSimulatorSatisfyInterest ();
+  NS_TEST_EXPECT_MSG_EQ (hasher->m_messages, producerHashes + 1, "Should hash once for the hash restricted entry");
+  NS_TEST_ASSERT_MSG_EQ (_satisfyInterestCallbackConnections->size (), 1, "wrong number of connections!");
+  NS_TEST_EXPECT_MSG_EQ (_satisfyInterestCallbackConnections->front (), connection1, "wrong connId!");
+
+  CCNxPacket::SetContentObjectHasher (CreateObject<CCNxHasherFnv1a> ());
+}
+EndTest ()
+
 BeginTest (InterestExpires)
 {
   //interest expires. with Perhopheader containing interestlifetime
@@ -759,6 +820,55 @@ BeginTest (PerhopheaderDoesntExpire)
 }
 EndTest ()
 
+static unsigned _expiredInterestCount;
+
+static void
+MockupExpiredInterestTrace (Ptr<const CCNxInterest> interest)
+{
+  _expiredInterestCount++;
+}
+
+BeginTest (ExpiredEntryReclaimed)
+{
+  //an unsatisfied interest is removed from the table at its expiry time without any further packets
+  //an interest refreshed before its expiry time stays in the table
+
+  printf ("TestCCNxStandardPitExpiredEntryReclaimed DoRun\n");
+
+  Ptr<CCNxStandardPit> pit = CreatePit ();
+  _expiredInterestCount = 0;
+  pit->TraceConnectWithoutContext ("ExpiredInterest", MakeCallback (&MockupExpiredInterestTrace));
+
+  Ptr<CCNxName> name1 = Create<CCNxName> ("ccnx:/name=trump/name=is");
+  Ptr<CCNxInterest> interest1 = Create<CCNxInterest> (name1);
+  Ptr<CCNxPacket> iPacket1 = CCNxPacket::CreateFromMessage (interest1);
+  iPacket1->AddPerHopHeaderEntry(Create<CCNxInterestLifetime> (Create<CCNxTime>(30)));
+
+  Ptr<CCNxVirtualConnection> connection1 = Create<CCNxVirtualConnection> ();
+
+  pit->ReceiveInterest (Create<CCNxForwarderMessage> (iPacket1, connection1));
+  StepSimulatorReceiveInterest ();
+  NS_TEST_EXPECT_MSG_EQ (pit->CountEntries (), 1, "wrong number of table entries!");
+
+  // refresh it before it expires
+  pit->ReceiveInterest (Create<CCNxForwarderMessage> (iPacket1, connection1));
+  StepSimulatorReceiveInterest ();
+
+  // past the first expiry time, but before the refreshed one
+  Simulator::Stop (MilliSeconds (15));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (pit->CountEntries (), 1, "refreshed entry should still be in the table");
+  NS_TEST_EXPECT_MSG_EQ (_expiredInterestCount, 0, "entry should not have expired yet");
+
+  Simulator::Stop (MilliSeconds (50));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (pit->CountEntries (), 0, "expired entry should have been reclaimed");
+  NS_TEST_EXPECT_MSG_EQ (_expiredInterestCount, 1, "wrong number of expired interests traced");
+
+  printf ("TestCCNxStandardPitExpiredEntryReclaimed End\n");
+}
+EndTest ()
+
 /**
  * \ingroup ccnx-test
  *
@@ -778,8 +888,10 @@ public:
     AddTestCase (new b4 (), TestCase::QUICK);
     AddTestCase (new b5 (), TestCase::QUICK);
     AddTestCase (new b6 (), TestCase::QUICK);
+    AddTestCase (new HashOnlyWhenRestricted (), TestCase::QUICK);
     AddTestCase (new InterestExpires(), TestCase::QUICK);
     AddTestCase (new PerhopheaderDoesntExpire(), TestCase::QUICK);
+    AddTestCase (new ExpiredEntryReclaimed(), TestCase::QUICK);
 
   }
 } g_TestSuiteCCNxStandardPit;
@@ -175,6 +175,26 @@ BeginTest (IsExpired_False)
 }
 EndTest ()
 
+/*
+ * The expiry time only moves forward
+ */
+BeginTest (GetExpiryTime_Extends)
+{
+  Ptr<CCNxStandardPitEntry> entry = Create<CCNxStandardPitEntry>();
+  TestData data = CreateTestData();
+
+  entry->ReceiveInterest(data.interest_Ingress2_Expiry2.interest,
+			 data.interest_Ingress2_Expiry2.ingress,
+			 data.interest_Ingress2_Expiry2.expiryTime);
+  NS_TEST_EXPECT_MSG_EQ(entry->GetExpiryTime(), data.interest_Ingress2_Expiry2.expiryTime, "Wrong expiry time");
+
+  entry->ReceiveInterest(data.interest_Ingress1_Expiry1.interest,
+			 data.interest_Ingress1_Expiry1.ingress,
+			 data.interest_Ingress1_Expiry1.expiryTime);
+  NS_TEST_EXPECT_MSG_EQ(entry->GetExpiryTime(), data.interest_Ingress2_Expiry2.expiryTime, "Expiry time should not shrink");
+}
+EndTest ()
+
 /*
  * The first interest should always be forwarded and the set size will be 1
  */
@@ -372,6 +392,7 @@ public:
     AddTestCase (new Size_NotEmptyExpired (), TestCase::QUICK);
     AddTestCase (new IsExpired_True (), TestCase::QUICK);
     AddTestCase (new IsExpired_False (), TestCase::QUICK);
+    AddTestCase (new GetExpiryTime_Extends (), TestCase::QUICK);
     AddTestCase (new ReceiveInterest_FirstInterest (), TestCase::QUICK);
     AddTestCase (new ReceiveInterest_SecondDifferentConnection (), TestCase::QUICK);
     AddTestCase (new ReceiveInterest_SecondSameConnection (), TestCase::QUICK);
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <sstream>
+
+#include "ns3/test.h"
+#include "ns3/ccnx-standard-slab-content-store.h"
+#include "ns3/ccnx-forwarder-message.h"
+#include "ns3/ccnx-standard-forwarder-work-item.h"
+#include "../../mockups/mockup_ccnx-virtual-connection.h"
+#include "ns3/integer.h"
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxStandardSlabContentStore {
+
+static Time _layerDelay = MilliSeconds (10);
+
+static Ptr<CCNxPacket> _matchInterestCallbackPacket;
+static bool _matchInterestCallbackFired;
+static bool _addContentObjectCallbackFired;
+static bool _addContentObjectCallbackAdded;
+
+static void
+MockupMatchInterestCallback (Ptr<CCNxForwarderMessage> message)
+{
+  Ptr<CCNxStandardForwarderWorkItem> workItem = DynamicCast<CCNxStandardForwarderWorkItem, CCNxForwarderMessage> (message);
+  _matchInterestCallbackPacket = workItem->GetContentStorePacket ();
+  _matchInterestCallbackFired = true;
+}
+
+static void
+MockupAddContentObjectCallback (Ptr<CCNxForwarderMessage> message)
+{
+  Ptr<CCNxStandardForwarderWorkItem> workItem = DynamicCast<CCNxStandardForwarderWorkItem, CCNxForwarderMessage> (message);
+  _addContentObjectCallbackAdded = workItem->GetContentAddedFlag ();
+  _addContentObjectCallbackFired = true;
+}
+
+static Ptr<CCNxStandardSlabContentStore>
+CreateContentStore (long long capacity)
+{
+  Ptr<CCNxStandardSlabContentStore> contentStore = CreateObject<CCNxStandardSlabContentStore> ();
+  contentStore->SetAttribute ("ObjectCapacity", IntegerValue (capacity));
+  contentStore->SetMatchInterestCallback (MakeCallback (&MockupMatchInterestCallback));
+  contentStore->SetAddContentObjectCallback (MakeCallback (&MockupAddContentObjectCallback));
+  contentStore->Initialize ();
+  return contentStore;
+}
+
+static Ptr<CCNxStandardForwarderWorkItem>
+CreateWorkItem (Ptr<CCNxPacket> packet)
+{
+  return Create<CCNxStandardForwarderWorkItem> (packet, Create<CCNxVirtualConnection> (), Ptr<CCNxConnection> (0));
+}
+
+static Ptr<CCNxPacket>
+CreateContent (const std::string &uri, uint64_t hash)
+{
+  Ptr<CCNxPacket> packet = CCNxPacket::CreateFromMessage (Create<CCNxContentObject> (Create<CCNxName> (uri)));
+  packet->SetContentObjectHash (Create<CCNxHashValue> (hash));
+  return packet;
+}
+
+static Ptr<CCNxPacket>
+CreateInterest (const std::string &uri, Ptr<CCNxHashValue> keyid, Ptr<CCNxHashValue> hash)
+{
+  Ptr<CCNxInterest> interest = Create<CCNxInterest> (Create<CCNxName> (uri), Create<CCNxBuffer> (0), keyid, hash);
+  return CCNxPacket::CreateFromMessage (interest);
+}
+
+static bool
+Add (Ptr<CCNxStandardSlabContentStore> cs, Ptr<CCNxPacket> cPacket)
+{
+  _addContentObjectCallbackFired = false;
+  cs->AddContentObject (CreateWorkItem (cPacket), Create<CCNxConnectionList> ());
+  Simulator::Stop (_layerDelay);
+  Simulator::Run ();
+  NS_ASSERT_MSG (_addContentObjectCallbackFired, "Did not get a call to AddContentObjectCallback");
+  return _addContentObjectCallbackAdded;
+}
+
+static Ptr<CCNxPacket>
+Match (Ptr<CCNxStandardSlabContentStore> cs, Ptr<CCNxPacket> iPacket)
+{
+  _matchInterestCallbackFired = false;
+  cs->MatchInterest (CreateWorkItem (iPacket));
+  Simulator::Stop (_layerDelay);
+  Simulator::Run ();
+  NS_ASSERT_MSG (_matchInterestCallbackFired, "Did not get a call to MatchInterestCallback");
+  return _matchInterestCallbackPacket;
+}
+
+static std::string
+Uri (unsigned i)
+{
+  std::ostringstream os;
+  os << "ccnx:/name=slab/name=" << i;
+  return os.str ();
+}
+
+BeginTest (MatchByName)
+{
+  Ptr<CCNxStandardSlabContentStore> cs = CreateContentStore (10);
+  Ptr<CCNxPacket> content = CreateContent ("ccnx:/name=a/name=b", 1);
+
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, content), true, "content should be added");
+  NS_TEST_EXPECT_MSG_EQ (Match (cs, CreateInterest ("ccnx:/name=a/name=b", 0, 0)), content, "wrong packet returned");
+  NS_TEST_EXPECT_MSG_EQ (Match (cs, CreateInterest ("ccnx:/name=a", 0, 0)), Ptr<CCNxPacket> (0), "prefix should not match");
+}
+EndTest ()
+
+BeginTest (MatchNullHash)
+{
+  Ptr<CCNxStandardSlabContentStore> cs = CreateContentStore (10);
+  Ptr<CCNxPacket> content = CreateContent ("ccnx:/name=a/name=b", 0);
+
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, content), true, "content should be added");
+  NS_TEST_EXPECT_MSG_EQ (Match (cs, CreateInterest ("ccnx:/name=a/name=b", 0, 0)), content, "wrong packet returned");
+  NS_TEST_EXPECT_MSG_EQ ((cs->FindEntry (content) != Ptr<CCNxStandardContentStoreEntry> (0)), true, "should find a name-only object");
+}
+EndTest ()
+
+BeginTest (MatchRestrictions)
+{
+  Ptr<CCNxStandardSlabContentStore> cs = CreateContentStore (10);
+  Ptr<CCNxPacket> content = CreateContent ("ccnx:/name=a/name=b", 2);
+  Add (cs, content);
+
+  NS_TEST_EXPECT_MSG_EQ (Match (cs, CreateInterest ("ccnx:/name=a/name=b", 0, Create<CCNxHashValue> (2))), content, "hash restriction should match");
+  NS_TEST_EXPECT_MSG_EQ (Match (cs, CreateInterest ("ccnx:/name=a/name=b", 0, Create<CCNxHashValue> (3))), Ptr<CCNxPacket> (0), "hash restriction should not match");
+  NS_TEST_EXPECT_MSG_EQ (Match (cs, CreateInterest ("ccnx:/name=a/name=b", Create<CCNxHashValue> (55), 0)), content, "keyid restriction should match (KEYIDHACK)");
+  NS_TEST_EXPECT_MSG_EQ (Match (cs, CreateInterest ("ccnx:/name=a/name=b", Create<CCNxHashValue> (56), 0)), Ptr<CCNxPacket> (0), "keyid restriction should not match");
+}
+EndTest ()
+
+BeginTest (AddTwice)
+{
+  Ptr<CCNxStandardSlabContentStore> cs = CreateContentStore (10);
+  Ptr<CCNxPacket> content = CreateContent ("ccnx:/name=a/name=b", 1);
+
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, content), true, "first add should succeed");
+  NS_TEST_EXPECT_MSG_EQ (Add (cs, content), false, "second add should be a duplicate");
+  NS_TEST_EXPECT_MSG_EQ (cs->GetObjectCount (), 1, "wrong object count");
+}
+EndTest ()
+
+BeginTest (EvictLru)
+{
+  Ptr<CCNxStandardSlabContentStore> cs = CreateContentStore (2);
+  Ptr<CCNxPacket> c1 = CreateContent (Uri (1), 1);
+  Ptr<CCNxPacket> c2 = CreateContent (Uri (2), 2);
+  Ptr<CCNxPacket> c3 = CreateContent (Uri (3), 3);
+
+  Add (cs, c1);
+  Add (cs, c2);
+  NS_TEST_EXPECT_MSG_EQ (cs->GetLruEntry ()->GetPacket (), c1, "c1 should be least recently used");
+
+  // using c1 makes c2 the LRU entry
+  Match (cs, CreateInterest (Uri (1), 0, 0));
+  NS_TEST_EXPECT_MSG_EQ (cs->GetLruEntry ()->GetPacket (), c2, "c2 should be least recently used");
+
+  Add (cs, c3);
+  NS_TEST_EXPECT_MSG_EQ (cs->GetObjectCount (), 2, "wrong object count");
+  NS_TEST_EXPECT_MSG_EQ (cs->FindEntry (c2), Ptr<CCNxStandardContentStoreEntry> (0), "c2 should have been evicted");
+  NS_TEST_EXPECT_MSG_EQ ((cs->FindEntry (c1) != Ptr<CCNxStandardContentStoreEntry> (0)), true, "c1 should still be stored");
+  NS_TEST_EXPECT_MSG_EQ ((cs->FindEntry (c3) != Ptr<CCNxStandardContentStoreEntry> (0)), true, "c3 should be stored");
+}
+EndTest ()
+
+BeginTest (SameNameNewHash)
+{
+  Ptr<CCNxStandardSlabContentStore> cs = CreateContentStore (10);
+  Ptr<CCNxPacket> older = CreateContent ("ccnx:/name=a/name=b", 1);
+  Ptr<CCNxPacket> newer = CreateContent ("ccnx:/name=a/name=b", 2);
+
+  Add (cs, older);
+  Add (cs, newer);
+  NS_TEST_EXPECT_MSG_EQ (Match (cs, CreateInterest ("ccnx:/name=a/name=b", 0, 0)), newer, "name should match the newer object");
+
+  NS_TEST_EXPECT_MSG_EQ (cs->DeleteContentObject (older), true, "could not delete the older object");
+  NS_TEST_EXPECT_MSG_EQ (Match (cs, CreateInterest ("ccnx:/name=a/name=b", 0, 0)), newer, "deleting the older object should keep the name");
+}
+EndTest ()
+
+BeginTest (ManyObjects)
+{
+  const unsigned count = 500;
+  Ptr<CCNxStandardSlabContentStore> cs = CreateContentStore (count);
+  std::vector< Ptr<CCNxPacket> > contents;
+  for (unsigned i = 0; i < count; ++i)
+    {
+      contents.push_back (CreateContent (Uri (i), i + 1));
+      Add (cs, contents.back ());
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (cs->GetObjectCount (), count, "wrong object count");
+  NS_TEST_EXPECT_MSG_EQ ((cs->GetIndexCapacity () >= 2 * count), true, "index should be at most half full");
+
+  for (unsigned i = 0; i < count; i += 2)
+    {
+      NS_TEST_EXPECT_MSG_EQ (cs->DeleteContentObject (contents[i]), true, "could not delete object " << i);
+    }
+
+  for (unsigned i = 0; i < count; ++i)
+    {
+      bool found = (cs->FindEntry (contents[i]) != Ptr<CCNxStandardContentStoreEntry> (0));
+      NS_TEST_EXPECT_MSG_EQ (found, (i % 2) == 1, "wrong lookup result for object " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (cs->GetObjectCount (), count / 2, "wrong object count");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxStandardSlabContentStore
+ */
+static class TestSuiteCCNxStandardSlabContentStore : public TestSuite
+{
+public:
+  TestSuiteCCNxStandardSlabContentStore () : TestSuite ("ccnx-standard-slab-content-store", UNIT)
+  {
+    AddTestCase (new MatchByName (), TestCase::QUICK);
+    AddTestCase (new MatchNullHash (), TestCase::QUICK);
+    AddTestCase (new MatchRestrictions (), TestCase::QUICK);
+    AddTestCase (new AddTwice (), TestCase::QUICK);
+    AddTestCase (new EvictLru (), TestCase::QUICK);
+    AddTestCase (new SameNameNewHash (), TestCase::QUICK);
+    AddTestCase (new ManyObjects (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxStandardSlabContentStore;
+
+} // namespace TestSuiteCCNxStandardSlabContentStore
@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "../../mockups/mockup_ccnx-virtual-connection.h"
+#include "ns3/test.h"
+#include "ns3/ccnx-standard-trie-fib.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/ccnx-forwarder-message.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxStandardTrieFib {
+
+static Time _layerDelay = MicroSeconds (10);
+
+static Ptr<CCNxConnectionList> _lookupCallbackConnections;
+static bool _lookupCallbackFired;
+
+static void
+MockupLookupCallback (Ptr<CCNxForwarderMessage> message, Ptr<CCNxConnectionList> egress)
+{
+  _lookupCallbackConnections = egress;
+  _lookupCallbackFired = true;
+}
+
+static void
+StepSimulator ()
+{
+  unsigned tries = 0;
+  _lookupCallbackFired = false;
+  while (!_lookupCallbackFired && tries < 4)
+    {
+      Simulator::Stop (_layerDelay);
+      Simulator::Run ();
+      tries++;
+    }
+
+  NS_ASSERT_MSG (_lookupCallbackFired, "Did not get a call to LookupCallback");
+}
+
+static Ptr<CCNxStandardTrieFib>
+CreateFib ()
+{
+  Ptr<CCNxStandardTrieFib> fib = CreateObject<CCNxStandardTrieFib> ();
+  fib->SetLookupCallback (MakeCallback (&MockupLookupCallback));
+  fib->Initialize ();
+  return fib;
+}
+
+static Ptr<CCNxStandardForwarderWorkItem>
+CreateWorkItem (Ptr<const CCNxName> name, Ptr<CCNxConnection> ingress)
+{
+  Ptr<CCNxPacket> packet = CCNxPacket::CreateFromMessage (CreateObject<CCNxInterest> (name));
+  return Create<CCNxStandardForwarderWorkItem> (packet, ingress, Ptr<CCNxConnection> (0));
+}
+
+BeginTest (Lookup)
+{
+  printf ("TestCCNxStandardTrieFibLookup DoRun\n");
+
+  Ptr<CCNxStandardTrieFib> fib = CreateFib ();
+
+  Ptr<const CCNxName> name1 = Create<CCNxName> ("ccnx:/name=apple/name=pie");
+  Ptr<const CCNxName> name1l = Create<CCNxName> ("ccnx:/name=apple/name=pie/name=with/name=cream");
+  Ptr<const CCNxName> name2 = Create<CCNxName> ("ccnx:/name=cherry");
+  Ptr<const CCNxName> name3 = Create<CCNxName> ("ccnx:/name=apple");
+  Ptr<CCNxConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxConnection> connection2 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxConnection> connection3 = Create<CCNxVirtualConnection> ();
+
+  fib->AddRoute (name1, connection1);
+  fib->AddRoute (name2, connection2);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 2, "wrong number of fib entries");
+
+  fib->Lookup (CreateWorkItem (name1, connection3));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), connection1, "exact match returned wrong connection");
+
+  fib->Lookup (CreateWorkItem (name1l, connection3));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), connection1, "prefix match returned wrong connection");
+
+  fib->Lookup (CreateWorkItem (name2, connection2));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->size (), 0, "ingress connection should be excluded");
+
+  // name3 is an interior node of the trie, but not a route
+  fib->Lookup (CreateWorkItem (name3, connection3));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->size (), 0, "interior trie node should not match");
+}
+EndTest ()
+
+BeginTest (LookupBestMatch)
+{
+  printf ("TestCCNxStandardTrieFibLookupBestMatch DoRun\n");
+
+  Ptr<CCNxStandardTrieFib> fib = CreateFib ();
+
+  Ptr<CCNxVirtualConnection> nextHop0 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> nextHop1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> nextHop2 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> nextHop3 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> ingress = Create<CCNxVirtualConnection> ();
+
+  Ptr<const CCNxName>  name0 = Create<CCNxName> ("ccnx:/name=aaaa/name=bbbb");
+  Ptr<const CCNxName>  name1 = Create<CCNxName> ("ccnx:/name=aaab/name=bbbb/name=cccc/name=dddd");
+  Ptr<const CCNxName>  name2 = Create<CCNxName> ("ccnx:/name=aaab/name=bbbb/name=eeee");
+  Ptr<const CCNxName>  name3 = Create<CCNxName> ("ccnx:/name=aaab/name=bbbb/name=eeee/name=ffff");
+  Ptr<const CCNxName>  name4 = Create<CCNxName> ("ccnx:/name=aaab/name=bbbb/name=eeee/name=fffg"); //should match name2
+  Ptr<const CCNxName>  name5 = Create<CCNxName> ("ccnx:/name=aaaa/name=bbbb/name=cccc/name=zzzz");//should match name0
+  Ptr<const CCNxName>  name6 = Create<CCNxName> ("ccnx:/name=aaab/name=bbbb/name=eeee/name=ffff/name=gggg"); //should match name3
+  Ptr<const CCNxName>  name7 = Create<CCNxName> ("ccnx:/name=aaaa/ver=bbbb"); //different segment type, no match
+
+  fib->AddRoute (name0, nextHop0);
+  fib->AddRoute (name1, nextHop1);
+  fib->AddRoute (name2, nextHop2);
+  fib->AddRoute (name3, nextHop3);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 4, "wrong number of fib entries");
+
+  fib->PrintRoutes (std::cout);
+
+  fib->Lookup (CreateWorkItem (name4, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), nextHop2, "lookup did not return correct connection");
+
+  fib->Lookup (CreateWorkItem (name5, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), nextHop0, "lookup did not return correct connection");
+
+  fib->Lookup (CreateWorkItem (name6, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), nextHop3, "lookup did not return correct connection");
+
+  fib->Lookup (CreateWorkItem (name7, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->size (), 0, "segment type must be part of the match");
+}
+EndTest ()
+
+BeginTest (DeleteRoute)
+{
+  printf ("TestCCNxStandardTrieFibDeleteRoute DoRun\n");
+
+  Ptr<CCNxStandardTrieFib> fib = CreateFib ();
+
+  Ptr<const CCNxName> shortName = Create<CCNxName> ("ccnx:/name=a");
+  Ptr<const CCNxName> longName = Create<CCNxName> ("ccnx:/name=a/name=b/name=c");
+  Ptr<const CCNxName> lookupName = Create<CCNxName> ("ccnx:/name=a/name=b/name=c/name=d");
+  Ptr<CCNxVirtualConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection2 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> ingress = Create<CCNxVirtualConnection> ();
+
+  fib->AddRoute (shortName, connection1);
+  fib->AddRoute (longName, connection2);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 2, "wrong number of fib entries");
+
+  bool ok = fib->DeleteRoute (longName, connection1);
+  NS_TEST_EXPECT_MSG_EQ (ok, false, "deleting a non-matching connection should fail");
+
+  ok = fib->DeleteRoute (Create<CCNxName> ("ccnx:/name=a/name=b"), connection2);
+  NS_TEST_EXPECT_MSG_EQ (ok, false, "deleting an interior node should fail");
+
+  ok = fib->DeleteRoute (longName, connection2);
+  NS_TEST_EXPECT_MSG_EQ (ok, true, "deleting an existing route should succeed");
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 1, "wrong number of fib entries");
+
+  fib->Lookup (CreateWorkItem (lookupName, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), connection1, "should fall back to the shorter prefix");
+
+  ok = fib->DeleteRoute (shortName, connection1);
+  NS_TEST_EXPECT_MSG_EQ (ok, true, "deleting an existing route should succeed");
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 0, "wrong number of fib entries");
+
+  fib->Lookup (CreateWorkItem (lookupName, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->size (), 0, "empty fib should not match");
+}
+EndTest ()
+
+BeginTest (RemoveConnection)
+{
+  printf ("TestCCNxStandardTrieFibRemoveConnection DoRun\n");
+
+  Ptr<CCNxStandardTrieFib> fib = CreateFib ();
+
+  Ptr<const CCNxName> name1 = Create<CCNxName> ("ccnx:/name=apple");
+  Ptr<const CCNxName> name2 = Create<CCNxName> ("ccnx:/name=apple/name=pie");
+  Ptr<const CCNxName> name2l = Create<CCNxName> ("ccnx:/name=apple/name=pie/name=slice");
+  Ptr<CCNxVirtualConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection2 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection3 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> ingress = Create<CCNxVirtualConnection> ();
+
+  fib->AddRoute (name1, connection1);
+  fib->AddRoute (name1, connection3);
+  fib->AddRoute (name2, connection1);
+  fib->AddRoute (name2, connection2);
+
+  fib->RemoveConnection (connection1);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 2, "wrong number of fib entries");
+
+  fib->Lookup (CreateWorkItem (name2l, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->size (), 1, "wrong number of connections");
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), connection2, "lookup did not return correct connection");
+
+  fib->RemoveConnection (connection2);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 1, "wrong number of fib entries");
+
+  fib->Lookup (CreateWorkItem (name2l, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), connection3, "lookup did not return correct connection");
+}
+EndTest ()
+
+BeginTest (ConnectionIndex)
+{
+  printf ("TestCCNxStandardTrieFibConnectionIndex DoRun\n");
+
+  Ptr<CCNxStandardTrieFib> fib = CreateFib ();
+
+  Ptr<const CCNxName> name1 = Create<CCNxName> ("ccnx:/name=apple");
+  Ptr<const CCNxName> name2 = Create<CCNxName> ("ccnx:/name=apple/name=pie");
+  Ptr<const CCNxName> name3 = Create<CCNxName> ("ccnx:/name=banana");
+  Ptr<CCNxVirtualConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection2 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> ingress = Create<CCNxVirtualConnection> ();
+
+  fib->AddRoute (name1, connection1);
+  fib->AddRoute (name2, connection1);
+  fib->AddRoute (name3, connection1);
+  fib->AddRoute (name3, connection2);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountConnectionEntries (connection1), 3, "wrong index size for connection1");
+  NS_TEST_EXPECT_MSG_EQ (fib->CountConnectionEntries (connection2), 1, "wrong index size for connection2");
+
+  fib->DeleteRoute (name1, connection1);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountConnectionEntries (connection1), 2, "DeleteRoute did not update the index");
+
+  fib->RemoveConnection (connection1);
+  NS_TEST_EXPECT_MSG_EQ (fib->CountConnectionEntries (connection1), 0, "RemoveConnection did not clear the index");
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 1, "wrong number of fib entries");
+
+  fib->Lookup (CreateWorkItem (name3, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), connection2, "lookup did not return correct connection");
+}
+EndTest ()
+
+BeginTest (BestRouteStrategy)
+{
+  printf ("TestCCNxStandardTrieFibBestRouteStrategy DoRun\n");
+
+  Ptr<CCNxStandardTrieFib> fib = CreateFib ();
+  fib->SetForwardingStrategy (CCNxStandardForwardingStrategy::BestRoute);
+
+  Ptr<const CCNxName> name1 = Create<CCNxName> ("ccnx:/name=apple");
+  Ptr<const CCNxName> name1l = Create<CCNxName> ("ccnx:/name=apple/name=pie");
+  Ptr<CCNxVirtualConnection> connection1 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> connection2 = Create<CCNxVirtualConnection> ();
+  Ptr<CCNxVirtualConnection> ingress = Create<CCNxVirtualConnection> ();
+
+  fib->AddRoute (name1, connection1, 20);
+  fib->AddRoute (name1, connection2, 10);
+
+  fib->Lookup (CreateWorkItem (name1l, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->size (), 1, "BestRoute should forward on one connection");
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), connection2, "lookup did not return the lowest cost connection");
+
+  // re-adding a route updates its cost
+  fib->AddRoute (name1, connection1, 5);
+  fib->Lookup (CreateWorkItem (name1l, ingress));
+  StepSimulator ();
+  NS_TEST_EXPECT_MSG_EQ (_lookupCallbackConnections->front (), connection1, "lookup did not use the updated cost");
+  NS_TEST_EXPECT_MSG_EQ (fib->CountEntries (), 1, "wrong number of fib entries");
+}
+EndTest ()
+
+/**
+ * \ingroup ccnx-test
+ *
+ * \brief Test Suite for CCNxStandardTrieFib
+ */
+static class TestSuiteCCNxStandardTrieFib : public TestSuite
+{
+public:
+  TestSuiteCCNxStandardTrieFib () : TestSuite ("ccnx-standard-trie-fib", UNIT)
+  {
+    AddTestCase (new Lookup (), TestCase::QUICK);
+    AddTestCase (new LookupBestMatch (), TestCase::QUICK);
+    AddTestCase (new DeleteRoute (), TestCase::QUICK);
+    AddTestCase (new RemoveConnection (), TestCase::QUICK);
+    AddTestCase (new ConnectionIndex (), TestCase::QUICK);
+    AddTestCase (new BestRouteStrategy (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxStandardTrieFib;
+
+} // namespace TestSuiteCCNxStandardTrieFib
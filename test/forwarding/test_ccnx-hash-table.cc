@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <map>
+#include <string>
+#include <sstream>
+
+#include "ns3/test.h"
+#include "../TestMacros.h"
+#include "ns3/ccnx-hash-table.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxHashTable {
+
+struct StringEqual
+{
+  bool operator() (const std::string &a, const std::string &b) const
+  {
+    return a == b;
+  }
+};
+
+typedef CCNxHashTable<std::string, int, StringEqual> TableType;
+
+/*
+ * A deliberately weak digest so many keys collide and the full key compare is exercised.
+ */
+static uint64_t
+WeakDigest (int i)
+{
+  return i % 7;
+}
+
+static std::string
+Key (int i)
+{
+  std::ostringstream os;
+  os << "key" << i;
+  return os.str ();
+}
+
+BeginTest (InsertFindErase)
+{
+  TableType table (4);
+
+  NS_TEST_EXPECT_MSG_EQ (table.size (), 0, "new table should be empty");
+  NS_TEST_EXPECT_MSG_EQ ((table.Find (WeakDigest (1), Key (1)) == 0), true, "empty table should not find anything");
+
+  table.Insert (WeakDigest (1), Key (1), 10);
+  table.Insert (WeakDigest (8), Key (8), 80);   // same digest as key 1
+  NS_TEST_EXPECT_MSG_EQ (table.size (), 2, "wrong size");
+
+  int *value = table.Find (WeakDigest (8), Key (8));
+  NS_TEST_EXPECT_MSG_EQ ((value != 0), true, "did not find key 8");
+  NS_TEST_EXPECT_MSG_EQ (*value, 80, "wrong value for key 8");
+
+  table.Insert (WeakDigest (8), Key (8), 81);
+  NS_TEST_EXPECT_MSG_EQ (table.size (), 2, "replacing a value should not change the size");
+  NS_TEST_EXPECT_MSG_EQ (*table.Find (WeakDigest (8), Key (8)), 81, "value not replaced");
+
+  NS_TEST_EXPECT_MSG_EQ (table.Erase (WeakDigest (1), Key (1)), true, "erase should find key 1");
+  NS_TEST_EXPECT_MSG_EQ (table.Erase (WeakDigest (1), Key (1)), false, "key 1 already erased");
+
+  // key 8 was probed past key 1's slot, it must still be reachable across the tombstone
+  NS_TEST_EXPECT_MSG_EQ ((table.Find (WeakDigest (8), Key (8)) != 0), true, "lost key 8 after erase");
+  NS_TEST_EXPECT_MSG_EQ (table.size (), 1, "wrong size");
+}
+EndTest ()
+
+/*
+ * Matches a stored key against a key number, so Find does not need to build the key string.
+ */
+struct KeyNumberEqual
+{
+  bool operator() (const std::string &a, int i) const
+  {
+    return a == Key (i);
+  }
+};
+
+BeginTest (FindByQuery)
+{
+  TableType table (4);
+  table.Insert (WeakDigest (1), Key (1), 10);
+  table.Insert (WeakDigest (8), Key (8), 80);   // same digest as key 1
+
+  int *value = table.Find (WeakDigest (8), 8, KeyNumberEqual ());
+  NS_TEST_EXPECT_MSG_EQ ((value != 0), true, "did not find key 8");
+  NS_TEST_EXPECT_MSG_EQ (*value, 80, "wrong value for key 8");
+  NS_TEST_EXPECT_MSG_EQ ((table.Find (WeakDigest (15), 15, KeyNumberEqual ()) == 0), true, "should not find key 15");
+}
+EndTest ()
+
+BeginTest (CompareToMap)
+{
+  TableType table;
+  std::map<std::string, int> truth;
+
+  for (int round = 0; round < 20000; ++round)
+    {
+      int i = (round * 7919) % 1000;
+      switch (round % 3)
+        {
+        case 0:
+          table.Insert (WeakDigest (i), Key (i), round);
+          truth[Key (i)] = round;
+          break;
+        case 1:
+          {
+            bool erased = table.Erase (WeakDigest (i), Key (i));
+            bool truthErased = truth.erase (Key (i)) > 0;
+            NS_TEST_ASSERT_MSG_EQ (erased, truthErased, "Erase mismatch round " << round);
+            break;
+          }
+        default:
+          {
+            int *value = table.Find (WeakDigest (i), Key (i));
+            std::map<std::string, int>::iterator it = truth.find (Key (i));
+            NS_TEST_ASSERT_MSG_EQ ((value != 0), (it != truth.end ()), "Find mismatch round " << round);
+            if (value)
+              {
+                NS_TEST_ASSERT_MSG_EQ (*value, it->second, "Value mismatch round " << round);
+              }
+            break;
+          }
+        }
+      NS_TEST_ASSERT_MSG_EQ (table.size (), truth.size (), "Size mismatch round " << round);
+    }
+
+  size_t walked = 0;
+  for (size_t slot = 0; slot < table.capacity (); ++slot)
+    {
+      if (table.IsOccupied (slot))
+        {
+          walked++;
+          NS_TEST_EXPECT_MSG_EQ (truth[table.GetKey (slot)], table.GetValue (slot), "Walk value mismatch");
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (walked, truth.size (), "Walk count mismatch");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxHashTable
+ */
+static class TestSuiteCCNxHashTable : public TestSuite
+{
+public:
+  TestSuiteCCNxHashTable () : TestSuite ("ccnx-hash-table", UNIT)
+  {
+    AddTestCase (new InsertFindErase (), TestCase::QUICK);
+    AddTestCase (new FindByQuery (), TestCase::QUICK);
+    AddTestCase (new CompareToMap (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxHashTable;
+
+} // namespace TestSuiteCCNxHashTable
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include "ns3/test.h"
+#include "../TestMacros.h"
+#include "ns3/ccnx-pool-allocator.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxPoolAllocator {
+
+class Pooled : public CCNxPoolAllocated
+{
+public:
+  virtual ~Pooled ()
+  {
+  }
+  uint32_t m_a;
+};
+
+class PooledDerived : public Pooled
+{
+public:
+  uint8_t m_b[100];
+};
+
+/**
+ * A pooled object allocated before `main` and freed at exit, like the file-scope
+ * `Ptr`s some of the model keeps.
+ */
+class StaticPooled
+{
+public:
+  StaticPooled () : m_pooled (new Pooled ())
+  {
+  }
+  ~StaticPooled ()
+  {
+    delete m_pooled;
+  }
+  Pooled *m_pooled;
+};
+
+static StaticPooled g_staticPooled;
+
+BeginTest (AllocateReuse)
+{
+  CCNxPoolAllocator::Stats before = CCNxPoolAllocator::GetStats ();
+
+  void *a = CCNxPoolAllocator::Allocate (40);
+  void *b = CCNxPoolAllocator::Allocate (48);
+  NS_TEST_EXPECT_MSG_EQ ((a != b), true, "two live blocks must differ");
+
+  CCNxPoolAllocator::Deallocate (a, 40);
+  void *c = CCNxPoolAllocator::Allocate (33);
+  NS_TEST_EXPECT_MSG_EQ ((c == a), true, "same size class should reuse the freed block");
+
+  CCNxPoolAllocator::Deallocate (b, 48);
+  CCNxPoolAllocator::Deallocate (c, 33);
+
+  CCNxPoolAllocator::Stats after = CCNxPoolAllocator::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.outstanding, before.outstanding, "blocks leaked");
+  NS_TEST_EXPECT_MSG_EQ (after.allocations - before.allocations, 3, "wrong allocation count");
+}
+EndTest ()
+
+BeginTest (LargeGoesToHeap)
+{
+  CCNxPoolAllocator::Stats before = CCNxPoolAllocator::GetStats ();
+  void *p = CCNxPoolAllocator::Allocate (CCNxPoolAllocator::MaxPooledSize + 1);
+  CCNxPoolAllocator::Stats after = CCNxPoolAllocator::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.heapAllocations - before.heapAllocations, 1, "large block should use the heap");
+  NS_TEST_EXPECT_MSG_EQ (after.outstanding, before.outstanding, "large block should not be pooled");
+  CCNxPoolAllocator::Deallocate (p, CCNxPoolAllocator::MaxPooledSize + 1);
+}
+EndTest ()
+
+BeginTest (DeleteThroughBase)
+{
+  CCNxPoolAllocator::Stats before = CCNxPoolAllocator::GetStats ();
+
+  Pooled *p = new PooledDerived ();
+  p->m_a = 7;
+  CCNxPoolAllocator::Stats during = CCNxPoolAllocator::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (during.outstanding - before.outstanding, 1, "object should come from the pool");
+
+  delete p;
+  CCNxPoolAllocator::Stats after = CCNxPoolAllocator::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.outstanding, before.outstanding, "delete through base should return the block");
+
+  // the block went back on the size class of PooledDerived, not Pooled
+  void *q = CCNxPoolAllocator::Allocate (sizeof(PooledDerived));
+  NS_TEST_EXPECT_MSG_EQ ((q == p), true, "block returned to the wrong size class");
+  CCNxPoolAllocator::Deallocate (q, sizeof(PooledDerived));
+}
+EndTest ()
+
+BeginTest (ToggleWithLiveObjects)
+{
+  NS_TEST_EXPECT_MSG_EQ ((g_staticPooled.m_pooled != 0), true, "static object missing");
+  CCNxPoolAllocator::Stats before = CCNxPoolAllocator::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ ((before.outstanding > 0), true, "static object should be pooled");
+
+  Pooled *pooled = new Pooled ();
+
+  // turning the pool off with live pooled blocks (including the static one) is allowed
+  CCNxPoolAllocator::SetEnabled (false);
+  Pooled *heap = new Pooled ();
+  CCNxPoolAllocator::Stats disabled = CCNxPoolAllocator::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (disabled.outstanding - before.outstanding, 1, "disabled allocation should use the heap");
+  NS_TEST_EXPECT_MSG_EQ (disabled.heapAllocations - before.heapAllocations, 1, "wrong heap allocation count");
+
+  // a pooled block freed while disabled still goes back on its free list
+  delete pooled;
+  NS_TEST_EXPECT_MSG_EQ (CCNxPoolAllocator::GetStats ().outstanding, before.outstanding, "pooled block not returned");
+
+  // a heap block freed while enabled still goes back to the heap
+  CCNxPoolAllocator::SetEnabled (true);
+  delete heap;
+  NS_TEST_EXPECT_MSG_EQ (CCNxPoolAllocator::GetStats ().outstanding, before.outstanding, "heap block put on a free list");
+
+  Pooled *again = new Pooled ();
+  NS_TEST_EXPECT_MSG_EQ ((again == pooled), true, "block freed while disabled was not reused");
+  delete again;
+
+  NS_TEST_EXPECT_MSG_EQ (CCNxPoolAllocator::IsEnabled (), true, "pool should be left enabled");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxPoolAllocator
+ */
+static class TestSuiteCCNxPoolAllocator : public TestSuite
+{
+public:
+  TestSuiteCCNxPoolAllocator () : TestSuite ("ccnx-pool-allocator", UNIT)
+  {
+    AddTestCase (new AllocateReuse (), TestCase::QUICK);
+    AddTestCase (new LargeGoesToHeap (), TestCase::QUICK);
+    AddTestCase (new DeleteThroughBase (), TestCase::QUICK);
+    AddTestCase (new ToggleWithLiveObjects (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxPoolAllocator;
+
+} // namespace TestSuiteCCNxPoolAllocator
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "../TestMacros.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/ccnx-small-vector.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxSmallVector {
+
+typedef CCNxSmallVector<int, 4> VectorType;
+
+BeginTest (InlineAndGrow)
+{
+  VectorType v;
+  NS_TEST_EXPECT_MSG_EQ (v.empty (), true, "new vector should be empty");
+  NS_TEST_EXPECT_MSG_EQ (v.capacity (), 4, "wrong inline capacity");
+
+  for (int i = 0; i < 10; ++i)
+    {
+      v.push_back (i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (v.size (), 10, "wrong size");
+  NS_TEST_EXPECT_MSG_EQ ((v.capacity () >= 10), true, "did not grow");
+  for (int i = 0; i < 10; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (v[i], i, "wrong value at " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (v.front (), 0, "wrong front");
+  NS_TEST_EXPECT_MSG_EQ (v.back (), 9, "wrong back");
+
+  v.pop_back ();
+  NS_TEST_EXPECT_MSG_EQ (v.back (), 8, "wrong back after pop_back");
+
+  VectorType copy (v);
+  v.clear ();
+  NS_TEST_EXPECT_MSG_EQ (v.size (), 0, "clear did not empty");
+  NS_TEST_EXPECT_MSG_EQ (copy.size (), 9, "copy changed by clear of original");
+  NS_TEST_EXPECT_MSG_EQ (copy[8], 8, "wrong value in copy");
+}
+EndTest ()
+
+BeginTest (EraseFind)
+{
+  VectorType v;
+  for (int i = 0; i < 6; ++i)
+    {
+      v.push_back (i * 10);
+    }
+
+  VectorType::iterator i = v.find (30);
+  NS_TEST_EXPECT_MSG_EQ ((i != v.end ()), true, "did not find 30");
+  i = v.erase (i);
+  NS_TEST_EXPECT_MSG_EQ (*i, 40, "erase should return the next element");
+  NS_TEST_EXPECT_MSG_EQ (v.size (), 5, "wrong size after erase");
+  NS_TEST_EXPECT_MSG_EQ ((v.find (30) == v.end ()), true, "30 still present");
+
+  int expected[] = { 0, 10, 20, 40, 50 };
+  for (size_t j = 0; j < v.size (); ++j)
+    {
+      NS_TEST_EXPECT_MSG_EQ (v[j], expected[j], "erase did not keep order at " << j);
+    }
+}
+EndTest ()
+
+class Counted : public SimpleRefCount<Counted>
+{
+public:
+  Counted ()
+  {
+    s_live++;
+  }
+  ~Counted ()
+  {
+    s_live--;
+  }
+  static int s_live;
+};
+
+int Counted::s_live = 0;
+
+BeginTest (ReleasesElements)
+{
+  {
+    CCNxSmallVector<Ptr<Counted>, 2> v;
+    for (int i = 0; i < 5; ++i)
+      {
+        v.push_back (Create<Counted> ());
+      }
+    NS_TEST_EXPECT_MSG_EQ (Counted::s_live, 5, "wrong live count");
+    v.erase (v.begin ());
+    NS_TEST_EXPECT_MSG_EQ (Counted::s_live, 4, "erase did not release");
+  }
+  NS_TEST_EXPECT_MSG_EQ (Counted::s_live, 0, "destructor did not release");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxSmallVector
+ */
+static class TestSuiteCCNxSmallVector : public TestSuite
+{
+public:
+  TestSuiteCCNxSmallVector () : TestSuite ("ccnx-small-vector", UNIT)
+  {
+    AddTestCase (new InlineAndGrow (), TestCase::QUICK);
+    AddTestCase (new EraseFind (), TestCase::QUICK);
+    AddTestCase (new ReleasesElements (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxSmallVector;
+
+} // namespace TestSuiteCCNxSmallVector
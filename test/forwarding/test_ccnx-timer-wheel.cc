@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "../TestMacros.h"
+#include "ns3/ccnx-timer-wheel.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxTimerWheel {
+
+struct MockItem
+{
+  Time deadline;
+  unsigned id;
+};
+
+typedef CCNxTimerWheel<MockItem> WheelType;
+
+static std::vector<MockItem> _fired;
+static std::vector<Time> _firedAt;
+
+static void
+MockExpire (MockItem item)
+{
+  _fired.push_back (item);
+  _firedAt.push_back (Simulator::Now ());
+}
+
+BeginTest (FiresInOrder)
+{
+  _fired.clear ();
+  _firedAt.clear ();
+
+  Ptr<WheelType> wheel = Create<WheelType> (MilliSeconds (1), MakeCallback (&MockExpire));
+
+  // deadlines on every level of the wheel
+  Time deadlines[] = { MilliSeconds (5), MicroSeconds (2500), Seconds (3), MilliSeconds (70), Seconds (300) };
+  unsigned count = sizeof (deadlines) / sizeof (deadlines[0]);
+  for (unsigned i = 0; i < count; ++i)
+    {
+      MockItem item = { deadlines[i], i };
+      wheel->Schedule (deadlines[i], item);
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (wheel->size (), count, "wrong size");
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (_fired.size (), count, "wrong number of items fired");
+  NS_TEST_EXPECT_MSG_EQ (wheel->size (), 0, "wheel should be empty");
+  for (unsigned i = 0; i < _fired.size (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((_firedAt[i] >= _fired[i].deadline), true, "item " << _fired[i].id << " fired early");
+      NS_TEST_EXPECT_MSG_EQ ((_firedAt[i] < _fired[i].deadline + MilliSeconds (1)), true, "item " << _fired[i].id << " fired late");
+      if (i > 0)
+        {
+          NS_TEST_EXPECT_MSG_EQ ((_fired[i - 1].deadline <= _fired[i].deadline), true, "items fired out of order");
+        }
+    }
+
+  Simulator::Destroy ();
+}
+EndTest ()
+
+BeginTest (Clear)
+{
+  _fired.clear ();
+  _firedAt.clear ();
+
+  Ptr<WheelType> wheel = Create<WheelType> (MilliSeconds (1), MakeCallback (&MockExpire));
+  MockItem item = { MilliSeconds (10), 0 };
+  wheel->Schedule (item.deadline, item);
+  wheel->clear ();
+
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (_fired.size (), 0, "cleared item should not fire");
+  NS_TEST_EXPECT_MSG_EQ (wheel->size (), 0, "wheel should be empty");
+
+  Simulator::Destroy ();
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxTimerWheel
+ */
+static class TestSuiteCCNxTimerWheel : public TestSuite
+{
+public:
+  TestSuiteCCNxTimerWheel () : TestSuite ("ccnx-timer-wheel", UNIT)
+  {
+    AddTestCase (new FiresInOrder (), TestCase::QUICK);
+    AddTestCase (new Clear (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxTimerWheel;
+
+} // namespace TestSuiteCCNxTimerWheel
@@ -151,6 +151,30 @@ BeginTest (AddAtStart)
 }
 EndTest ()
 
+BeginTest (CreateFragment)
+{
+  Ptr<CCNxBuffer> buffer = Create<CCNxBuffer> (10, "applecider");
+  Ptr<CCNxBuffer> fragment = buffer->CreateFragment (5, 5);
+  NS_TEST_EXPECT_MSG_EQ (fragment->GetSize (), 5, "Got wrong size");
+  NS_TEST_EXPECT_MSG_EQ (fragment->Equals (Create<CCNxBuffer> (5, "cider")), true, "Got wrong bytes");
+
+  // the fragment aliases the original storage
+  bool shared = (fragment->GetBuffer ().PeekData () == buffer->GetBuffer ().PeekData () + 5);
+  NS_TEST_EXPECT_MSG_EQ (shared, true, "Fragment should share storage");
+}
+EndTest ()
+
+BeginTest (Constructor_Packet)
+{
+  Ptr<Packet> packet = Create<Packet> ((const uint8_t *) "apple", 5);
+  Ptr<CCNxBuffer> buffer = Create<CCNxBuffer> (packet);
+  NS_TEST_EXPECT_MSG_EQ (buffer->Equals (Create<CCNxBuffer> (5, "apple")), true, "Got wrong bytes");
+
+  Ptr<Packet> fragment = packet->CreateFragment (1, 3);
+  NS_TEST_EXPECT_MSG_EQ (Create<CCNxBuffer> (fragment)->Equals (Create<CCNxBuffer> (3, "ppl")), true, "Got wrong bytes");
+}
+EndTest ()
+
 /**
  * @ingroup ccnx-test
  *
@@ -168,6 +192,8 @@ public:
     AddTestCase (new Equals (), TestCase::QUICK);
     AddTestCase (new AddAtStart (), TestCase::QUICK);
     AddTestCase (new IteratorBeginEnd (), TestCase::QUICK);
+    AddTestCase (new CreateFragment (), TestCase::QUICK);
+    AddTestCase (new Constructor_Packet (), TestCase::QUICK);
   }
 } g_TestSuiteCCNxBuffer;
 
@@ -245,6 +245,12 @@ BeginTest (CreateBuffer)
       NS_TEST_EXPECT_MSG_EQ(truth, test, "Incorrect value from iterator");
       ++offset;
   }
+
+  // Later calls share the storage of the first
+  Ptr<CCNxBuffer> again = a->CreateBuffer();
+  bool shared = (again->GetBuffer ().PeekData () == buffer->GetBuffer ().PeekData ());
+  NS_TEST_EXPECT_MSG_EQ (shared, true, "CreateBuffer should share storage");
+  NS_TEST_EXPECT_MSG_EQ (again->Equals (buffer), true, "Wrong buffer contents");
 }
 EndTest ()
 
@@ -145,6 +145,23 @@ BeginTest (IsPrefixOf)
 }
 EndTest ()
 
+BeginTest (GetHash)
+{
+  Ptr<const CCNxName> a = Create<CCNxName> ("ccnx:/name=pear/name=tart");
+  Ptr<const CCNxName> b = Create<CCNxName> ("ccnx:/name=pear/name=tart");
+  Ptr<const CCNxName> c = Create<CCNxName> ("ccnx:/name=pea/name=rtart");
+  Ptr<const CCNxName> d = Create<CCNxName> ("ccnx:/name=pear/ver=tart");
+
+  NS_TEST_EXPECT_MSG_EQ (a->GetHash (), b->GetHash (), "Equal names must have equal hashes");
+  NS_TEST_EXPECT_MSG_EQ (a->GetHash (), a->GetHash (), "Cached hash changed");
+  NS_TEST_EXPECT_MSG_NE (a->GetHash (), c->GetHash (), "Segment boundaries should be part of the hash");
+  NS_TEST_EXPECT_MSG_NE (a->GetHash (), d->GetHash (), "Segment types should be part of the hash");
+
+  CCNxName copy (*a);
+  NS_TEST_EXPECT_MSG_EQ (copy.GetHash (), a->GetHash (), "Copy should have the same hash");
+}
+EndTest ()
+
 BeginTest (LessThan)
 {
   struct vectors
@@ -170,6 +187,62 @@ BeginTest (LessThan)
 }
 EndTest ()
 
+BeginTest (SegmentAccessors)
+{
+  Ptr<const CCNxName> a = Create<CCNxName> ("ccnx:/NAME=foor/VER=bar/CHUNK=333");
+
+  NS_TEST_EXPECT_MSG_EQ (a->GetSegmentType (1), CCNxNameSegment_Version, "Wrong segment type");
+  NS_TEST_EXPECT_MSG_EQ (a->GetSegmentLength (0), 4, "Wrong segment length");
+  std::string value ((const char *) a->GetSegmentData (2), a->GetSegmentLength (2));
+  NS_TEST_EXPECT_MSG_EQ (value, "333", "Wrong segment value");
+  NS_TEST_EXPECT_MSG_EQ (a->GetEncodedSize (), 3 * 4 + 4 + 3 + 3, "Wrong encoded size");
+
+  Ptr<const CCNxNameSegment> segment = a->GetSegment (1);
+  NS_TEST_EXPECT_MSG_EQ (segment->GetValue (), "bar", "Wrong segment");
+  NS_TEST_EXPECT_MSG_EQ (a->GetSegment (1), segment, "GetSegment should return the same segment object");
+}
+EndTest ()
+
+BeginTest (GetPrefix)
+{
+  Ptr<const CCNxName> a = Create<CCNxName> ("ccnx:/NAME=foor/VER=bar/CHUNK=333");
+  Ptr<const CCNxName> truth = Create<CCNxName> ("ccnx:/NAME=foor/VER=bar");
+
+  Ptr<const CCNxName> prefix = a->GetPrefix (2);
+  NS_TEST_EXPECT_MSG_EQ (prefix->GetSegmentCount (), 2, "Wrong segment count");
+  NS_TEST_EXPECT_MSG_EQ (prefix->Equals (*truth), true, "Prefix not equal to truth");
+  NS_TEST_EXPECT_MSG_EQ (truth->Equals (*prefix), true, "Truth not equal to prefix");
+  NS_TEST_EXPECT_MSG_EQ (prefix->GetHash (), truth->GetHash (), "Prefix should hash like the equal name");
+  NS_TEST_EXPECT_MSG_EQ (prefix->IsPrefixOf (*a), true, "Prefix should be a prefix of the name");
+  NS_TEST_EXPECT_MSG_EQ (a->IsPrefixOf (*prefix), false, "Name should not be a prefix of its prefix");
+  NS_TEST_EXPECT_MSG_EQ (*prefix < *a, true, "Prefix should sort before the name");
+  bool shared = prefix->GetSegmentData (1) == a->GetSegmentData (1);
+  NS_TEST_EXPECT_MSG_EQ (shared, true, "Prefix should share the segment buffer");
+
+  Ptr<const CCNxName> empty = a->GetPrefix (0);
+  NS_TEST_EXPECT_MSG_EQ (empty->GetSegmentCount (), 0, "Wrong segment count");
+  NS_TEST_EXPECT_MSG_EQ (empty->IsPrefixOf (*a), true, "Empty prefix should be a prefix of every name");
+}
+EndTest ()
+
+BeginTest (GetPrefixHash)
+{
+  Ptr<const CCNxName> a = Create<CCNxName> ("ccnx:/name=pear/name=tart/ver=sugar");
+
+  for (size_t i = 0; i <= a->GetSegmentCount (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (a->GetPrefixHash (i), a->GetPrefix (i)->GetHash (), "Wrong prefix hash for length " << i);
+    }
+
+  Ptr<const CCNxName> b = Create<CCNxName> ("ccnx:/name=pear/name=tart");
+  NS_TEST_EXPECT_MSG_EQ (a->GetPrefixHash (2), b->GetHash (), "Prefix hash should equal the hash of the equal name");
+  NS_TEST_EXPECT_MSG_EQ (a->GetPrefixHash (3), a->GetHash (), "Full-length prefix hash should be the name hash");
+
+  Ptr<const CCNxName> c = Create<CCNxName> ("ccnx:/name=pear/name=tarts");
+  NS_TEST_EXPECT_MSG_EQ (c->IsPrefixOf (*a), false, "Different last segment is not a prefix");
+}
+EndTest ()
+
 BeginTest (PrintName)
 {
   std::string s ("ccnx:/NAME=foor/VER=bar");
@@ -193,7 +266,11 @@ public:
     AddTestCase (new Equals (), TestCase::QUICK);
     AddTestCase (new Parse_1 (), TestCase::QUICK);
     AddTestCase (new IsPrefixOf (), TestCase::QUICK);
+    AddTestCase (new GetHash (), TestCase::QUICK);
     AddTestCase (new LessThan (), TestCase::QUICK);
+    AddTestCase (new SegmentAccessors (), TestCase::QUICK);
+    AddTestCase (new GetPrefix (), TestCase::QUICK);
+    AddTestCase (new GetPrefixHash (), TestCase::QUICK);
     AddTestCase (new PrintName (), TestCase::QUICK);
   }
 } g_TestSuiteCCNxName;
@@ -63,6 +63,11 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/ccns3Sim-module.h"
 #include "ns3/net-device.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/ccnx-schema-v1.h"
+
+#include <sstream>
+#include <vector>
 
 #include "../../TestMacros.h"
 
@@ -356,6 +361,74 @@ BeginTest (ReceiveFromLayer2)
 }
 EndTest ()
 
+/**
+ * Packets dropped in ReceiveFromLayer2() before they are decoded fire the Drop trace with
+ * a null CCNxPacket.  The ASCII trace must still print them.
+ */
+BeginTest (ReceiveFromLayer2_DropBeforeDecode)
+{
+  Ptr<Node> node = Create<Node> ();
+
+  CCNxStackHelper stack;
+  stack.Install (node);
+
+  std::ostringstream trace;
+  stack.EnableAsciiCCNx (Create<OutputStreamWrapper> (&trace), Ptr<CCNxName> (0), node);
+
+  Ptr<VirtualNetDevice> device = SetupTapDevice (node, 0, MakeCallback (&SendCallback));
+  Ptr<CCNxL3Protocol> ccnx = node->GetObject<CCNxL3Protocol> ();
+  ccnx->AddInterface (device);
+  ccnx->TraceConnectWithoutContext ("Drop", MakeCallback (&ReceiveFromLayer2_DropBeforeDecode::DropTrace, this));
+
+  uint16_t protocol = ccnx->GetProtocolNumber ();
+  Address from = Mac48Address ("11:00:00:00:11:11");
+  Address to = Mac48Address ("ff:ff:ff:ff:ff:ff");
+
+  // a truncated fixed header
+  ccnx->ReceiveFromLayer2 (device, Create<Packet> (4), protocol, from, to, NetDevice::PACKET_BROADCAST);
+
+  // an Interest with no hops left
+  Ptr<CCNxInterest> interest = Create<CCNxInterest> (Create<CCNxName> ("ccnx:/name=foo/name=sink"));
+  Ptr<CCNxPacket> packet = CCNxPacket::CreateFromMessage (interest);
+  packet->SetHopLimit (0);
+  ccnx->ReceiveFromLayer2 (device, packet->CreateNs3Packet (), protocol, from, to, NetDevice::PACKET_BROADCAST);
+
+  // an InterestReturn, which has no message codec
+  Ptr<Packet> wire = CCNxPacket::CreateFromMessage (interest)->CreateNs3Packet ();
+  std::vector<uint8_t> bytes (wire->GetSize ());
+  wire->CopyData (&bytes[0], bytes.size ());
+  bytes[1] = CCNxSchemaV1::PT_RETURN;
+  ccnx->ReceiveFromLayer2 (device, Create<Packet> (&bytes[0], bytes.size ()), protocol, from, to, NetDevice::PACKET_BROADCAST);
+
+  NS_TEST_ASSERT_MSG_EQ (m_reasons.size (), 3, "Expected three drops");
+  NS_TEST_EXPECT_MSG_EQ (m_reasons[0], CCNxL3Protocol::DROP_BAD_HEADER, "Wrong drop reason");
+  NS_TEST_EXPECT_MSG_EQ (m_reasons[1], CCNxL3Protocol::DROP_TTL_EXPIRED, "Wrong drop reason");
+  NS_TEST_EXPECT_MSG_EQ (m_reasons[2], CCNxL3Protocol::DROP_UNSUPPORTED_TYPE, "Wrong drop reason");
+
+  size_t drops = 0;
+  std::istringstream lines (trace.str ());
+  std::string line;
+  while (std::getline (lines, line))
+    {
+      if (line.compare (0, 2, "d ") == 0)
+        {
+          drops++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (drops, 3, "Expected three drops in the ASCII trace");
+}
+
+void
+DropTrace (const CCNxL3Protocol *ccnx, Ptr<const Packet> packet, Ptr<const CCNxPacket> ccnxPacket,
+           uint32_t interface, CCNxL3Protocol::DropReason reason)
+{
+  NS_TEST_EXPECT_MSG_EQ ((ccnxPacket == 0), true, "Packet dropped before decode should have no CCNxPacket");
+  m_reasons.push_back (reason);
+}
+
+std::vector<CCNxL3Protocol::DropReason> m_reasons;
+EndTest ()
+
 
 /**
  * @ingroup ccnx-test
@@ -379,6 +452,7 @@ public:
     AddTestCase (new GetInterfaceNonexistent (), TestCase::QUICK);
     AddTestCase (new GetNInterfaces (), TestCase::QUICK);
     AddTestCase (new ReceiveFromLayer2 (), TestCase::QUICK);
+    AddTestCase (new ReceiveFromLayer2_DropBeforeDecode (), TestCase::QUICK);
   }
 } g_TestSuiteCCNxStandardLayer3;
 
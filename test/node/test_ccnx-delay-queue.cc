@@ -53,6 +53,8 @@
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
 
+#include <vector>
+
 #include "ns3/test.h"
 #include "../TestMacros.h"
 #include "ns3/ccnx-delay-queue.h"
@@ -192,6 +194,280 @@ void Service (Ptr<MockQueueItem> item)
 }
 EndTest ()
 
+/**
+ * A 1-server queue with a batch size of 3 and a service time of 1 second.  Six items arrive
+ * at time 1 while the server is idle, so item 1 is served alone and items 2-4 and 5-6
+ * are batched.  Each item's completion time is the same as unbatched service,
+ * but only 3 timer events are used instead of 6.
+ */
+BeginTest (BatchTiming)
+{
+  QueueType::GetServiceTimeCallback getTime = MakeCallback (&BatchTiming::GetServiceTime, this);
+  QueueType::DequeueCallback service = MakeCallback (&BatchTiming::Service, this);
+
+  m_queue = Create< QueueType > (1, getTime, service);
+  m_queue->SetBatchSize (3, MakeCallback (&BatchTiming::BatchService, this));
+
+  for (unsigned i = 1; i <= 6; i++)
+    {
+      Ptr<MockQueueItem> item = Create<MockQueueItem> (i, Seconds (1.0f + i));
+      Simulator::Schedule (Seconds (1.0f), &BatchTiming::GenerateTraffic, this, item);
+    }
+
+  m_completedItems = 0;
+  m_batches = 0;
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_completedItems, 6, "Incorrect number of completed items");
+  NS_TEST_EXPECT_MSG_EQ (m_batches, 3, "Incorrect number of batches");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetServiceEventCount (), 3, "Incorrect number of service events");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->size (), 0, "Queue should be empty");
+
+  // each item waits until the one before it is done, so the delays are 0 through 5 seconds
+  const QueueType::ClassStats &stats = m_queue->GetClassStats (0);
+  NS_TEST_EXPECT_MSG_EQ (stats.served, 6, "Wrong served count");
+  NS_TEST_EXPECT_MSG_EQ (stats.totalDelay, Seconds (15), "Wrong total queueing delay");
+  NS_TEST_EXPECT_MSG_EQ (stats.maxDelay, Seconds (5), "Wrong max queueing delay");
+}
+
+Ptr<QueueType> m_queue;
+unsigned m_completedItems;
+unsigned m_batches;
+
+void GenerateTraffic (Ptr<MockQueueItem> item)
+{
+  m_queue->push_back (item);
+}
+
+Time GetServiceTime (Ptr<MockQueueItem> item)
+{
+  return Seconds (1);
+}
+
+void Service (Ptr<MockQueueItem> item)
+{
+  NS_TEST_EXPECT_MSG_EQ (true, false, "Should use the batch callback");
+}
+
+void BatchService (const QueueType::CompletionList &batch)
+{
+  m_batches++;
+  for (size_t i = 0; i < batch.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (batch[i].time, batch[i].item->GetFinishTime (), "Incorrect finish time for " << batch[i].item->GetId ());
+      m_completedItems++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), batch.back ().time, "Batch should be delivered when the last item is done");
+}
+EndTest ()
+
+/**
+ * Two queues in a row: a 2-server queue with a 1 second service time feeds a 1-server queue
+ * with a 0.25 second service time from its `DequeueCallback`.  Ten items arrive 0.2 seconds apart.
+ * Each item must leave each queue at the same modeled time (CCNxDelayQueueClock::Now()) whether the
+ * queues serve one item per timer or up to 4, and batching must use fewer timers.
+ */
+BeginTest (BatchDownstreamTiming)
+{
+  std::vector<Time> unbatchedFirst, unbatchedSecond;
+  uint64_t unbatchedEvents = Run (1, unbatchedFirst, unbatchedSecond);
+
+  std::vector<Time> batchedFirst, batchedSecond;
+  uint64_t batchedEvents = Run (4, batchedFirst, batchedSecond);
+
+  for (unsigned i = 0; i < _items; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (batchedFirst[i], unbatchedFirst[i], "First queue completion differs for item " << i);
+      NS_TEST_EXPECT_MSG_EQ (batchedSecond[i], unbatchedSecond[i], "Second queue completion differs for item " << i);
+    }
+
+  // item 0 goes straight through both queues
+  NS_TEST_EXPECT_MSG_EQ (unbatchedSecond[0], Seconds (2.25), "Wrong completion time for item 0");
+  NS_TEST_EXPECT_MSG_EQ ((batchedEvents < unbatchedEvents), true, "Batching should use fewer timers");
+}
+
+static const unsigned _items = 10;
+
+Ptr<QueueType> m_first;
+Ptr<QueueType> m_second;
+std::vector<Time> *m_firstTimes;
+std::vector<Time> *m_secondTimes;
+
+uint64_t Run (unsigned batchSize, std::vector<Time> &firstTimes, std::vector<Time> &secondTimes)
+{
+  m_first = Create< QueueType > (2, MakeCallback (&BatchDownstreamTiming::FirstServiceTime, this),
+                                 MakeCallback (&BatchDownstreamTiming::FirstService, this));
+  m_second = Create< QueueType > (1, MakeCallback (&BatchDownstreamTiming::SecondServiceTime, this),
+                                  MakeCallback (&BatchDownstreamTiming::SecondService, this));
+  m_first->SetBatchSize (batchSize);
+  m_second->SetBatchSize (batchSize);
+
+  firstTimes.assign (_items, Time ());
+  secondTimes.assign (_items, Time ());
+  m_firstTimes = &firstTimes;
+  m_secondTimes = &secondTimes;
+
+  for (unsigned i = 0; i < _items; i++)
+    {
+      Ptr<MockQueueItem> item = Create<MockQueueItem> (i, Seconds (0));
+      Simulator::Schedule (Seconds (1.0 + 0.2 * i), &BatchDownstreamTiming::GenerateTraffic, this, item);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_second->size (), 0, "Second queue should be empty");
+  return m_first->GetServiceEventCount () + m_second->GetServiceEventCount ();
+}
+
+void GenerateTraffic (Ptr<MockQueueItem> item)
+{
+  m_first->push_back (item);
+}
+
+Time FirstServiceTime (Ptr<MockQueueItem> item)
+{
+  return Seconds (1);
+}
+
+void FirstService (Ptr<MockQueueItem> item)
+{
+  (*m_firstTimes)[item->GetId ()] = CCNxDelayQueueClock::Now ();
+  m_second->push_back (item);
+}
+
+Time SecondServiceTime (Ptr<MockQueueItem> item)
+{
+  return Seconds (0.25);
+}
+
+void SecondService (Ptr<MockQueueItem> item)
+{
+  (*m_secondTimes)[item->GetId ()] = CCNxDelayQueueClock::Now ();
+}
+EndTest ()
+
+/**
+ * A 2-server queue with a capacity of 3.  Ten items arrive at once: 2 go to the servers,
+ * 3 wait, and 5 are dropped.
+ */
+BeginTest (CapacityTailDrop)
+{
+  QueueType::GetServiceTimeCallback getTime = MakeCallback (&CapacityTailDrop::GetServiceTime, this);
+  QueueType::DequeueCallback service = MakeCallback (&CapacityTailDrop::Service, this);
+
+  Ptr<QueueType> queue = Create< QueueType > (2, getTime, service);
+  queue->SetCapacity (3);
+  queue->SetDropCallback (MakeCallback (&CapacityTailDrop::Drop, this));
+
+  m_completedItems = 0;
+  m_droppedItems = 0;
+  unsigned accepted = 0;
+  for (unsigned i = 1; i <= 10; i++)
+    {
+      if (queue->push_back (Create<MockQueueItem> (i, Seconds (0))))
+        {
+          accepted++;
+        }
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (accepted, 5, "Incorrect number of accepted items");
+  NS_TEST_EXPECT_MSG_EQ (m_droppedItems, 5, "Incorrect number of drop callbacks");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetDropCount (), 5, "Incorrect drop count");
+  NS_TEST_EXPECT_MSG_EQ (queue->size (), 5, "Incorrect backlog");
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_completedItems, 5, "Incorrect number of completed items");
+  NS_TEST_EXPECT_MSG_EQ (queue->size (), 0, "Queue should be empty");
+}
+
+unsigned m_completedItems;
+unsigned m_droppedItems;
+
+Time GetServiceTime (Ptr<MockQueueItem> item)
+{
+  return Seconds (1);
+}
+
+void Service (Ptr<MockQueueItem> item)
+{
+  m_completedItems++;
+}
+
+void Drop (Ptr<MockQueueItem> item)
+{
+  NS_TEST_EXPECT_MSG_EQ ((item->GetId () > 5), true, "Dropped an early arrival " << item->GetId ());
+  m_droppedItems++;
+}
+EndTest ()
+
+/**
+ * A 1-server queue with 3 classes (class = id / 100).  Item 0 is served at once, then the
+ * order depends on the scheduler.  With strict priority class 0 goes first.  With weights
+ * 2, 1, 1 weighted round robin takes two of class 0, then one of each other class.
+ */
+BeginTest (ClassScheduling)
+{
+  unsigned strictOrder[] = { 200, 0, 1, 2, 100, 101, 102, 201, 202 };
+  unsigned wrrOrder[] = { 200, 0, 1, 100, 201, 2, 101, 202, 102 };
+
+  RunScheduler (CCNxDelayQueueScheduler_StrictPriority, strictOrder);
+  RunScheduler (CCNxDelayQueueScheduler_WeightedRoundRobin, wrrOrder);
+}
+
+Ptr<QueueType> m_queue;
+std::vector<unsigned> m_order;
+
+void RunScheduler (CCNxDelayQueueScheduler scheduler, unsigned expected[])
+{
+  m_queue = Create< QueueType > (1, MakeCallback (&ClassScheduling::GetServiceTime, this),
+                                 MakeCallback (&ClassScheduling::Service, this));
+  std::vector<unsigned> weights;
+  weights.push_back (2);
+  weights.push_back (1);
+  weights.push_back (1);
+  m_queue->SetClasses (MakeCallback (&ClassScheduling::Classify, this), scheduler, weights);
+
+  m_order.clear ();
+  for (unsigned i = 0; i < 3; i++)
+    {
+      m_queue->push_back (Create<MockQueueItem> (200 + i, Seconds (0)));
+      m_queue->push_back (Create<MockQueueItem> (100 + i, Seconds (0)));
+      m_queue->push_back (Create<MockQueueItem> (i, Seconds (0)));
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_order.size (), 9, "Incorrect number of completed items");
+  for (unsigned i = 0; i < 9; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_order[i], expected[i], "Wrong order at " << i << " for scheduler " << scheduler);
+    }
+
+  const QueueType::ClassStats &stats = m_queue->GetClassStats (2);
+  NS_TEST_EXPECT_MSG_EQ (stats.enqueued, 3, "Wrong class 2 enqueued count");
+  NS_TEST_EXPECT_MSG_EQ (stats.served, 3, "Wrong class 2 served count");
+  NS_TEST_EXPECT_MSG_EQ ((stats.maxDelay > Seconds (0)), true, "Class 2 should have waited");
+}
+
+unsigned Classify (Ptr<MockQueueItem> item)
+{
+  return item->GetId () / 100;
+}
+
+Time GetServiceTime (Ptr<MockQueueItem> item)
+{
+  return Seconds (1);
+}
+
+void Service (Ptr<MockQueueItem> item)
+{
+  m_order.push_back (item->GetId ());
+}
+EndTest ()
+
 /**
  * @ingroup ccnx-test
  *
@@ -204,6 +480,10 @@ public:
   {
     AddTestCase (new Constructor (), TestCase::QUICK);
     AddTestCase (new Timing (), TestCase::QUICK);
+    AddTestCase (new BatchTiming (), TestCase::QUICK);
+    AddTestCase (new BatchDownstreamTiming (), TestCase::QUICK);
+    AddTestCase (new CapacityTailDrop (), TestCase::QUICK);
+    AddTestCase (new ClassScheduling (), TestCase::QUICK);
   }
 } g_TestSuiteCCNxDelayQueue;
 
@@ -191,6 +191,25 @@ BeginTest (RemoveNexthop_Exists)
 }
 EndTest ()
 
+BeginTest (GetNexthop)
+{
+  Ptr<const CCNxName> prefix = Create<const CCNxName> ("ccnx:/name=foo");
+  Ptr<CCNxRoute> route = Create<CCNxRoute> (prefix);
+  TestVector t (prefix,10,100);
+  Ptr<CCNxRouteEntry> entry = CreateRouteEntry (t);
+  route->AddNexthop (entry);
+
+  Ptr<const CCNxRouteEntry> test = route->GetNexthop (Create<CCNxVirtualConnection> (100));
+  bool exists = (test);
+  NS_TEST_EXPECT_MSG_EQ (exists, true, "Should find the nexthop for connection 100");
+  NS_TEST_EXPECT_MSG_EQ (test->GetCost (), 10, "Wrong cost");
+
+  test = route->GetNexthop (Create<CCNxVirtualConnection> (200));
+  exists = (test);
+  NS_TEST_EXPECT_MSG_EQ (exists, false, "Should not find a nexthop for connection 200");
+}
+EndTest ()
+
 BeginTest (Equals)
 {
   Ptr<const CCNxName> prefix1 = Create<const CCNxName> ("ccnx:/name=foo");
@@ -441,6 +460,7 @@ public:
     AddTestCase (new RemoveNexthop_Missing (), TestCase::QUICK);
     AddTestCase (new RemoveNexthop_Exists (), TestCase::QUICK);
     AddTestCase (new GetNexthops (), TestCase::QUICK);
+    AddTestCase (new GetNexthop (), TestCase::QUICK);
 
     AddTestCase (new Equals (), TestCase::QUICK);
     AddTestCase (new Operator_Output (), TestCase::QUICK);
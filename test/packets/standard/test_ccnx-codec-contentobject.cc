@@ -252,6 +252,37 @@ BeginTest (TestDeserializeWithNonDataPayloadType)
 }
 EndTest ()
 
+BeginTest (TestDeserializeDeferPayload)
+{
+  printf ("TestDeserializeDeferPayload DoRun\n");
+
+  Ptr<CCNxName> name = Create<CCNxName> ("ccnx:/name=apple/ver=pie/chunk=crust");
+  Ptr<CCNxTime> expiryTime  = Create<CCNxTime> (3600);
+  Ptr<CCNxBuffer> payload = CreatePayload (sizeof(payloadBytes), payloadBytes);
+
+  Ptr<CCNxContentObject> content = Create<CCNxContentObject> (name, payload, CCNxContentObjectPayloadType_Data, expiryTime);
+  CCNxCodecContentObject ci;
+  ci.SetHeader (content);
+
+  Buffer buffer (0);
+  buffer.AddAtStart (ci.GetSerializedSize ());
+  ci.Serialize (buffer.Begin ());
+
+  CCNxCodecContentObject citest;
+  citest.SetDeferPayload (true);
+  citest.Deserialize (buffer.Begin ());
+
+  NS_TEST_EXPECT_MSG_EQ (citest.HasDeferredPayload (), true, "Payload should be deferred");
+  NS_TEST_EXPECT_MSG_EQ (citest.GetDeferredPayloadLength (), sizeof(payloadBytes), "Wrong payload length");
+  // 4 (T_OBJECT) + 29 (name) + 12 (expiry) + 4 (T_PAYLOAD)
+  NS_TEST_EXPECT_MSG_EQ (citest.GetDeferredPayloadOffset (), 4 + 29 + 12 + 4, "Wrong payload offset");
+
+  Ptr<CCNxContentObject> test = citest.GetHeader ();
+  NS_TEST_EXPECT_MSG_EQ (test->GetName ()->Equals (*name), true, "Wrong name");
+  NS_TEST_EXPECT_MSG_EQ (test->HasPayload (), false, "Payload should not be decoded");
+}
+EndTest ()
+
 BeginTest (TestSerialize_PayloadType)
 {
   printf ("TestSerialize_PayloadType DoRun\n");
@@ -304,6 +335,7 @@ public:
     AddTestCase (new TestCCNxCodecContentObject::TestSerializeWithNonDataPayloadType (), TestCase::QUICK);
     AddTestCase (new TestCCNxCodecContentObject::TestDeserializeWithDataPayloadType (), TestCase::QUICK);
     AddTestCase (new TestCCNxCodecContentObject::TestDeserializeWithNonDataPayloadType (), TestCase::QUICK);
+    AddTestCase (new TestCCNxCodecContentObject::TestDeserializeDeferPayload (), TestCase::QUICK);
     AddTestCase (new TestCCNxCodecContentObject::TestSerialize_PayloadType (), TestCase::QUICK);
     AddTestCase (new TestCCNxCodecContentObject::TestDeserialize_PayloadType (), TestCase::QUICK);
   }
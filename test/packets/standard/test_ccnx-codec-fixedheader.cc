@@ -57,6 +57,7 @@
 #include "ns3/ccnx-codec-fixedheader.h"
 #include "ns3/ccnx-time.h"
 #include "ns3/ccnx-interestlifetime.h"
+#include "ns3/ccnx-schema-v1.h"
 #include "../../TestMacros.h"
 
 using namespace ns3;
@@ -159,6 +160,96 @@ BeginTest (TestDeserialize)
 }
 EndTest ()
 
+BeginTest (TestReserializeEncoded)
+{
+  printf ("TestReserializeEncoded DoRun\n");
+
+  CCNxCodecFixedHeader codec;
+  codec.SetFixedHeader (Create<CCNxFixedHeader> (1, CCNxFixedHeaderType_Interest, 300, 255, 3, 20));
+  codec.GetPerHopHeader()->AddHeader(Create<CCNxInterestLifetime> (Create<CCNxTime>(3600)));
+  codec.GetPerHopHeader()->AddHeader(Create<CCNxInterestLifetime> (Create<CCNxTime>(1200)));
+
+  Buffer buffer (0);
+  buffer.AddAtStart (codec.GetSerializedSize ());
+  codec.Serialize (buffer.Begin ());
+
+  // Write the per hop headers back without decoding them
+  CCNxCodecFixedHeader codectest;
+  uint32_t bytesRead = codectest.Deserialize (buffer.Begin ());
+  NS_TEST_EXPECT_MSG_EQ (bytesRead, buffer.GetSize (), "Wrong bytes read");
+  NS_TEST_EXPECT_MSG_EQ (codectest.GetSerializedSize (), buffer.GetSize (), "Wrong size");
+
+  Buffer output (0);
+  output.AddAtStart (codectest.GetSerializedSize ());
+  codectest.Serialize (output.Begin ());
+  NS_TEST_EXPECT_MSG_EQ (memcmp (buffer.PeekData (), output.PeekData (), buffer.GetSize ()), 0, "Data in buffer wrong");
+
+  // Adding a header decodes the others first
+  codectest.GetPerHopHeader()->AddHeader(Create<CCNxInterestLifetime> (Create<CCNxTime>(600)));
+  NS_TEST_EXPECT_MSG_EQ (codectest.GetPerHopHeader()->size(), 3, "Wrong number of per hop headers");
+  NS_TEST_EXPECT_MSG_EQ (codectest.GetSerializedSize (), buffer.GetSize () + 6, "Wrong size");
+}
+EndTest ()
+
+BeginTest (TestCheck)
+{
+  printf ("TestCheck DoRun\n");
+
+  // version 1, Interest, length 16, hop limit 7, header length 8, then an 8 byte message
+  uint8_t wire[] = {
+    1, 1, 0, 16, 7, 0, 0, 8,
+    0, 1, 0, 4, 0, 0, 0, 0,
+  };
+
+  CCNxFixedHeaderType packetType = CCNxFixedHeaderType_Object;
+  uint8_t hopLimit = 0;
+  CCNxCodecFixedHeader::CheckResult result = CCNxCodecFixedHeader::Check (Create<Packet> (wire, sizeof(wire)), packetType, hopLimit);
+  NS_TEST_EXPECT_MSG_EQ (result, CCNxCodecFixedHeader::CHECK_OK, "Good header should pass");
+  NS_TEST_EXPECT_MSG_EQ (packetType, CCNxFixedHeaderType_Interest, "Wrong packet type");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t) hopLimit, 7, "Wrong hop limit");
+
+  // layer 2 padding after the packet is allowed
+  Ptr<Packet> padded = Create<Packet> (wire, sizeof(wire));
+  padded->AddPaddingAtEnd (10);
+  result = CCNxCodecFixedHeader::Check (padded, packetType, hopLimit);
+  NS_TEST_EXPECT_MSG_EQ (result, CCNxCodecFixedHeader::CHECK_OK, "Padded packet should pass");
+
+  result = CCNxCodecFixedHeader::Check (Create<Packet> (wire, 6), packetType, hopLimit);
+  NS_TEST_EXPECT_MSG_EQ (result, CCNxCodecFixedHeader::CHECK_TRUNCATED, "Short fixed header");
+
+  result = CCNxCodecFixedHeader::Check (Create<Packet> (wire, 12), packetType, hopLimit);
+  NS_TEST_EXPECT_MSG_EQ (result, CCNxCodecFixedHeader::CHECK_TRUNCATED, "Shorter than PacketLength");
+
+  uint8_t bad[sizeof(wire)];
+  memcpy (bad, wire, sizeof(wire));
+  bad[0] = 2;
+  result = CCNxCodecFixedHeader::Check (Create<Packet> (bad, sizeof(bad)), packetType, hopLimit);
+  NS_TEST_EXPECT_MSG_EQ (result, CCNxCodecFixedHeader::CHECK_BAD_VERSION, "Bad version");
+
+  memcpy (bad, wire, sizeof(wire));
+  bad[1] = 9;
+  result = CCNxCodecFixedHeader::Check (Create<Packet> (bad, sizeof(bad)), packetType, hopLimit);
+  NS_TEST_EXPECT_MSG_EQ (result, CCNxCodecFixedHeader::CHECK_BAD_PACKET_TYPE, "Bad packet type");
+
+  // InterestReturn is well formed but has no message codec
+  memcpy (bad, wire, sizeof(wire));
+  bad[1] = CCNxSchemaV1::PT_RETURN;
+  result = CCNxCodecFixedHeader::Check (Create<Packet> (bad, sizeof(bad)), packetType, hopLimit);
+  NS_TEST_EXPECT_MSG_EQ (result, CCNxCodecFixedHeader::CHECK_UNSUPPORTED_PACKET_TYPE, "InterestReturn is not decoded");
+
+  memcpy (bad, wire, sizeof(wire));
+  bad[7] = 4;
+  result = CCNxCodecFixedHeader::Check (Create<Packet> (bad, sizeof(bad)), packetType, hopLimit);
+  NS_TEST_EXPECT_MSG_EQ (result, CCNxCodecFixedHeader::CHECK_BAD_HEADER_LENGTH, "Bad header length");
+
+  // header length leaves no room for the message
+  memcpy (bad, wire, sizeof(wire));
+  bad[7] = 14;
+  result = CCNxCodecFixedHeader::Check (Create<Packet> (bad, sizeof(bad)), packetType, hopLimit);
+  NS_TEST_EXPECT_MSG_EQ (result, CCNxCodecFixedHeader::CHECK_TRUNCATED, "No room for message");
+}
+EndTest ()
+
 /**
  * @ingroup ccnx-test
  *
@@ -172,6 +263,8 @@ public:
     AddTestCase (new TestGetSerializedSize (), TestCase::QUICK);
     AddTestCase (new TestSerialize (), TestCase::QUICK);
     AddTestCase (new TestDeserialize (), TestCase::QUICK);
+    AddTestCase (new TestReserializeEncoded (), TestCase::QUICK);
+    AddTestCase (new TestCheck (), TestCase::QUICK);
   }
 } g_TestSuiteCCNxCodecFixedHeader;
 
@@ -128,6 +128,51 @@ BeginTest (TestDeserialize)
 }
 EndTest ()
 
+BeginTest (TestDeserializeSegments)
+{
+  printf ("TestDeserializeSegments DoRun\n");
+
+  const uint8_t encoded[] = {
+    0, 0, 0, 25,
+    0, 1, 0, 5, 'a', 'p', 'p', 'l', 'e',
+    0, 19, 0, 3, 'p', 'i', 'e',
+    0, 16, 0, 5, 'c', 'r', 'u', 's', 't'
+  };
+
+  Buffer buffer (0);
+  buffer.AddAtStart (sizeof(encoded));
+  buffer.Begin ().Write (encoded, sizeof(encoded));
+
+  CCNxCodecName cn;
+  uint32_t bytesRead = cn.Deserialize (buffer.Begin ());
+  NS_TEST_EXPECT_MSG_EQ (bytesRead, sizeof(encoded), "Wrong bytes read");
+
+  Ptr<const CCNxName> test = cn.GetHeader ();
+  NS_TEST_EXPECT_MSG_EQ (test->GetSegmentCount (), 3, "Wrong segment count");
+  NS_TEST_EXPECT_MSG_EQ (test->GetSegmentType (0), CCNxNameSegment_Name, "Wrong type 0");
+  NS_TEST_EXPECT_MSG_EQ (test->GetSegmentType (1), CCNxNameSegment_Version, "Wrong type 1");
+  NS_TEST_EXPECT_MSG_EQ (test->GetSegmentType (2), CCNxNameSegment_Chunk, "Wrong type 2");
+  NS_TEST_EXPECT_MSG_EQ (test->GetSegmentLength (1), 3, "Wrong length 1");
+  NS_TEST_EXPECT_MSG_EQ (memcmp (test->GetSegmentData (2), "crust", 5), 0, "Wrong value 2");
+
+  // the prefix of a deserialized name serializes to the prefix of the wire format
+  CCNxCodecName prefix;
+  prefix.SetHeader (test->GetPrefix (1));
+  Buffer out (0);
+  out.AddAtStart (prefix.GetSerializedSize ());
+  prefix.Serialize (out.Begin ());
+
+  const uint8_t truth[] = {
+    0, 0, 0, 9,
+    0, 1, 0, 5, 'a', 'p', 'p', 'l', 'e'
+  };
+  NS_TEST_EXPECT_MSG_EQ (out.GetSize (), sizeof(truth), "Wrong prefix size");
+  uint8_t bytes[sizeof(truth)];
+  out.CopyData (bytes, sizeof(truth));
+  NS_TEST_EXPECT_MSG_EQ (memcmp (truth, bytes, sizeof(truth)), 0, "Wrong prefix bytes");
+}
+EndTest ()
+
 /**
  * @ingroup ccnx-test
  *
@@ -141,6 +186,7 @@ public:
     AddTestCase (new TestGetSerializedSize (), TestCase::QUICK);
     AddTestCase (new TestSerialize (), TestCase::QUICK);
     AddTestCase (new TestDeserialize (), TestCase::QUICK);
+    AddTestCase (new TestDeserializeSegments (), TestCase::QUICK);
   }
 } g_TestSuiteCCNxCodecName;
 
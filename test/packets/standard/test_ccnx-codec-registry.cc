@@ -52,3 +52,112 @@
  * intellectual property used by its contributions to this software. You may
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
+
+#include "ns3/test.h"
+#include "ns3/ccnx-codec-registry.h"
+#include "ns3/ccnx-codec-interestlifetime.h"
+#include "ns3/ccnx-codec-cachetime.h"
+#include "ns3/ccnx-schema-v1.h"
+#include "ns3/ccnx-interest.h"
+#include "ns3/ccnx-contentobject.h"
+
+#include "../../TestMacros.h"
+
+using namespace ns3;
+using namespace ns3::ccnx;
+
+namespace TestSuiteCCNxCodecRegistry {
+
+BeginTest (PerHopLookup)
+{
+  // make sure the codecs have registered themselves
+  CCNxCodecInterestLifetime::GetTypeId ();
+  CCNxCodecCachetime::GetTypeId ();
+
+  Ptr<CCNxCodecPerHopHeaderEntry> codec = CCNxCodecRegistry::PerHopLookupCodec (CCNxSchemaV1::T_INT_LIFE);
+  bool isLifetime = (bool) DynamicCast<CCNxCodecInterestLifetime, CCNxCodecPerHopHeaderEntry> (codec);
+  NS_TEST_EXPECT_MSG_EQ (isLifetime, true, "Wrong codec for T_INT_LIFE");
+
+  codec = CCNxCodecRegistry::PerHopLookupCodec (CCNxSchemaV1::T_CACHE_TIME);
+  bool isCachetime = (bool) DynamicCast<CCNxCodecCachetime, CCNxCodecPerHopHeaderEntry> (codec);
+  NS_TEST_EXPECT_MSG_EQ (isCachetime, true, "Wrong codec for T_CACHE_TIME");
+
+  codec = CCNxCodecRegistry::PerHopLookupCodec (0x00FE);
+  bool isNull = !codec;
+  NS_TEST_EXPECT_MSG_EQ (isNull, true, "Unregistered type should have no codec");
+}
+EndTest ()
+
+BeginTest (PerHopRegister)
+{
+  Ptr<CCNxCodecPerHopHeaderEntry> codec = CreateObject<CCNxCodecCachetime> ();
+
+  // one type in the direct table and one beyond it
+  CCNxCodecRegistry::TlvTypeType types[] = { 0x00FE, 0x1234 };
+  for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++)
+    {
+      CCNxCodecRegistry::PerHopRegisterCodec (types[i], codec);
+      bool found = (CCNxCodecRegistry::PerHopLookupCodec (types[i]) == codec);
+      NS_TEST_EXPECT_MSG_EQ (found, true, "Did not find registered codec for type " << types[i]);
+
+      CCNxCodecRegistry::PerHopUnegisterCodec (types[i]);
+      bool isNull = !CCNxCodecRegistry::PerHopLookupCodec (types[i]);
+      NS_TEST_EXPECT_MSG_EQ (isNull, true, "Unregistered codec still found for type " << types[i]);
+    }
+}
+EndTest ()
+
+BeginTest (MessageLookup)
+{
+  const CCNxCodecRegistry::MessageCodec &interest = CCNxCodecRegistry::LookupMessageCodec (CCNxMessage::Interest);
+  NS_TEST_EXPECT_MSG_EQ (interest.packetType, CCNxFixedHeaderType_Interest, "Wrong packet type");
+  NS_TEST_EXPECT_MSG_EQ (interest.tlvType, CCNxSchemaV1::T_INTEREST, "Wrong TLV type");
+
+  const CCNxCodecRegistry::MessageCodec &object = CCNxCodecRegistry::LookupMessageCodec (CCNxFixedHeaderType_Object);
+  NS_TEST_EXPECT_MSG_EQ (object.messageType, CCNxMessage::ContentObject, "Wrong message type");
+  NS_TEST_EXPECT_MSG_EQ (object.tlvType, CCNxSchemaV1::T_OBJECT, "Wrong TLV type");
+}
+EndTest ()
+
+BeginTest (MessageRoundTrip)
+{
+  Ptr<CCNxName> name = Create<CCNxName> ("ccnx:/name=apple/name=pie");
+  Ptr<CCNxBuffer> payload = Create<CCNxBuffer> (20, true);
+  Ptr<CCNxContentObject> content = Create<CCNxContentObject> (name, payload);
+
+  const CCNxCodecRegistry::MessageCodec &codec = CCNxCodecRegistry::LookupMessageCodec (content->GetMessageType ());
+
+  Ptr<Packet> packet = Create<Packet> ();
+  codec.Serialize (content, packet);
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), codec.GetSerializedSize (content), "Wrong encoded size");
+
+  Ptr<CCNxMessage> eager = codec.Deserialize (packet, false);
+  NS_TEST_EXPECT_MSG_EQ (eager->GetMessageType (), CCNxMessage::ContentObject, "Wrong decoded type");
+  NS_TEST_EXPECT_MSG_EQ (eager->IsPayloadEncoded (), false, "Payload should be decoded");
+
+  Ptr<CCNxMessage> lazy = codec.Deserialize (packet, true);
+  NS_TEST_EXPECT_MSG_EQ (lazy->IsPayloadEncoded (), true, "Payload should be deferred");
+
+  Ptr<CCNxContentObject> test = DynamicCast<CCNxContentObject, CCNxMessage> (lazy);
+  NS_TEST_EXPECT_MSG_EQ (content->Equals (test), true, "Decoded content object not equal");
+}
+EndTest ()
+
+/**
+ * @ingroup ccnx-test
+ *
+ * Test Suite for CCNxCodecRegistry
+ */
+static class TestSuiteCCNxCodecRegistry : public TestSuite
+{
+public:
+  TestSuiteCCNxCodecRegistry () : TestSuite ("ccnx-codec-registry", UNIT)
+  {
+    AddTestCase (new PerHopLookup (), TestCase::QUICK);
+    AddTestCase (new PerHopRegister (), TestCase::QUICK);
+    AddTestCase (new MessageLookup (), TestCase::QUICK);
+    AddTestCase (new MessageRoundTrip (), TestCase::QUICK);
+  }
+} g_TestSuiteCCNxCodecRegistry;
+
+} // namespace TestSuiteCCNxCodecRegistry
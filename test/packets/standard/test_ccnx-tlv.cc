@@ -68,6 +68,71 @@ BeginTest (Constructor)
 }
 EndTest ()
 
+BeginTest (Cursor_Next)
+{
+  const uint8_t encoded[] = {
+    0, 1, 0, 3, 'a', 'b', 'c',
+    0, 2, 0, 0,
+    0, 3, 0, 1, 'x'
+  };
+
+  CCNxTlvCursor cursor (encoded, sizeof(encoded));
+  uint16_t type;
+  uint16_t length;
+  const uint8_t *value;
+
+  bool more = cursor.Next (type, length, value);
+  NS_TEST_EXPECT_MSG_EQ (more, true, "Should have read first TLV");
+  NS_TEST_EXPECT_MSG_EQ (type, 1, "Wrong type");
+  NS_TEST_EXPECT_MSG_EQ (length, 3, "Wrong length");
+  NS_TEST_EXPECT_MSG_EQ (memcmp (value, "abc", 3), 0, "Wrong value");
+  NS_TEST_EXPECT_MSG_EQ (cursor.GetOffset (), 7, "Wrong offset");
+
+  more = cursor.Next (type, length, value);
+  NS_TEST_EXPECT_MSG_EQ (more, true, "Should have read empty TLV");
+  NS_TEST_EXPECT_MSG_EQ (type, 2, "Wrong type");
+  NS_TEST_EXPECT_MSG_EQ (length, 0, "Wrong length");
+
+  more = cursor.Next (type, length, value);
+  NS_TEST_EXPECT_MSG_EQ (more, true, "Should have read last TLV");
+  NS_TEST_EXPECT_MSG_EQ (type, 3, "Wrong type");
+  NS_TEST_EXPECT_MSG_EQ (value[0], 'x', "Wrong value");
+
+  more = cursor.Next (type, length, value);
+  NS_TEST_EXPECT_MSG_EQ (more, false, "Should be at end");
+  NS_TEST_EXPECT_MSG_EQ (cursor.IsEnd (), true, "Should be at end");
+  NS_TEST_EXPECT_MSG_EQ (cursor.HasError (), false, "Should not have an error");
+  NS_TEST_EXPECT_MSG_EQ (cursor.GetRemaining (), 0, "Should have nothing left");
+}
+EndTest ()
+
+BeginTest (Cursor_Overrun)
+{
+  // the second TLV claims 9 bytes but only 2 remain
+  const uint8_t encoded[] = {
+    0, 1, 0, 1, 'a',
+    0, 2, 0, 9, 'b', 'c'
+  };
+
+  CCNxTlvCursor cursor (encoded, sizeof(encoded));
+  uint16_t type;
+  uint16_t length;
+  const uint8_t *value;
+
+  NS_TEST_EXPECT_MSG_EQ (cursor.Next (type, length, value), true, "Should have read first TLV");
+  NS_TEST_EXPECT_MSG_EQ (cursor.Next (type, length, value), false, "Should stop at the overrun");
+  NS_TEST_EXPECT_MSG_EQ (cursor.HasError (), true, "Should have an error");
+  NS_TEST_EXPECT_MSG_EQ (cursor.IsEnd (), false, "Should not be at end");
+  NS_TEST_EXPECT_MSG_EQ (cursor.GetOffset (), 5, "Should not advance past the bad TLV");
+
+  // a partial TL is also an error
+  CCNxTlvCursor partial (encoded, 7);
+  partial.Next (type, length, value);
+  NS_TEST_EXPECT_MSG_EQ (partial.Next (type, length, value), false, "Should stop at the partial TL");
+  NS_TEST_EXPECT_MSG_EQ (partial.HasError (), true, "Should have an error");
+}
+EndTest ()
+
 /**
  * @ingroup ccnx-test
  *
@@ -79,6 +144,8 @@ public:
   TestSuiteCCNxTlv () : TestSuite ("ccnx-tlv", UNIT)
   {
     AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new Cursor_Next (), TestCase::QUICK);
+    AddTestCase (new Cursor_Overrun (), TestCase::QUICK);
   }
 } g_TestSuiteCCNxTlv;
 
@@ -55,6 +55,9 @@
 
 #include "ns3/test.h"
 #include "ns3/ccnx-packet.h"
+#include "ns3/ccnx-hasher-fnv1a.h"
+#include "ns3/ccnx-hasher-sha256.h"
+#include "ns3/ccnx-cachetime.h"
 
 #include "../TestMacros.h"
 
@@ -68,6 +71,172 @@ BeginTest (Constructor)
 }
 EndTest ()
 
+static Ptr<CCNxPacket>
+CreateContentObjectPacket (void)
+{
+  Ptr<CCNxName> name = Create<CCNxName> ("ccnx:/name=foo/name=bar");
+  Ptr<CCNxBuffer> payload = Create<CCNxBuffer> (11, "hello world");
+  Ptr<CCNxContentObject> content = Create<CCNxContentObject> (name, payload);
+  return CCNxPacket::CreateFromMessage (content);
+}
+
+BeginTest (ContentObjectHashComputedOnce)
+{
+  Ptr<CCNxPacket> packet = CreateContentObjectPacket ();
+  CCNxHashValue zero (0);
+  NS_TEST_EXPECT_MSG_EQ (*packet->GetContentObjectHash () == zero, true, "Hash should be zero before serialization");
+
+  Ptr<Packet> ns3Packet = packet->CreateNs3Packet ();
+  Ptr<CCNxHashValue> hash = packet->GetContentObjectHash ();
+  NS_TEST_EXPECT_MSG_EQ (*hash == zero, false, "Hash should be set after serialization");
+
+  Ptr<CCNxPacket> received = CCNxPacket::CreateFromNs3Packet (ns3Packet);
+  NS_TEST_EXPECT_MSG_EQ (*received->GetContentObjectHash () == *hash, true, "Deserialized hash differs from serialized hash");
+}
+EndTest ()
+
+BeginTest (InterestHasNoContentObjectHash)
+{
+  Ptr<CCNxInterest> interest = Create<CCNxInterest> (Create<CCNxName> ("ccnx:/name=foo/name=bar"));
+  Ptr<CCNxPacket> packet = CCNxPacket::CreateFromMessage (interest);
+  Ptr<Packet> ns3Packet = packet->CreateNs3Packet ();
+  Ptr<CCNxPacket> received = CCNxPacket::CreateFromNs3Packet (ns3Packet);
+
+  CCNxHashValue zero (0);
+  NS_TEST_EXPECT_MSG_EQ (*packet->GetContentObjectHash () == zero, true, "Interest should not have a hash");
+  NS_TEST_EXPECT_MSG_EQ (*received->GetContentObjectHash () == zero, true, "Interest should not have a hash");
+}
+EndTest ()
+
+BeginTest (ContentObjectHasher)
+{
+  CCNxPacket::SetContentObjectHasher (CreateObject<CCNxHasherSha256> ());
+  Ptr<CCNxPacket> packet = CreateContentObjectPacket ();
+  Ptr<Packet> ns3Packet = packet->CreateNs3Packet ();
+  NS_TEST_EXPECT_MSG_EQ (packet->GetContentObjectHash ()->size (), 32, "SHA-256 hash should be 32 bytes");
+
+  Ptr<CCNxPacket> received = CCNxPacket::CreateFromNs3Packet (ns3Packet);
+  NS_TEST_EXPECT_MSG_EQ (*received->GetContentObjectHash () == *packet->GetContentObjectHash (), true, "Wrong deserialized hash");
+
+  CCNxPacket::SetContentObjectHasher (CreateObject<CCNxHasherFnv1a> ());
+  packet = CreateContentObjectPacket ();
+  packet->CreateNs3Packet ();
+  NS_TEST_EXPECT_MSG_EQ (packet->GetContentObjectHash ()->size (), 8, "FNV-1a hash should be 8 bytes");
+}
+EndTest ()
+
+BeginTest (SerializeOnce)
+{
+  Ptr<CCNxPacket> packet = CreateContentObjectPacket ();
+  uint32_t wireSize = packet->GetWireSize ();
+  NS_TEST_EXPECT_MSG_EQ (wireSize, packet->GetFixedHeader ()->GetPacketLength (), "Wire size does not match fixed header");
+
+  Ptr<const Packet> first = packet->GetNs3Packet ();
+  Ptr<const Packet> second = packet->GetNs3Packet ();
+  bool same = (first == second);
+  NS_TEST_EXPECT_MSG_EQ (same, true, "GetNs3Packet should return the cached packet");
+  NS_TEST_EXPECT_MSG_EQ (first->GetSize (), wireSize, "Wrong serialized size");
+
+  Ptr<Packet> copy = packet->CreateNs3Packet ();
+  NS_TEST_EXPECT_MSG_EQ (copy->GetSize (), wireSize, "Wrong copy size");
+  bool shared = (copy == first);
+  NS_TEST_EXPECT_MSG_EQ (shared, false, "CreateNs3Packet should return a copy");
+}
+EndTest ()
+
+BeginTest (NewVersionAfterPerHopHeader)
+{
+  Ptr<CCNxPacket> packet = CreateContentObjectPacket ();
+  Ptr<const Packet> first = packet->GetNs3Packet ();
+  Ptr<CCNxHashValue> hash = packet->GetContentObjectHash ();
+
+  packet->AddPerHopHeaderEntry (Create<CCNxCachetime> (Create<CCNxTime> (1000)));
+  Ptr<const Packet> second = packet->GetNs3Packet ();
+  bool same = (first == second);
+  NS_TEST_EXPECT_MSG_EQ (same, false, "Adding a per hop header should make a new packet");
+  NS_TEST_EXPECT_MSG_EQ (second->GetSize (), packet->GetWireSize (), "Wrong serialized size");
+  NS_TEST_EXPECT_MSG_EQ (second->GetSize () > first->GetSize (), true, "Per hop header not serialized");
+  NS_TEST_EXPECT_MSG_EQ (packet->GetFixedHeader ()->GetPacketLength (), second->GetSize (), "Wrong fixed header length");
+  NS_TEST_EXPECT_MSG_EQ (*packet->GetContentObjectHash () == *hash, true, "Hash should not change");
+
+  Ptr<CCNxPacket> received = CCNxPacket::CreateFromNs3Packet (second);
+  NS_TEST_EXPECT_MSG_EQ (received->GetPerhopHeaders ()->size (), 1, "Missing per hop header");
+  NS_TEST_EXPECT_MSG_EQ (received->GetWireSize (), second->GetSize (), "Wrong received wire size");
+
+  // a new version of a received packet re-uses its message bytes
+  received->AddPerHopHeaderEntry (Create<CCNxCachetime> (Create<CCNxTime> (2000)));
+  Ptr<const Packet> third = received->GetNs3Packet ();
+  NS_TEST_EXPECT_MSG_EQ (third->GetSize (), second->GetSize () + (second->GetSize () - first->GetSize ()), "Wrong size with two per hop headers");
+  Ptr<CCNxPacket> again = CCNxPacket::CreateFromNs3Packet (third);
+  NS_TEST_EXPECT_MSG_EQ (again->GetPerhopHeaders ()->size (), 2, "Missing per hop headers");
+  NS_TEST_EXPECT_MSG_EQ (again->GetMessage ()->GetName ()->Equals (*packet->GetMessage ()->GetName ()), true, "Wrong name");
+}
+EndTest ()
+
+BeginTest (LazyDecode)
+{
+  Ptr<CCNxPacket> packet = CreateContentObjectPacket ();
+  Ptr<CCNxPacket> received = CCNxPacket::CreateFromNs3Packet (packet->GetNs3Packet ());
+
+  // forwarding the packet does not decode the payload
+  Ptr<const Packet> forwarded = received->GetNs3Packet ();
+  NS_TEST_EXPECT_MSG_EQ (forwarded->GetSize (), packet->GetWireSize (), "Wrong forwarded size");
+
+  Ptr<CCNxMessage> message = received->GetMessage ();
+  NS_TEST_EXPECT_MSG_EQ (message->GetName ()->Equals (*packet->GetMessage ()->GetName ()), true, "Wrong name");
+  NS_TEST_EXPECT_MSG_EQ (message->IsPayloadEncoded (), true, "Payload should still be encoded");
+  NS_TEST_EXPECT_MSG_EQ (message->HasPayload (), true, "Message should have a payload");
+  NS_TEST_EXPECT_MSG_EQ (message->GetPayloadSize (), 11, "Wrong payload size");
+
+  bool equal = message->GetPayload ()->Equals (packet->GetMessage ()->GetPayload ());
+  NS_TEST_EXPECT_MSG_EQ (equal, true, "Decoded payload differs");
+  NS_TEST_EXPECT_MSG_EQ (message->IsPayloadEncoded (), false, "Payload should be decoded");
+  NS_TEST_EXPECT_MSG_EQ (*received->GetContentObjectHash () == *packet->GetContentObjectHash (), true, "Wrong hash");
+}
+EndTest ()
+
+BeginTest (EagerDecode)
+{
+  CCNxPacket::SetLazyDecode (false);
+  Ptr<CCNxPacket> packet = CreateContentObjectPacket ();
+  Ptr<CCNxPacket> received = CCNxPacket::CreateFromNs3Packet (packet->GetNs3Packet ());
+  CCNxPacket::SetLazyDecode (true);
+
+  Ptr<CCNxMessage> message = received->GetMessage ();
+  NS_TEST_EXPECT_MSG_EQ (message->IsPayloadEncoded (), false, "Payload should be decoded");
+  bool equal = message->GetPayload ()->Equals (packet->GetMessage ()->GetPayload ());
+  NS_TEST_EXPECT_MSG_EQ (equal, true, "Decoded payload differs");
+}
+EndTest ()
+
+BeginTest (HopLimit)
+{
+  Ptr<CCNxInterest> interest = Create<CCNxInterest> (Create<CCNxName> ("ccnx:/name=foo/name=bar"));
+  Ptr<CCNxPacket> packet = CCNxPacket::CreateFromMessage (interest);
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t) packet->GetHopLimit (), (uint32_t) CCNxPacket::DefaultHopLimit, "Wrong default Interest hop limit");
+
+  Ptr<CCNxPacket> content = CreateContentObjectPacket ();
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t) content->GetHopLimit (), 0, "Content Object hop limit should be 0");
+
+  // The hop limit must survive serialization and a new version of the packet
+  packet->SetHopLimit (9);
+  Ptr<CCNxPacket> received = CCNxPacket::CreateFromNs3Packet (packet->GetNs3Packet ());
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t) received->GetHopLimit (), 9, "Hop limit not serialized");
+
+  Ptr<const Packet> first = received->GetNs3Packet ();
+  received->SetHopLimit (8);
+  Ptr<const Packet> second = received->GetNs3Packet ();
+  bool same = (first == second);
+  NS_TEST_EXPECT_MSG_EQ (same, false, "Setting the hop limit should make a new packet");
+  NS_TEST_EXPECT_MSG_EQ (second->GetSize (), first->GetSize (), "Wrong size");
+
+  received->AddPerHopHeaderEntry (Create<CCNxCachetime> (Create<CCNxTime> (1000)));
+  Ptr<CCNxPacket> again = CCNxPacket::CreateFromNs3Packet (received->GetNs3Packet ());
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t) again->GetHopLimit (), 8, "Hop limit lost by a new version");
+  NS_TEST_EXPECT_MSG_EQ (again->GetMessage ()->GetName ()->Equals (*interest->GetName ()), true, "Wrong name");
+}
+EndTest ()
+
 /**
  * @ingroup ccnx-test
  *
@@ -79,6 +248,14 @@ public:
   TestSuiteCCNxPacket () : TestSuite ("ccnx-packet", UNIT)
   {
     AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new ContentObjectHashComputedOnce (), TestCase::QUICK);
+    AddTestCase (new InterestHasNoContentObjectHash (), TestCase::QUICK);
+    AddTestCase (new ContentObjectHasher (), TestCase::QUICK);
+    AddTestCase (new SerializeOnce (), TestCase::QUICK);
+    AddTestCase (new NewVersionAfterPerHopHeader (), TestCase::QUICK);
+    AddTestCase (new LazyDecode (), TestCase::QUICK);
+    AddTestCase (new EagerDecode (), TestCase::QUICK);
+    AddTestCase (new HopLimit (), TestCase::QUICK);
   }
 } g_TestSuiteCCNxPacket;
 
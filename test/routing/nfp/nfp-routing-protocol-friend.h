@@ -189,6 +189,33 @@ public:
     return m_nfp->ReceiveHello (neighbor, msgSeqnum, ingressConnection);
   }
 
+  ns3::Ptr<const ns3::ccnx::NfpAdvertise>
+  GetRibAdvertisement (ns3::Ptr<const ns3::ccnx::CCNxName> prefix, ns3::Ptr<const ns3::ccnx::CCNxName> anchorName) const
+  {
+    return m_nfp->m_prefixes[prefix]->GetAdvertisement (anchorName);
+  }
+
+  void RecordSent (ns3::Ptr<const ns3::ccnx::CCNxName> prefix, ns3::Ptr<const ns3::ccnx::CCNxName> anchorName,
+                   ns3::Ptr<const ns3::ccnx::NfpAdvertise> advertise)
+  {
+    m_nfp->RecordSent (ns3::Create<ns3::ccnx::NfpWorkQueueEntry> (anchorName, prefix), advertise);
+  }
+
+  bool IsRefreshNeeded (ns3::Ptr<const ns3::ccnx::CCNxName> prefix, ns3::Ptr<const ns3::ccnx::CCNxName> anchorName)
+  {
+    return m_nfp->IsRefreshNeeded (prefix, anchorName);
+  }
+
+  /**
+   * True if the RIB has `prefix` with a next hop to `anchorName`.
+   */
+  bool
+  IsRibReachable (ns3::Ptr<const ns3::ccnx::CCNxName> prefix, ns3::Ptr<const ns3::ccnx::CCNxName> anchorName) const
+  {
+    return m_nfp->m_prefixes.find (prefix) != m_nfp->m_prefixes.end ()
+           && m_nfp->m_prefixes[prefix]->IsReachable (anchorName);
+  }
+
   typedef std::map< ns3::Ptr<ns3::ccnx::NfpNeighborKey>, ns3::Ptr<ns3::ccnx::NfpNeighbor>, ns3::ccnx::NfpNeighborKey::isLessPtrNfpNeighborKey > NeighborMapType;
   NeighborMapType &
   GetNeighbors (void)
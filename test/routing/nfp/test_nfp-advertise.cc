@@ -149,6 +149,22 @@ BeginTest (TestGetDistance)
 }
 EndTest ()
 
+BeginTest (TestConstructor_LinkCost)
+{
+  TestState state;
+  Ptr<NfpAdvertise> advertise = state.Create ();
+
+  Ptr<NfpAdvertise> finite = Create<NfpAdvertise> (*advertise, 1);
+  NS_TEST_EXPECT_MSG_EQ (finite->GetDistance (), state.distance + 1, "distance should include the link cost");
+  NS_TEST_EXPECT_MSG_EQ (finite->IsInfinite (), false, "distance should be finite");
+
+  // 0xabcd + 0xffff does not fit in 16 bits
+  Ptr<NfpAdvertise> infinite = Create<NfpAdvertise> (*advertise, 0xFFFF);
+  NS_TEST_EXPECT_MSG_EQ (infinite->GetDistance (), NfpAdvertise::InfiniteDistance, "distance should saturate");
+  NS_TEST_EXPECT_MSG_EQ (infinite->IsInfinite (), true, "distance should be infinite");
+}
+EndTest ()
+
 BeginTest (TestGetSerializedSize)
 {
   TestState state;
@@ -262,6 +278,7 @@ public:
     AddTestCase (new TestGetPrefix (), TestCase::QUICK);
     AddTestCase (new TestGetAnchorSeqnum (), TestCase::QUICK);
     AddTestCase (new TestGetDistance (), TestCase::QUICK);
+    AddTestCase (new TestConstructor_LinkCost (), TestCase::QUICK);
     AddTestCase (new TestGetSerializedSize (), TestCase::QUICK);
     AddTestCase (new TestEquals (), TestCase::QUICK);
     AddTestCase (new TestSerialize (), TestCase::QUICK);
@@ -65,6 +65,12 @@ namespace TestSuiteNfpLinkCost {
 
 BeginTest (Constructor)
 {
+  Ptr<NfpLinkCost> linkCost = Create<NfpLinkCost> (3, 10);
+  NS_TEST_EXPECT_MSG_EQ (linkCost->GetInterface (), 3, "Wrong interface");
+  NS_TEST_EXPECT_MSG_EQ (linkCost->GetCost (), 10, "Wrong cost");
+
+  linkCost->SetCost (20);
+  NS_TEST_EXPECT_MSG_EQ (linkCost->GetCost (), 20, "Wrong cost after SetCost");
 }
 EndTest ()
 
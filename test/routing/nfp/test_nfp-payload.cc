@@ -119,10 +119,10 @@ public:
   }
 
   Ptr<NfpPayload>
-  CreatePayload () const
+  CreatePayload (bool compact = false) const
   {
     Ptr<NfpPayload> payload = Create<NfpPayload> (1000, routerName,
-                                                  messageSeqnum);
+                                                  messageSeqnum, compact);
     payload->AppendMessage (adv1);
     payload->AppendMessage (adv2);
     payload->AppendMessage (withdraw);
@@ -265,6 +265,93 @@ BeginTest (TestDeserialize)
 }
 EndTest ()
 
+BeginTest (TestGetMessageSize_Compact)
+{
+  TestState state;
+  Ptr<NfpPayload> payload = state.CreatePayload (true);
+  NS_TEST_ASSERT_MSG_EQ (payload->IsCompact (), true, "Payload should be compact");
+
+  // anchorName is a T_NAME_REF, the prefix a T_NAME_DELTA of prefixName_2, and the
+  // seqnum and distance repeat adv2 so there is no T_ADV_DATA.
+  Ptr<NfpAdvertise> adv3 = Create<NfpAdvertise> (state.anchorName, Create<CCNxName> ("ccnx:/name=prefix/name=3"),
+                                                 state.anchorSeqnum_2, state.prefixDistance_2);
+  NS_TEST_ASSERT_MSG_EQ (payload->GetMessageSize (adv3), 4 + 6 + 13, "Wrong compact size");
+  NS_TEST_ASSERT_MSG_EQ (payload->GetMessageSize (adv3) < adv3->GetSerializedSize (), true, "Compact size not smaller");
+
+  size_t remaining = payload->GetRemaining ();
+  payload->AppendMessage (adv3);
+  NS_TEST_ASSERT_MSG_EQ (payload->GetRemaining (), remaining - (4 + 6 + 13), "Wrong remaining");
+}
+EndTest ()
+
+BeginTest (TestSerialize_Compact)
+{
+  TestState state;
+  Ptr<NfpPayload> payload = state.CreatePayload (true);
+
+  uint8_t expected[] = {
+    // msg header
+    0, 4, 0,116,
+    0, 0, 0, 10,
+    0, 1, 0,  6, 'r', 'o', 'u', 't', 'e', 'r',
+    0, 5, 0,  2, 0x12, 0x34,
+    // adv1 (anchor is index 1, prefix is index 2)
+    0, 7, 0, 43,
+    0, 0, 0, 10,
+    0, 1, 0,  6, 'a', 'n', 'c', 'h', 'o', 'r',
+    0, 0, 0, 15,
+    0, 1, 0,  6, 'p', 'r', 'e', 'f', 'i', 'x',
+    0, 1, 0,  1, '1',
+    0, 6, 0,  6, 0x01, 0x02, 0x03, 0x04, 0x0a, 0x0b,
+    // adv2 (prefix is index 3)
+    0, 7, 0, 29,
+    0, 9, 0,  2, 0, 1,
+    0, 10, 0, 9, 0, 2, 0, 1,
+    0, 1, 0,  1, '2',
+    0, 6, 0,  6, 0x05, 0x06, 0x07, 0x08, 0x0c, 0x0d,
+    // withdraw
+    0, 8, 0, 12,
+    0, 9, 0,  2, 0, 1,
+    0, 9, 0,  2, 0, 2,
+  };
+
+  NS_TEST_ASSERT_MSG_EQ (payload->GetSerializedSize (), sizeof(expected), "Wrong serialized size");
+
+  Buffer actual (0);
+  actual.AddAtStart (payload->GetSerializedSize ());
+  payload->Serialize (actual.Begin ());
+
+  int result = memcmp (expected, actual.PeekData (), sizeof(expected));
+  if (result != 0)
+    {
+      hexdump ("expected", sizeof(expected), expected);
+      hexdump ("actual", actual.GetSize (), actual.PeekData ());
+    }
+  NS_TEST_ASSERT_MSG_EQ (result, 0, "Incorrect serialized form");
+}
+EndTest ()
+
+BeginTest (TestDeserialize_Compact)
+{
+  TestState state;
+  Ptr<NfpPayload> payload = state.CreatePayload (true);
+  payload->AppendMessage (Create<NfpAdvertise> (state.anchorName, Create<CCNxName> ("ccnx:/name=prefix/name=3"),
+                                                state.anchorSeqnum_2, state.prefixDistance_2));
+  payload->AppendMessage (Create<NfpWithdraw> (state.routerName, Create<CCNxName> ("ccnx:/name=other")));
+
+  Buffer truth (0);
+  truth.AddAtStart (payload->GetSerializedSize ());
+  payload->Serialize (truth.Begin ());
+
+  Ptr<NfpPayload> test = Create<NfpPayload> ();
+  uint32_t length = test->Deserialize (truth.Begin ());
+
+  NS_TEST_ASSERT_MSG_EQ (length, payload->GetSerializedSize (), "Wrong deserialized length");
+  NS_TEST_ASSERT_MSG_EQ (test->IsCompact (), true, "Deserialized payload should be compact");
+  NS_TEST_ASSERT_MSG_EQ (payload->Equals (*test), true, "Incorrect deserialize");
+}
+EndTest ()
+
 /**
  * \ingroup ccnx-test
  *
@@ -285,6 +372,9 @@ public:
     AddTestCase (new TestGetSerializedSize (), TestCase::QUICK);
     AddTestCase (new TestSerialize (), TestCase::QUICK);
     AddTestCase (new TestDeserialize (), TestCase::QUICK);
+    AddTestCase (new TestGetMessageSize_Compact (), TestCase::QUICK);
+    AddTestCase (new TestSerialize_Compact (), TestCase::QUICK);
+    AddTestCase (new TestDeserialize_Compact (), TestCase::QUICK);
   }
 } g_TestSuiteNfpPayload;
 }
@@ -54,7 +54,9 @@
  */
 
 #include "ns3/test.h"
+#include "ns3/simulator.h"
 #include "ns3/nfp-prefix.h"
+#include "../../mockups/mockup_ccnx-virtual-connection.h"
 
 #include "../../TestMacros.h"
 
@@ -63,11 +65,91 @@ using namespace ns3::ccnx;
 
 namespace TestSuiteNfpPrefix {
 
+static unsigned _stateChanges = 0;
+
+static void
+StateChanged (Ptr<const CCNxName> prefix, Ptr<const CCNxName> anchorName)
+{
+  _stateChanges++;
+}
+
+static Ptr<NfpPrefix>
+CreatePrefix (Time advertisementTimeout)
+{
+  Ptr<const CCNxName> prefix = Create<CCNxName> ("ccnx:/name=mars");
+  return Create<NfpPrefix> (prefix, advertisementTimeout, MakeCallback (&StateChanged));
+}
+
+static void
+Advertise (Ptr<NfpPrefix> prefix, const char *anchor, uint16_t distance, Ptr<CCNxConnection> connection)
+{
+  Ptr<NfpAdvertise> advertise = Create<NfpAdvertise> (Create<CCNxName> (anchor), prefix->GetPrefix (), 1, distance);
+  prefix->ReceiveAdvertisement (advertise, connection, Simulator::Now ());
+}
+
 BeginTest (Constructor)
 {
 }
 EndTest ()
 
+BeginTest (RemoveConnection)
+{
+  Ptr<NfpPrefix> prefix = CreatePrefix (Seconds (10));
+  Ptr<CCNxConnection> c1 = Create<CCNxVirtualConnection> (1);
+  Ptr<CCNxConnection> c2 = Create<CCNxVirtualConnection> (2);
+  Ptr<CCNxConnection> c3 = Create<CCNxVirtualConnection> (3);
+
+  // anchor A on c1 and c3 (equal cost), anchor B on c2
+  Advertise (prefix, "ccnx:/name=anchor_a", 2, c1);
+  Advertise (prefix, "ccnx:/name=anchor_b", 3, c2);
+  Advertise (prefix, "ccnx:/name=anchor_a", 2, c3);
+
+  Ptr<const CCNxRoute> route = prefix->GetRoute ();
+  NS_TEST_EXPECT_MSG_EQ (route->size (), 3, "Route should have 3 nexthops");
+  NS_TEST_EXPECT_MSG_EQ (prefix->GetRoute (), route, "Unchanged route should come from the cache");
+
+  // an unknown connection changes nothing
+  prefix->RemoveConnection (Create<CCNxVirtualConnection> (9));
+  NS_TEST_EXPECT_MSG_EQ (prefix->GetRoute (), route, "Unknown connection should not rebuild the route");
+
+  _stateChanges = 0;
+  prefix->RemoveConnection (c2);
+  NS_TEST_EXPECT_MSG_EQ (_stateChanges, 1, "Anchor B should have become unreachable");
+  NS_TEST_EXPECT_MSG_EQ (prefix->IsReachable (Create<CCNxName> ("ccnx:/name=anchor_b")), false, "Anchor B should be unreachable");
+  NS_TEST_EXPECT_MSG_EQ (prefix->GetRoute ()->size (), 2, "Route should have 2 nexthops");
+  NS_TEST_EXPECT_MSG_EQ (route->size (), 3, "The old route should not be modified");
+
+  prefix->RemoveConnection (c1);
+  NS_TEST_EXPECT_MSG_EQ (prefix->IsReachable (), true, "Anchor A is still reachable on c3");
+  prefix->RemoveConnection (c3);
+  NS_TEST_EXPECT_MSG_EQ (prefix->IsReachable (), false, "No anchor should be reachable");
+  NS_TEST_EXPECT_MSG_EQ (_stateChanges, 2, "Anchor A should have become unreachable");
+}
+EndTest ()
+
+static size_t _routeSize = 0;
+
+static void
+CheckRouteSize (Ptr<NfpPrefix> prefix)
+{
+  _routeSize = prefix->GetRoute ()->size ();
+}
+
+BeginTest (RouteExpiry)
+{
+  Ptr<NfpPrefix> prefix = CreatePrefix (Seconds (1));
+  Advertise (prefix, "ccnx:/name=anchor_a", 2, Create<CCNxVirtualConnection> (1));
+  NS_TEST_EXPECT_MSG_EQ (prefix->GetRoute ()->size (), 1, "Route should have 1 nexthop");
+
+  // the cached route must not outlive the advertisement timeout
+  Simulator::Schedule (Seconds (2), &CheckRouteSize, prefix);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (_routeSize, 0, "Route should have expired");
+}
+EndTest ()
+
 /**
  * @ingroup ccnx-test
  *
@@ -79,6 +161,8 @@ public:
   TestSuiteNfpPrefix () : TestSuite ("nfp-prefix", UNIT)
   {
     AddTestCase (new Constructor (), TestCase::QUICK);
+    AddTestCase (new RemoveConnection (), TestCase::QUICK);
+    AddTestCase (new RouteExpiry (), TestCase::QUICK);
   }
 } g_TestSuiteNfpPrefix;
 
@@ -54,12 +54,15 @@
  */
 
 #include <deque>
+#include <sstream>
 #include <map>
+#include <limits>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/type-id.h"
 #include "ns3/ccnx-stack-helper.h"
 #include "ns3/ccnx-packet.h"
+#include "ns3/uinteger.h"
 
 #include "ns3/nfp-routing-protocol.h"
 #include "ns3/nfp-routing-helper.h"
@@ -336,6 +339,51 @@ BeginTest (TestCreatePacket)
 }
 EndTest ()
 
+/**
+ * Fill a payload on a 1500 byte MTU interface and verify the Interest fits the MTU
+ * with no room for another advertisement.
+ */
+BeginTest (TestCreatePayload_FitsMtu)
+{
+  std::cout << GetName() << ".DoRun()" << std::endl;
+
+  Ptr<Node> node = Create<Node> ();
+  Ptr<NfpRoutingProtocol> nfp = CreateProtocol (node);
+  NfpRoutingProtocolFriend theFriend (nfp);
+  Ptr<VirtualNetDevice> if0 = SetupTapDevice (node, 0, MakeCallback (&TestCreatePayload_FitsMtu::SendCallback, this));
+  theFriend.DoInitialize ();
+
+  Ptr<NfpPayload> payload = theFriend.CreatePayload ();
+  NS_TEST_ASSERT_MSG_EQ (payload->IsCompact (), true, "CompactPayloads should default to true");
+
+  Ptr<NfpAdvertise> advertise;
+  for (int i = 0; ; ++i)
+    {
+      std::ostringstream uri;
+      uri << "ccnx:/name=foo/name=prefix" << i;
+      advertise = Create<NfpAdvertise> (theFriend.GetRouterName (), Create<CCNxName> (uri.str ()), 1, 1);
+      if (payload->GetMessageSize (advertise) > payload->GetRemaining ())
+        {
+          break;
+        }
+      payload->AppendMessage (advertise);
+    }
+
+  Ptr<CCNxPacket> packet = theFriend.CreatePacket (payload);
+  NS_TEST_ASSERT_MSG_EQ ((packet->GetWireSize () <= 1500), true, "Packet exceeds the MTU");
+  NS_TEST_ASSERT_MSG_EQ ((packet->GetWireSize () + payload->GetMessageSize (advertise) > 1500), true,
+                         "Another advertisement would have fit in the MTU");
+}
+
+bool
+SendCallback (Ptr<Packet> packet, const Address& source,
+              const Address& dest, uint16_t protocolNumber)
+{
+  return false;
+}
+
+EndTest ()
+
 /**
  * Add an interface to L3 and verify that we get the Up notification.
  */
@@ -516,6 +564,109 @@ BeginTest (TestReceiveHello_Update)
 }
 EndTest ()
 
+BeginTest (TestReceiveAdvertise_LinkCost)
+{
+  std::cout << GetName() << ".DoRun()" << std::endl;
+
+  Ptr<Node> node = Create<Node> ();
+
+  Ptr<NfpRoutingProtocol> nfp = CreateProtocol (node);
+  nfp->SetAttribute ("LinkCost", UintegerValue (5));
+  NfpRoutingProtocolFriend theFriend (nfp);
+  theFriend.DoInitialize ();
+
+  NS_TEST_EXPECT_MSG_EQ (nfp->GetLinkCost (7), 5, "An unknown interface should use the LinkCost attribute");
+  nfp->SetLinkCost (7, 9);
+  NS_TEST_EXPECT_MSG_EQ (nfp->GetLinkCost (7), 9, "Wrong configured link cost");
+
+  // A virtual connection is not on an interface, so it uses the LinkCost attribute
+  Ptr<const CCNxName> anchorName = Create<CCNxName> ("ccnx:/name=martian");
+  Ptr<const CCNxName> prefix = Create<CCNxName> ("ccnx:/name=mars");
+  Ptr<NfpAdvertise> advertise = Create<NfpAdvertise> (anchorName, prefix, 1, 3);
+  Ptr<CCNxVirtualConnection> ingressConnection = Create<CCNxVirtualConnection> (99);
+  theFriend.ReceiveAdvertise (advertise, ingressConnection);
+
+  Ptr<const NfpAdvertise> stored = theFriend.GetRibAdvertisement (prefix, anchorName);
+  NS_TEST_EXPECT_MSG_EQ (stored->GetDistance (), 8, "RIB distance should include the link cost");
+  NS_TEST_EXPECT_MSG_EQ (advertise->GetDistance (), 3, "The received advertisement should not change");
+}
+EndTest ()
+
+BeginTest (TestReceiveAdvertise_InfiniteDistance)
+{
+  std::cout << GetName() << ".DoRun()" << std::endl;
+
+  Ptr<Node> node = Create<Node> ();
+
+  Ptr<NfpRoutingProtocol> nfp = CreateProtocol (node);
+  nfp->SetAttribute ("LinkCost", UintegerValue (5));
+  NfpRoutingProtocolFriend theFriend (nfp);
+  theFriend.DoInitialize ();
+
+  Ptr<const CCNxName> anchorName = Create<CCNxName> ("ccnx:/name=martian");
+  Ptr<const CCNxName> prefix = Create<CCNxName> ("ccnx:/name=mars");
+  Ptr<CCNxVirtualConnection> ingressConnection = Create<CCNxVirtualConnection> (99);
+
+  // A finite distance is stored
+  theFriend.ReceiveAdvertise (Create<NfpAdvertise> (anchorName, prefix, 1, 3), ingressConnection);
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRibReachable (prefix, anchorName), true, "A finite distance should be reachable");
+
+  // distance + link cost saturates, which withdraws the route through this neighbor
+  nfp->SetAttribute ("LinkCost", UintegerValue (std::numeric_limits<uint16_t>::max ()));
+  Ptr<NfpAdvertise> advertise = Create<NfpAdvertise> (anchorName, prefix, 2, 3);
+  theFriend.ReceiveAdvertise (advertise, ingressConnection);
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRibReachable (prefix, anchorName), false, "An infinite distance should withdraw the route");
+  NS_TEST_EXPECT_MSG_EQ (advertise->GetDistance (), 3, "The received advertisement should not change");
+
+  // A new prefix at an infinite distance is not added
+  Ptr<const CCNxName> other = Create<CCNxName> ("ccnx:/name=phobos");
+  theFriend.ReceiveAdvertise (Create<NfpAdvertise> (anchorName, other, 1, 1), ingressConnection);
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRibReachable (other, anchorName), false, "An infinite distance should not be added");
+}
+EndTest ()
+
+BeginTest (TestDeltaRefresh)
+{
+  std::cout << GetName() << ".DoRun()" << std::endl;
+
+  Ptr<Node> node = Create<Node> ();
+
+  Ptr<NfpRoutingProtocol> nfp = CreateProtocol (node);
+  nfp->SetAttribute ("FullRefreshInterval", UintegerValue (3));
+  NfpRoutingProtocolFriend theFriend (nfp);
+  theFriend.DoInitialize ();
+
+  Ptr<const CCNxName> anchorName = Create<CCNxName> ("ccnx:/name=martian");
+  Ptr<const CCNxName> prefix = Create<CCNxName> ("ccnx:/name=mars");
+  Ptr<CCNxVirtualConnection> ingressConnection = Create<CCNxVirtualConnection> (99);
+
+  // Never sent, so the refresh is needed
+  theFriend.ReceiveAdvertise (Create<NfpAdvertise> (anchorName, prefix, 1, 3), ingressConnection);
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRefreshNeeded (prefix, anchorName), true, "An unsent route should be refreshed");
+
+  // Unchanged since sent: two delta refreshes skip it, the third is a full refresh
+  theFriend.RecordSent (prefix, anchorName, theFriend.GetRibAdvertisement (prefix, anchorName));
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRefreshNeeded (prefix, anchorName), false, "Unchanged route should be skipped");
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRefreshNeeded (prefix, anchorName), false, "Unchanged route should be skipped");
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRefreshNeeded (prefix, anchorName), true, "Third refresh should be full");
+
+  // A new anchor seqnum is a change
+  theFriend.RecordSent (prefix, anchorName, theFriend.GetRibAdvertisement (prefix, anchorName));
+  theFriend.ReceiveAdvertise (Create<NfpAdvertise> (anchorName, prefix, 2, 3), ingressConnection);
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRefreshNeeded (prefix, anchorName), true, "Changed seqnum should be refreshed");
+
+  // A withdrawn route is skipped after its withdraw was sent
+  theFriend.ReceiveWithdraw (Create<NfpWithdraw> (anchorName, prefix), ingressConnection);
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRefreshNeeded (prefix, anchorName), true, "Withdrawn route should be refreshed");
+  theFriend.RecordSent (prefix, anchorName, Ptr<const NfpAdvertise> (0));
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRefreshNeeded (prefix, anchorName), false, "Sent withdraw should be skipped");
+
+  // With a full refresh every interval, everything is sent
+  nfp->SetAttribute ("FullRefreshInterval", UintegerValue (1));
+  NS_TEST_EXPECT_MSG_EQ (theFriend.IsRefreshNeeded (prefix, anchorName), true, "Every refresh should be full");
+}
+EndTest ()
+
 static uint32_t
 GetLastConnectionId()
 {
@@ -662,12 +813,16 @@ public:
 
     AddTestCase (new TestCreatePayload (), TestCase::QUICK);
     AddTestCase (new TestCreatePacket (), TestCase::QUICK);
+    AddTestCase (new TestCreatePayload_FitsMtu (), TestCase::QUICK);
     AddTestCase (new TestNotifyInterfaceUp (), TestCase::QUICK);
     AddTestCase (new TestBroadcast (), TestCase::QUICK);
 
     AddTestCase (new TestReceiveHello_FirstTime (), TestCase::QUICK);
     AddTestCase (new TestReceiveHello_OldSeqnum (), TestCase::QUICK);
     AddTestCase (new TestReceiveHello_Update (), TestCase::QUICK);
+    AddTestCase (new TestReceiveAdvertise_LinkCost (), TestCase::QUICK);
+    AddTestCase (new TestReceiveAdvertise_InfiniteDistance (), TestCase::QUICK);
+    AddTestCase (new TestDeltaRefresh (), TestCase::QUICK);
     AddTestCase (new TestReceiveNotify_Hello (), TestCase::QUICK);
     AddTestCase (new TestHelloExpired (), TestCase::QUICK);
 